@@ -0,0 +1,68 @@
+﻿using Jacobi.Vst.Core;
+using Jacobi.Vst.Core.Plugin;
+using Jacobi.Vst.Plugin.Framework;
+using Jacobi.Vst.Plugin.Framework.Plugin;
+
+namespace Jacobi.Vst.Benchmark.Plugin
+{
+    /// <summary>
+    /// Accepts the buffers and leaves them untouched.
+    /// </summary>
+    /// <remarks>The number of channels follows the speaker arrangement the host proposes.</remarks>
+    internal sealed class AudioProcessor : VstPluginAudioPrecisionProcessor, IVstPluginConnections
+    {
+        private readonly Plugin _plugin;
+
+        /// <summary>
+        /// Constructs a new instance.
+        /// </summary>
+        /// <param name="plugin">Must not be null.</param>
+        public AudioProcessor(Plugin plugin)
+            : base(2, 2, 0, noSoundOnStop: false)
+        {
+            _plugin = plugin;
+        }
+
+        public override void Process(VstAudioBuffer[] inChannels, VstAudioBuffer[] outChannels)
+        { }
+
+        public override void Process(VstAudioPrecisionBuffer[] inChannels, VstAudioPrecisionBuffer[] outChannels)
+        { }
+
+        #region IVstPluginConnections Members
+
+        public VstSpeakerArrangement InputSpeakerArrangement { get; private set; }
+
+        public VstSpeakerArrangement OutputSpeakerArrangement { get; private set; }
+
+        public VstConnectionInfoCollection InputConnectionInfos { get; } = new VstConnectionInfoCollection();
+
+        public VstConnectionInfoCollection OutputConnectionInfos { get; } = new VstConnectionInfoCollection();
+
+        public bool AcceptNewArrangement(VstSpeakerArrangement input, VstSpeakerArrangement output)
+        {
+            var hostCmdProxy = _plugin.Host?.GetInstance<IVstHostCommandProxy>();
+
+            if (hostCmdProxy == null)
+            {
+                return false;
+            }
+
+            InputSpeakerArrangement = input;
+            OutputSpeakerArrangement = output;
+            InputCount = input.Speakers?.Length ?? 0;
+            OutputCount = output.Speakers?.Length ?? 0;
+
+            // updates the channel counts the interop uses to wrap the buffers
+            var pluginInfo = new VstPluginInfo
+            {
+                AudioInputCount = InputCount,
+                AudioOutputCount = OutputCount,
+            };
+
+            return hostCmdProxy.UpdatePluginInfo(pluginInfo);
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,15 @@
+﻿using Jacobi.Vst.Plugin.Framework;
+
+namespace Jacobi.Vst.Benchmark.Plugin
+{
+    /// <summary>
+    /// Accepts the Midi events and ignores them.
+    /// </summary>
+    internal sealed class MidiProcessor : IVstMidiProcessor
+    {
+        public int ChannelCount => 16;
+
+        public void Process(VstEventCollection events)
+        { }
+    }
+}
@@ -0,0 +1,30 @@
+﻿using Jacobi.Vst.Core;
+using Jacobi.Vst.Plugin.Framework;
+using Jacobi.Vst.Plugin.Framework.Plugin;
+using Microsoft.Extensions.DependencyInjection;
+
+namespace Jacobi.Vst.Benchmark.Plugin
+{
+    /// <summary>
+    /// The Plugin root class.
+    /// </summary>
+    /// <remarks>The plugin accepts any number of channels and Midi events and does no processing,
+    /// so the process block benchmarks measure the interop and framework only.</remarks>
+    internal sealed class Plugin : VstPluginWithServices
+    {
+        /// <summary>
+        /// Constructs a new instance.
+        /// </summary>
+        public Plugin()
+            : base("VST.NET Benchmark Plugin", 0x4E6F4F70,
+                new VstProductInfo("VST.NET Benchmark", "Jacobi Software © 2008-2020", 2000),
+                VstPluginCategory.Effect)
+        { }
+
+        protected override void ConfigureServices(IServiceCollection services)
+        {
+            services.AddSingletonAll(new AudioProcessor(this));
+            services.AddSingletonAll(new MidiProcessor());
+        }
+    }
+}
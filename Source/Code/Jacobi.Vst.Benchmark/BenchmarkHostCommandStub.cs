@@ -0,0 +1,49 @@
+﻿using Jacobi.Vst.Core;
+using Jacobi.Vst.Core.Host;
+
+namespace Jacobi.Vst.Benchmark
+{
+    /// <summary>
+    /// Answers the plugin with fixed values.
+    /// </summary>
+    internal sealed class BenchmarkHostCommandStub : IVstHostCommandStub
+    {
+        public BenchmarkHostCommandStub()
+        {
+            Commands = new HostCommands();
+        }
+
+        public IVstPluginContext PluginContext { get; set; }
+
+        public IVstHostCommands20 Commands { get; }
+
+        private sealed class HostCommands : IVstHostCommands20
+        {
+            public VstTimeInfo GetTimeInfo(VstTimeInfoFlags filterFlags) => null;
+            public bool ProcessEvents(VstEvent[] events) => false;
+            public bool IoChanged() => true;
+            public bool SizeWindow(int width, int height) => false;
+            public float GetSampleRate() => 44100.0f;
+            public int GetBlockSize() => 0;
+            public int GetInputLatency() => 0;
+            public int GetOutputLatency() => 0;
+            public VstProcessLevels GetProcessLevel() => VstProcessLevels.Realtime;
+            public VstAutomationStates GetAutomationState() => VstAutomationStates.Off;
+            public string GetVendorString() => "Jacobi Software";
+            public string GetProductString() => "VST.NET Benchmark";
+            public int GetVendorVersion() => 2000;
+            public VstCanDoResult CanDo(string cando) => VstCanDoResult.No;
+            public VstHostLanguage GetLanguage() => VstHostLanguage.English;
+            public string GetDirectory() => null;
+            public bool UpdateDisplay() => false;
+            public bool BeginEdit(int index) => false;
+            public bool EndEdit(int index) => false;
+            public bool OpenFileSelector(VstFileSelect fileSelect) => false;
+            public bool CloseFileSelector(VstFileSelect fileSelect) => false;
+            public void SetParameterAutomated(int index, float value) { }
+            public int GetVersion() => 2400;
+            public int GetCurrentPluginID() => 0;
+            public void ProcessIdle() { }
+        }
+    }
+}
@@ -0,0 +1,44 @@
+﻿using System.Collections.Generic;
+
+namespace Jacobi.Vst.Benchmark
+{
+    /// <summary>
+    /// The timing and allocation figures of one benchmark.
+    /// </summary>
+    internal sealed class BenchmarkResult
+    {
+        public string Name { get; set; }
+        public IDictionary<string, int> Parameters { get; set; }
+
+        /// <summary>The number of calls per sample.</summary>
+        public int Iterations { get; set; }
+        /// <summary>The number of timed samples.</summary>
+        public int Samples { get; set; }
+
+        public double MinNanoseconds { get; set; }
+        public double MedianNanoseconds { get; set; }
+        public double MeanNanoseconds { get; set; }
+        public double StdDevNanoseconds { get; set; }
+
+        /// <summary>The managed bytes allocated per call.</summary>
+        public double AllocatedBytes { get; set; }
+
+        public string DisplayName
+        {
+            get
+            {
+                if (Parameters.Count == 0)
+                {
+                    return Name;
+                }
+
+                var values = new List<string>();
+                foreach (var param in Parameters)
+                {
+                    values.Add($"{param.Key}={param.Value}");
+                }
+                return $"{Name}({string.Join(", ", values)})";
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+﻿using Jacobi.Vst.Benchmark.Interop;
+using System;
+using System.Diagnostics;
+using System.Linq;
+
+namespace Jacobi.Vst.Benchmark
+{
+    /// <summary>
+    /// Measures an <see cref="InteropBenchmark"/>.
+    /// </summary>
+    /// <remarks>The iteration count is doubled until one sample takes at least <see cref="SampleTime"/>.
+    /// Then a number of samples is timed and reported per call.</remarks>
+    internal sealed class BenchmarkRunner
+    {
+        public TimeSpan SampleTime { get; set; } = TimeSpan.FromMilliseconds(10);
+        public int SampleCount { get; set; } = 15;
+        public int WarmupCount { get; set; } = 3;
+
+        public BenchmarkResult Run(InteropBenchmark benchmark)
+        {
+            benchmark.Setup();
+
+            try
+            {
+                var iterations = Calibrate(benchmark);
+
+                for (int i = 0; i < WarmupCount; i++)
+                {
+                    benchmark.Run(iterations);
+                }
+
+                GC.Collect();
+                GC.WaitForPendingFinalizers();
+                GC.Collect();
+
+                var samples = new double[SampleCount];
+                var allocated = GC.GetAllocatedBytesForCurrentThread();
+
+                for (int i = 0; i < SampleCount; i++)
+                {
+                    var start = Stopwatch.GetTimestamp();
+                    benchmark.Run(iterations);
+                    var elapsed = Stopwatch.GetTimestamp() - start;
+
+                    samples[i] = elapsed * (1e9 / Stopwatch.Frequency) / iterations;
+                }
+
+                allocated = GC.GetAllocatedBytesForCurrentThread() - allocated;
+
+                return CreateResult(benchmark, iterations, samples, (double)allocated / ((long)iterations * SampleCount));
+            }
+            finally
+            {
+                benchmark.Cleanup();
+            }
+        }
+
+        private int Calibrate(InteropBenchmark benchmark)
+        {
+            var sampleTicks = SampleTime.TotalSeconds * Stopwatch.Frequency;
+            var iterations = 1;
+
+            while (iterations < Int32.MaxValue / 2)
+            {
+                var start = Stopwatch.GetTimestamp();
+                benchmark.Run(iterations);
+                var elapsed = Stopwatch.GetTimestamp() - start;
+
+                if (elapsed >= sampleTicks)
+                {
+                    break;
+                }
+
+                iterations *= 2;
+            }
+
+            return iterations;
+        }
+
+        private static BenchmarkResult CreateResult(InteropBenchmark benchmark, int iterations, double[] samples, double allocatedBytes)
+        {
+            var sorted = samples.OrderBy(s => s).ToArray();
+            var mean = sorted.Average();
+            var variance = sorted.Sum(s => (s - mean) * (s - mean)) / Math.Max(1, sorted.Length - 1);
+
+            return new BenchmarkResult
+            {
+                Name = benchmark.Name,
+                Parameters = benchmark.Parameters,
+                Iterations = iterations,
+                Samples = sorted.Length,
+                MinNanoseconds = sorted[0],
+                MedianNanoseconds = sorted[sorted.Length / 2],
+                MeanNanoseconds = mean,
+                StdDevNanoseconds = Math.Sqrt(variance),
+                AllocatedBytes = allocatedBytes,
+            };
+        }
+    }
+}
@@ -0,0 +1,27 @@
+﻿using System;
+
+namespace Jacobi.Vst.Benchmark
+{
+    /// <summary>
+    /// A host that calls a plugin block by block and times each block.
+    /// </summary>
+    internal interface IProcessBlockHost : IDisposable
+    {
+        /// <summary>
+        /// Gets the name of the measured path, for instance 'ProcessBlock.NativeHost'.
+        /// </summary>
+        string Name { get; }
+
+        /// <summary>
+        /// Sets the number of input and output channels and resumes the plugin.
+        /// </summary>
+        /// <returns>Returns false when the plugin did not accept the channel count.</returns>
+        bool Configure(int channelCount, int maxBlockSize, float sampleRate);
+
+        /// <summary>
+        /// Processes one block of <paramref name="blockSize"/> samples and <paramref name="eventCount"/> Midi events
+        /// for each element of <paramref name="blockNanoseconds"/> and stores the duration of each block.
+        /// </summary>
+        void Run(int blockSize, int eventCount, bool doublePrecision, double[] blockNanoseconds);
+    }
+}
@@ -0,0 +1,78 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Text.Json;
+
+namespace Jacobi.Vst.Benchmark
+{
+    /// <summary>
+    /// Writes benchmark results as json, one object per benchmark.
+    /// </summary>
+    /// <remarks>Times are in nanoseconds per call (results) or per block (processBlocks), allocations in bytes per call.</remarks>
+    internal static class JsonResultWriter
+    {
+        public static void Write(Stream stream, IEnumerable<BenchmarkResult> results, IEnumerable<ProcessBlockResult> processBlockResults)
+        {
+            using (var writer = new Utf8JsonWriter(stream, new JsonWriterOptions { Indented = true }))
+            {
+                writer.WriteStartObject();
+
+                writer.WriteStartObject("environment");
+                writer.WriteString("timestamp", DateTimeOffset.Now);
+                writer.WriteString("machine", Environment.MachineName);
+                writer.WriteString("os", RuntimeInformation.OSDescription);
+                writer.WriteString("runtime", RuntimeInformation.FrameworkDescription);
+                writer.WriteString("architecture", RuntimeInformation.ProcessArchitecture.ToString());
+                writer.WriteNumber("processorCount", Environment.ProcessorCount);
+                writer.WriteEndObject();
+
+                writer.WriteStartArray("results");
+                foreach (var result in results)
+                {
+                    writer.WriteStartObject();
+                    writer.WriteString("name", result.Name);
+
+                    writer.WriteStartObject("parameters");
+                    foreach (var param in result.Parameters)
+                    {
+                        writer.WriteNumber(param.Key, param.Value);
+                    }
+                    writer.WriteEndObject();
+
+                    writer.WriteNumber("iterations", result.Iterations);
+                    writer.WriteNumber("samples", result.Samples);
+                    writer.WriteNumber("minNs", result.MinNanoseconds);
+                    writer.WriteNumber("medianNs", result.MedianNanoseconds);
+                    writer.WriteNumber("meanNs", result.MeanNanoseconds);
+                    writer.WriteNumber("stdDevNs", result.StdDevNanoseconds);
+                    writer.WriteNumber("allocatedBytes", result.AllocatedBytes);
+                    writer.WriteEndObject();
+                }
+                writer.WriteEndArray();
+
+                writer.WriteStartArray("processBlocks");
+                foreach (var result in processBlockResults)
+                {
+                    writer.WriteStartObject();
+                    writer.WriteString("name", result.Name);
+                    writer.WriteNumber("blockSize", result.BlockSize);
+                    writer.WriteNumber("channels", result.Channels);
+                    writer.WriteNumber("events", result.Events);
+                    writer.WriteNumber("precision", result.Precision);
+                    writer.WriteNumber("blocks", result.Blocks);
+                    writer.WriteNumber("minNs", result.MinNanoseconds);
+                    writer.WriteNumber("meanNs", result.MeanNanoseconds);
+                    writer.WriteNumber("p50Ns", result.P50Nanoseconds);
+                    writer.WriteNumber("p99Ns", result.P99Nanoseconds);
+                    writer.WriteNumber("p999Ns", result.P999Nanoseconds);
+                    writer.WriteNumber("maxNs", result.MaxNanoseconds);
+                    writer.WriteEndObject();
+                }
+                writer.WriteEndArray();
+
+                writer.WriteEndObject();
+            }
+        }
+    }
+}
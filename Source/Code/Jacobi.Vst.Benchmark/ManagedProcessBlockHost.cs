@@ -0,0 +1,154 @@
+﻿using Jacobi.Vst.Core;
+using Jacobi.Vst.Core.Host;
+using Jacobi.Vst.Host.Interop;
+using System;
+using System.Diagnostics;
+using System.Linq;
+
+namespace Jacobi.Vst.Benchmark
+{
+    /// <summary>
+    /// Managed host → Host.Interop (VstPluginCommandsImpl) → native plugin.
+    /// </summary>
+    /// <remarks>Each block is one <see cref="IVstPluginCommands20.ProcessEvents"/> call (when there are events)
+    /// and one ProcessReplacing call, timed with the <see cref="Stopwatch"/>.</remarks>
+    internal sealed class ManagedProcessBlockHost : IProcessBlockHost
+    {
+        private readonly VstPluginContext _pluginCtx;
+        private readonly IVstPluginCommands24 _commands;
+        private bool _isResumed;
+        private int _channelCount;
+
+        public ManagedProcessBlockHost(string pluginPath)
+        {
+            _pluginCtx = VstPluginContext.Create(pluginPath, new BenchmarkHostCommandStub());
+            _commands = _pluginCtx.PluginCommandStub.Commands;
+            _commands.Open();
+        }
+
+        public const string HostName = "ProcessBlock.ManagedHost";
+
+        public string Name => HostName;
+
+        public bool Configure(int channelCount, int maxBlockSize, float sampleRate)
+        {
+            Suspend();
+
+            _commands.SetSampleRate(sampleRate);
+            _commands.SetBlockSize(maxBlockSize);
+
+            if (!_commands.SetSpeakerArrangement(CreateArrangement(channelCount), CreateArrangement(channelCount)))
+            {
+                return false;
+            }
+
+            _channelCount = channelCount;
+            _commands.MainsChanged(true);
+            _commands.StartProcess();
+            _isResumed = true;
+            return true;
+        }
+
+        public void Run(int blockSize, int eventCount, bool doublePrecision, double[] blockNanoseconds)
+        {
+            var events = CreateEvents(eventCount, blockSize);
+
+            if (doublePrecision)
+            {
+                using (var inputMgr = new VstAudioPrecisionBufferManager(_channelCount, blockSize))
+                using (var outputMgr = new VstAudioPrecisionBufferManager(_channelCount, blockSize))
+                {
+                    var inputs = inputMgr.Buffers.ToArray();
+                    var outputs = outputMgr.Buffers.ToArray();
+
+                    for (int block = 0; block < blockNanoseconds.Length; block++)
+                    {
+                        var start = Stopwatch.GetTimestamp();
+
+                        if (events.Length > 0)
+                        {
+                            _commands.ProcessEvents(events);
+                        }
+                        _commands.ProcessReplacing(inputs, outputs);
+
+                        blockNanoseconds[block] = ToNanoseconds(Stopwatch.GetTimestamp() - start);
+                    }
+                }
+            }
+            else
+            {
+                using (var inputMgr = new VstAudioBufferManager(_channelCount, blockSize))
+                using (var outputMgr = new VstAudioBufferManager(_channelCount, blockSize))
+                {
+                    var inputs = inputMgr.Buffers.ToArray();
+                    var outputs = outputMgr.Buffers.ToArray();
+
+                    for (int block = 0; block < blockNanoseconds.Length; block++)
+                    {
+                        var start = Stopwatch.GetTimestamp();
+
+                        if (events.Length > 0)
+                        {
+                            _commands.ProcessEvents(events);
+                        }
+                        _commands.ProcessReplacing(inputs, outputs);
+
+                        blockNanoseconds[block] = ToNanoseconds(Stopwatch.GetTimestamp() - start);
+                    }
+                }
+            }
+        }
+
+        public void Dispose()
+        {
+            Suspend();
+            _pluginCtx.Dispose();
+        }
+
+        private void Suspend()
+        {
+            if (_isResumed)
+            {
+                _commands.StopProcess();
+                _commands.MainsChanged(false);
+                _isResumed = false;
+            }
+        }
+
+        private static double ToNanoseconds(long ticks)
+        {
+            return ticks * (1e9 / Stopwatch.Frequency);
+        }
+
+        private static VstSpeakerArrangement CreateArrangement(int channelCount)
+        {
+            var arrangement = new VstSpeakerArrangement
+            {
+                Type = channelCount == 1 ? VstSpeakerArrangementType.SpeakerArrMono
+                    : (channelCount == 2 ? VstSpeakerArrangementType.SpeakerArrStereo : VstSpeakerArrangementType.SpeakerArrUserDefined),
+                Speakers = new VstSpeakerProperties[channelCount],
+            };
+
+            for (int i = 0; i < channelCount; i++)
+            {
+                arrangement.Speakers[i] = new VstSpeakerProperties();
+            }
+
+            return arrangement;
+        }
+
+        // note on/off pairs spread evenly over the block, like the native host.
+        private static VstEvent[] CreateEvents(int eventCount, int blockSize)
+        {
+            var events = new VstEvent[eventCount];
+
+            for (int i = 0; i < eventCount; i++)
+            {
+                var data = new byte[] { (byte)((i & 1) == 0 ? 0x90 : 0x80), (byte)(60 + (i / 2) % 24), 100, 0 };
+                events[i] = new VstMidiEvent((int)((long)i * blockSize / eventCount), 0, 0, data, 0, 0);
+            }
+
+            return events;
+        }
+    }
+}
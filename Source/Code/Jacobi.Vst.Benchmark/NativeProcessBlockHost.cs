@@ -0,0 +1,37 @@
+﻿using Jacobi.Vst.Benchmark.Interop;
+
+namespace Jacobi.Vst.Benchmark
+{
+    /// <summary>
+    /// Native host → Plugin.Interop (PluginCommandProxy) → managed plugin.
+    /// </summary>
+    /// <remarks>The blocks are called and timed in native code by <see cref="NativeHost"/>.</remarks>
+    internal sealed class NativeProcessBlockHost : IProcessBlockHost
+    {
+        private readonly NativeHost _host;
+
+        public NativeProcessBlockHost(string pluginPath)
+        {
+            _host = new NativeHost(pluginPath);
+        }
+
+        public const string HostName = "ProcessBlock.NativeHost";
+
+        public string Name => HostName;
+
+        public bool Configure(int channelCount, int maxBlockSize, float sampleRate)
+        {
+            return _host.Configure(channelCount, maxBlockSize, sampleRate);
+        }
+
+        public void Run(int blockSize, int eventCount, bool doublePrecision, double[] blockNanoseconds)
+        {
+            _host.Run(blockSize, eventCount, doublePrecision, blockNanoseconds);
+        }
+
+        public void Dispose()
+        {
+            _host.Dispose();
+        }
+    }
+}
@@ -0,0 +1,28 @@
+﻿namespace Jacobi.Vst.Benchmark
+{
+    /// <summary>
+    /// The distribution of the block durations of one process block measurement.
+    /// </summary>
+    internal sealed class ProcessBlockResult
+    {
+        public string Name { get; set; }
+
+        public int BlockSize { get; set; }
+        public int Channels { get; set; }
+        public int Events { get; set; }
+        /// <summary>32 or 64 (bits per sample).</summary>
+        public int Precision { get; set; }
+
+        /// <summary>The number of timed blocks.</summary>
+        public int Blocks { get; set; }
+
+        public double MinNanoseconds { get; set; }
+        public double MeanNanoseconds { get; set; }
+        public double P50Nanoseconds { get; set; }
+        public double P99Nanoseconds { get; set; }
+        public double P999Nanoseconds { get; set; }
+        public double MaxNanoseconds { get; set; }
+
+        public string DisplayName => $"{Name}(block={BlockSize}, channels={Channels}, events={Events}, precision={Precision})";
+    }
+}
@@ -0,0 +1,87 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace Jacobi.Vst.Benchmark
+{
+    /// <summary>
+    /// Measures the per block overhead of an <see cref="IProcessBlockHost"/> with a plugin that does no processing.
+    /// </summary>
+    /// <remarks>Sweeps block sizes, channel counts, event densities and sample precision.
+    /// Each measurement times <see cref="BlockCount"/> consecutive blocks after <see cref="WarmupCount"/> blocks
+    /// and reports the percentiles of the block durations (jitter).</remarks>
+    internal sealed class ProcessBlockRunner
+    {
+        public static readonly int[] BlockSizes = { 32, 128, 512, 2048, 8192 };
+        public static readonly int[] ChannelCounts = { 1, 2, 8, 16, 64 };
+        public static readonly int[] EventCounts = { 0, 1, 16, 256 };
+
+        private const float SampleRate = 44100.0f;
+
+        public int BlockCount { get; set; } = 10000;
+        public int WarmupCount { get; set; } = 100;
+
+        public IEnumerable<ProcessBlockResult> Run(IProcessBlockHost host)
+        {
+            var maxBlockSize = BlockSizes.Max();
+            var warmup = new double[WarmupCount];
+            var blockNanoseconds = new double[BlockCount];
+
+            foreach (var channelCount in ChannelCounts)
+            {
+                if (!host.Configure(channelCount, maxBlockSize, SampleRate))
+                {
+                    throw new InvalidOperationException($"{host.Name}: the plugin did not accept {channelCount} channels.");
+                }
+
+                foreach (var precision in new[] { 32, 64 })
+                {
+                    foreach (var blockSize in BlockSizes)
+                    {
+                        foreach (var eventCount in EventCounts)
+                        {
+                            host.Run(blockSize, eventCount, precision == 64, warmup);
+
+                            GC.Collect();
+                            GC.WaitForPendingFinalizers();
+                            GC.Collect();
+
+                            host.Run(blockSize, eventCount, precision == 64, blockNanoseconds);
+
+                            yield return CreateResult(host.Name, blockSize, channelCount, eventCount, precision, blockNanoseconds);
+                        }
+                    }
+                }
+            }
+        }
+
+        private static ProcessBlockResult CreateResult(string name, int blockSize, int channelCount, int eventCount, int precision, double[] blockNanoseconds)
+        {
+            var sorted = (double[])blockNanoseconds.Clone();
+            Array.Sort(sorted);
+
+            return new ProcessBlockResult
+            {
+                Name = name,
+                BlockSize = blockSize,
+                Channels = channelCount,
+                Events = eventCount,
+                Precision = precision,
+                Blocks = sorted.Length,
+                MinNanoseconds = sorted[0],
+                MeanNanoseconds = sorted.Average(),
+                P50Nanoseconds = Percentile(sorted, 0.5),
+                P99Nanoseconds = Percentile(sorted, 0.99),
+                P999Nanoseconds = Percentile(sorted, 0.999),
+                MaxNanoseconds = sorted[sorted.Length - 1],
+            };
+        }
+
+        // nearest rank on sorted values.
+        private static double Percentile(double[] sorted, double percentile)
+        {
+            var rank = (int)Math.Ceiling(percentile * sorted.Length) - 1;
+            return sorted[Math.Clamp(rank, 0, sorted.Length - 1)];
+        }
+    }
+}
@@ -0,0 +1,119 @@
+﻿using Jacobi.Vst.Benchmark.Interop;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+
+namespace Jacobi.Vst.Benchmark
+{
+    public static class Program
+    {
+        // the Plugin.Interop assembly renamed to the managed plugin (see the project file).
+        private const string ManagedPluginFileName = "Jacobi.Vst.Benchmark.Plugin.dll";
+
+        public static int Main(string[] args)
+        {
+            string filter = null;
+            string outputPath = null;
+            var runner = new BenchmarkRunner();
+            var processBlockRunner = new ProcessBlockRunner();
+
+            for (int i = 0; i < args.Length; i++)
+            {
+                switch (args[i])
+                {
+                    case "--filter" when i + 1 < args.Length:
+                        filter = args[++i];
+                        break;
+                    case "--output" when i + 1 < args.Length:
+                        outputPath = args[++i];
+                        break;
+                    case "--quick":
+                        runner.SampleTime = TimeSpan.FromMilliseconds(2);
+                        runner.SampleCount = 5;
+                        runner.WarmupCount = 1;
+                        processBlockRunner.BlockCount = 1000;
+                        processBlockRunner.WarmupCount = 10;
+                        break;
+                    default:
+                        Usage();
+                        return 1;
+                }
+            }
+
+            var results = RunMarshalingBenchmarks(runner, filter);
+            var processBlockResults = RunProcessBlockBenchmarks(processBlockRunner, filter);
+
+            if (outputPath != null)
+            {
+                using (var stream = File.Create(outputPath))
+                {
+                    JsonResultWriter.Write(stream, results, processBlockResults);
+                }
+
+                Console.WriteLine($"Results written to {outputPath}.");
+            }
+
+            return 0;
+        }
+
+        private static List<BenchmarkResult> RunMarshalingBenchmarks(BenchmarkRunner runner, string filter)
+        {
+            var benchmarks = MarshalingBenchmarks.Create()
+                .Where(b => IsMatch(b.Name, filter))
+                .ToList();
+
+            var results = new List<BenchmarkResult>();
+
+            foreach (var benchmark in benchmarks)
+            {
+                var result = runner.Run(benchmark);
+                results.Add(result);
+
+                Console.WriteLine($"{result.DisplayName,-64} {result.MedianNanoseconds,12:F1} ns {result.StdDevNanoseconds,10:F1} sd {result.AllocatedBytes,10:F1} B");
+            }
+
+            return results;
+        }
+
+        private static List<ProcessBlockResult> RunProcessBlockBenchmarks(ProcessBlockRunner runner, string filter)
+        {
+            // hosts are only created (and their plugin loaded) when they pass the filter.
+            var hostFactories = new (string Name, Func<IProcessBlockHost> Create)[]
+            {
+                (NativeProcessBlockHost.HostName, () => new NativeProcessBlockHost(Path.Combine(AppContext.BaseDirectory, "plugin", ManagedPluginFileName))),
+                (ManagedProcessBlockHost.HostName, () => new ManagedProcessBlockHost(NativeHost.NoOpPluginPath)),
+            };
+
+            var results = new List<ProcessBlockResult>();
+
+            foreach (var factory in hostFactories.Where(f => IsMatch(f.Name, filter)))
+            {
+                using (var host = factory.Create())
+                {
+                    foreach (var result in runner.Run(host))
+                    {
+                        results.Add(result);
+
+                        Console.WriteLine($"{result.DisplayName,-90} p50 {result.P50Nanoseconds,10:F0} ns p99 {result.P99Nanoseconds,10:F0} ns p999 {result.P999Nanoseconds,10:F0} ns");
+                    }
+                }
+            }
+
+            return results;
+        }
+
+        private static bool IsMatch(string name, string filter)
+        {
+            return filter == null || name.Contains(filter, StringComparison.OrdinalIgnoreCase);
+        }
+
+        private static void Usage()
+        {
+            Console.WriteLine("Jacobi.Vst.Benchmark [--filter <text>] [--output <file.json>] [--quick]");
+            Console.WriteLine("\t--filter - only runs the benchmarks with <text> in their name.");
+            Console.WriteLine("\t--output - writes the results as json to <file.json>.");
+            Console.WriteLine("\t--quick - shorter samples and fewer blocks for a smoke run.");
+        }
+    }
+}
@@ -13,6 +13,13 @@ namespace Jacobi.Vst.CLI
                     new ArgumentInfo { Property = nameof(PublishCommand.FilePath), Description="The file to publish." },
                     new ArgumentInfo { Property = nameof(PublishCommand.DeployPath), Name = "-o", Description="The output directory that will receive all the files." },
                 }
+            },
+            new CommandInfo { Type = typeof(StatsCommand), Name = "stats", Description="Displays the live statistics of running VST.NET plugins and hosts.",
+                Arguments = new[] {
+                    new ArgumentInfo { Property = nameof(StatsCommand.ProcessId), Description="The id of the process to display (default: all processes)." },
+                    new ArgumentInfo { Property = nameof(StatsCommand.Interval), Name = "-i", Description="The number of seconds between refreshes (default: 1)." },
+                    new ArgumentInfo { Property = nameof(StatsCommand.Count), Name = "-n", Description="The number of refreshes (default: until a key is pressed)." },
+                }
             }
         };
 
@@ -107,9 +114,12 @@ namespace Jacobi.Vst.CLI
                 else
                     throw new InvalidOperationException(
                         $"'{tokens.Current} did not match any argument for the {cmdInfo.Name} command.");
+
+                if (!tokens.MoveNext()) return;
             }
 
-            while (tokens.MoveNext())
+            // the current token is the first named argument
+            do
             {
                 if (!tokens.IsArgument)
                     break;
@@ -133,7 +143,7 @@ namespace Jacobi.Vst.CLI
                     throw new InvalidOperationException(
                         $"The {cmdInfo.Name} command does not have an argument '{tokens.Current}'");
                 }
-            }
+            } while (tokens.MoveNext());
         }
 
         private static void SetProperty(object instance, string property, string value)
@@ -0,0 +1,182 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace Jacobi.Vst.CLI
+{
+    /// <summary>
+    /// Reads the live statistics segment a process with VST.NET interop publishes.
+    /// </summary>
+    /// <remarks>The layout must match LiveStatistics.h in Jacobi.Vst.Interop (version 1).</remarks>
+    internal sealed class LiveStatisticsReader : IDisposable
+    {
+        private const uint Magic = 'V' | 'N' << 8 | 'L' << 16 | 'S' << 24;
+        private const uint Version = 1;
+        private const int HeaderSize = 64;
+        private const int SlotSize = 1280;
+        private const int NameLength = 64;
+        private const int OpcodeCount = 128;
+
+        private readonly MemoryMappedFile _file;
+        private readonly MemoryMappedViewAccessor _view;
+        private readonly int _slotCount;
+
+        private LiveStatisticsReader(MemoryMappedFile file, MemoryMappedViewAccessor view, int slotCount)
+        {
+            _file = file;
+            _view = view;
+            _slotCount = slotCount;
+        }
+
+        public void Dispose()
+        {
+            _view.Dispose();
+            _file.Dispose();
+        }
+
+        /// <summary>
+        /// Opens the segment of the process with <paramref name="processId"/>.
+        /// </summary>
+        /// <returns>Returns null when the process does not publish live statistics (of this version).</returns>
+        public static LiveStatisticsReader Open(int processId)
+        {
+            MemoryMappedFile file;
+
+            try
+            {
+                if (RuntimeInformation.IsOSPlatform(OSPlatform.Windows))
+                {
+                    file = MemoryMappedFile.OpenExisting($@"Local\Jacobi.Vst.LiveStatistics.{processId}", MemoryMappedFileRights.Read);
+                }
+                else
+                {
+                    file = MemoryMappedFile.CreateFromFile($"/dev/shm/Jacobi.Vst.LiveStatistics.{processId}",
+                        FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+                }
+            }
+            catch (IOException)
+            {
+                return null;
+            }
+            catch (UnauthorizedAccessException)
+            {
+                return null;
+            }
+
+            try
+            {
+                var view = file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+
+                if (view.Capacity >= HeaderSize &&
+                    view.ReadUInt32(0) == Magic && view.ReadUInt32(4) == Version &&
+                    view.ReadUInt32(12) == SlotSize)
+                {
+                    int slotCount = view.ReadInt32(16);
+                    if (view.Capacity >= HeaderSize + (long)slotCount * SlotSize)
+                    {
+                        return new LiveStatisticsReader(file, view, slotCount);
+                    }
+                }
+
+                view.Dispose();
+            }
+            catch (IOException)
+            { }
+
+            file.Dispose();
+            return null;
+        }
+
+        /// <summary>
+        /// Returns a snapshot of the slots that are in use.
+        /// </summary>
+        public IReadOnlyList<LiveStatisticsSlot> ReadSlots()
+        {
+            var slots = new List<LiveStatisticsSlot>();
+
+            for (int i = 0; i < _slotCount; i++)
+            {
+                long offset = HeaderSize + (long)i * SlotSize;
+
+                var kind = (LiveStatisticsKind)_view.ReadUInt32(offset);
+                if (kind == LiveStatisticsKind.None)
+                {
+                    continue;
+                }
+
+                var name = new byte[NameLength];
+                _view.ReadArray(offset + 16, name, 0, NameLength);
+                int nameLength = Array.IndexOf(name, (byte)0);
+
+                var dispatchCounts = new long[OpcodeCount];
+                _view.ReadArray(offset + 256, dispatchCounts, 0, OpcodeCount);
+
+                slots.Add(new LiveStatisticsSlot
+                {
+                    Index = i,
+                    Kind = kind,
+                    Sequence = _view.ReadUInt32(offset + 4),
+                    PluginId = _view.ReadInt32(offset + 8),
+                    PluginVersion = _view.ReadInt32(offset + 12),
+                    Name = Encoding.Default.GetString(name, 0, nameLength < 0 ? NameLength : nameLength),
+                    ProcessCount = _view.ReadInt64(offset + 80),
+                    ProcessFrames = _view.ReadInt64(offset + 88),
+                    DispatchCount = _view.ReadInt64(offset + 96),
+                    ParameterCount = _view.ReadInt64(offset + 104),
+                    EventCount = _view.ReadInt64(offset + 112),
+                    EventBlockCount = _view.ReadInt64(offset + 120),
+                    LastEventCount = _view.ReadInt32(offset + 128),
+                    MaxEventCount = _view.ReadInt32(offset + 132),
+                    MarshaledBytes = _view.ReadInt64(offset + 136),
+                    AllocationCount = _view.ReadInt64(offset + 144),
+                    AllocatedBytes = _view.ReadInt64(offset + 152),
+                    DeadlineMissCount = _view.ReadInt64(offset + 160),
+                    Load = _view.ReadSingle(offset + 168),
+                    PeakLoad = _view.ReadSingle(offset + 172),
+                    SampleRate = _view.ReadSingle(offset + 176),
+                    BlockSize = _view.ReadInt32(offset + 180),
+                    DispatchCounts = dispatchCounts,
+                });
+            }
+
+            return slots;
+        }
+    }
+
+    internal enum LiveStatisticsKind
+    {
+        None,
+        Host,
+        Plugin,
+    }
+
+    internal sealed class LiveStatisticsSlot
+    {
+        public int Index { get; set; }
+        public LiveStatisticsKind Kind { get; set; }
+        public uint Sequence { get; set; }
+        public int PluginId { get; set; }
+        public int PluginVersion { get; set; }
+        public string Name { get; set; }
+        public long ProcessCount { get; set; }
+        public long ProcessFrames { get; set; }
+        public long DispatchCount { get; set; }
+        public long ParameterCount { get; set; }
+        public long EventCount { get; set; }
+        public long EventBlockCount { get; set; }
+        public int LastEventCount { get; set; }
+        public int MaxEventCount { get; set; }
+        public long MarshaledBytes { get; set; }
+        public long AllocationCount { get; set; }
+        public long AllocatedBytes { get; set; }
+        public long DeadlineMissCount { get; set; }
+        public float Load { get; set; }
+        public float PeakLoad { get; set; }
+        public float SampleRate { get; set; }
+        public int BlockSize { get; set; }
+        public long[] DispatchCounts { get; set; }
+    }
+}
@@ -0,0 +1,148 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Threading;
+
+namespace Jacobi.Vst.CLI
+{
+    internal sealed class StatsCommand : ICommand
+    {
+        public bool Execute()
+        {
+            if (Interval <= 0)
+            {
+                Interval = 1;
+            }
+
+            var previous = new Dictionary<(int, int, uint), LiveStatisticsSlot>();
+            var stopwatch = Stopwatch.StartNew();
+            int refresh = 0;
+
+            while (true)
+            {
+                var elapsed = stopwatch.Elapsed.TotalSeconds;
+                stopwatch.Restart();
+
+                var current = ReadProcesses();
+                if (current.Count == 0)
+                {
+                    ConsoleOutput.Warning(ProcessId > 0
+                        ? $"Process {ProcessId} does not publish VST.NET live statistics."
+                        : "No process publishes VST.NET live statistics.");
+                    return false;
+                }
+
+                Display(current, previous, elapsed);
+
+                previous = current.SelectMany(p => p.Value.Select(s => (p.Key, Slot: s)))
+                    .ToDictionary(e => (e.Key, e.Slot.Index, e.Slot.Sequence), e => e.Slot);
+
+                if (Count > 0 && ++refresh >= Count)
+                {
+                    return true;
+                }
+
+                if (WaitForKey())
+                {
+                    return true;
+                }
+            }
+        }
+
+        /// <summary>The id of the process to show. All processes when 0.</summary>
+        public int ProcessId { get; set; }
+        /// <summary>The seconds between refreshes.</summary>
+        public int Interval { get; set; }
+        /// <summary>The number of refreshes. Until a key is pressed when 0.</summary>
+        public int Count { get; set; }
+
+        private Dictionary<int, IReadOnlyList<LiveStatisticsSlot>> ReadProcesses()
+        {
+            var result = new Dictionary<int, IReadOnlyList<LiveStatisticsSlot>>();
+            var processIds = ProcessId > 0
+                ? new[] { ProcessId }
+                : Process.GetProcesses().Select(p => p.Id).ToArray();
+
+            foreach (var processId in processIds)
+            {
+                using var reader = LiveStatisticsReader.Open(processId);
+                if (reader != null)
+                {
+                    result.Add(processId, reader.ReadSlots());
+                }
+            }
+
+            return result;
+        }
+
+        private static void Display(Dictionary<int, IReadOnlyList<LiveStatisticsSlot>> current,
+            Dictionary<(int, int, uint), LiveStatisticsSlot> previous, double elapsed)
+        {
+            ConsoleOutput.NewLine();
+            ConsoleOutput.Help($"{"Process",-8} {"Side",-6} {"Name",-24} {"Proc/s",8} {"Disp/s",8} {"Par/s",8} {"Evt/s",8} " +
+                $"{"MaxEvt",6} {"KB/s",8} {"Allocs",8} {"Load",6} {"Peak",6} {"Misses",8}  Top opcodes");
+
+            foreach (var process in current.OrderBy(p => p.Key))
+            {
+                foreach (var slot in process.Value)
+                {
+                    previous.TryGetValue((process.Key, slot.Index, slot.Sequence), out var last);
+
+                    double Rate(Func<LiveStatisticsSlot, long> counter) =>
+                        last == null || elapsed <= 0 ? 0 : (counter(slot) - counter(last)) / elapsed;
+
+                    var line = $"{process.Key,-8} {slot.Kind,-6} {Truncate(slot.Name, 24),-24} " +
+                        $"{Rate(s => s.ProcessCount),8:0} {Rate(s => s.DispatchCount),8:0} {Rate(s => s.ParameterCount),8:0} " +
+                        $"{Rate(s => s.EventCount),8:0} {slot.MaxEventCount,6} {Rate(s => s.MarshaledBytes) / 1024,8:0.0} " +
+                        $"{slot.AllocationCount,8} {slot.Load,6:0.00} {slot.PeakLoad,6:0.00} {slot.DeadlineMissCount,8}  " +
+                        TopOpcodes(slot, last);
+
+                    if (slot.Load > 1.0f)
+                    {
+                        ConsoleOutput.Warning(line);
+                    }
+                    else
+                    {
+                        ConsoleOutput.Information(line);
+                    }
+                }
+            }
+        }
+
+        // the opcodes dispatched most since the last refresh (since the start for a new instance).
+        private static string TopOpcodes(LiveStatisticsSlot slot, LiveStatisticsSlot last)
+        {
+            return String.Join(" ", slot.DispatchCounts
+                .Select((count, opcode) => (Opcode: opcode, Count: count - (last?.DispatchCounts[opcode] ?? 0)))
+                .Where(e => e.Count > 0)
+                .OrderByDescending(e => e.Count)
+                .Take(3)
+                .Select(e => $"{e.Opcode}:{e.Count}"));
+        }
+
+        private static string Truncate(string text, int length)
+        {
+            return text.Length <= length ? text : text.Substring(0, length);
+        }
+
+        // returns true when a key was pressed during the interval.
+        private bool WaitForKey()
+        {
+            var until = DateTime.UtcNow.AddSeconds(Interval);
+
+            while (DateTime.UtcNow < until)
+            {
+                if (!Console.IsInputRedirected && Console.KeyAvailable)
+                {
+                    Console.ReadKey(intercept: true);
+                    return true;
+                }
+
+                Thread.Sleep(50);
+            }
+
+            return false;
+        }
+    }
+}
@@ -442,4 +442,22 @@
         /// <returns>Returns the number of Midi Out channels, or 0 (zero) if not supported.</returns>
         int GetNumberOfMidiOutputChannels();
     }
+
+    /// <summary>
+    /// The optional Plugin commands for variable input/output processing (offline).
+    /// </summary>
+    /// <remarks>Implemented by plugins that can consume a different number of samples than they produce,
+    /// for instance for resampling or time-stretching.</remarks>
+    public interface IVstPluginCommandsVariableIo
+    {
+        /// <summary>
+        /// Called by the host to process a variable number of input samples into a variable number of output samples.
+        /// </summary>
+        /// <param name="inputs">An array with audio input buffers. The sample count of the buffers is the number of input samples available.</param>
+        /// <param name="outputs">An array with audio output buffers. The sample count of the buffers is the number of output samples requested.</param>
+        /// <param name="inputSamplesProcessed">Receives the number of input samples the plugin consumed.</param>
+        /// <param name="outputSamplesProcessed">Receives the number of output samples the plugin produced.</param>
+        /// <returns>Returns true if the call was successful.</returns>
+        bool ProcessVariableIo(VstAudioBuffer[] inputs, VstAudioBuffer[] outputs, out int inputSamplesProcessed, out int outputSamplesProcessed);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,111 @@
+﻿namespace Jacobi.Vst.Core.Plugin
+{
+    using Microsoft.Extensions.Configuration;
+    using System;
+    using System.Collections.Concurrent;
+    using System.Collections.Generic;
+    using System.IO;
+    using System.Linq;
+
+    /// <summary>
+    /// Creates managed plugin command stubs, loading the plugin assembly and its configuration once per interop path.
+    /// </summary>
+    /// <remarks>
+    /// The first instance of a plugin locates the command stub type (see <see cref="ManagedPluginFactory"/>)
+    /// and reads the settings from the optional <b>&lt;name&gt;.appsettings.json</b> next to the interop assembly.
+    /// Additional instances only construct a new command stub, without assembly probing, reflection or file I/O.
+    /// Each command stub gets its own <see cref="IConfiguration"/> built from the cached settings,
+    /// so a value one instance changes through the indexer is not seen by the other instances.
+    /// Changes to the settings file are not picked up until the process restarts.
+    /// </remarks>
+    public class ManagedPluginCache
+    {
+        private readonly ConcurrentDictionary<string, Entry> _entries =
+            new ConcurrentDictionary<string, Entry>(StringComparer.OrdinalIgnoreCase);
+
+        /// <summary>
+        /// Gets the instance used by the plugin interop.
+        /// </summary>
+        public static ManagedPluginCache Current { get; } = new ManagedPluginCache();
+
+        /// <summary>
+        /// Creates a new command stub for the plugin with its own configuration.
+        /// </summary>
+        /// <param name="interopAssemblyPath">The full file path to the interop assembly. Must not be null or empty.</param>
+        /// <returns>Never returns null.</returns>
+        /// <exception cref="FileNotFoundException">Thrown when no suitable managed Plugin assembly could be found.</exception>
+        /// <exception cref="InvalidOperationException">Thrown when no public class could be found
+        /// that implemented the <see cref="IVstPluginCommandStub"/> interface.</exception>
+        public IVstPluginCommandStub CreatePluginCommandStub(string interopAssemblyPath)
+        {
+            Throw.IfArgumentIsNullOrEmpty(interopAssemblyPath, nameof(interopAssemblyPath));
+
+            if (!_entries.TryGetValue(interopAssemblyPath, out Entry? entry))
+            {
+                entry = LoadEntry(interopAssemblyPath);
+
+                // another thread may have loaded the same plugin, keep the first.
+                entry = _entries.GetOrAdd(interopAssemblyPath, entry);
+            }
+
+            var commandStub = entry.CreateCommandStub();
+            commandStub.PluginConfiguration = new ConfigurationBuilder()
+                .AddInMemoryCollection(entry.Settings)
+                .Build();
+
+            return commandStub;
+        }
+
+        /// <summary>
+        /// Gets the number of plugins (interop paths) that have been loaded.
+        /// </summary>
+        public int Count
+        {
+            get { return _entries.Count; }
+        }
+
+        /// <summary>
+        /// Loads the managed plugin assembly that belongs to the <paramref name="interopAssemblyPath"/>.
+        /// </summary>
+        /// <param name="interopAssemblyPath">The full file path to the interop assembly.</param>
+        /// <returns>Returns a delegate that constructs new instances of the Plugin command stub.</returns>
+        /// <remarks>Called once per interop path.</remarks>
+        protected virtual Func<IVstPluginCommandStub> LoadCommandStubFactory(string interopAssemblyPath)
+        {
+            var factory = new ManagedPluginFactory();
+            factory.LoadAssemblyByDefaultName(interopAssemblyPath);
+
+            return factory.CreatePluginCommandStubFactory();
+        }
+
+        private Entry LoadEntry(string interopAssemblyPath)
+        {
+            var createCommandStub = LoadCommandStubFactory(interopAssemblyPath);
+
+            var basePath = Path.GetDirectoryName(interopAssemblyPath) ?? String.Empty;
+            var name = Path.GetFileNameWithoutExtension(interopAssemblyPath);
+
+            var configuration = new ConfigurationBuilder()
+                .SetBasePath(basePath)
+                .AddJsonFile(name + ".appsettings.json", optional: true)
+                .Build();
+
+            return new Entry(createCommandStub, configuration.AsEnumerable().ToArray());
+        }
+
+        // the loaded plugin assembly and settings of one interop path.
+        private sealed class Entry
+        {
+            public Entry(Func<IVstPluginCommandStub> createCommandStub, IEnumerable<KeyValuePair<string, string>> settings)
+            {
+                CreateCommandStub = createCommandStub;
+                Settings = settings;
+            }
+
+            public Func<IVstPluginCommandStub> CreateCommandStub { get; }
+
+            // flattened (section:key) values, read-only once cached.
+            public IEnumerable<KeyValuePair<string, string>> Settings { get; }
+        }
+    }
+}
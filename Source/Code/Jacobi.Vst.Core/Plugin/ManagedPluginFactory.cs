@@ -2,6 +2,7 @@
 {
     using System;
     using System.IO;
+    using System.Linq.Expressions;
     using System.Reflection;
 
     /// <summary>
@@ -59,21 +60,56 @@
         /// <exception cref="InvalidOperationException">Thrown when no public class could be found 
         /// that implemented the <see cref="IVstPluginCommandStub"/> interface.</exception>
         public IVstPluginCommandStub CreatePluginCommandStub()
+        {
+            Type pluginType = GetPluginCommandStubType();
+
+            var cmdStub = (IVstPluginCommandStub?)Activator.CreateInstance(pluginType)
+                ?? throw new InvalidOperationException(
+                    String.Format(Properties.Resources.ManagedPluginFactory_CreationFailed, pluginType));
+
+            return cmdStub;
+        }
+
+        /// <summary>
+        /// Locates the public Plugin command stub type in the loaded assembly.
+        /// </summary>
+        /// <returns>Returns the type that implements the <see cref="IVstPluginCommandStub"/> interface.</returns>
+        /// <exception cref="InvalidOperationException">Thrown when no public class could be found
+        /// that implemented the <see cref="IVstPluginCommandStub"/> interface.</exception>
+        public Type GetPluginCommandStubType()
         {
             if (_assembly == null)
             {
                 throw new InvalidOperationException(Properties.Resources.ManagedPluginFactory_NoAssemblyLoaded);
             }
 
-            Type pluginType = LocateTypeByInterface(typeof(IVstPluginCommandStub))
+            return LocateTypeByInterface(typeof(IVstPluginCommandStub))
                 ?? throw new InvalidOperationException(
                     String.Format(Properties.Resources.ManagedPluginFactory_NoPublicStub, _assembly.FullName));
+        }
 
-            var cmdStub = (IVstPluginCommandStub?)Activator.CreateInstance(pluginType)
-                ?? throw new InvalidOperationException(
+        /// <summary>
+        /// Creates a delegate that constructs new instances of the Plugin command stub.
+        /// </summary>
+        /// <returns>Never returns null.</returns>
+        /// <remarks>The type is located and the constructor is compiled once,
+        /// so the delegate can be cached to create additional instances without reflection.</remarks>
+        /// <exception cref="InvalidOperationException">Thrown when no public class could be found
+        /// that implemented the <see cref="IVstPluginCommandStub"/> interface.</exception>
+        public Func<IVstPluginCommandStub> CreatePluginCommandStubFactory()
+        {
+            Type pluginType = GetPluginCommandStubType();
+
+            if (pluginType.GetConstructor(Type.EmptyTypes) == null)
+            {
+                throw new InvalidOperationException(
                     String.Format(Properties.Resources.ManagedPluginFactory_CreationFailed, pluginType));
+            }
 
-            return cmdStub;
+            var create = Expression.Lambda<Func<IVstPluginCommandStub>>(
+                Expression.Convert(Expression.New(pluginType), typeof(IVstPluginCommandStub)));
+
+            return create.Compile();
         }
 
         private Type? LocateTypeByInterface(Type typeOfInterface)
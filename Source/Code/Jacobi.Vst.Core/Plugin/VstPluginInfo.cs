@@ -45,5 +45,14 @@
         /// The version of the plugin.
         /// </summary>
         public int PluginVersion { get; set; }
+
+        /// <summary>
+        /// The number of samples the plugin processes per call. Zero (default) processes the blocks of the host.
+        /// </summary>
+        /// <remarks>When set, the interop collects the (small) audio blocks of the host into blocks of this size
+        /// and calls the plugin once per block. This adds ProcessBlockSize samples of latency, which is reported
+        /// to the host on top of the <see cref="InitialDelay"/>. The events for a block are passed in one ProcessEvents call
+        /// right before the block is processed. Read once when the plugin is created.</remarks>
+        public int ProcessBlockSize { get; set; }
     }
 }
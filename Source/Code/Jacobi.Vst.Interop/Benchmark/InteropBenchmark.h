@@ -0,0 +1,50 @@
+#pragma once
+
+namespace Jacobi {
+namespace Vst {
+namespace Benchmark {
+namespace Interop {
+
+	/// <summary>
+	/// The InteropBenchmark class is the base class for the measurement of one interop routine at one size.
+	/// </summary>
+	/// <remarks>The runner calls <see cref="Setup"/> once, <see cref="Run"/> repeatedly with a calibrated
+	/// iteration count and <see cref="Cleanup"/> at the end. Only <see cref="Run"/> is timed.</remarks>
+	public ref class InteropBenchmark abstract
+	{
+	public:
+		/// <summary>Gets the name of the routine, for instance 'Events.Midi.ToUnmanaged'.</summary>
+		property System::String^ Name { System::String^ get() { return _name; } }
+
+		/// <summary>Gets the size parameters of the measurement, for instance 'events' or 'channels'.</summary>
+		property System::Collections::Generic::IDictionary<System::String^, System::Int32>^ Parameters
+		{
+			System::Collections::Generic::IDictionary<System::String^, System::Int32>^ get() { return _parameters; }
+		}
+
+		/// <summary>Allocates the input data of the routine.</summary>
+		virtual void Setup() {}
+		/// <summary>Calls the routine <paramref name="iterations"/> times.</summary>
+		virtual void Run(System::Int32 iterations) abstract;
+		/// <summary>Frees the input data.</summary>
+		virtual void Cleanup() {}
+
+	protected:
+		InteropBenchmark(System::String^ name)
+		{
+			_name = name;
+			_parameters = gcnew System::Collections::Generic::SortedDictionary<System::String^, System::Int32>();
+		}
+
+		void AddParameter(System::String^ name, System::Int32 value)
+		{ _parameters->Add(name, value); }
+
+		/// <summary>Keeps results of the routine reachable so the work cannot be optimized away.</summary>
+		System::Object^ Sink;
+
+	private:
+		System::String^ _name;
+		System::Collections::Generic::IDictionary<System::String^, System::Int32>^ _parameters;
+	};
+
+}}}} // Jacobi::Vst::Benchmark::Interop
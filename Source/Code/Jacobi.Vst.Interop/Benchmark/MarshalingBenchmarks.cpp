@@ -0,0 +1,647 @@
+#include "pch.h"
+#include "MarshalingBenchmarks.h"
+#include "../TypeConverter.h"
+#include "../Host/UnmanagedArray.h"
+
+using namespace Jacobi::Vst::Core;
+
+namespace Jacobi {
+namespace Vst {
+namespace Benchmark {
+namespace Interop {
+
+	namespace
+	{
+		const int EventCounts[] = { 1, 4, 16, 64, 256, 1024 };
+		const int ChannelCounts[] = { 1, 2, 8, 16, 64 };
+		const int SampleCounts[] = { 32, 256, 1024, 8192 };
+	}
+
+	//-------------------------------------------------------------------------
+
+	// AllocUnmanagedEvents/DeleteUnmanagedEvents, AllocUnmanagedEvents into a reset arena and ToManagedEventArray.
+	ref class EventsBenchmark sealed : InteropBenchmark
+	{
+	public:
+		enum class Mode { ToUnmanaged, ToUnmanagedArena, ToManaged };
+
+		EventsBenchmark(Mode mode, bool sysEx, int eventCount)
+			: InteropBenchmark(System::String::Format("Events.{0}.{1}", sysEx ? SysExName : MidiName, mode))
+		{
+			_mode = mode;
+			_sysEx = sysEx;
+			_eventCount = eventCount;
+			AddParameter("events", eventCount);
+		}
+
+		virtual void Setup() override
+		{
+			_events = gcnew array<VstEvent^>(_eventCount);
+
+			for(int i = 0; i < _eventCount; i++)
+			{
+				if(_sysEx)
+				{
+					_events[i] = gcnew VstMidiSysExEvent(i, gcnew array<System::Byte>(SysExLength));
+				}
+				else
+				{
+					auto data = gcnew array<System::Byte>(4) { 0x90, (System::Byte)(i & 0x7F), 100, 0 };
+					_events[i] = gcnew VstMidiEvent(i, 0, 0, data, 0, 0);
+				}
+			}
+
+			_pEvents = TypeConverter::AllocUnmanagedEvents(_events);
+			_pArena = new MemoryArena();
+		}
+
+		virtual void Run(System::Int32 iterations) override
+		{
+			switch(_mode)
+			{
+			case Mode::ToUnmanaged:
+				for(int i = 0; i < iterations; i++)
+				{
+					TypeConverter::DeleteUnmanagedEvents(TypeConverter::AllocUnmanagedEvents(_events));
+				}
+				break;
+			case Mode::ToUnmanagedArena:
+				for(int i = 0; i < iterations; i++)
+				{
+					// as VstPluginCommandsImpl::ProcessEvents does.
+					_pArena->Reset();
+					TypeConverter::AllocUnmanagedEvents(_events, _pArena);
+				}
+				break;
+			case Mode::ToManaged:
+				for(int i = 0; i < iterations; i++)
+				{
+					Sink = TypeConverter::ToManagedEventArray(_pEvents);
+				}
+				break;
+			}
+		}
+
+		virtual void Cleanup() override
+		{
+			TypeConverter::DeleteUnmanagedEvents(_pEvents);
+			_pEvents = NULL;
+			delete _pArena;
+			_pArena = NULL;
+			_events = nullptr;
+		}
+
+	private:
+		static const int SysExLength = 256;
+		static initonly System::String^ MidiName = "Midi";
+		static initonly System::String^ SysExName = "SysEx";
+
+		Mode _mode;
+		bool _sysEx;
+		int _eventCount;
+		array<VstEvent^>^ _events;
+		::Vst2Events* _pEvents;
+		::MemoryArena* _pArena;
+	};
+
+	//-------------------------------------------------------------------------
+
+	// ToManagedAudioBufferArray for single and double precision.
+	ref class AudioBufferArrayBenchmark sealed : InteropBenchmark
+	{
+	public:
+		AudioBufferArrayBenchmark(bool precision, int channelCount, int sampleCount)
+			: InteropBenchmark(System::String::Format("AudioBuffers.ToManaged{0}", precision ? 64 : 32))
+		{
+			_precision = precision;
+			_channelCount = channelCount;
+			_sampleCount = sampleCount;
+			AddParameter("channels", channelCount);
+			AddParameter("samples", sampleCount);
+		}
+
+		virtual void Setup() override
+		{
+			size_t sampleSize = _precision ? sizeof(double) : sizeof(float);
+			_pSamples = new char[_channelCount * _sampleCount * sampleSize];
+			_ppChannels = new void*[_channelCount];
+
+			for(int i = 0; i < _channelCount; i++)
+			{
+				_ppChannels[i] = _pSamples + (i * _sampleCount * sampleSize);
+			}
+		}
+
+		virtual void Run(System::Int32 iterations) override
+		{
+			for(int i = 0; i < iterations; i++)
+			{
+				if(_precision)
+				{
+					Sink = TypeConverter::ToManagedAudioBufferArray((double**)_ppChannels, _sampleCount, _channelCount, true);
+				}
+				else
+				{
+					Sink = TypeConverter::ToManagedAudioBufferArray((float**)_ppChannels, _sampleCount, _channelCount, true);
+				}
+			}
+		}
+
+		virtual void Cleanup() override
+		{
+			delete[] _ppChannels;
+			delete[] _pSamples;
+		}
+
+	private:
+		bool _precision;
+		int _channelCount;
+		int _sampleCount;
+		char* _pSamples;
+		void** _ppChannels;
+	};
+
+	//-------------------------------------------------------------------------
+
+	// VstAudioBufferManager and VstAudioPrecisionBufferManager.
+	ref class BufferManagerBenchmark sealed : InteropBenchmark
+	{
+	public:
+		enum class Mode { Create, ClearAll };
+
+		BufferManagerBenchmark(Mode mode, bool precision, int channelCount, int sampleCount)
+			: InteropBenchmark(System::String::Format("BufferManager{0}.{1}", precision ? 64 : 32, mode))
+		{
+			_mode = mode;
+			_precision = precision;
+			_channelCount = channelCount;
+			_sampleCount = sampleCount;
+			AddParameter("channels", channelCount);
+			AddParameter("samples", sampleCount);
+		}
+
+		virtual void Setup() override
+		{
+			if(_precision)
+			{
+				_precisionManager = gcnew Jacobi::Vst::Host::Interop::VstAudioPrecisionBufferManager(_channelCount, _sampleCount);
+			}
+			else
+			{
+				_manager = gcnew Jacobi::Vst::Host::Interop::VstAudioBufferManager(_channelCount, _sampleCount);
+			}
+		}
+
+		virtual void Run(System::Int32 iterations) override
+		{
+			switch(_mode)
+			{
+			case Mode::Create:
+				for(int i = 0; i < iterations; i++)
+				{
+					if(_precision)
+					{
+						delete gcnew Jacobi::Vst::Host::Interop::VstAudioPrecisionBufferManager(_channelCount, _sampleCount);
+					}
+					else
+					{
+						delete gcnew Jacobi::Vst::Host::Interop::VstAudioBufferManager(_channelCount, _sampleCount);
+					}
+				}
+				break;
+			case Mode::ClearAll:
+				for(int i = 0; i < iterations; i++)
+				{
+					if(_precision)
+					{
+						_precisionManager->ClearAllBuffers();
+					}
+					else
+					{
+						_manager->ClearAllBuffers();
+					}
+				}
+				break;
+			}
+		}
+
+		virtual void Cleanup() override
+		{
+			delete _manager;
+			delete _precisionManager;
+		}
+
+	private:
+		Mode _mode;
+		bool _precision;
+		int _channelCount;
+		int _sampleCount;
+		Jacobi::Vst::Host::Interop::VstAudioBufferManager^ _manager;
+		Jacobi::Vst::Host::Interop::VstAudioPrecisionBufferManager^ _precisionManager;
+	};
+
+	//-------------------------------------------------------------------------
+
+	// UnmanagedArray: reuse at the same length and growth from empty in doubling steps.
+	ref class UnmanagedArrayBenchmark sealed : InteropBenchmark
+	{
+	public:
+		enum class Mode { Reuse, Grow };
+
+		UnmanagedArrayBenchmark(Mode mode, int length)
+			: InteropBenchmark(System::String::Format("UnmanagedArray.{0}", mode))
+		{
+			_mode = mode;
+			_length = length;
+			AddParameter("samples", length);
+		}
+
+		virtual void Run(System::Int32 iterations) override
+		{
+			switch(_mode)
+			{
+			case Mode::Reuse:
+				for(int i = 0; i < iterations; i++)
+				{
+					_array.GetArray(_length);
+				}
+				break;
+			case Mode::Grow:
+				for(int i = 0; i < iterations; i++)
+				{
+					UnmanagedArray<float> growing;
+
+					// a host that raises its block size from 32 samples in steps.
+					for(int length = 32; length < _length; length *= 2)
+					{
+						growing.GetArray(length);
+					}
+
+					growing.GetArray(_length);
+				}
+				break;
+			}
+		}
+
+	private:
+		Mode _mode;
+		int _length;
+		UnmanagedArray<float> _array;
+	};
+
+	//-------------------------------------------------------------------------
+
+	// StringToChar, CharToString, AllocateString/DeallocateString, ByteArrayToPtr and PtrToByteArray.
+	ref class BufferConversionBenchmark sealed : InteropBenchmark
+	{
+	public:
+		enum class Mode { StringToChar, CharToString, AllocateString, ByteArrayToPtr, PtrToByteArray };
+
+		BufferConversionBenchmark(Mode mode, int length)
+			: InteropBenchmark(System::String::Format("Buffers.{0}", mode))
+		{
+			_mode = mode;
+			_length = length;
+			AddParameter("length", length);
+		}
+
+		virtual void Setup() override
+		{
+			_text = gcnew System::String('x', _length);
+			_bytes = gcnew array<System::Byte>(_length);
+			_pBuffer = new char[_length + 1];
+			memset(_pBuffer, 'x', _length);
+			_pBuffer[_length] = 0;
+		}
+
+		virtual void Run(System::Int32 iterations) override
+		{
+			switch(_mode)
+			{
+			case Mode::StringToChar:
+				for(int i = 0; i < iterations; i++)
+				{
+					TypeConverter::StringToChar(_text, _pBuffer, _length + 1);
+				}
+				break;
+			case Mode::CharToString:
+				for(int i = 0; i < iterations; i++)
+				{
+					Sink = TypeConverter::CharToString(_pBuffer);
+				}
+				break;
+			case Mode::AllocateString:
+				for(int i = 0; i < iterations; i++)
+				{
+					TypeConverter::DeallocateString(TypeConverter::AllocateString(_text));
+				}
+				break;
+			case Mode::ByteArrayToPtr:
+				for(int i = 0; i < iterations; i++)
+				{
+					delete[] TypeConverter::ByteArrayToPtr(_bytes);
+				}
+				break;
+			case Mode::PtrToByteArray:
+				for(int i = 0; i < iterations; i++)
+				{
+					Sink = TypeConverter::PtrToByteArray(_pBuffer, _length);
+				}
+				break;
+			}
+		}
+
+		virtual void Cleanup() override
+		{
+			delete[] _pBuffer;
+		}
+
+	private:
+		Mode _mode;
+		int _length;
+		System::String^ _text;
+		array<System::Byte>^ _bytes;
+		char* _pBuffer;
+	};
+
+	//-------------------------------------------------------------------------
+
+	// The fixed size structure conversions.
+	ref class StructConversionBenchmark sealed : InteropBenchmark
+	{
+	public:
+		enum class Mode
+		{
+			RectangleToUnmanaged, RectangleToManaged,
+			PinPropertiesToUnmanaged, PinPropertiesToManaged,
+			ParameterPropertiesToUnmanaged, ParameterPropertiesToManaged,
+			MidiProgramNameToUnmanaged, MidiProgramNameToManaged,
+			MidiProgramCategoryToUnmanaged, MidiProgramCategoryToManaged,
+			PatchChunkInfoToUnmanaged, PatchChunkInfoToManaged,
+			TimeInfoToUnmanaged, TimeInfoToManaged, TimeInfoAllocUnmanaged,
+			FileSelectAllocUnmanaged,
+		};
+
+		StructConversionBenchmark(Mode mode)
+			: InteropBenchmark(System::String::Format("Structs.{0}", mode))
+		{
+			_mode = mode;
+		}
+
+		virtual void Setup() override
+		{
+			_pinProps = gcnew VstPinProperties();
+			_pinProps->Label = "Left";
+			_pinProps->ShortLabel = "L";
+			_paramProps = gcnew VstParameterProperties();
+			_paramProps->Label = "Cutoff";
+			_paramProps->ShortLabel = "Cut";
+			_paramProps->CategoryLabel = "Filter";
+			_progName = gcnew VstMidiProgramName();
+			_progName->Name = "Grand Piano";
+			_progCat = gcnew VstMidiProgramCategory();
+			_progCat->Name = "Keys";
+			_chunkInfo = gcnew VstPatchChunkInfo(1, 0x4A616362, 1000, 128);
+			_timeInfo = gcnew VstTimeInfo();
+			_timeInfo->SampleRate = 48000;
+			_timeInfo->Tempo = 120;
+			_fileSelect = gcnew VstFileSelect();
+			_fileSelect->InitialPath = "C:\\Presets";
+			_fileSelect->FileTypes = gcnew array<VstFileType^>(4);
+			for(int i = 0; i < _fileSelect->FileTypes->Length; i++)
+			{
+				_fileSelect->FileTypes[i] = gcnew VstFileType();
+				_fileSelect->FileTypes[i]->Name = "Preset";
+				_fileSelect->FileTypes[i]->Extension = "fxp";
+			}
+
+			_pRect = new ::Vst2Rectangle();
+			_pPinProps = new ::Vst2PinProperties();
+			_pParamProps = new ::Vst2ParameterProperties();
+			_pProgName = new ::Vst2MidiProgramName();
+			_pProgCat = new ::Vst2MidiProgramCategory();
+			_pChunkInfo = new ::Vst2PatchChunkInfo();
+			_pTimeInfo = new ::Vst2TimeInfo();
+
+			TypeConverter::ToUnmanagedPinProperties(_pPinProps, _pinProps);
+			TypeConverter::ToUnmanagedParameterProperties(_pParamProps, _paramProps);
+			TypeConverter::ToUnmanagedMidiProgramName(_pProgName, _progName);
+			TypeConverter::ToUnmanagedMidiProgramCategory(_pProgCat, _progCat);
+			TypeConverter::ToUnmanagedPatchChunkInfo(_pChunkInfo, _chunkInfo);
+			TypeConverter::ToUnmanagedTimeInfo(_pTimeInfo, _timeInfo);
+		}
+
+		virtual void Run(System::Int32 iterations) override
+		{
+			System::Drawing::Rectangle rect(10, 20, 640, 480);
+
+			switch(_mode)
+			{
+			case Mode::RectangleToUnmanaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::ToUnmanagedRectangle(_pRect, rect);
+				break;
+			case Mode::RectangleToManaged:
+				for(int i = 0; i < iterations; i++) rect = TypeConverter::ToManagedRectangle(_pRect);
+				break;
+			case Mode::PinPropertiesToUnmanaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::ToUnmanagedPinProperties(_pPinProps, _pinProps);
+				break;
+			case Mode::PinPropertiesToManaged:
+				for(int i = 0; i < iterations; i++) Sink = TypeConverter::ToManagedPinProperties(_pPinProps);
+				break;
+			case Mode::ParameterPropertiesToUnmanaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::ToUnmanagedParameterProperties(_pParamProps, _paramProps);
+				break;
+			case Mode::ParameterPropertiesToManaged:
+				for(int i = 0; i < iterations; i++) Sink = TypeConverter::ToManagedParameterProperties(_pParamProps);
+				break;
+			case Mode::MidiProgramNameToUnmanaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::ToUnmanagedMidiProgramName(_pProgName, _progName);
+				break;
+			case Mode::MidiProgramNameToManaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::ToManagedMidiProgramName(_progName, _pProgName);
+				break;
+			case Mode::MidiProgramCategoryToUnmanaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::ToUnmanagedMidiProgramCategory(_pProgCat, _progCat);
+				break;
+			case Mode::MidiProgramCategoryToManaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::ToManagedMidiProgramCategory(_progCat, _pProgCat);
+				break;
+			case Mode::PatchChunkInfoToUnmanaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::ToUnmanagedPatchChunkInfo(_pChunkInfo, _chunkInfo);
+				break;
+			case Mode::PatchChunkInfoToManaged:
+				for(int i = 0; i < iterations; i++) Sink = TypeConverter::ToManagedPatchChunkInfo(_pChunkInfo);
+				break;
+			case Mode::TimeInfoToUnmanaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::ToUnmanagedTimeInfo(_pTimeInfo, _timeInfo);
+				break;
+			case Mode::TimeInfoToManaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::ToManagedTimeInfo(_timeInfo, _pTimeInfo);
+				break;
+			case Mode::TimeInfoAllocUnmanaged:
+				for(int i = 0; i < iterations; i++) delete TypeConverter::AllocUnmanagedTimeInfo(_timeInfo);
+				break;
+			case Mode::FileSelectAllocUnmanaged:
+				for(int i = 0; i < iterations; i++) TypeConverter::DeleteUnmanagedFileSelect(TypeConverter::AllocUnmanagedFileSelect(_fileSelect));
+				break;
+			}
+
+			Sink = rect;
+		}
+
+		virtual void Cleanup() override
+		{
+			delete _pRect;
+			delete _pPinProps;
+			delete _pParamProps;
+			delete _pProgName;
+			delete _pProgCat;
+			delete _pChunkInfo;
+			delete _pTimeInfo;
+		}
+
+	private:
+		Mode _mode;
+		VstPinProperties^ _pinProps;
+		VstParameterProperties^ _paramProps;
+		VstMidiProgramName^ _progName;
+		VstMidiProgramCategory^ _progCat;
+		VstPatchChunkInfo^ _chunkInfo;
+		VstTimeInfo^ _timeInfo;
+		VstFileSelect^ _fileSelect;
+
+		::Vst2Rectangle* _pRect;
+		::Vst2PinProperties* _pPinProps;
+		::Vst2ParameterProperties* _pParamProps;
+		::Vst2MidiProgramName* _pProgName;
+		::Vst2MidiProgramCategory* _pProgCat;
+		::Vst2PatchChunkInfo* _pChunkInfo;
+		::Vst2TimeInfo* _pTimeInfo;
+	};
+
+	//-------------------------------------------------------------------------
+
+	// ToUnmanagedSpeakerArrangement/ToManagedSpeakerArrangement for any channel count.
+	ref class SpeakerArrangementBenchmark sealed : InteropBenchmark
+	{
+	public:
+		enum class Mode { ToUnmanaged, ToManaged };
+
+		SpeakerArrangementBenchmark(Mode mode, int channelCount)
+			: InteropBenchmark(System::String::Format("SpeakerArrangement.{0}", mode))
+		{
+			_mode = mode;
+			_channelCount = channelCount;
+			AddParameter("channels", channelCount);
+		}
+
+		virtual void Setup() override
+		{
+			_arrangement = gcnew VstSpeakerArrangement();
+			_arrangement->Type = VstSpeakerArrangementType::SpeakerArrUserDefined;
+			_arrangement->Speakers = gcnew array<VstSpeakerProperties^>(_channelCount);
+
+			for(int i = 0; i < _channelCount; i++)
+			{
+				_arrangement->Speakers[i] = gcnew VstSpeakerProperties();
+				_arrangement->Speakers[i]->Name = "Speaker " + i;
+			}
+
+			_pArrangement = TypeConverter::AllocUnmanagedSpeakerArrangement(_channelCount);
+			TypeConverter::ToUnmanagedSpeakerArrangement(_pArrangement, _arrangement);
+		}
+
+		virtual void Run(System::Int32 iterations) override
+		{
+			switch(_mode)
+			{
+			case Mode::ToUnmanaged:
+				for(int i = 0; i < iterations; i++)
+				{
+					TypeConverter::ToUnmanagedSpeakerArrangement(_pArrangement, _arrangement);
+				}
+				break;
+			case Mode::ToManaged:
+				for(int i = 0; i < iterations; i++)
+				{
+					Sink = TypeConverter::ToManagedSpeakerArrangement(_pArrangement);
+				}
+				break;
+			}
+		}
+
+		virtual void Cleanup() override
+		{
+			TypeConverter::DeleteUnmanagedSpeakerArrangement(_pArrangement);
+			_pArrangement = NULL;
+		}
+
+	private:
+		Mode _mode;
+		int _channelCount;
+		VstSpeakerArrangement^ _arrangement;
+		::Vst2SpeakerArrangement* _pArrangement;
+	};
+
+	//-------------------------------------------------------------------------
+
+	System::Collections::Generic::IList<InteropBenchmark^>^ MarshalingBenchmarks::Create()
+	{
+		auto benchmarks = gcnew System::Collections::Generic::List<InteropBenchmark^>();
+
+		for(int eventCount : EventCounts)
+		{
+			benchmarks->Add(gcnew EventsBenchmark(EventsBenchmark::Mode::ToUnmanaged, false, eventCount));
+			benchmarks->Add(gcnew EventsBenchmark(EventsBenchmark::Mode::ToUnmanagedArena, false, eventCount));
+			benchmarks->Add(gcnew EventsBenchmark(EventsBenchmark::Mode::ToManaged, false, eventCount));
+			benchmarks->Add(gcnew EventsBenchmark(EventsBenchmark::Mode::ToUnmanaged, true, eventCount));
+			benchmarks->Add(gcnew EventsBenchmark(EventsBenchmark::Mode::ToUnmanagedArena, true, eventCount));
+			benchmarks->Add(gcnew EventsBenchmark(EventsBenchmark::Mode::ToManaged, true, eventCount));
+		}
+
+		for(int channelCount : ChannelCounts)
+		{
+			benchmarks->Add(gcnew SpeakerArrangementBenchmark(SpeakerArrangementBenchmark::Mode::ToUnmanaged, channelCount));
+			benchmarks->Add(gcnew SpeakerArrangementBenchmark(SpeakerArrangementBenchmark::Mode::ToManaged, channelCount));
+
+			for(int sampleCount : SampleCounts)
+			{
+				benchmarks->Add(gcnew AudioBufferArrayBenchmark(false, channelCount, sampleCount));
+				benchmarks->Add(gcnew AudioBufferArrayBenchmark(true, channelCount, sampleCount));
+				benchmarks->Add(gcnew BufferManagerBenchmark(BufferManagerBenchmark::Mode::Create, false, channelCount, sampleCount));
+				benchmarks->Add(gcnew BufferManagerBenchmark(BufferManagerBenchmark::Mode::ClearAll, false, channelCount, sampleCount));
+				benchmarks->Add(gcnew BufferManagerBenchmark(BufferManagerBenchmark::Mode::Create, true, channelCount, sampleCount));
+				benchmarks->Add(gcnew BufferManagerBenchmark(BufferManagerBenchmark::Mode::ClearAll, true, channelCount, sampleCount));
+			}
+		}
+
+		for(int sampleCount : SampleCounts)
+		{
+			benchmarks->Add(gcnew UnmanagedArrayBenchmark(UnmanagedArrayBenchmark::Mode::Reuse, sampleCount));
+			benchmarks->Add(gcnew UnmanagedArrayBenchmark(UnmanagedArrayBenchmark::Mode::Grow, sampleCount));
+		}
+
+		// label (8), name (64) and chunk (4k, 64k) sizes.
+		for each(int length in gcnew array<int> { 8, 64 })
+		{
+			benchmarks->Add(gcnew BufferConversionBenchmark(BufferConversionBenchmark::Mode::StringToChar, length));
+			benchmarks->Add(gcnew BufferConversionBenchmark(BufferConversionBenchmark::Mode::CharToString, length));
+			benchmarks->Add(gcnew BufferConversionBenchmark(BufferConversionBenchmark::Mode::AllocateString, length));
+		}
+
+		for each(int length in gcnew array<int> { 64, 4096, 65536 })
+		{
+			benchmarks->Add(gcnew BufferConversionBenchmark(BufferConversionBenchmark::Mode::ByteArrayToPtr, length));
+			benchmarks->Add(gcnew BufferConversionBenchmark(BufferConversionBenchmark::Mode::PtrToByteArray, length));
+		}
+
+		for each(StructConversionBenchmark::Mode mode in System::Enum::GetValues(StructConversionBenchmark::Mode::typeid))
+		{
+			benchmarks->Add(gcnew StructConversionBenchmark(mode));
+		}
+
+		return benchmarks;
+	}
+
+}}}} // Jacobi::Vst::Benchmark::Interop
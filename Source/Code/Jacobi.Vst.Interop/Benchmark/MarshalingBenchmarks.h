@@ -0,0 +1,22 @@
+#pragma once
+
+#include "InteropBenchmark.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Benchmark {
+namespace Interop {
+
+	/// <summary>
+	/// The MarshalingBenchmarks class creates the benchmarks for the marshaling routines of the interop layer.
+	/// </summary>
+	/// <remarks>Covers the TypeConverter routines, the unmanaged event lists, UnmanagedArray growth and
+	/// the audio buffer managers at 1-1024 events, 1-64 channels and 32-8192 samples.</remarks>
+	public ref class MarshalingBenchmarks abstract sealed
+	{
+	public:
+		/// <summary>Creates one benchmark for each routine and size.</summary>
+		static System::Collections::Generic::IList<InteropBenchmark^>^ Create();
+	};
+
+}}}} // Jacobi::Vst::Benchmark::Interop
@@ -0,0 +1,212 @@
+// compiled without /clr and without the precompiled header (uses <chrono>).
+#include "NativeBenchmarkHost.h"
+
+#include <chrono>
+#include <string.h>
+
+namespace
+{
+	Vst2IntPtr Vst2Handler HostCallback(::Vst2Plugin*, int32_t opcode, int32_t, Vst2IntPtr, void*, float)
+	{
+		switch((Vst2HostCommands)opcode)
+		{
+		case Vst2HostCommands::Version:
+			return Vst2Version;
+		case Vst2HostCommands::IoChanged:
+			return 1;
+		default:
+			return 0;
+		}
+	}
+
+	// Vst2SpeakerArrangement declares 8 speakers; larger arrangements extend past the struct.
+	std::vector<char> CreateArrangement(int32_t channelCount)
+	{
+		size_t size = sizeof(::Vst2SpeakerArrangement);
+		if(channelCount > 8)
+		{
+			size += (channelCount - 8) * sizeof(::Vst2SpeakerProperties);
+		}
+
+		std::vector<char> buffer(size);
+		auto pArrangement = (::Vst2SpeakerArrangement*)buffer.data();
+		pArrangement->kind = channelCount == 1 ? ArrMono : (channelCount == 2 ? ArrStereo : ArrUserDefined);
+		pArrangement->channelCount = channelCount;
+		return buffer;
+	}
+}
+
+NativeBenchmarkHost::NativeBenchmarkHost()
+	: _handle(NULL), _pPlugin(NULL), _isResumed(false), _channelCount(0), _maxBlockSize(0)
+{
+}
+
+NativeBenchmarkHost::~NativeBenchmarkHost()
+{
+	Unload();
+}
+
+NativeLoadResult NativeBenchmarkHost::Load(const NativePathChar* pPath)
+{
+	Unload();
+
+	NativePluginModule module;
+	auto result = NativePluginLoader::Load(pPath, &module);
+
+	if(result != NativeLoadResult::Success)
+	{
+		return result;
+	}
+
+	result = NativePluginLoader::CreatePlugin(module.pluginMain, &HostCallback, &_pPlugin);
+
+	if(result != NativeLoadResult::Success)
+	{
+		_pPlugin = NULL;
+		NativePluginLoader::Unload(module.handle);
+		return result;
+	}
+
+	_handle = module.handle;
+	Dispatch(Vst2PluginCommands::Open, 0, 0, NULL, 0);
+	return NativeLoadResult::Success;
+}
+
+bool NativeBenchmarkHost::Configure(int32_t channelCount, int32_t maxBlockSize, float sampleRate)
+{
+	if(_pPlugin == NULL)
+	{
+		return false;
+	}
+
+	if(_isResumed)
+	{
+		Dispatch(Vst2PluginCommands::ProcessStop, 0, 0, NULL, 0);
+		Dispatch(Vst2PluginCommands::OnOff, 0, 0, NULL, 0);
+		_isResumed = false;
+	}
+
+	Dispatch(Vst2PluginCommands::SampleRateSet, 0, 0, NULL, sampleRate);
+	Dispatch(Vst2PluginCommands::BlockSizeSet, 0, maxBlockSize, NULL, 0);
+
+	auto input = CreateArrangement(channelCount);
+	auto output = CreateArrangement(channelCount);
+	Dispatch(Vst2PluginCommands::SetSpeakerArrangement, 0, (Vst2IntPtr)input.data(), output.data(), 0);
+
+	if(_pPlugin->inputCount != channelCount || _pPlugin->outputCount != channelCount)
+	{
+		return false;
+	}
+
+	_channelCount = channelCount;
+	_maxBlockSize = maxBlockSize;
+
+	// inputs followed by outputs, one channel after the other.
+	_samples32.assign((size_t)channelCount * 2 * maxBlockSize, 0.0f);
+	_samples64.assign((size_t)channelCount * 2 * maxBlockSize, 0.0);
+	_inputs32.resize(channelCount);
+	_outputs32.resize(channelCount);
+	_inputs64.resize(channelCount);
+	_outputs64.resize(channelCount);
+
+	for(int32_t i = 0; i < channelCount; i++)
+	{
+		_inputs32[i] = &_samples32[(size_t)i * maxBlockSize];
+		_outputs32[i] = &_samples32[(size_t)(channelCount + i) * maxBlockSize];
+		_inputs64[i] = &_samples64[(size_t)i * maxBlockSize];
+		_outputs64[i] = &_samples64[(size_t)(channelCount + i) * maxBlockSize];
+	}
+
+	Dispatch(Vst2PluginCommands::OnOff, 0, 1, NULL, 0);
+	Dispatch(Vst2PluginCommands::ProcessStart, 0, 0, NULL, 0);
+	_isResumed = true;
+	return true;
+}
+
+void NativeBenchmarkHost::Run(int32_t blockSize, int32_t eventCount, bool doublePrecision, double* pNanoseconds, int32_t blockCount)
+{
+	if(!_isResumed || blockSize > _maxBlockSize)
+	{
+		return;
+	}
+
+	FillEvents(eventCount, blockSize);
+	auto pEvents = (::Vst2Events*)_eventList.data();
+
+	for(int32_t block = 0; block < blockCount; block++)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		if(eventCount > 0)
+		{
+			Dispatch(Vst2PluginCommands::ProcessEvents, 0, 0, pEvents, 0);
+		}
+
+		if(doublePrecision)
+		{
+			_pPlugin->replaceDouble(_pPlugin, _inputs64.data(), _outputs64.data(), blockSize);
+		}
+		else
+		{
+			_pPlugin->replace(_pPlugin, _inputs32.data(), _outputs32.data(), blockSize);
+		}
+
+		auto end = std::chrono::steady_clock::now();
+		pNanoseconds[block] = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	}
+}
+
+void NativeBenchmarkHost::Unload()
+{
+	if(_pPlugin != NULL)
+	{
+		if(_isResumed)
+		{
+			Dispatch(Vst2PluginCommands::ProcessStop, 0, 0, NULL, 0);
+			Dispatch(Vst2PluginCommands::OnOff, 0, 0, NULL, 0);
+			_isResumed = false;
+		}
+
+		// the plugin deletes itself
+		Dispatch(Vst2PluginCommands::Close, 0, 0, NULL, 0);
+		_pPlugin = NULL;
+	}
+
+	NativePluginLoader::Unload(_handle);
+	_handle = NULL;
+}
+
+Vst2IntPtr NativeBenchmarkHost::Dispatch(Vst2PluginCommands command, int32_t index, Vst2IntPtr value, void* ptr, float opt)
+{
+	return _pPlugin->command(_pPlugin, command, index, value, ptr, opt);
+}
+
+// note on/off pairs spread evenly over the block.
+void NativeBenchmarkHost::FillEvents(int32_t eventCount, int32_t blockSize)
+{
+	_midiEvents.assign(eventCount, ::Vst2MidiEvent());
+
+	// Vst2Events declares 2 event pointers; longer lists extend past the struct.
+	size_t size = sizeof(::Vst2Events);
+	if(eventCount > 2)
+	{
+		size += (eventCount - 2) * sizeof(::Vst2Event*);
+	}
+	_eventList.assign(size, 0);
+
+	auto pEvents = (::Vst2Events*)_eventList.data();
+	pEvents->eventCount = eventCount;
+
+	for(int32_t i = 0; i < eventCount; i++)
+	{
+		auto& midiEvent = _midiEvents[i];
+		midiEvent.kind = Vst2EventKind::Midi;
+		midiEvent.sizeInBytes = sizeof(::Vst2MidiEvent);
+		midiEvent.deltaFrames = (int32_t)((int64_t)i * blockSize / eventCount);
+		midiEvent.midiData[0] = (i & 1) == 0 ? 0x90 : 0x80;
+		midiEvent.midiData[1] = (uint8_t)(60 + (i / 2) % 24);
+		midiEvent.midiData[2] = 100;
+
+		pEvents->events[i] = (::Vst2Event*)&midiEvent;
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../Host/NativePluginLoader.h"
+
+#include <vector>
+
+// A minimal native VST2 host that calls a plugin block by block and times each block.
+// Does not depend on the CLR: the timed calls are exactly what a native host executes.
+class NativeBenchmarkHost
+{
+public:
+	NativeBenchmarkHost();
+	~NativeBenchmarkHost();
+
+	// Loads the library at pPath, creates the plugin and opens it.
+	NativeLoadResult Load(const NativePathChar* pPath);
+
+	// Suspends the plugin, proposes channelCount inputs and outputs and resumes it.
+	// Returns false when the plugin does not report channelCount inputs and outputs afterwards.
+	bool Configure(int32_t channelCount, int32_t maxBlockSize, float sampleRate);
+
+	// Calls processEvents (when eventCount > 0) and processReplacing (or processDoubleReplacing) blockCount times
+	// and writes the duration of each block in nanoseconds to pNanoseconds.
+	void Run(int32_t blockSize, int32_t eventCount, bool doublePrecision, double* pNanoseconds, int32_t blockCount);
+
+	// Closes the plugin and unloads the library.
+	void Unload();
+
+	::Vst2Plugin* GetPlugin() { return _pPlugin; }
+
+private:
+	Vst2IntPtr Dispatch(Vst2PluginCommands command, int32_t index, Vst2IntPtr value, void* ptr, float opt);
+	void FillEvents(int32_t eventCount, int32_t blockSize);
+
+	void* _handle;
+	::Vst2Plugin* _pPlugin;
+	bool _isResumed;
+	int32_t _channelCount;
+	int32_t _maxBlockSize;
+
+	std::vector<float> _samples32;
+	std::vector<double> _samples64;
+	std::vector<float*> _inputs32;
+	std::vector<float*> _outputs32;
+	std::vector<double*> _inputs64;
+	std::vector<double*> _outputs64;
+
+	std::vector<::Vst2MidiEvent> _midiEvents;
+	std::vector<char> _eventList;
+};
@@ -0,0 +1,73 @@
+#include "pch.h"
+#include "NativeHost.h"
+#include "NativeBenchmarkHost.h"
+
+#include <vcclr.h>
+
+namespace Jacobi {
+namespace Vst {
+namespace Benchmark {
+namespace Interop {
+
+	NativeHost::NativeHost(System::String^ pluginPath)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNullOrEmpty(pluginPath, "pluginPath");
+
+		_pHost = new NativeBenchmarkHost();
+
+		pin_ptr<const wchar_t> pPath = PtrToStringChars(pluginPath);
+		auto result = _pHost->Load(pPath);
+
+		if(result != NativeLoadResult::Success)
+		{
+			delete _pHost;
+			_pHost = NULL;
+
+			throw gcnew System::InvalidOperationException(
+				System::String::Format("Loading plugin '{0}' failed: {1}.", pluginPath, (int)result));
+		}
+	}
+
+	NativeHost::~NativeHost()
+	{
+		this->!NativeHost();
+	}
+
+	NativeHost::!NativeHost()
+	{
+		if(_pHost != NULL)
+		{
+			delete _pHost;
+			_pHost = NULL;
+		}
+	}
+
+	System::Boolean NativeHost::Configure(System::Int32 channelCount, System::Int32 maxBlockSize, System::Single sampleRate)
+	{
+		if(_pHost == NULL)
+		{
+			throw gcnew System::ObjectDisposedException("NativeHost");
+		}
+
+		return _pHost->Configure(channelCount, maxBlockSize, sampleRate);
+	}
+
+	void NativeHost::Run(System::Int32 blockSize, System::Int32 eventCount, System::Boolean doublePrecision, array<System::Double>^ blockNanoseconds)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(blockNanoseconds, "blockNanoseconds");
+
+		if(_pHost == NULL)
+		{
+			throw gcnew System::ObjectDisposedException("NativeHost");
+		}
+
+		if(blockNanoseconds->Length == 0)
+		{
+			return;
+		}
+
+		pin_ptr<System::Double> pNanoseconds = &blockNanoseconds[0];
+		_pHost->Run(blockSize, eventCount, doublePrecision, pNanoseconds, blockNanoseconds->Length);
+	}
+
+}}}} // Jacobi::Vst::Benchmark::Interop
@@ -0,0 +1,45 @@
+#pragma once
+
+class NativeBenchmarkHost;
+
+namespace Jacobi {
+namespace Vst {
+namespace Benchmark {
+namespace Interop {
+
+	/// <summary>
+	/// The NativeHost class drives a VST2 plugin from native code and times each process block.
+	/// </summary>
+	/// <remarks>Loading a VST.NET plugin (the renamed Plugin.Interop assembly) measures the path
+	/// native host, plugin interop and managed plugin. The managed code only starts and stops a run;
+	/// the blocks themselves are called and timed natively.</remarks>
+	public ref class NativeHost sealed
+	{
+	public:
+		/// <summary>Loads the plugin library at <paramref name="pluginPath"/> and opens the plugin.</summary>
+		/// <exception cref="System::InvalidOperationException">Thrown when the plugin could not be loaded.</exception>
+		NativeHost(System::String^ pluginPath);
+		/// <summary>Closes the plugin and unloads its library.</summary>
+		~NativeHost();
+		/// <summary>Closes the plugin and unloads its library.</summary>
+		!NativeHost();
+
+		/// <summary>Sets the number of input and output channels and resumes the plugin.</summary>
+		/// <returns>Returns false when the plugin did not accept the channel count.</returns>
+		System::Boolean Configure(System::Int32 channelCount, System::Int32 maxBlockSize, System::Single sampleRate);
+
+		/// <summary>Calls the plugin for one block of <paramref name="blockSize"/> samples and
+		/// <paramref name="eventCount"/> Midi events per element of <paramref name="blockNanoseconds"/>,
+		/// and stores the duration of each block.</summary>
+		void Run(System::Int32 blockSize, System::Int32 eventCount, System::Boolean doublePrecision, array<System::Double>^ blockNanoseconds);
+
+		/// <summary>Gets the path to a native VST2 plugin that does no processing.</summary>
+		/// <remarks>The plugin is exported by this assembly (VSTPluginMain).</remarks>
+		static property System::String^ NoOpPluginPath
+		{ System::String^ get() { return NativeHost::typeid->Assembly->Location; } }
+
+	private:
+		NativeBenchmarkHost* _pHost;
+	};
+
+}}}} // Jacobi::Vst::Benchmark::Interop
@@ -0,0 +1,88 @@
+// compiled without /clr and without the precompiled header.
+// A native VST2 plugin that does no processing, used to measure the host interop.
+// Exported from Jacobi.Vst.Benchmark.Interop.dll (see Jacobi.Vst.Benchmark.Interop.def).
+#include "../Vst2400.h"
+
+#include <new>
+
+#ifdef _WIN32
+#define NOOP_EXPORT extern "C"
+#else
+#define NOOP_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+namespace
+{
+	// Vst2Plugin must be the first member: the host passes it back on each call.
+	struct NoOpPlugin
+	{
+		::Vst2Plugin plugin;
+		::Vst2HostCallback hostCallback;
+	};
+
+	Vst2IntPtr Vst2Handler Dispatch(::Vst2Plugin* pPlugin, Vst2PluginCommands command, int32_t, Vst2IntPtr value, void* ptr, float)
+	{
+		switch(command)
+		{
+		case Vst2PluginCommands::Close:
+			delete (NoOpPlugin*)pPlugin;
+			return 1;
+		case Vst2PluginCommands::SetSpeakerArrangement:
+			// accepts any channel count
+			pPlugin->inputCount = ((::Vst2SpeakerArrangement*)value)->channelCount;
+			pPlugin->outputCount = ((::Vst2SpeakerArrangement*)ptr)->channelCount;
+			return 1;
+		case Vst2PluginCommands::ProcessEvents:
+			return 1;
+		case Vst2PluginCommands::GetVstVersion:
+			return Vst2Version;
+		case Vst2PluginCommands::PluginGetCategory:
+			return (Vst2IntPtr)Vst2PlugCategory::Effect;
+		default:
+			return 0;
+		}
+	}
+
+	void Vst2Handler Process32(::Vst2Plugin*, float**, float**, int32_t)
+	{
+	}
+
+	void Vst2Handler Process64(::Vst2Plugin*, double**, double**, int32_t)
+	{
+	}
+
+	void Vst2Handler SetParameter(::Vst2Plugin*, int32_t, float)
+	{
+	}
+
+	float Vst2Handler GetParameter(::Vst2Plugin*, int32_t)
+	{
+		return 0.0f;
+	}
+}
+
+NOOP_EXPORT ::Vst2Plugin* VSTPluginMain(::Vst2HostCallback hostCallback)
+{
+	auto pNoOp = new(std::nothrow) NoOpPlugin();
+
+	if(pNoOp == nullptr)
+	{
+		return nullptr;
+	}
+
+	pNoOp->hostCallback = hostCallback;
+
+	auto pPlugin = &pNoOp->plugin;
+	pPlugin->VstP = Vst2FourCharacterCode;
+	pPlugin->command = &Dispatch;
+	pPlugin->replace = &Process32;
+	pPlugin->replaceDouble = &Process64;
+	pPlugin->parameterSet = &SetParameter;
+	pPlugin->parameterGet = &GetParameter;
+	pPlugin->flags = (Vst2PluginFlags)((int32_t)Vst2PluginFlags::CanReplace | (int32_t)Vst2PluginFlags::CanReplaceDouble);
+	pPlugin->inputCount = 2;
+	pPlugin->outputCount = 2;
+	pPlugin->id = 'NoOp';
+	pPlugin->version = 1;
+	return pPlugin;
+}
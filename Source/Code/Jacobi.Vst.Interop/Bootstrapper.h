@@ -3,6 +3,9 @@
 /// <summary>
 /// The Bootstrapper class loads the managed plugin assembly.
 /// </summary>
+/// <remarks>The plugin assembly, its command stub type and configuration are loaded once per process
+/// (per interop path) by <see cref="Jacobi::Vst::Core::Plugin::ManagedPluginCache"/>.
+/// Additional instances only construct a new command stub with its own configuration.</remarks>
 class Bootstrapper
 {
 public:
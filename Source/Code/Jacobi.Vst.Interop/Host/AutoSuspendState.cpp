@@ -0,0 +1,62 @@
+// compiled without /clr and without the precompiled header (runs on the audio thread, also built by the native tests).
+#include "AutoSuspendState.h"
+#include "SilenceScan.h"
+
+AutoSuspendState::AutoSuspendState()
+	: _threshold(0.0f), _defaultTailSize(48000), _pluginTailSize(-1), _resumeRequested(false),
+	_silentSamples(0), _isSuspended(false), _skippedCount(0)
+{
+}
+
+void AutoSuspendState::SetTailSize(int32_t pluginTailSize)
+{
+	_pluginTailSize = pluginTailSize;
+	RequestResume();
+}
+
+bool AutoSuspendState::Update(float** ppInputs, int32_t inputCount, int32_t sampleFrames, bool eventsPending)
+{
+	return Update(inputCount > 0 && !eventsPending && SilenceScan::IsSilent(ppInputs, inputCount, sampleFrames, _threshold),
+		sampleFrames);
+}
+
+bool AutoSuspendState::Update(double** ppInputs, int32_t inputCount, int32_t sampleFrames, bool eventsPending)
+{
+	return Update(inputCount > 0 && !eventsPending && SilenceScan::IsSilent(ppInputs, inputCount, sampleFrames, _threshold),
+		sampleFrames);
+}
+
+bool AutoSuspendState::Update(bool inputSilent, int32_t sampleFrames)
+{
+	if(_resumeRequested)
+	{
+		_resumeRequested = false;
+		_silentSamples = 0;
+		_isSuspended = false;
+	}
+
+	if(!inputSilent)
+	{
+		_silentSamples = 0;
+		_isSuspended = false;
+		return false;
+	}
+
+	// the tail has been rendered by the previous calls.
+	if(_silentSamples >= GetTailSize())
+	{
+		_isSuspended = true;
+		_skippedCount = _skippedCount + 1;
+		return true;
+	}
+
+	_silentSamples += sampleFrames;
+	return false;
+}
+
+int32_t AutoSuspendState::GetTailSize() const
+{
+	int32_t tailSize = _pluginTailSize;
+
+	return tailSize <= 0 ? _defaultTailSize : (tailSize == 1 ? 0 : tailSize);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+
+// Decides for VstAutoSuspend when the process call of a plugin can be skipped because its input is silent
+// and the tail it reported has been rendered.
+// Update runs on the audio thread and is the only method that changes the suspend state.
+// SetTailSize and RequestResume may be called on another thread: they leave a value or flag
+// that the next Update picks up, so the audio thread never sees a half-reset state.
+class AutoSuspendState
+{
+public:
+	AutoSuspendState();
+
+	// The absolute sample value up to which input is considered silent. The default is 0 (digital silence only).
+	float GetThreshold() const { return _threshold; }
+	void SetThreshold(float threshold) { _threshold = threshold; }
+
+	// The tail (in samples) used when the plugin does not report one. The default is 48000.
+	int32_t GetDefaultTailSize() const { return _defaultTailSize; }
+	void SetDefaultTailSize(int32_t tailSize) { _defaultTailSize = tailSize; }
+
+	// Stores the tail size the plugin reported through GetTailSize (0: unknown, 1: no tail) and resumes.
+	// Call when the plugin is switched on, not on the audio thread.
+	void SetTailSize(int32_t pluginTailSize);
+	// Resumes processing with the next Update.
+	void RequestResume() { _resumeRequested = true; }
+
+	// Returns true when the process call for this block can be skipped (the outputs must be cleared).
+	// A plugin without inputs is never suspended, it may produce sound on its own.
+	// Pending events count as activity.
+	bool Update(float** ppInputs, int32_t inputCount, int32_t sampleFrames, bool eventsPending);
+	bool Update(double** ppInputs, int32_t inputCount, int32_t sampleFrames, bool eventsPending);
+
+	bool IsSuspended() const { return _isSuspended; }
+	// The number of process calls that were skipped.
+	int64_t GetSkippedCount() const { return _skippedCount; }
+
+private:
+	volatile float _threshold;
+	volatile int32_t _defaultTailSize;
+	volatile int32_t _pluginTailSize;	// -1 when not queried
+	volatile bool _resumeRequested;
+
+	// audio thread
+	int64_t _silentSamples;
+	volatile bool _isSuspended;
+	volatile int64_t _skippedCount;
+
+	bool Update(bool inputSilent, int32_t sampleFrames);
+	int32_t GetTailSize() const;
+};
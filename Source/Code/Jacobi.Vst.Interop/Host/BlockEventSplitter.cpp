@@ -0,0 +1,90 @@
+// compiled without /clr and without the precompiled header (runs on the audio thread, also built by the native tests).
+#include "BlockEventSplitter.h"
+
+#include <algorithm>
+#include <stddef.h>
+#include <string.h>
+
+const ::Vst2Events* BlockEventSplitter::GetSubBlock(const ::Vst2Events* pEvents, int32_t offset, int32_t sampleCount, bool isLast)
+{
+	if(pEvents == NULL || pEvents->eventCount <= 0 || sampleCount <= 0)
+	{
+		return NULL;
+	}
+
+	size_t capacity = (size_t)pEvents->eventCount;
+	if(_events.size() < capacity)
+	{
+		_events.resize(capacity);
+		_list.resize(sizeof(::Vst2Events) + capacity * sizeof(::Vst2Event*));
+	}
+
+	auto pSubEvents = (::Vst2Events*)_list.data();
+	memset(pSubEvents, 0, sizeof(::Vst2Events));
+
+	for(int32_t n = 0; n < pEvents->eventCount; n++)
+	{
+		const ::Vst2Event* pEvent = pEvents->events[n];
+		if(pEvent == NULL)
+		{
+			continue;
+		}
+
+		if((pEvent->deltaFrames >= offset || offset == 0) &&
+			(pEvent->deltaFrames < offset + sampleCount || isLast))
+		{
+			EventData& data = _events[pSubEvents->eventCount];
+			if(pEvent->kind == ::Vst2EventKind::SystemExclusive)
+			{
+				data.sysExEvent = *(const ::Vst2MidiSysExEvent*)pEvent;
+			}
+			else
+			{
+				data.event = *pEvent;
+			}
+
+			data.event.deltaFrames = std::max(0, std::min(pEvent->deltaFrames - offset, sampleCount - 1));
+			pSubEvents->events[pSubEvents->eventCount++] = &data.event;
+		}
+	}
+
+	return pSubEvents->eventCount > 0 ? pSubEvents : NULL;
+}
+
+void BlockEventSplitter::Defer(const ::Vst2Events* pEvents)
+{
+	if(pEvents == NULL || pEvents->eventCount <= 0)
+	{
+		return;
+	}
+
+	int32_t count = _deferred.empty() ? 0 : ((const ::Vst2Events*)_deferred.data())->eventCount;
+	size_t size = offsetof(::Vst2Events, events) + (size_t)(count + pEvents->eventCount) * sizeof(::Vst2Event*);
+	if(_deferred.size() < size)
+	{
+		// resize keeps the events deferred so far.
+		_deferred.resize(std::max(size, sizeof(::Vst2Events)));
+	}
+
+	auto pDeferred = (::Vst2Events*)_deferred.data();
+	memcpy(&pDeferred->events[count], &pEvents->events[0], pEvents->eventCount * sizeof(::Vst2Event*));
+	pDeferred->eventCount = count + pEvents->eventCount;
+}
+
+const ::Vst2Events* BlockEventSplitter::GetDeferred() const
+{
+	if(_deferred.empty() || ((const ::Vst2Events*)_deferred.data())->eventCount == 0)
+	{
+		return NULL;
+	}
+
+	return (const ::Vst2Events*)_deferred.data();
+}
+
+void BlockEventSplitter::ClearDeferred()
+{
+	if(!_deferred.empty())
+	{
+		((::Vst2Events*)_deferred.data())->eventCount = 0;
+	}
+}
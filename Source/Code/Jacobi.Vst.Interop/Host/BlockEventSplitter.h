@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../Vst2400.h"
+
+#include <vector>
+
+// Selects the events of one sub-block when VstBlockSplitter processes a host block in several calls.
+// Events before the block go with the first, events past the block with the last sub-block.
+// The selected events are copies with deltaFrames relative to the start of the sub-block (clamped to it);
+// the events of the caller are not changed, so each sub-block selects on the original deltaFrames.
+// Sysex copies refer to the dump of the caller's event.
+// The events of several ProcessEvents calls for the same block are collected with Defer.
+// The storage grows to the largest event count seen and is reused after that.
+class BlockEventSplitter
+{
+public:
+	// Returns the events of the sub-block [offset, offset + sampleCount) of pEvents,
+	// or NULL when there are none. The list stays valid until the next call.
+	const ::Vst2Events* GetSubBlock(const ::Vst2Events* pEvents, int32_t offset, int32_t sampleCount, bool isLast);
+
+	// Appends the events of pEvents to the deferred list. The events must stay valid until ClearDeferred.
+	void Defer(const ::Vst2Events* pEvents);
+	// Returns the events of all Defer calls since ClearDeferred, or NULL when there are none.
+	const ::Vst2Events* GetDeferred() const;
+	void ClearDeferred();
+
+private:
+	union EventData
+	{
+		::Vst2Event event;
+		::Vst2MidiEvent midiEvent;
+		::Vst2MidiSysExEvent sysExEvent;
+	};
+
+	std::vector<EventData> _events;
+	// Vst2Events declares 2 event pointers.
+	std::vector<char> _list;
+	std::vector<char> _deferred;
+};
@@ -0,0 +1,242 @@
+#include "pch.h"
+#include "ChunkCodec.h"
+
+// the codec does not touch managed objects.
+#pragma unmanaged
+
+namespace
+{
+	const int MinMatch = 4;
+	// the last 5 bytes are always literals and the last match starts 12 bytes before the end.
+	const int LastLiterals = 5;
+	const int MatchFindLimit = 12;
+	const int MaxOffset = 65535;
+	const int HashLog = 12;
+
+	inline uint32_t Read32(const uint8_t* p)
+	{
+		uint32_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	inline uint32_t Hash(uint32_t sequence)
+	{
+		return (sequence * 2654435761U) >> (32 - HashLog);
+	}
+
+	inline uint8_t* WriteLength(uint8_t* op, size_t length)
+	{
+		while(length >= 255)
+		{
+			*op++ = 255;
+			length -= 255;
+		}
+		*op++ = (uint8_t)length;
+		return op;
+	}
+
+	inline bool ReadLength(const uint8_t*& ip, const uint8_t* iend, size_t& length)
+	{
+		uint8_t b;
+		do
+		{
+			if(ip >= iend) return false;
+			b = *ip++;
+			length += b;
+		} while(b == 255);
+
+		return true;
+	}
+}
+
+int ChunkCodec::Compress(const uint8_t* pSource, int sourceLength, uint8_t* pDest, int destCapacity)
+{
+	int32_t table[1 << HashLog];
+	memset(table, 0xFF, sizeof(table));
+
+	const uint8_t* ip = pSource;
+	const uint8_t* anchor = pSource;
+	const uint8_t* const iend = pSource + sourceLength;
+	const uint8_t* const mflimit = iend - MatchFindLimit;
+	const uint8_t* const matchlimit = iend - LastLiterals;
+
+	uint8_t* op = pDest;
+	uint8_t* const oend = pDest + destCapacity;
+
+	if(sourceLength > MatchFindLimit)
+	{
+		while(ip < mflimit)
+		{
+			uint32_t sequence = Read32(ip);
+			uint32_t h = Hash(sequence);
+			int32_t ref = table[h];
+			table[h] = (int32_t)(ip - pSource);
+
+			if(ref < 0 || (ip - pSource) - ref > MaxOffset || Read32(pSource + ref) != sequence)
+			{
+				ip++;
+				continue;
+			}
+
+			const uint8_t* match = pSource + ref;
+
+			// extend backwards into the pending literals
+			while(ip > anchor && match > pSource && ip[-1] == match[-1])
+			{
+				ip--;
+				match--;
+			}
+
+			const uint8_t* mp = ip + MinMatch;
+			const uint8_t* mm = match + MinMatch;
+			while(mp < matchlimit && *mp == *mm)
+			{
+				mp++;
+				mm++;
+			}
+
+			size_t literalLength = ip - anchor;
+			size_t matchLength = (mp - ip) - MinMatch;
+
+			if(op + 1 + (literalLength / 255) + 1 + literalLength + 2 + (matchLength / 255) + 1 > oend)
+			{
+				return 0;
+			}
+
+			uint8_t* token = op++;
+
+			if(literalLength >= 15)
+			{
+				*token = 15 << 4;
+				op = WriteLength(op, literalLength - 15);
+			}
+			else
+			{
+				*token = (uint8_t)(literalLength << 4);
+			}
+
+			memcpy(op, anchor, literalLength);
+			op += literalLength;
+
+			size_t offset = ip - match;
+			*op++ = (uint8_t)offset;
+			*op++ = (uint8_t)(offset >> 8);
+
+			if(matchLength >= 15)
+			{
+				*token |= 15;
+				op = WriteLength(op, matchLength - 15);
+			}
+			else
+			{
+				*token |= (uint8_t)matchLength;
+			}
+
+			ip = mp;
+			anchor = ip;
+		}
+	}
+
+	// the remainder is stored as literals
+	size_t literalLength = iend - anchor;
+
+	if(op + 1 + (literalLength / 255) + 1 + literalLength > oend)
+	{
+		return 0;
+	}
+
+	if(literalLength >= 15)
+	{
+		*op++ = 15 << 4;
+		op = WriteLength(op, literalLength - 15);
+	}
+	else
+	{
+		*op++ = (uint8_t)(literalLength << 4);
+	}
+
+	memcpy(op, anchor, literalLength);
+	op += literalLength;
+
+	return (int)(op - pDest);
+}
+
+bool ChunkCodec::Decompress(const uint8_t* pSource, int sourceLength, uint8_t* pDest, int destLength)
+{
+	const uint8_t* ip = pSource;
+	const uint8_t* const iend = pSource + sourceLength;
+	uint8_t* op = pDest;
+	uint8_t* const oend = pDest + destLength;
+
+	while(ip < iend)
+	{
+		uint8_t token = *ip++;
+
+		size_t literalLength = token >> 4;
+		if(literalLength == 15 && !ReadLength(ip, iend, literalLength))
+		{
+			return false;
+		}
+
+		if(literalLength > (size_t)(iend - ip) || literalLength > (size_t)(oend - op))
+		{
+			return false;
+		}
+
+		memcpy(op, ip, literalLength);
+		op += literalLength;
+		ip += literalLength;
+
+		// the last sequence has no match
+		if(ip == iend)
+		{
+			break;
+		}
+
+		if(iend - ip < 2)
+		{
+			return false;
+		}
+
+		size_t offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+
+		if(offset == 0 || offset > (size_t)(op - pDest))
+		{
+			return false;
+		}
+
+		size_t matchLength = token & 15;
+		if(matchLength == 15 && !ReadLength(ip, iend, matchLength))
+		{
+			return false;
+		}
+		matchLength += MinMatch;
+
+		if(matchLength > (size_t)(oend - op))
+		{
+			return false;
+		}
+
+		const uint8_t* match = op - offset;
+
+		if(offset >= matchLength)
+		{
+			memcpy(op, match, matchLength);
+			op += matchLength;
+		}
+		else
+		{
+			// overlapping copy repeats the last 'offset' bytes
+			for(size_t n = 0; n < matchLength; n++)
+			{
+				*op++ = *match++;
+			}
+		}
+	}
+
+	return op == oend;
+}
+
+#pragma managed
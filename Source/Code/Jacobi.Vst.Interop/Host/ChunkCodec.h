@@ -0,0 +1,22 @@
+#pragma once
+
+// Fast LZ77 block codec for plugin chunk data (LZ4 block format).
+// Favors speed over ratio: plugin state is mostly repetitive and is
+// compressed on the host serialization path.
+class ChunkCodec
+{
+public:
+	// Returns the maximum compressed size for a block of sourceLength bytes.
+	static int CompressBound(int sourceLength)
+	{
+		return sourceLength + (sourceLength / 255) + 16;
+	}
+
+	// Compresses sourceLength bytes from pSource into pDest.
+	// Returns the compressed length or 0 when destCapacity is too small.
+	static int Compress(const uint8_t* pSource, int sourceLength, uint8_t* pDest, int destCapacity);
+
+	// Decompresses sourceLength bytes from pSource into exactly destLength bytes at pDest.
+	// Returns false when the data is corrupt or does not decompress to destLength bytes.
+	static bool Decompress(const uint8_t* pSource, int sourceLength, uint8_t* pDest, int destLength);
+};
@@ -0,0 +1,184 @@
+// compiled without /clr and without the precompiled header (uses <thread>).
+#include "NativePluginLoader.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#include <string.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+	void* OpenLibrary(const NativePathChar* pPath, NativeLoadResult* pResult)
+	{
+		HMODULE hLib = ::LoadLibraryW(pPath);
+
+		if(hLib == NULL)
+		{
+			*pResult = ::GetLastError() == ERROR_BAD_EXE_FORMAT
+				? NativeLoadResult::BadImageFormat : NativeLoadResult::LoadFailed;
+		}
+
+		return hLib;
+	}
+
+	void* FindSymbol(void* handle, const char* pName)
+	{
+		return (void*)::GetProcAddress((HMODULE)handle, pName);
+	}
+
+	void CloseLibrary(void* handle)
+	{
+		::FreeLibrary((HMODULE)handle);
+	}
+#else
+	void* OpenLibrary(const NativePathChar* pPath, NativeLoadResult* pResult)
+	{
+		void* handle = ::dlopen(pPath, RTLD_NOW | RTLD_LOCAL);
+
+		if(handle == NULL)
+		{
+			// dlopen only reports text; the loader mentions the ELF header or class for foreign files.
+			const char* pError = ::dlerror();
+			*pResult = pError != NULL && (strstr(pError, "ELF") != NULL || strstr(pError, "file too short") != NULL)
+				? NativeLoadResult::BadImageFormat : NativeLoadResult::LoadFailed;
+		}
+
+		return handle;
+	}
+
+	void* FindSymbol(void* handle, const char* pName)
+	{
+		return ::dlsym(handle, pName);
+	}
+
+	void CloseLibrary(void* handle)
+	{
+		::dlclose(handle);
+	}
+#endif
+}
+
+NativeLoadResult NativePluginLoader::Load(const NativePathChar* pPath, NativePluginModule* pModule)
+{
+	pModule->handle = NULL;
+	pModule->pluginMain = NULL;
+
+	NativeLoadResult result = NativeLoadResult::Success;
+	void* handle = OpenLibrary(pPath, &result);
+
+	if(handle == NULL)
+	{
+		return result;
+	}
+
+	auto pluginMain = (Vst2PluginMain)FindSymbol(handle, "VSTPluginMain");
+
+	if(pluginMain == NULL)
+	{
+		// check old entry point
+		pluginMain = (Vst2PluginMain)FindSymbol(handle, "main");
+	}
+
+	if(pluginMain == NULL)
+	{
+		CloseLibrary(handle);
+		return NativeLoadResult::EntryPointNotFound;
+	}
+
+	pModule->handle = handle;
+	pModule->pluginMain = pluginMain;
+	return NativeLoadResult::Success;
+}
+
+void NativePluginLoader::Unload(void* handle)
+{
+	if(handle != NULL)
+	{
+		CloseLibrary(handle);
+	}
+}
+
+NativeLoadResult NativePluginLoader::CreatePlugin(Vst2PluginMain pluginMain, ::Vst2HostCallback hostCallback, ::Vst2Plugin** ppPlugin)
+{
+	*ppPlugin = pluginMain(hostCallback);
+
+	if(*ppPlugin == NULL)
+	{
+		return NativeLoadResult::PluginReturnedNull;
+	}
+
+	if((*ppPlugin)->VstP != Vst2FourCharacterCode)
+	{
+		return NativeLoadResult::MagicNumberMismatch;
+	}
+
+	return NativeLoadResult::Success;
+}
+
+int32_t NativePluginLoader::Preload(const NativePathChar* const* ppPaths, int32_t count,
+	NativePluginModule* pModules, NativeLoadResult* pResults, int32_t threadCount)
+{
+	if(count <= 0)
+	{
+		return 0;
+	}
+
+	if(threadCount <= 0)
+	{
+		threadCount = (int32_t)std::thread::hardware_concurrency();
+	}
+
+	if(threadCount <= 0)
+	{
+		threadCount = 1;
+	}
+
+	if(threadCount > count)
+	{
+		threadCount = count;
+	}
+
+	// libraries differ a lot in load time, so each thread takes the next path instead of a fixed range.
+	std::atomic<int32_t> nextIndex(0);
+	std::atomic<int32_t> loadedCount(0);
+
+	auto worker = [&]()
+	{
+		int32_t index;
+		while((index = nextIndex.fetch_add(1)) < count)
+		{
+			pResults[index] = Load(ppPaths[index], &pModules[index]);
+
+			if(pResults[index] == NativeLoadResult::Success)
+			{
+				loadedCount.fetch_add(1);
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+
+	for(int32_t i = 1; i < threadCount; i++)
+	{
+		threads.emplace_back(worker);
+	}
+
+	// the calling thread works along.
+	worker();
+
+	for(auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	return loadedCount.load();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../Vst2400.h"
+
+// typedef for the main exported function from a plugin library
+typedef ::Vst2Plugin* (Vst2Handler* Vst2PluginMain)(::Vst2HostCallback);
+
+// Paths are passed in the native encoding of the platform loader:
+// UTF-16 for LoadLibraryW, UTF-8 for dlopen.
+#ifdef _WIN32
+typedef wchar_t NativePathChar;
+#else
+typedef char NativePathChar;
+#endif
+
+enum class NativeLoadResult
+{
+	Success,
+	// the library could not be opened (missing file or dependency).
+	LoadFailed,
+	// the file is not a library for this process (bitness or platform).
+	BadImageFormat,
+	// neither 'VSTPluginMain' nor 'main' is exported.
+	EntryPointNotFound,
+	// the entry point returned NULL.
+	PluginReturnedNull,
+	// the returned Vst2Plugin does not carry the 'VstP' magic number.
+	MagicNumberMismatch,
+};
+
+// A loaded plugin library and its resolved entry point.
+struct NativePluginModule
+{
+	void* handle;
+	Vst2PluginMain pluginMain;
+};
+
+// Loads VST2 plugin libraries and resolves and verifies their entry points.
+// Does not depend on the CLR; the same code is used by the Linux test harness.
+class NativePluginLoader
+{
+public:
+	// Opens the library at pPath and resolves 'VSTPluginMain' (or 'main').
+	// On failure pModule is cleared and no library stays loaded.
+	static NativeLoadResult Load(const NativePathChar* pPath, NativePluginModule* pModule);
+
+	// Closes the library. Does nothing when handle is NULL.
+	static void Unload(void* handle);
+
+	// Calls the entry point and validates the returned Vst2Plugin.
+	// *ppPlugin receives the plugin pointer even when the magic number does not match.
+	static NativeLoadResult CreatePlugin(Vst2PluginMain pluginMain, ::Vst2HostCallback hostCallback, ::Vst2Plugin** ppPlugin);
+
+	// Loads count libraries in parallel on up to threadCount threads (0: one per processor).
+	// pModules and pResults receive one entry per path. Loaded modules must be unloaded by the caller.
+	// Returns the number of libraries that loaded and export an entry point.
+	static int32_t Preload(const NativePathChar* const* ppPaths, int32_t count,
+		NativePluginModule* pModules, NativeLoadResult* pResults, int32_t threadCount);
+};
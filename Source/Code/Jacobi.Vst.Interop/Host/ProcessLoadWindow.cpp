@@ -0,0 +1,61 @@
+// compiled without /clr and without the precompiled header (also built by the native tests).
+#include "ProcessLoadWindow.h"
+
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+ProcessLoadWindow::ProcessLoadWindow()
+	: _deadlineThreshold(1.0f)
+{
+	Reset();
+}
+
+void ProcessLoadWindow::Record(double elapsedSeconds, float sampleRate, int32_t sampleFrames)
+{
+	// the deadline is the duration of the block that was processed.
+	if(sampleRate <= 0 || sampleFrames <= 0)
+	{
+		return;
+	}
+
+	float load = (float)(elapsedSeconds * sampleRate / sampleFrames);
+
+	_loads[_processCount % WindowSize] = load;
+	_processCount++;
+	_lastLoad = load;
+
+	if(load > _peakLoad)
+	{
+		_peakLoad = load;
+	}
+
+	if(load > _deadlineThreshold)
+	{
+		_deadlineMissCount++;
+	}
+}
+
+float ProcessLoadWindow::GetPercentile(double percentile) const
+{
+	int32_t count = (int32_t)std::min(_processCount, (int64_t)WindowSize);
+	if(count == 0)
+	{
+		return 0.0f;
+	}
+
+	std::vector<float> window(_loads, _loads + count);
+	std::sort(window.begin(), window.end());
+
+	int32_t index = (int32_t)ceil(percentile / 100.0 * count) - 1;
+
+	return window[std::max(0, std::min(index, count - 1))];
+}
+
+void ProcessLoadWindow::Reset()
+{
+	_processCount = 0;
+	_deadlineMissCount = 0;
+	_lastLoad = 0.0f;
+	_peakLoad = 0.0f;
+}
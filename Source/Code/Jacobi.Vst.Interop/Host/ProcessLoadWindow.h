@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+
+// Keeps the load of the most recent process calls (the time spent relative to the duration of the block)
+// for VstProcessLoadMeter, with the peak and the number of deadline misses since the last Reset.
+// Recorded on the audio thread without locking; readers on another thread get a (slightly stale) snapshot.
+class ProcessLoadWindow
+{
+public:
+	static const int32_t WindowSize = 1024;
+
+	ProcessLoadWindow();
+
+	// A call with a load above the threshold counts as a deadline miss. The default is 1.0.
+	float GetDeadlineThreshold() const { return _deadlineThreshold; }
+	void SetDeadlineThreshold(float threshold) { _deadlineThreshold = threshold; }
+
+	// Records a process call of sampleFrames that took elapsedSeconds.
+	// Not recorded when the sample rate or the number of frames is not known.
+	void Record(double elapsedSeconds, float sampleRate, int32_t sampleFrames);
+
+	// The load below which percentile (0-100) of the calls in the window are. 0 when nothing was recorded.
+	// Sorts a copy of the window; not for the audio thread.
+	float GetPercentile(double percentile) const;
+
+	void Reset();
+
+	int64_t GetProcessCount() const { return _processCount; }
+	int64_t GetDeadlineMissCount() const { return _deadlineMissCount; }
+	float GetLastLoad() const { return _lastLoad; }
+	float GetPeakLoad() const { return _peakLoad; }
+
+private:
+	float _loads[WindowSize];	// ring buffer
+	float _deadlineThreshold;
+	int64_t _processCount;
+	int64_t _deadlineMissCount;
+	float _lastLoad;
+	float _peakLoad;
+};
@@ -0,0 +1,84 @@
+// compiled without /clr and without the precompiled header (SSE2 intrinsics, also built by the native tests).
+#include "SilenceScan.h"
+
+#include <emmintrin.h>
+#include <math.h>
+
+namespace
+{
+	template<typename T>
+	bool AreSilent(T** ppBuffers, int32_t bufferCount, int32_t sampleCount, float threshold)
+	{
+		for(int32_t i = 0; i < bufferCount; i++)
+		{
+			if(!SilenceScan::IsSilent(ppBuffers[i], sampleCount, threshold))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+bool SilenceScan::IsSilent(const float* pBuffer, int32_t sampleCount, float threshold)
+{
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 limit = _mm_set1_ps(threshold);
+	int32_t n = 0;
+
+	for(; n + 4 <= sampleCount; n += 4)
+	{
+		__m128 value = _mm_and_ps(_mm_loadu_ps(pBuffer + n), absMask);
+		if(_mm_movemask_ps(_mm_cmpgt_ps(value, limit)) != 0)
+		{
+			return false;
+		}
+	}
+
+	for(; n < sampleCount; n++)
+	{
+		if(fabsf(pBuffer[n]) > threshold)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool SilenceScan::IsSilent(const double* pBuffer, int32_t sampleCount, float threshold)
+{
+	const __m128d absMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFF));
+	const __m128d limit = _mm_set1_pd(threshold);
+	int32_t n = 0;
+
+	for(; n + 2 <= sampleCount; n += 2)
+	{
+		__m128d value = _mm_and_pd(_mm_loadu_pd(pBuffer + n), absMask);
+		if(_mm_movemask_pd(_mm_cmpgt_pd(value, limit)) != 0)
+		{
+			return false;
+		}
+	}
+
+	for(; n < sampleCount; n++)
+	{
+		if(fabs(pBuffer[n]) > threshold)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool SilenceScan::IsSilent(float** ppBuffers, int32_t bufferCount, int32_t sampleCount, float threshold)
+{
+	return AreSilent(ppBuffers, bufferCount, sampleCount, threshold);
+}
+
+bool SilenceScan::IsSilent(double** ppBuffers, int32_t bufferCount, int32_t sampleCount, float threshold)
+{
+	return AreSilent(ppBuffers, bufferCount, sampleCount, threshold);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+
+// Scans audio buffers for silence, 4 (float) or 2 (double) samples at a time (SSE2).
+// A sample is silent when its absolute value does not exceed the threshold.
+// Implemented in SilenceScan.cpp, which is compiled without /clr so the intrinsics stay native code.
+class SilenceScan
+{
+public:
+	static bool IsSilent(const float* pBuffer, int32_t sampleCount, float threshold);
+	static bool IsSilent(const double* pBuffer, int32_t sampleCount, float threshold);
+
+	// true when all bufferCount buffers are silent (also when there are no buffers).
+	static bool IsSilent(float** ppBuffers, int32_t bufferCount, int32_t sampleCount, float threshold);
+	static bool IsSilent(double** ppBuffers, int32_t bufferCount, int32_t sampleCount, float threshold);
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// On-disk layout of the fxp (program) and fxb (bank) preset files.
+// All multi-byte values are stored big-endian.
+
+constexpr int32_t Vst2PresetChunkMagic = 'C' << 24 | 'c' << 16 | 'n' << 8 | 'K';
+constexpr int32_t Vst2PresetProgramMagic = 'F' << 24 | 'x' << 16 | 'C' << 8 | 'k';
+constexpr int32_t Vst2PresetProgramChunkMagic = 'F' << 24 | 'P' << 16 | 'C' << 8 | 'h';
+constexpr int32_t Vst2PresetBankMagic = 'F' << 24 | 'x' << 16 | 'B' << 8 | 'k';
+constexpr int32_t Vst2PresetBankChunkMagic = 'F' << 24 | 'B' << 16 | 'C' << 8 | 'h';
+
+const int32_t Vst2PresetProgramNameLen = 28;
+
+struct Vst2PresetProgramHeader
+{
+    int32_t chunkMagic;
+    int32_t byteSize;
+    int32_t fxMagic;
+    int32_t version;
+    int32_t pluginId;
+    int32_t pluginVersion;
+    int32_t parameterCount;
+    char name[Vst2PresetProgramNameLen];
+};
+
+struct Vst2PresetBankHeader
+{
+    int32_t chunkMagic;
+    int32_t byteSize;
+    int32_t fxMagic;
+    int32_t version;
+    int32_t pluginId;
+    int32_t pluginVersion;
+    int32_t programCount;
+    int32_t currentProgram;     // version 2 only
+    char future[124];
+};
+
+// the chunk size (int32) that precedes opaque chunk data.
+const int32_t Vst2PresetChunkSizeLen = sizeof(int32_t);
+
+// Swaps between big-endian (file) and native (little-endian) byte order.
+inline int32_t Vst2PresetSwap(int32_t value)
+{
+    return (int32_t)_byteswap_ulong((unsigned long)value);
+}
+
+// parameter values are swapped as bits; a float holding swapped bits could be a NaN that gets altered.
+inline uint32_t Vst2PresetSwap(uint32_t value)
+{
+    return _byteswap_ulong(value);
+}
+
+// Converts a parameter value to the big-endian bits stored in the file.
+inline uint32_t Vst2PresetFloatToFile(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return Vst2PresetSwap(bits);
+}
+
+// Converts the big-endian bits stored in the file to a parameter value.
+inline float Vst2PresetFloatFromFile(uint32_t bits)
+{
+    float value;
+    bits = Vst2PresetSwap(bits);
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// The number of bytes a single program with parameter values occupies.
+inline int64_t Vst2PresetProgramSize(int32_t parameterCount)
+{
+    return (int64_t)sizeof(Vst2PresetProgramHeader) + ((int64_t)parameterCount * sizeof(float));
+}
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "VstAudioBufferManager.h"
+#include "VstEngineThread.h"
 #include "..\Properties\Resources.h"
 
 namespace Jacobi {
@@ -40,9 +41,32 @@ namespace Interop {
 
 	VstAudioBufferManager::~VstAudioBufferManager()
 	{
+		UnlockMemory();
 		// destroys the contained UnmanagedArray.
 	}
 
+	System::Boolean VstAudioBufferManager::LockMemory()
+	{
+		if(!_isMemoryLocked)
+		{
+			size_t growth = 0;
+			_isMemoryLocked = VstEngineThread::LockMemory(_unmanagedBuffers.GetArray(), _unmanagedBuffers.GetByteLength(), &growth);
+			_workingSetGrowth = growth;
+		}
+
+		return _isMemoryLocked;
+	}
+
+	void VstAudioBufferManager::UnlockMemory()
+	{
+		if(_isMemoryLocked)
+		{
+			VstEngineThread::UnlockMemory(_unmanagedBuffers.GetArray(), _unmanagedBuffers.GetByteLength(), _workingSetGrowth);
+			_workingSetGrowth = 0;
+			_isMemoryLocked = false;
+		}
+	}
+
 	void VstAudioBufferManager::ClearBuffer(Jacobi::Vst::Core::VstAudioBuffer^ buffer)
 	{
 		Jacobi::Vst::Core::Throw::IfArgumentIsNull(buffer, "buffer");
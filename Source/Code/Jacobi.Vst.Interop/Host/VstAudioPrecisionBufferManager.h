@@ -44,11 +44,22 @@ namespace Interop {
 		/// <summary>Gets the size of a single buffer.</summary>
 		property System::Int32 BufferSize { System::Int32 get() { return _bufferSize; } }
 
+		/// <summary>Locks the unmanaged memory of all buffers into physical memory.</summary>
+		/// <returns>Returns true when the memory is locked.</returns>
+		/// <remarks>Prevents page faults on the audio thread. The memory is unlocked when the instance is disposed.</remarks>
+		System::Boolean LockMemory();
+		/// <summary>Unlocks the memory locked by <see cref="LockMemory"/>.</summary>
+		void UnlockMemory();
+		/// <summary>Gets if the unmanaged memory is locked into physical memory.</summary>
+		property System::Boolean IsMemoryLocked { System::Boolean get() { return _isMemoryLocked; } }
+
 	private:
 		System::Int32 _bufferCount;
 		System::Int32 _bufferSize;
 
 		UnmanagedArray<double> _unmanagedBuffers;
+		System::Boolean _isMemoryLocked;
+		size_t _workingSetGrowth;	// by LockMemory
 		System::Collections::Generic::List<Jacobi::Vst::Core::VstAudioPrecisionBuffer^>^ _managedBuffers;
 
 		void ClearBuffer(double* buffer, int bufferSize)
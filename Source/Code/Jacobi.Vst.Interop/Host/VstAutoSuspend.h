@@ -0,0 +1,69 @@
+#pragma once
+
+#include "AutoSuspendState.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	/// <summary>
+	/// The VstAutoSuspend class controls skipping the process calls of a plugin while its input is silent.
+	/// </summary>
+	/// <remarks>When enabled, the input buffers are scanned for silence before each process call.
+	/// Once the input has been silent for longer than the tail the plugin reports (GetTailSize),
+	/// the plugin is no longer called and its output buffers are cleared instead.
+	/// Processing resumes with the first block that has non-silent input or MIDI events.
+	/// The tail size is queried when the plugin is switched on (MainsChanged); until then <see cref="DefaultTailSize"/> is used.
+	/// A plugin without inputs is never suspended.</remarks>
+	public ref class VstAutoSuspend sealed
+	{
+	public:
+		/// <summary>Gets or sets if silent plugins are suspended. The default is false.</summary>
+		property System::Boolean Enabled
+		{
+			System::Boolean get() { return _enabled; }
+			void set(System::Boolean value) { _enabled = value; _pState->RequestResume(); }
+		}
+
+		/// <summary>Gets or sets the absolute sample value up to which input is considered silent.
+		/// The default is 0 (digital silence only).</summary>
+		property System::Single Threshold
+		{
+			System::Single get() { return _pState->GetThreshold(); }
+			void set(System::Single value) { _pState->SetThreshold(value); }
+		}
+
+		/// <summary>Gets or sets the tail (in samples) used when the plugin does not report one.</summary>
+		/// <remarks>The default is 48000.</remarks>
+		property System::Int32 DefaultTailSize
+		{
+			System::Int32 get() { return _pState->GetDefaultTailSize(); }
+			void set(System::Int32 value) { _pState->SetDefaultTailSize(value); }
+		}
+
+		/// <summary>Gets if the plugin is currently suspended and its output is silent.</summary>
+		property System::Boolean IsSuspended { System::Boolean get() { return _pState->IsSuspended(); } }
+		/// <summary>Gets the number of process calls that were skipped.</summary>
+		property System::Int64 SkippedCount { System::Int64 get() { return _pState->GetSkippedCount(); } }
+
+		/// <summary>Deletes the unmanaged state.</summary>
+		~VstAutoSuspend() { this->!VstAutoSuspend(); }
+		/// <summary>Deletes the unmanaged state.</summary>
+		!VstAutoSuspend() { delete _pState; _pState = NULL; }
+
+	internal:
+		VstAutoSuspend()
+		{
+			_pState = new AutoSuspendState();
+		}
+
+		// the state that is updated by the audio thread.
+		property AutoSuspendState* State { AutoSuspendState* get() { return _pState; } }
+
+	private:
+		bool _enabled;
+		AutoSuspendState* _pState;
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,40 @@
+#pragma once
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	/// <summary>
+	/// The VstBlockSplitter class controls splitting large process calls into blocks the plugin can handle.
+	/// </summary>
+	/// <remarks>When enabled, a process call with more samples than <see cref="MaxBlockSize"/> is passed to the
+	/// plugin as consecutive sub-blocks that point into the original buffers (no copies).
+	/// Events passed to ProcessEvents are held back until the next process call and are delivered with the
+	/// sub-block they fall in, their delta frames relative to the sub-block. The time info the plugin
+	/// requests during a sub-block is advanced by the sub-block offset.
+	/// Useful for offline rendering with large blocks.</remarks>
+	public ref class VstBlockSplitter sealed
+	{
+	public:
+		/// <summary>Gets or sets if large process calls are split. The default is false.</summary>
+		property System::Boolean Enabled;
+
+		/// <summary>Gets or sets the maximum number of samples passed to the plugin per call.</summary>
+		/// <remarks>Is set to the block size passed to the plugin (SetBlockSize), which can be overridden afterwards.
+		/// Zero does not split.</remarks>
+		property System::Int32 MaxBlockSize;
+
+		/// <summary>Gets the number of process calls that were split.</summary>
+		property System::Int64 SplitCount { System::Int64 get() { return _splitCount; } }
+
+	internal:
+		VstBlockSplitter() {}
+
+		void IncrementSplitCount() { _splitCount++; }
+
+	private:
+		int64_t _splitCount;
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,478 @@
+// compiled without /clr and without the precompiled header (uses <mutex> and <chrono>).
+#include "VstCallLog.h"
+
+#include <chrono>
+#include <mutex>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+	// large enough to keep file writes off most process calls.
+	const size_t FileBufferSize = 1024 * 1024;
+
+	inline uint32_t Padding(size_t size)
+	{
+		return (uint32_t)((8 - (size & 7)) & 7);
+	}
+
+	FILE* OpenFile(const NativePathChar* pPath, bool write)
+	{
+#ifdef _WIN32
+		FILE* pFile = NULL;
+		return ::_wfopen_s(&pFile, pPath, write ? L"wb" : L"rb") == 0 ? pFile : NULL;
+#else
+		return ::fopen(pPath, write ? "wb" : "rb");
+#endif
+	}
+
+	// Vst2SpeakerArrangement declares 8 speakers; larger arrangements extend past the struct.
+	uint32_t GetArrangementSize(const ::Vst2SpeakerArrangement* pArrangement)
+	{
+		int32_t channelCount = pArrangement->channelCount > 0 ? pArrangement->channelCount : 0;
+		return (uint32_t)(offsetof(::Vst2SpeakerArrangement, speakers) + channelCount * sizeof(::Vst2SpeakerProperties));
+	}
+}
+
+struct VstCallLogWriter::State
+{
+	FILE* pFile;
+	std::mutex lock;
+	std::chrono::steady_clock::time_point startTime;
+	// the record that is being written (reused).
+	std::vector<uint8_t> record;
+};
+
+VstCallLogWriter::VstCallLogWriter()
+	: _pState(new State()), _isOpen(false), _recordCount(0)
+{
+	_pState->pFile = NULL;
+}
+
+VstCallLogWriter::~VstCallLogWriter()
+{
+	Close();
+	delete _pState;
+}
+
+bool VstCallLogWriter::Open(const NativePathChar* pPath, const ::Vst2Plugin* pPlugin)
+{
+	Close();
+
+	FILE* pFile = OpenFile(pPath, true);
+
+	if(pFile == NULL)
+	{
+		return false;
+	}
+
+	::setvbuf(pFile, NULL, _IOFBF, FileBufferSize);
+
+	VstCallLogHeader header = {};
+	header.magic = VstCallLogMagic;
+	header.version = VstCallLogVersion;
+	header.pointerSize = (uint16_t)sizeof(void*);
+	header.pluginId = pPlugin->id;
+	header.pluginVersion = pPlugin->version;
+	header.inputCount = pPlugin->inputCount;
+	header.outputCount = pPlugin->outputCount;
+	header.flags = (int32_t)pPlugin->flags;
+
+	if(::fwrite(&header, sizeof(header), 1, pFile) != 1)
+	{
+		::fclose(pFile);
+		return false;
+	}
+
+	std::lock_guard<std::mutex> guard(_pState->lock);
+	_pState->pFile = pFile;
+	_pState->startTime = std::chrono::steady_clock::now();
+	_recordCount = 0;
+	_isOpen = true;
+	return true;
+}
+
+void VstCallLogWriter::Close()
+{
+	std::lock_guard<std::mutex> guard(_pState->lock);
+
+	if(_pState->pFile != NULL)
+	{
+		::fclose(_pState->pFile);
+		_pState->pFile = NULL;
+	}
+
+	_isOpen = false;
+}
+
+VstCallLogData VstCallLogWriter::GetDataKind(Vst2PluginCommands command)
+{
+	switch(command)
+	{
+	case Vst2PluginCommands::ProgramSetName:
+	case Vst2PluginCommands::ParameterFromString:
+	case Vst2PluginCommands::CanDo:
+		return VstCallLogData::String;
+	case Vst2PluginCommands::ChunkSet:
+		return VstCallLogData::Bytes;
+	case Vst2PluginCommands::MidiProgramGetName:
+	case Vst2PluginCommands::MidiProgramGetCurrent:
+	case Vst2PluginCommands::MidiProgramGetCategory:
+	case Vst2PluginCommands::MidiKeyGetName:
+	case Vst2PluginCommands::BeginLoadBank:
+	case Vst2PluginCommands::BeginLoadProgram:
+		return VstCallLogData::Struct;
+	case Vst2PluginCommands::ProcessEvents:
+		return VstCallLogData::Events;
+	case Vst2PluginCommands::SetSpeakerArrangement:
+		return VstCallLogData::SpeakerArrangements;
+	case Vst2PluginCommands::ProgramGetName:
+	case Vst2PluginCommands::ParameterGetLabel:
+	case Vst2PluginCommands::ParameterGetDisplay:
+	case Vst2PluginCommands::ParameterGetName:
+	case Vst2PluginCommands::EditorGetRectangle:
+	case Vst2PluginCommands::ChunkGet:
+	case Vst2PluginCommands::ProgramGetNameByIndex:
+	case Vst2PluginCommands::GetInputProperties:
+	case Vst2PluginCommands::GetOutputProperties:
+	case Vst2PluginCommands::PluginGetName:
+	case Vst2PluginCommands::GetErrorText:
+	case Vst2PluginCommands::VendorGetString:
+	case Vst2PluginCommands::ProductGetString:
+	case Vst2PluginCommands::ParameterGetProperties:
+	case Vst2PluginCommands::GetNextPlugin:
+		return VstCallLogData::Output;
+	case Vst2PluginCommands::GetSpeakerArrangement:
+		return VstCallLogData::SpeakerArrangementOutput;
+	// there is no editor window (or offline processing) during a replay.
+	case Vst2PluginCommands::EditorOpen:
+	case Vst2PluginCommands::EditorClose:
+	case Vst2PluginCommands::EditorDraw:
+	case Vst2PluginCommands::EditorMouse:
+	case Vst2PluginCommands::EditorKey:
+	case Vst2PluginCommands::EditorIdle:
+	case Vst2PluginCommands::EditorTop:
+	case Vst2PluginCommands::EditorSleep:
+	case Vst2PluginCommands::EditorKeyDown:
+	case Vst2PluginCommands::EditorKeyUp:
+	case Vst2PluginCommands::SetViewPosition:
+	case Vst2PluginCommands::GetDestinationBuffer:
+	case Vst2PluginCommands::OfflineNotify:
+	case Vst2PluginCommands::OfflinePrepare:
+	case Vst2PluginCommands::OfflineRun:
+	case Vst2PluginCommands::ProcessVariableIo:
+	case Vst2PluginCommands::VendorSpecific:
+	case Vst2PluginCommands::GetIcon:
+		return VstCallLogData::NotReplayable;
+	default:
+		return VstCallLogData::None;
+	}
+}
+
+uint32_t VstCallLogWriter::GetStructSize(Vst2PluginCommands command)
+{
+	switch(command)
+	{
+	case Vst2PluginCommands::MidiProgramGetName:
+	case Vst2PluginCommands::MidiProgramGetCurrent:
+		return sizeof(::Vst2MidiProgramName);
+	case Vst2PluginCommands::MidiProgramGetCategory:
+		return sizeof(::Vst2MidiProgramCategory);
+	case Vst2PluginCommands::MidiKeyGetName:
+		return sizeof(::Vst2MidiKeyName);
+	case Vst2PluginCommands::BeginLoadBank:
+	case Vst2PluginCommands::BeginLoadProgram:
+		return sizeof(::Vst2PatchChunkInfo);
+	default:
+		return 0;
+	}
+}
+
+void VstCallLogWriter::Append(const void* pData, size_t size)
+{
+	auto pBytes = (const uint8_t*)pData;
+	_pState->record.insert(_pState->record.end(), pBytes, pBytes + size);
+}
+
+void VstCallLogWriter::AppendPadding()
+{
+	_pState->record.resize(_pState->record.size() + Padding(_pState->record.size()));
+}
+
+void VstCallLogWriter::BeginRecord(VstCallLogRecordKind kind)
+{
+	auto elapsed = std::chrono::steady_clock::now() - _pState->startTime;
+
+	VstCallLogRecord record = {};
+	record.kind = kind;
+	record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+	_pState->record.clear();
+	Append(&record, sizeof(record));
+}
+
+void VstCallLogWriter::EndRecord()
+{
+	AppendPadding();
+
+	auto pRecord = (VstCallLogRecord*)_pState->record.data();
+	pRecord->payloadSize = (uint32_t)(_pState->record.size() - sizeof(VstCallLogRecord));
+
+	if(::fwrite(_pState->record.data(), _pState->record.size(), 1, _pState->pFile) == 1)
+	{
+		_recordCount++;
+	}
+}
+
+void VstCallLogWriter::WriteDispatch(Vst2PluginCommands command, int32_t index, Vst2IntPtr value, const void* ptr, float opt)
+{
+	std::lock_guard<std::mutex> guard(_pState->lock);
+
+	if(_pState->pFile == NULL)
+	{
+		return;
+	}
+
+	VstCallLogData data = GetDataKind(command);
+
+	if(ptr == NULL && data != VstCallLogData::SpeakerArrangements && data != VstCallLogData::NotReplayable)
+	{
+		data = VstCallLogData::None;
+	}
+	else if(data == VstCallLogData::None && ptr != NULL)
+	{
+		// an opcode this version does not know.
+		data = VstCallLogData::NotReplayable;
+	}
+
+	BeginRecord(VstCallLogRecordKind::Dispatch);
+
+	VstCallLogDispatch dispatch = {};
+	dispatch.command = (int32_t)command;
+	dispatch.index = index;
+	dispatch.value = value;
+	dispatch.opt = opt;
+	dispatch.data = data;
+	size_t dispatchOffset = _pState->record.size();
+	Append(&dispatch, sizeof(dispatch));
+
+	switch(data)
+	{
+	case VstCallLogData::String:
+		Append(ptr, strlen((const char*)ptr) + 1);
+		break;
+	case VstCallLogData::Bytes:
+		if(value > 0)
+		{
+			Append(ptr, (size_t)value);
+		}
+		break;
+	case VstCallLogData::Struct:
+		Append(ptr, GetStructSize(command));
+		break;
+	case VstCallLogData::Events:
+	{
+		auto pEvents = (const ::Vst2Events*)ptr;
+		VstCallLogBlock count = { (uint32_t)(pEvents->eventCount > 0 ? pEvents->eventCount : 0), 1 };
+		Append(&count, sizeof(count));
+
+		for(uint32_t i = 0; i < count.size; i++)
+		{
+			const ::Vst2Event* pEvent = pEvents->events[i];
+
+			VstCallLogEvent event = {};
+			event.kind = (int32_t)pEvent->kind;
+			event.sizeInBytes = pEvent->sizeInBytes;
+			event.deltaFrames = pEvent->deltaFrames;
+			event.flags = pEvent->flags;
+
+			if(pEvent->kind == Vst2EventKind::SystemExclusive)
+			{
+				auto pSysEx = (const ::Vst2MidiSysExEvent*)pEvent;
+				event.dumpSize = pSysEx->dump != NULL && pSysEx->dumpInBytes > 0 ? pSysEx->dumpInBytes : 0;
+				Append(&event, sizeof(event));
+				Append(pSysEx->dump, event.dumpSize);
+				AppendPadding();
+			}
+			else
+			{
+				memcpy(event.data, pEvent->data, sizeof(event.data));
+				Append(&event, sizeof(event));
+			}
+		}
+		break;
+	}
+	case VstCallLogData::SpeakerArrangements:
+	{
+		const ::Vst2SpeakerArrangement* arrangements[] = { (const ::Vst2SpeakerArrangement*)value, (const ::Vst2SpeakerArrangement*)ptr };
+
+		for(auto pArrangement : arrangements)
+		{
+			VstCallLogBlock block = {};
+			if(pArrangement != NULL)
+			{
+				block.size = GetArrangementSize(pArrangement);
+				block.isPresent = 1;
+			}
+
+			Append(&block, sizeof(block));
+			Append(pArrangement, block.size);
+			AppendPadding();
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	auto pDispatch = (VstCallLogDispatch*)(_pState->record.data() + dispatchOffset);
+	pDispatch->dataSize = (uint32_t)(_pState->record.size() - dispatchOffset - sizeof(VstCallLogDispatch));
+
+	EndRecord();
+}
+
+template<typename T>
+void VstCallLogWriter::WriteProcessRecord(VstCallLogRecordKind kind, const T* const* ppInputs, int32_t inputCount, int32_t outputCount, int32_t inputFrames, int32_t outputFrames)
+{
+	std::lock_guard<std::mutex> guard(_pState->lock);
+
+	if(_pState->pFile == NULL)
+	{
+		return;
+	}
+
+	BeginRecord(kind);
+
+	VstCallLogProcess process = { inputCount, outputCount, inputFrames, outputFrames };
+	Append(&process, sizeof(process));
+
+	for(int32_t i = 0; i < inputCount; i++)
+	{
+		Append(ppInputs[i], inputFrames * sizeof(T));
+	}
+
+	EndRecord();
+}
+
+void VstCallLogWriter::WriteProcess(const float* const* ppInputs, int32_t inputCount, int32_t outputCount, int32_t sampleFrames, bool accumulating)
+{
+	WriteProcessRecord(accumulating ? VstCallLogRecordKind::ProcessAccumulating : VstCallLogRecordKind::Process32,
+		ppInputs, inputCount, outputCount, sampleFrames, sampleFrames);
+}
+
+void VstCallLogWriter::WriteProcess(const double* const* ppInputs, int32_t inputCount, int32_t outputCount, int32_t sampleFrames)
+{
+	WriteProcessRecord(VstCallLogRecordKind::Process64, ppInputs, inputCount, outputCount, sampleFrames, sampleFrames);
+}
+
+void VstCallLogWriter::WriteProcessVariableIo(const ::Vst2VariableIo* pVarIo, int32_t inputCount, int32_t outputCount)
+{
+	WriteProcessRecord(VstCallLogRecordKind::ProcessVariableIo, (const float* const*)pVarIo->inputs,
+		inputCount, outputCount, pVarIo->sampleInputCount, pVarIo->sampleOutputCount);
+}
+
+void VstCallLogWriter::WriteSetParameter(int32_t index, float value)
+{
+	std::lock_guard<std::mutex> guard(_pState->lock);
+
+	if(_pState->pFile == NULL)
+	{
+		return;
+	}
+
+	BeginRecord(VstCallLogRecordKind::SetParameter);
+	VstCallLogParameter parameter = { index, value };
+	Append(&parameter, sizeof(parameter));
+	EndRecord();
+}
+
+void VstCallLogWriter::WriteGetParameter(int32_t index)
+{
+	std::lock_guard<std::mutex> guard(_pState->lock);
+
+	if(_pState->pFile == NULL)
+	{
+		return;
+	}
+
+	BeginRecord(VstCallLogRecordKind::GetParameter);
+	VstCallLogParameter parameter = { index, 0 };
+	Append(&parameter, sizeof(parameter));
+	EndRecord();
+}
+
+VstCallLogReader::VstCallLogReader()
+	: _position(0), _header()
+{
+}
+
+bool VstCallLogReader::Open(const NativePathChar* pPath)
+{
+	_data.clear();
+
+	FILE* pFile = OpenFile(pPath, false);
+
+	if(pFile == NULL)
+	{
+		return false;
+	}
+
+	uint8_t buffer[64 * 1024];
+	size_t count;
+
+	while((count = ::fread(buffer, 1, sizeof(buffer), pFile)) > 0)
+	{
+		_data.insert(_data.end(), buffer, buffer + count);
+	}
+
+	::fclose(pFile);
+
+	return ReadHeader();
+}
+
+bool VstCallLogReader::Open(const uint8_t* pData, size_t size)
+{
+	_data.assign(pData, pData + size);
+
+	return ReadHeader();
+}
+
+bool VstCallLogReader::ReadHeader()
+{
+	if(_data.size() < sizeof(VstCallLogHeader))
+	{
+		return false;
+	}
+
+	memcpy(&_header, _data.data(), sizeof(_header));
+
+	if(_header.magic != VstCallLogMagic || _header.version != VstCallLogVersion ||
+		_header.pointerSize != sizeof(void*))
+	{
+		return false;
+	}
+
+	Rewind();
+	return true;
+}
+
+bool VstCallLogReader::Next(const VstCallLogRecord** ppRecord, const uint8_t** ppPayload)
+{
+	if(_position + sizeof(VstCallLogRecord) > _data.size())
+	{
+		return false;
+	}
+
+	auto pRecord = (const VstCallLogRecord*)(_data.data() + _position);
+
+	if(pRecord->payloadSize > _data.size() - _position - sizeof(VstCallLogRecord))
+	{
+		return false;
+	}
+
+	*ppRecord = pRecord;
+	*ppPayload = _data.data() + _position + sizeof(VstCallLogRecord);
+	_position += sizeof(VstCallLogRecord) + pRecord->payloadSize;
+	return true;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "NativePluginLoader.h"
+
+#include <stddef.h>
+#include <vector>
+
+// A call log holds the calls a host made into a VST2 plugin, in the order the plugin received them.
+// The layout uses the byte order and pointer size of the recording machine:
+//   VstCallLogHeader
+//   VstCallLogRecord followed by payloadSize bytes (a multiple of 8), repeated.
+// A log that was cut short (the host crashed) is read up to the last complete record.
+
+const uint32_t VstCallLogMagic = 'V' | 'N' << 8 | 'C' << 16 | 'L' << 24;
+const uint16_t VstCallLogVersion = 1;
+
+struct VstCallLogHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	// sizeof(void*) of the recording process.
+	uint16_t pointerSize;
+	// the plugin's id, version and channel counts when recording started.
+	int32_t pluginId;
+	int32_t pluginVersion;
+	int32_t inputCount;
+	int32_t outputCount;
+	int32_t flags;
+	int32_t reserved;
+};
+
+enum class VstCallLogRecordKind : uint8_t
+{
+	Dispatch = 1,
+	Process32,
+	Process64,
+	ProcessAccumulating,
+	ProcessVariableIo,
+	SetParameter,
+	GetParameter,
+};
+
+struct VstCallLogRecord
+{
+	VstCallLogRecordKind kind;
+	uint8_t reserved[3];
+	uint32_t payloadSize;
+	// nanoseconds since recording started, taken when the call was made.
+	int64_t time;
+};
+
+// How the ptr (and value) argument of a dispatcher call is stored.
+enum class VstCallLogData : uint32_t
+{
+	// ptr is not used.
+	None,
+	// a zero terminated input string.
+	String,
+	// value bytes (ChunkSet).
+	Bytes,
+	// a fixed size in/out structure.
+	Struct,
+	// a Vst2Events list: a VstCallLogBlock (size is the event count) and a VstCallLogEvent per event.
+	Events,
+	// the input (value) and output (ptr) arrangement: a VstCallLogBlock for each.
+	SpeakerArrangements,
+	// ptr is an output buffer. Replayed with a cleared buffer.
+	Output,
+	// value and ptr receive pointers to the plugin's arrangements.
+	SpeakerArrangementOutput,
+	// editor and offline calls, or ptr refers to unknown data. Not replayed.
+	NotReplayable,
+};
+
+// payload of a Dispatch record, followed by dataSize bytes (padded to 8).
+struct VstCallLogDispatch
+{
+	int32_t command;
+	int32_t index;
+	int64_t value;
+	float opt;
+	VstCallLogData data;
+	uint32_t dataSize;
+	uint32_t reserved;
+};
+
+// a variable size block inside the dispatch data, followed by size bytes (padded to 8).
+struct VstCallLogBlock
+{
+	uint32_t size;
+	// 0 when the pointer was NULL.
+	uint32_t isPresent;
+};
+
+// one event inside the dispatch data. SysEx events are followed by dumpSize bytes (padded to 8).
+struct VstCallLogEvent
+{
+	int32_t kind;
+	int32_t sizeInBytes;
+	int32_t deltaFrames;
+	int32_t flags;
+	uint8_t data[16];
+	uint32_t dumpSize;
+	uint32_t reserved;
+};
+
+// payload of the process records, followed by inputCount * inputFrames samples (float or double), channel by channel.
+struct VstCallLogProcess
+{
+	int32_t inputCount;
+	int32_t outputCount;
+	int32_t inputFrames;
+	// only differs from inputFrames for ProcessVariableIo.
+	int32_t outputFrames;
+};
+
+// payload of the parameter records.
+struct VstCallLogParameter
+{
+	int32_t index;
+	float value;
+};
+
+// Writes a call log. The Write methods may be called from several threads (editor and audio).
+// Not real-time safe: a Write call holds a lock shared by all threads while it builds the record
+// (which may allocate) and writes it to the file, on the calling thread.
+// Does not depend on the CLR; the same code is used by the Linux test harness.
+class VstCallLogWriter
+{
+public:
+	VstCallLogWriter();
+	~VstCallLogWriter();
+
+	// Creates (or overwrites) the file at pPath and writes the header for pPlugin.
+	bool Open(const NativePathChar* pPath, const ::Vst2Plugin* pPlugin);
+	// Flushes and closes the file. Calls made afterwards are not recorded.
+	void Close();
+
+	bool IsOpen() const { return _isOpen; }
+	int64_t GetRecordCount() const { return _recordCount; }
+
+	void WriteDispatch(Vst2PluginCommands command, int32_t index, Vst2IntPtr value, const void* ptr, float opt);
+	void WriteProcess(const float* const* ppInputs, int32_t inputCount, int32_t outputCount, int32_t sampleFrames, bool accumulating);
+	void WriteProcess(const double* const* ppInputs, int32_t inputCount, int32_t outputCount, int32_t sampleFrames);
+	void WriteProcessVariableIo(const ::Vst2VariableIo* pVarIo, int32_t inputCount, int32_t outputCount);
+	void WriteSetParameter(int32_t index, float value);
+	void WriteGetParameter(int32_t index);
+
+	// Returns how the ptr argument of the command is stored (when it is not NULL).
+	static VstCallLogData GetDataKind(Vst2PluginCommands command);
+	// Returns the size of the structure ptr refers to for VstCallLogData::Struct commands.
+	static uint32_t GetStructSize(Vst2PluginCommands command);
+
+private:
+	// the file, the lock and the record buffer live in the .cpp (no <mutex> under /clr).
+	struct State;
+	State* _pState;
+
+	bool _isOpen;
+	int64_t _recordCount;
+
+	void Append(const void* pData, size_t size);
+	void AppendPadding();
+	void BeginRecord(VstCallLogRecordKind kind);
+	void EndRecord();
+
+	template<typename T>
+	void WriteProcessRecord(VstCallLogRecordKind kind, const T* const* ppInputs, int32_t inputCount, int32_t outputCount, int32_t inputFrames, int32_t outputFrames);
+};
+
+// Reads a call log into memory and iterates its records.
+class VstCallLogReader
+{
+public:
+	VstCallLogReader();
+
+	// Reads the file at pPath. Returns false when it cannot be read or is not a call log.
+	bool Open(const NativePathChar* pPath);
+	// Copies a log from memory.
+	bool Open(const uint8_t* pData, size_t size);
+
+	const VstCallLogHeader& GetHeader() const { return _header; }
+
+	// Moves to the next record. Returns false at the end of the log or on a truncated record.
+	bool Next(const VstCallLogRecord** ppRecord, const uint8_t** ppPayload);
+	// Moves back to the first record.
+	void Rewind() { _position = sizeof(VstCallLogHeader); }
+
+private:
+	std::vector<uint8_t> _data;
+	size_t _position;
+	VstCallLogHeader _header;
+
+	bool ReadHeader();
+};
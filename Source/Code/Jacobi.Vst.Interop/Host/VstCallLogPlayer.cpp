@@ -0,0 +1,332 @@
+// compiled without /clr and without the precompiled header (uses <chrono> and <thread>).
+#include "VstCallLogPlayer.h"
+
+#include <chrono>
+#include <thread>
+#include <string.h>
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	// large enough for any structure a VST2 output pointer refers to.
+	const size_t ScratchSize = 4096;
+	// each event is rebuilt in a slot that fits the largest event structure.
+	const size_t EventSlotSize = sizeof(::Vst2MidiSysExEvent) > sizeof(::Vst2Event) ? sizeof(::Vst2MidiSysExEvent) : sizeof(::Vst2Event);
+
+	inline uint32_t Padded(uint32_t size)
+	{
+		return (size + 7) & ~7u;
+	}
+
+	inline int64_t ElapsedNanoseconds(Clock::time_point startTime)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count();
+	}
+
+	// sleeps until shortly before the time and spins for the rest: sleeps are not precise enough.
+	void WaitUntil(Clock::time_point startTime, int64_t time)
+	{
+		auto target = startTime + std::chrono::nanoseconds(time);
+		auto sleepTarget = target - std::chrono::milliseconds(2);
+
+		if(Clock::now() < sleepTarget)
+		{
+			std::this_thread::sleep_until(sleepTarget);
+		}
+
+		while(Clock::now() < target)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// returns size cleared bytes; the buffer only grows.
+	void* Allocate(std::vector<uint64_t>& buffer, size_t size)
+	{
+		buffer.assign((size + 7) / 8 + 1, 0);
+		return buffer.data();
+	}
+}
+
+void VstCallLogPlayer::Play(VstCallLogReader& reader, ::Vst2Plugin* pPlugin, VstCallLogTiming timing, VstCallLogStats* pStats)
+{
+	pStats->dispatchCount = 0;
+	pStats->processCount = 0;
+	pStats->parameterCount = 0;
+	pStats->skippedCount = 0;
+	pStats->processNanoseconds.clear();
+
+	const VstCallLogRecord* pRecord;
+	const uint8_t* pPayload;
+	auto startTime = Clock::now();
+
+	while(reader.Next(&pRecord, &pPayload))
+	{
+		if(timing == VstCallLogTiming::Recorded)
+		{
+			WaitUntil(startTime, pRecord->time);
+		}
+
+		switch(pRecord->kind)
+		{
+		case VstCallLogRecordKind::Dispatch:
+			if(Dispatch(pPlugin, pPayload))
+			{
+				pStats->dispatchCount++;
+			}
+			else
+			{
+				pStats->skippedCount++;
+			}
+			break;
+		case VstCallLogRecordKind::Process32:
+		case VstCallLogRecordKind::Process64:
+		case VstCallLogRecordKind::ProcessAccumulating:
+		case VstCallLogRecordKind::ProcessVariableIo:
+		{
+			int64_t nanoseconds = Process(pPlugin, pRecord->kind, pPayload);
+			if(nanoseconds >= 0)
+			{
+				pStats->processNanoseconds.push_back(nanoseconds);
+				pStats->processCount++;
+			}
+			else
+			{
+				pStats->skippedCount++;
+			}
+			break;
+		}
+		case VstCallLogRecordKind::SetParameter:
+		{
+			auto pParameter = (const VstCallLogParameter*)pPayload;
+			if(pPlugin->parameterSet != NULL)
+			{
+				pPlugin->parameterSet(pPlugin, pParameter->index, pParameter->value);
+			}
+			pStats->parameterCount++;
+			break;
+		}
+		case VstCallLogRecordKind::GetParameter:
+		{
+			auto pParameter = (const VstCallLogParameter*)pPayload;
+			if(pPlugin->parameterGet != NULL)
+			{
+				pPlugin->parameterGet(pPlugin, pParameter->index);
+			}
+			pStats->parameterCount++;
+			break;
+		}
+		default:
+			pStats->skippedCount++;
+			break;
+		}
+	}
+
+	pStats->durationNanoseconds = ElapsedNanoseconds(startTime);
+}
+
+bool VstCallLogPlayer::Dispatch(::Vst2Plugin* pPlugin, const uint8_t* pPayload)
+{
+	auto pDispatch = (const VstCallLogDispatch*)pPayload;
+	const uint8_t* pData = pPayload + sizeof(VstCallLogDispatch);
+	auto command = (Vst2PluginCommands)pDispatch->command;
+
+	// the caller owns the plugin: it is already open and is closed by the caller.
+	if(pPlugin->command == NULL || command == Vst2PluginCommands::Open || command == Vst2PluginCommands::Close)
+	{
+		return false;
+	}
+
+	Vst2IntPtr value = (Vst2IntPtr)pDispatch->value;
+	void* ptr = NULL;
+	void* arrangements[2] = { NULL, NULL };
+
+	switch(pDispatch->data)
+	{
+	case VstCallLogData::None:
+		break;
+	case VstCallLogData::String:
+	case VstCallLogData::Bytes:
+		// the log stays in memory during the replay (plugins may hold on to chunk data).
+		ptr = (void*)pData;
+		break;
+	case VstCallLogData::Struct:
+		ptr = Allocate(_scratch, pDispatch->dataSize);
+		memcpy(ptr, pData, pDispatch->dataSize);
+		break;
+	case VstCallLogData::Output:
+		ptr = Allocate(_scratch, ScratchSize);
+		break;
+	case VstCallLogData::Events:
+	{
+		auto pCount = (const VstCallLogBlock*)pData;
+		const uint8_t* pNext = pData + sizeof(VstCallLogBlock);
+
+		auto pEvents = (::Vst2Events*)Allocate(_eventList, sizeof(::Vst2Events) + pCount->size * sizeof(::Vst2Event*));
+		auto pSlots = (uint8_t*)Allocate(_events, pCount->size * EventSlotSize);
+		pEvents->eventCount = (int32_t)pCount->size;
+
+		for(uint32_t i = 0; i < pCount->size; i++)
+		{
+			auto pLogEvent = (const VstCallLogEvent*)pNext;
+			pNext += sizeof(VstCallLogEvent);
+
+			auto pEvent = (::Vst2Event*)(pSlots + i * EventSlotSize);
+			pEvent->kind = (Vst2EventKind)pLogEvent->kind;
+			pEvent->sizeInBytes = pLogEvent->sizeInBytes;
+			pEvent->deltaFrames = pLogEvent->deltaFrames;
+			pEvent->flags = pLogEvent->flags;
+
+			if(pEvent->kind == Vst2EventKind::SystemExclusive)
+			{
+				auto pSysEx = (::Vst2MidiSysExEvent*)pEvent;
+				pSysEx->dumpInBytes = (int32_t)pLogEvent->dumpSize;
+				pSysEx->dump = (char*)pNext;
+				pNext += Padded(pLogEvent->dumpSize);
+			}
+			else
+			{
+				memcpy(pEvent->data, pLogEvent->data, sizeof(pEvent->data));
+			}
+
+			pEvents->events[i] = pEvent;
+		}
+
+		ptr = pEvents;
+		break;
+	}
+	case VstCallLogData::SpeakerArrangements:
+	{
+		const uint8_t* pNext = pData;
+
+		for(int i = 0; i < 2; i++)
+		{
+			auto pBlock = (const VstCallLogBlock*)pNext;
+			pNext += sizeof(VstCallLogBlock);
+
+			if(pBlock->isPresent)
+			{
+				// plugins may read all 8 speakers of the declared structure.
+				size_t size = pBlock->size > sizeof(::Vst2SpeakerArrangement) ? pBlock->size : sizeof(::Vst2SpeakerArrangement);
+				arrangements[i] = Allocate(_arrangements[i], size);
+				memcpy(arrangements[i], pNext, pBlock->size);
+			}
+
+			pNext += Padded(pBlock->size);
+		}
+
+		value = (Vst2IntPtr)arrangements[0];
+		ptr = arrangements[1];
+		break;
+	}
+	case VstCallLogData::SpeakerArrangementOutput:
+		value = (Vst2IntPtr)&arrangements[0];
+		ptr = &arrangements[1];
+		break;
+	default:
+		return false;
+	}
+
+	pPlugin->command(pPlugin, command, pDispatch->index, value, ptr, pDispatch->opt);
+	return true;
+}
+
+template<typename T>
+void VstCallLogPlayer::PrepareBuffers(const VstCallLogProcess* pProcess, const uint8_t* pSamples, int32_t inputCount, int32_t outputCount,
+	std::vector<T>& samples, std::vector<T*>& pointers)
+{
+	size_t recordedSize = (size_t)pProcess->inputCount * pProcess->inputFrames;
+	size_t inputSize = (size_t)inputCount * pProcess->inputFrames;
+	size_t outputSize = (size_t)outputCount * pProcess->outputFrames;
+
+	// the outputs and any channels the plugin has in addition to the recorded ones are silent.
+	samples.assign(inputSize + outputSize + 1, 0);
+	memcpy(samples.data(), pSamples, recordedSize * sizeof(T));
+
+	pointers.resize(inputCount + outputCount + 1);
+
+	for(int32_t i = 0; i < inputCount; i++)
+	{
+		pointers[i] = samples.data() + i * pProcess->inputFrames;
+	}
+	for(int32_t i = 0; i < outputCount; i++)
+	{
+		pointers[inputCount + i] = samples.data() + inputSize + i * pProcess->outputFrames;
+	}
+}
+
+int64_t VstCallLogPlayer::Process(::Vst2Plugin* pPlugin, VstCallLogRecordKind kind, const uint8_t* pPayload)
+{
+	auto pProcess = (const VstCallLogProcess*)pPayload;
+	const uint8_t* pSamples = pPayload + sizeof(VstCallLogProcess);
+
+	// a newer version of the plugin may have more channels than were recorded.
+	int32_t inputCount = pProcess->inputCount > pPlugin->inputCount ? pProcess->inputCount : pPlugin->inputCount;
+	int32_t outputCount = pProcess->outputCount > pPlugin->outputCount ? pProcess->outputCount : pPlugin->outputCount;
+
+	Clock::time_point startTime;
+
+	switch(kind)
+	{
+	case VstCallLogRecordKind::Process64:
+	{
+		if(pPlugin->replaceDouble == NULL)
+		{
+			return -1;
+		}
+
+		PrepareBuffers(pProcess, pSamples, inputCount, outputCount, _samples64, _buffers64);
+		double** ppBuffers = _buffers64.data();
+
+		startTime = Clock::now();
+		pPlugin->replaceDouble(pPlugin, ppBuffers, ppBuffers + inputCount, pProcess->inputFrames);
+		break;
+	}
+	case VstCallLogRecordKind::Process32:
+	case VstCallLogRecordKind::ProcessAccumulating:
+	{
+		Vst2PluginProcess process = kind == VstCallLogRecordKind::Process32 ? pPlugin->replace : pPlugin->process;
+
+		if(process == NULL)
+		{
+			return -1;
+		}
+
+		PrepareBuffers(pProcess, pSamples, inputCount, outputCount, _samples32, _buffers32);
+		float** ppBuffers = _buffers32.data();
+
+		startTime = Clock::now();
+		process(pPlugin, ppBuffers, ppBuffers + inputCount, pProcess->inputFrames);
+		break;
+	}
+	case VstCallLogRecordKind::ProcessVariableIo:
+	{
+		if(pPlugin->command == NULL)
+		{
+			return -1;
+		}
+
+		PrepareBuffers(pProcess, pSamples, inputCount, outputCount, _samples32, _buffers32);
+
+		int32_t inputProcessed = 0;
+		int32_t outputProcessed = 0;
+
+		::Vst2VariableIo varIo;
+		varIo.inputs = _buffers32.data();
+		varIo.outputs = _buffers32.data() + inputCount;
+		varIo.sampleInputCount = pProcess->inputFrames;
+		varIo.sampleOutputCount = pProcess->outputFrames;
+		varIo.sampleInputProcessedCount = &inputProcessed;
+		varIo.sampleOutputProcessedCount = &outputProcessed;
+
+		startTime = Clock::now();
+		pPlugin->command(pPlugin, Vst2PluginCommands::ProcessVariableIo, 0, 0, &varIo, 0);
+		break;
+	}
+	default:
+		return -1;
+	}
+
+	return ElapsedNanoseconds(startTime);
+}
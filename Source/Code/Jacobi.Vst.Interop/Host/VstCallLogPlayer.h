@@ -0,0 +1,56 @@
+#pragma once
+
+#include "VstCallLog.h"
+
+enum class VstCallLogTiming
+{
+	// each call is made at the time it was recorded (relative to the start).
+	Recorded,
+	// the calls follow each other without waiting.
+	AsFastAsPossible,
+};
+
+struct VstCallLogStats
+{
+	int64_t dispatchCount;
+	int64_t processCount;
+	int64_t parameterCount;
+	// records that were not replayed (editor calls).
+	int64_t skippedCount;
+	// the duration of the complete replay.
+	int64_t durationNanoseconds;
+	// the duration of each process call, in replay order.
+	std::vector<int64_t> processNanoseconds;
+};
+
+// Replays a call log on a plugin. Process calls get copies of the recorded input audio
+// and cleared output buffers; data that was returned by the plugin is not compared.
+// Open and Close are not replayed: the caller owns the (opened) plugin.
+// Does not depend on the CLR; the same code is used by the Linux test harness.
+class VstCallLogPlayer
+{
+public:
+	// Calls pPlugin for each record of the reader (from its current position) and fills pStats.
+	void Play(VstCallLogReader& reader, ::Vst2Plugin* pPlugin, VstCallLogTiming timing, VstCallLogStats* pStats);
+
+private:
+	bool Dispatch(::Vst2Plugin* pPlugin, const uint8_t* pPayload);
+	int64_t Process(::Vst2Plugin* pPlugin, VstCallLogRecordKind kind, const uint8_t* pPayload);
+
+	template<typename T>
+	void PrepareBuffers(const VstCallLogProcess* pProcess, const uint8_t* pSamples, int32_t inputCount, int32_t outputCount,
+		std::vector<T>& samples, std::vector<T*>& pointers);
+
+	// audio buffers: the inputs followed by the outputs.
+	std::vector<float> _samples32;
+	std::vector<double> _samples64;
+	std::vector<float*> _buffers32;
+	std::vector<double*> _buffers64;
+
+	// rebuilt dispatch data. Kept until the next dispatch call of the same kind,
+	// because plugins may hold on to events and arrangements until the next process call.
+	std::vector<uint64_t> _scratch;
+	std::vector<uint64_t> _events;
+	std::vector<uint64_t> _eventList;
+	std::vector<uint64_t> _arrangements[2];
+};
@@ -0,0 +1,54 @@
+#include "pch.h"
+#include "VstCallRecorder.h"
+#include "..\Properties\Resources.h"
+#include <vcclr.h>
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	VstCallRecorder::VstCallRecorder(::Vst2Plugin* pPlugin)
+	{
+		_pPlugin = pPlugin;
+		_pWriter = new VstCallLogWriter();
+	}
+
+	VstCallRecorder::~VstCallRecorder()
+	{
+		this->!VstCallRecorder();
+	}
+
+	VstCallRecorder::!VstCallRecorder()
+	{
+		delete _pWriter;
+		_pWriter = NULL;
+	}
+
+	void VstCallRecorder::Start(System::String^ filePath)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNullOrEmpty(filePath, "filePath");
+
+		if(_pWriter == NULL)
+		{
+			throw gcnew System::ObjectDisposedException(VstCallRecorder::typeid->Name);
+		}
+
+		pin_ptr<const wchar_t> pPath = PtrToStringChars(filePath);
+
+		if(!_pWriter->Open(pPath, _pPlugin))
+		{
+			throw gcnew System::IO::IOException(System::String::Format(
+				Jacobi::Vst::Interop::Properties::Resources::VstCallRecorder_OpenFailed, filePath));
+		}
+	}
+
+	void VstCallRecorder::Stop()
+	{
+		if(_pWriter != NULL)
+		{
+			_pWriter->Close();
+		}
+	}
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "VstCallLog.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	/// <summary>
+	/// The VstCallRecorder class records the calls the host makes into the plugin to a call log file.
+	/// </summary>
+	/// <remarks>Dispatcher calls are recorded with the data their pointer arguments refer to (strings, chunks,
+	/// events, speaker arrangements), process calls with their input audio, and parameter calls with their values,
+	/// in the order (and at the time) the plugin receives them. Replay the log with <see cref="VstCallReplayer"/>.
+	/// Recording writes all input audio to the file: use it to capture a session, not permanently.
+	/// Recording is not real-time safe: every recorded call, including the process calls on the audio thread,
+	/// takes a lock it shares with the other threads, may grow the record buffer and writes to the file
+	/// before the call reaches the plugin. Expect dropouts at small block sizes while recording.
+	/// Recording stops when the plugin is closed.</remarks>
+	public ref class VstCallRecorder sealed
+	{
+	public:
+		/// <summary>Stops recording.</summary>
+		~VstCallRecorder();
+		/// <summary>Closes the log file.</summary>
+		!VstCallRecorder();
+
+		/// <summary>
+		/// Starts recording to a new file at <paramref name="filePath"/>. A file that exists is overwritten.
+		/// </summary>
+		/// <param name="filePath">The path to the log file. Must not be null or empty.</param>
+		/// <exception cref="System::IO::IOException">Thrown when the file cannot be created.</exception>
+		void Start(System::String^ filePath);
+
+		/// <summary>Stops recording and closes the file.</summary>
+		void Stop();
+
+		/// <summary>Gets if calls are being recorded.</summary>
+		property System::Boolean IsRecording
+		{ System::Boolean get() { return _pWriter != NULL && _pWriter->IsOpen(); } }
+
+		/// <summary>Gets the number of calls recorded since <see cref="Start"/>.</summary>
+		property System::Int64 RecordCount
+		{ System::Int64 get() { return _pWriter != NULL ? _pWriter->GetRecordCount() : 0; } }
+
+	internal:
+		VstCallRecorder(::Vst2Plugin* pPlugin);
+
+		// called by VstPluginCommandsImpl before each call into the plugin.
+		void WriteDispatch(::Vst2PluginCommands command, ::int32_t index, ::Vst2IntPtr value, void* ptr, float opt)
+		{
+			if(IsRecording) _pWriter->WriteDispatch(command, index, value, ptr, opt);
+		}
+		void WriteProcess(float** inputs, ::int32_t sampleFrames, bool accumulating)
+		{
+			if(IsRecording) _pWriter->WriteProcess(inputs, _pPlugin->inputCount, _pPlugin->outputCount, sampleFrames, accumulating);
+		}
+		void WriteProcess(double** inputs, ::int32_t sampleFrames)
+		{
+			if(IsRecording) _pWriter->WriteProcess(inputs, _pPlugin->inputCount, _pPlugin->outputCount, sampleFrames);
+		}
+		void WriteProcessVariableIo(::Vst2VariableIo* pVarIo)
+		{
+			if(IsRecording) _pWriter->WriteProcessVariableIo(pVarIo, _pPlugin->inputCount, _pPlugin->outputCount);
+		}
+		void WriteSetParameter(::int32_t index, float value)
+		{
+			if(IsRecording) _pWriter->WriteSetParameter(index, value);
+		}
+		void WriteGetParameter(::int32_t index)
+		{
+			if(IsRecording) _pWriter->WriteGetParameter(index);
+		}
+
+	private:
+		::Vst2Plugin* _pPlugin;
+		VstCallLogWriter* _pWriter;
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,93 @@
+#include "pch.h"
+#include "VstCallReplayer.h"
+#include "VstCallLogPlayer.h"
+#include "VstPluginContext.h"
+#include "VstPluginCommandStub.h"
+#include "..\Properties\Resources.h"
+#include <vcclr.h>
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	VstCallReplayResult::VstCallReplayResult(System::Int64 dispatchCount, System::Int64 processCount, System::Int64 parameterCount,
+		System::Int64 skippedCount, System::TimeSpan duration, array<System::Int64>^ processNanoseconds)
+	{
+		_dispatchCount = dispatchCount;
+		_processCount = processCount;
+		_parameterCount = parameterCount;
+		_skippedCount = skippedCount;
+		_duration = duration;
+		_processNanoseconds = processNanoseconds;
+	}
+
+	System::Int64 VstCallReplayResult::GetProcessPercentile(System::Double percentile)
+	{
+		if(percentile < 0 || percentile > 100)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("percentile");
+		}
+
+		int count = _processNanoseconds->Length;
+		if(count == 0)
+		{
+			return 0;
+		}
+
+		auto sorted = safe_cast<array<System::Int64>^>(_processNanoseconds->Clone());
+		System::Array::Sort(sorted);
+
+		int index = (int)System::Math::Ceiling(percentile / 100.0 * count) - 1;
+
+		return sorted[System::Math::Max(0, System::Math::Min(index, count - 1))];
+	}
+
+	VstCallReplayResult^ VstCallReplayer::Replay(VstPluginContext^ pluginContext, System::String^ filePath, VstCallReplayTiming timing)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(pluginContext, "pluginContext");
+		Jacobi::Vst::Core::Throw::IfArgumentIsNullOrEmpty(filePath, "filePath");
+
+		// managed plugins are called without the unmanaged Vst2Plugin structure.
+		auto pluginCmdStub = dynamic_cast<VstPluginCommandStub^>(pluginContext->PluginCommandStub);
+		if(pluginCmdStub == nullptr || pluginCmdStub->CommandsImpl->Plugin == NULL)
+		{
+			throw gcnew System::NotSupportedException(
+				Jacobi::Vst::Interop::Properties::Resources::VstCallReplayer_NotSupported);
+		}
+
+		if(!System::IO::File::Exists(filePath))
+		{
+			throw gcnew System::IO::FileNotFoundException(filePath);
+		}
+
+		VstCallLogReader reader;
+		VstCallLogPlayer player;
+		VstCallLogStats stats;
+
+		{
+			pin_ptr<const wchar_t> pFilePath = PtrToStringChars(filePath);
+
+			if(!reader.Open(pFilePath))
+			{
+				throw gcnew System::IO::InvalidDataException(System::String::Format(
+					Jacobi::Vst::Interop::Properties::Resources::VstCallReplayer_InvalidFormat, filePath));
+			}
+		}
+
+		player.Play(reader, pluginCmdStub->CommandsImpl->Plugin,
+			timing == VstCallReplayTiming::Recorded ? VstCallLogTiming::Recorded : VstCallLogTiming::AsFastAsPossible, &stats);
+
+		auto processNanoseconds = gcnew array<System::Int64>((int)stats.processNanoseconds.size());
+		if(processNanoseconds->Length > 0)
+		{
+			System::Runtime::InteropServices::Marshal::Copy(System::IntPtr(stats.processNanoseconds.data()),
+				processNanoseconds, 0, processNanoseconds->Length);
+		}
+
+		// TimeSpan ticks are 100ns.
+		return gcnew VstCallReplayResult(stats.dispatchCount, stats.processCount, stats.parameterCount, stats.skippedCount,
+			System::TimeSpan(stats.durationNanoseconds / 100), processNanoseconds);
+	}
+
+}}}} // Jacobi::Vst::Host::Interop
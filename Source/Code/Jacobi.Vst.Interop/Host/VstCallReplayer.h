@@ -0,0 +1,82 @@
+#pragma once
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	ref class VstPluginContext;
+
+	/// <summary>
+	/// Specifies when the calls of a call log are made during a replay.
+	/// </summary>
+	public enum class VstCallReplayTiming
+	{
+		/// <summary>Each call is made at the time it was recorded (relative to the start of the recording).</summary>
+		Recorded,
+		/// <summary>The calls follow each other without waiting.</summary>
+		AsFastAsPossible,
+	};
+
+	/// <summary>
+	/// The VstCallReplayResult class contains the figures of a replay.
+	/// </summary>
+	public ref class VstCallReplayResult sealed
+	{
+	public:
+		/// <summary>Gets the number of dispatcher calls that were replayed.</summary>
+		property System::Int64 DispatchCount { System::Int64 get() { return _dispatchCount; } }
+		/// <summary>Gets the number of process calls that were replayed.</summary>
+		property System::Int64 ProcessCount { System::Int64 get() { return _processCount; } }
+		/// <summary>Gets the number of parameter calls that were replayed.</summary>
+		property System::Int64 ParameterCount { System::Int64 get() { return _parameterCount; } }
+		/// <summary>Gets the number of recorded calls that were not replayed (open, close, editor and offline calls).</summary>
+		property System::Int64 SkippedCount { System::Int64 get() { return _skippedCount; } }
+		/// <summary>Gets the duration of the complete replay.</summary>
+		property System::TimeSpan Duration { System::TimeSpan get() { return _duration; } }
+
+		/// <summary>Gets the duration of each process call in nanoseconds, in replay order.</summary>
+		property array<System::Int64>^ ProcessNanoseconds { array<System::Int64>^ get() { return _processNanoseconds; } }
+
+		/// <summary>Calculates the process call duration percentile.</summary>
+		/// <param name="percentile">A value between 0 and 100, for instance 50, 99 or 99.9.</param>
+		/// <returns>Returns the duration in nanoseconds or 0 when no process calls were replayed.</returns>
+		System::Int64 GetProcessPercentile(System::Double percentile);
+
+	internal:
+		VstCallReplayResult(System::Int64 dispatchCount, System::Int64 processCount, System::Int64 parameterCount,
+			System::Int64 skippedCount, System::TimeSpan duration, array<System::Int64>^ processNanoseconds);
+
+	private:
+		System::Int64 _dispatchCount;
+		System::Int64 _processCount;
+		System::Int64 _parameterCount;
+		System::Int64 _skippedCount;
+		System::TimeSpan _duration;
+		array<System::Int64>^ _processNanoseconds;
+	};
+
+	/// <summary>
+	/// The VstCallReplayer class replays a call log recorded by <see cref="VstCallRecorder"/> on a plugin.
+	/// </summary>
+	/// <remarks>The recorded dispatcher, process and parameter calls are made on the plugin of the context
+	/// on the calling thread, for instance to reproduce a performance problem of a session or to compare
+	/// versions of a plugin with the same traffic. Process calls get the recorded input audio; the plugin's output is discarded.
+	/// Open and Close are not replayed (the context owns the plugin) and neither are editor calls.
+	/// Prepare the plugin as the recording host did (or include the setup calls in the recording).</remarks>
+	public ref class VstCallReplayer abstract sealed
+	{
+	public:
+		/// <summary>
+		/// Replays the call log at <paramref name="filePath"/> on the plugin of the <paramref name="pluginContext"/>.
+		/// </summary>
+		/// <param name="pluginContext">An opened plugin context. Must not be null.</param>
+		/// <param name="filePath">The path to the call log. Must not be null or empty.</param>
+		/// <param name="timing">Specifies if the recorded timing is kept.</param>
+		/// <returns>Returns the figures of the replay.</returns>
+		/// <exception cref="System::NotSupportedException">Thrown when the plugin is a managed plugin.</exception>
+		/// <exception cref="System::IO::InvalidDataException">Thrown when the file is not a call log (of this platform).</exception>
+		static VstCallReplayResult^ Replay(VstPluginContext^ pluginContext, System::String^ filePath, VstCallReplayTiming timing);
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,191 @@
+#include "pch.h"
+#include "VstChunkCompressor.h"
+#include "VstPluginCommandStub.h"
+#include "ChunkCodec.h"
+#include "..\Properties\Resources.h"
+
+namespace
+{
+	// precedes compressed chunk data (little-endian).
+	struct CompressedChunkHeader
+	{
+		int32_t magic;
+		int32_t method;
+		int32_t length;		// uncompressed
+	};
+
+	const int32_t CompressedChunkMagic = 'z' << 24 | 'c' << 16 | 'N' << 8 | 'V';
+	const int32_t MethodStored = 0;
+	const int32_t MethodBlock = 1;
+}
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	array<System::Byte>^ VstChunkCompressor::GetChunk(Jacobi::Vst::Core::Host::IVstPluginCommandStub^ pluginCmdStub, System::Boolean isPreset)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(pluginCmdStub, "pluginCmdStub");
+
+		auto unmanagedStub = dynamic_cast<VstPluginCommandStub^>(pluginCmdStub);
+		if(unmanagedStub != nullptr)
+		{
+			return unmanagedStub->CommandsImpl->GetChunkCompressed(isPreset);
+		}
+
+		auto chunk = pluginCmdStub->Commands->GetChunk(isPreset);
+		if(chunk == nullptr)
+		{
+			return nullptr;
+		}
+
+		return Compress(chunk);
+	}
+
+	System::Int32 VstChunkCompressor::SetChunk(Jacobi::Vst::Core::Host::IVstPluginCommandStub^ pluginCmdStub, array<System::Byte>^ data, System::Boolean isPreset)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(pluginCmdStub, "pluginCmdStub");
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(data, "data");
+
+		auto unmanagedStub = dynamic_cast<VstPluginCommandStub^>(pluginCmdStub);
+		if(unmanagedStub != nullptr)
+		{
+			return unmanagedStub->CommandsImpl->SetChunkCompressed(data, isPreset);
+		}
+
+		return pluginCmdStub->Commands->SetChunk(Decompress(data), isPreset);
+	}
+
+	array<System::Byte>^ VstChunkCompressor::Compress(array<System::Byte>^ chunk)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(chunk, "chunk");
+
+		if(chunk->Length == 0)
+		{
+			return Compress((const uint8_t*)NULL, 0);
+		}
+
+		pin_ptr<System::Byte> pChunk = &chunk[0];
+		return Compress(pChunk, chunk->Length);
+	}
+
+	array<System::Byte>^ VstChunkCompressor::Compress(const uint8_t* pChunk, int length)
+	{
+		int bound = ChunkCodec::CompressBound(length);
+		uint8_t* pBuffer = new uint8_t[bound];
+
+		try
+		{
+			int compressedLength = length > 0 ? ChunkCodec::Compress(pChunk, length, pBuffer, bound) : 0;
+
+			// fall back to storing the data when it does not compress.
+			bool stored = compressedLength == 0 || compressedLength >= length;
+			int payloadLength = stored ? length : compressedLength;
+
+			auto data = gcnew array<System::Byte>(sizeof(CompressedChunkHeader) + payloadLength);
+			pin_ptr<System::Byte> pData = &data[0];
+
+			auto pHeader = (CompressedChunkHeader*)pData;
+			pHeader->magic = CompressedChunkMagic;
+			pHeader->method = stored ? MethodStored : MethodBlock;
+			pHeader->length = length;
+
+			if(payloadLength > 0)
+			{
+				memcpy(pHeader + 1, stored ? pChunk : pBuffer, payloadLength);
+			}
+
+			return data;
+		}
+		finally
+		{
+			delete[] pBuffer;
+		}
+	}
+
+	array<System::Byte>^ VstChunkCompressor::Decompress(array<System::Byte>^ data)
+	{
+		if(!IsCompressed(data))
+		{
+			return data;
+		}
+
+		int length = GetUncompressedLength(data);
+		auto chunk = gcnew array<System::Byte>(length);
+
+		if(length > 0)
+		{
+			pin_ptr<System::Byte> pChunk = &chunk[0];
+			Decompress(data, pChunk, length);
+		}
+
+		return chunk;
+	}
+
+	void VstChunkCompressor::Decompress(array<System::Byte>^ data, uint8_t* pDest, int length)
+	{
+		if(!IsCompressed(data))
+		{
+			System::Runtime::InteropServices::Marshal::Copy(data, 0, System::IntPtr(pDest), length);
+			return;
+		}
+
+		pin_ptr<System::Byte> pData = &data[0];
+		auto pHeader = (const CompressedChunkHeader*)pData;
+		auto pPayload = (const uint8_t*)(pHeader + 1);
+		int payloadLength = data->Length - sizeof(CompressedChunkHeader);
+
+		bool valid = pHeader->length == length;
+
+		if(valid && pHeader->method == MethodStored)
+		{
+			valid = payloadLength == length;
+			if(valid && length > 0)
+			{
+				memcpy(pDest, pPayload, length);
+			}
+		}
+		else if(valid && pHeader->method == MethodBlock)
+		{
+			valid = ChunkCodec::Decompress(pPayload, payloadLength, pDest, length);
+		}
+		else
+		{
+			valid = false;
+		}
+
+		if(!valid)
+		{
+			throw gcnew System::IO::InvalidDataException(
+				Jacobi::Vst::Interop::Properties::Resources::VstChunkCompressor_InvalidData);
+		}
+	}
+
+	System::Boolean VstChunkCompressor::IsCompressed(array<System::Byte>^ data)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(data, "data");
+
+		if(data->Length < (int)sizeof(CompressedChunkHeader))
+		{
+			return false;
+		}
+
+		pin_ptr<System::Byte> pData = &data[0];
+		auto pHeader = (const CompressedChunkHeader*)pData;
+
+		return pHeader->magic == CompressedChunkMagic && pHeader->length >= 0;
+	}
+
+	System::Int32 VstChunkCompressor::GetUncompressedLength(array<System::Byte>^ data)
+	{
+		if(!IsCompressed(data))
+		{
+			return data->Length;
+		}
+
+		pin_ptr<System::Byte> pData = &data[0];
+		return ((const CompressedChunkHeader*)pData)->length;
+	}
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,63 @@
+#pragma once
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	/// <summary>
+	/// The VstChunkCompressor class compresses plugin chunk data (program or bank state)
+	/// for storage by the host.
+	/// </summary>
+	/// <remarks>Compressed data starts with a small header that records the uncompressed length,
+	/// so <see cref="SetChunk"/> can decompress straight into the buffer that is passed to the plugin.
+	/// Data that was not produced by this class is passed through unaltered, so hosts can
+	/// mix compressed and raw (previously stored) chunks.</remarks>
+	public ref class VstChunkCompressor abstract sealed
+	{
+	public:
+		/// <summary>Retrieves the chunk from the plugin and compresses it.</summary>
+		/// <param name="pluginCmdStub">The plugin to retrieve the chunk from. Must not be null.</param>
+		/// <param name="isPreset">True for the current program only, false for the whole bank.</param>
+		/// <returns>Returns the compressed chunk or null when the plugin did not return a chunk.</returns>
+		/// <remarks>For unmanaged plugins the chunk is compressed directly from the plugin's memory.</remarks>
+		static array<System::Byte>^ GetChunk(Jacobi::Vst::Core::Host::IVstPluginCommandStub^ pluginCmdStub, System::Boolean isPreset);
+
+		/// <summary>Decompresses the chunk <paramref name="data"/> and passes it to the plugin.</summary>
+		/// <param name="pluginCmdStub">The plugin to set the chunk on. Must not be null.</param>
+		/// <param name="data">The (compressed) chunk data. Must not be null.</param>
+		/// <param name="isPreset">True for the current program only, false for the whole bank.</param>
+		/// <returns>Returns the result of the plugin's SetChunk call.</returns>
+		/// <exception cref="System::IO::InvalidDataException">Thrown when the compressed data is corrupt.</exception>
+		static System::Int32 SetChunk(Jacobi::Vst::Core::Host::IVstPluginCommandStub^ pluginCmdStub, array<System::Byte>^ data, System::Boolean isPreset);
+
+		/// <summary>Compresses the <paramref name="chunk"/>.</summary>
+		/// <param name="chunk">The raw chunk data. Must not be null.</param>
+		/// <returns>Returns the compressed data.</returns>
+		/// <remarks>Data that does not compress is stored and only grows by the size of the header.</remarks>
+		static array<System::Byte>^ Compress(array<System::Byte>^ chunk);
+
+		/// <summary>Decompresses the <paramref name="data"/>.</summary>
+		/// <param name="data">The compressed data. Must not be null.</param>
+		/// <returns>Returns the raw chunk data, or <paramref name="data"/> itself when it is not compressed.</returns>
+		/// <exception cref="System::IO::InvalidDataException">Thrown when the compressed data is corrupt.</exception>
+		static array<System::Byte>^ Decompress(array<System::Byte>^ data);
+
+		/// <summary>Indicates if the <paramref name="data"/> was produced by this class.</summary>
+		/// <param name="data">The data to inspect. Must not be null.</param>
+		/// <returns>Returns true when the data is compressed.</returns>
+		static System::Boolean IsCompressed(array<System::Byte>^ data);
+
+		/// <summary>Gets the length of the chunk when <paramref name="data"/> is decompressed.</summary>
+		/// <param name="data">The (compressed) data. Must not be null.</param>
+		/// <returns>Returns the uncompressed length.</returns>
+		static System::Int32 GetUncompressedLength(array<System::Byte>^ data);
+
+	internal:
+		// compresses native chunk memory owned by the plugin.
+		static array<System::Byte>^ Compress(const uint8_t* pChunk, int length);
+		// decompresses into a native buffer of GetUncompressedLength bytes.
+		static void Decompress(array<System::Byte>^ data, uint8_t* pDest, int length);
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,206 @@
+#include "pch.h"
+#include "VstEngineThread.h"
+#include "..\Properties\Resources.h"
+#include <vcclr.h>
+#include <avrt.h>
+
+#pragma comment(lib, "avrt.lib")
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	VstThreadGrant::VstThreadGrant()
+	{
+		_originalPriority = THREAD_PRIORITY_ERROR_RETURN;
+		_originalIdealProcessor = (DWORD)-1;
+		_idealProcessor = -1;
+		_failures = gcnew System::Collections::Generic::List<System::String^>();
+	}
+
+	VstThreadGrant::~VstThreadGrant()
+	{
+		if(_threadId == 0)
+		{
+			return;
+		}
+
+		// the MMCSS task and the thread settings belong to the thread that configured them.
+		if(_threadId != ::GetCurrentThreadId())
+		{
+			throw gcnew System::InvalidOperationException(
+				Jacobi::Vst::Interop::Properties::Resources::VstEngineThread_WrongThread);
+		}
+
+		HANDLE hThread = ::GetCurrentThread();
+
+		if(_originalIdealProcessor != (DWORD)-1)
+		{
+			::SetThreadIdealProcessor(hThread, _originalIdealProcessor);
+		}
+
+		if(_originalAffinityMask != 0)
+		{
+			::SetThreadAffinityMask(hThread, _originalAffinityMask);
+		}
+
+		if(_timeCriticalGranted)
+		{
+			::SetThreadPriority(hThread, _originalPriority);
+		}
+
+		if(_hTask != NULL)
+		{
+			::AvRevertMmThreadCharacteristics(_hTask);
+			_hTask = NULL;
+		}
+
+		_threadId = 0;
+	}
+
+	void VstThreadGrant::AddFailure(System::String^ setting)
+	{
+		_failures->Add(System::String::Format(
+			Jacobi::Vst::Interop::Properties::Resources::VstEngineThread_SettingFailed, setting, ::GetLastError()));
+	}
+
+	VstThreadGrant^ VstEngineThread::ConfigureCurrentThread(VstThreadSettings^ settings)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(settings, "settings");
+
+		auto grant = gcnew VstThreadGrant();
+		HANDLE hThread = ::GetCurrentThread();
+		grant->_threadId = ::GetCurrentThreadId();
+
+		if(settings->UseMultimediaClass)
+		{
+			Jacobi::Vst::Core::Throw::IfArgumentIsNullOrEmpty(settings->MultimediaTaskName, "settings.MultimediaTaskName");
+
+			pin_ptr<const wchar_t> pTaskName = PtrToStringChars(settings->MultimediaTaskName);
+			DWORD taskIndex = 0;
+
+			grant->_hTask = ::AvSetMmThreadCharacteristicsW(pTaskName, &taskIndex);
+			grant->_taskIndex = taskIndex;
+
+			if(grant->_hTask == NULL)
+			{
+				grant->AddFailure("UseMultimediaClass");
+			}
+		}
+
+		if(settings->TimeCritical)
+		{
+			grant->_originalPriority = ::GetThreadPriority(hThread);
+			grant->_timeCriticalGranted = ::SetThreadPriority(hThread, THREAD_PRIORITY_TIME_CRITICAL) != FALSE;
+
+			if(!grant->_timeCriticalGranted)
+			{
+				grant->AddFailure("TimeCritical");
+			}
+		}
+
+		if(settings->AffinityMask != 0)
+		{
+			// returns the previous mask, or 0 when the mask holds no allowed processor.
+			grant->_originalAffinityMask = ::SetThreadAffinityMask(hThread, (DWORD_PTR)settings->AffinityMask);
+
+			if(grant->_originalAffinityMask == 0)
+			{
+				grant->AddFailure("AffinityMask");
+			}
+		}
+
+		if(settings->IdealProcessor >= 0)
+		{
+			grant->_originalIdealProcessor = ::SetThreadIdealProcessor(hThread, settings->IdealProcessor);
+
+			if(grant->_originalIdealProcessor == (DWORD)-1)
+			{
+				grant->AddFailure("IdealProcessor");
+			}
+			else
+			{
+				grant->_idealProcessor = settings->IdealProcessor;
+			}
+		}
+
+		// query the mask that is in effect (without setting it).
+		GROUP_AFFINITY affinity;
+		grant->_affinityMask = ::GetThreadGroupAffinity(hThread, &affinity) ? (System::UInt64)affinity.Mask : 0;
+
+		return grant;
+	}
+
+	System::UInt64 VstEngineThread::GetProcessAffinityMask()
+	{
+		DWORD_PTR processMask = 0;
+		DWORD_PTR systemMask = 0;
+
+		if(!::GetProcessAffinityMask(::GetCurrentProcess(), &processMask, &systemMask))
+		{
+			return 0;
+		}
+
+		return processMask;
+	}
+
+	bool VstEngineThread::LockMemory(void* pMemory, size_t size, size_t* pGrowth)
+	{
+		*pGrowth = 0;
+
+		if(pMemory == NULL || size == 0)
+		{
+			return false;
+		}
+
+		if(::VirtualLock(pMemory, size))
+		{
+			return true;
+		}
+
+		// the working set is too small to hold the locked pages, grow it and retry.
+		if(::GetLastError() == ERROR_WORKING_SET_QUOTA)
+		{
+			SIZE_T minimumSize = 0;
+			SIZE_T maximumSize = 0;
+			HANDLE hProcess = ::GetCurrentProcess();
+
+			if(::GetProcessWorkingSetSize(hProcess, &minimumSize, &maximumSize) &&
+				::SetProcessWorkingSetSize(hProcess, minimumSize + size, maximumSize + size))
+			{
+				*pGrowth = size;
+
+				if(::VirtualLock(pMemory, size))
+				{
+					return true;
+				}
+
+				UnlockMemory(NULL, 0, size);
+				*pGrowth = 0;
+			}
+		}
+
+		return false;
+	}
+
+	void VstEngineThread::UnlockMemory(void* pMemory, size_t size, size_t growth)
+	{
+		if(pMemory != NULL && size != 0)
+		{
+			::VirtualUnlock(pMemory, size);
+		}
+
+		// give back what LockMemory added to the working set.
+		SIZE_T minimumSize = 0;
+		SIZE_T maximumSize = 0;
+		HANDLE hProcess = ::GetCurrentProcess();
+
+		if(growth != 0 && ::GetProcessWorkingSetSize(hProcess, &minimumSize, &maximumSize) &&
+			minimumSize >= growth && maximumSize >= growth)
+		{
+			::SetProcessWorkingSetSize(hProcess, minimumSize - growth, maximumSize - growth);
+		}
+	}
+
+}}}} // Jacobi::Vst::Host::Interop
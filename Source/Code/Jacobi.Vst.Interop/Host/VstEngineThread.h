@@ -0,0 +1,100 @@
+#pragma once
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	/// <summary>
+	/// The VstThreadSettings class specifies the real-time settings requested for a host engine thread.
+	/// </summary>
+	public ref class VstThreadSettings sealed
+	{
+	public:
+		/// <summary>Constructs a new instance that requests the 'Pro Audio' multimedia class.</summary>
+		VstThreadSettings()
+		{
+			UseMultimediaClass = true;
+			MultimediaTaskName = "Pro Audio";
+			IdealProcessor = -1;
+		}
+
+		/// <summary>Gets or sets if the thread is registered with the multimedia class scheduler service (MMCSS).</summary>
+		property System::Boolean UseMultimediaClass;
+		/// <summary>Gets or sets the MMCSS task name, for instance 'Pro Audio' or 'Audio'.</summary>
+		property System::String^ MultimediaTaskName;
+		/// <summary>Gets or sets if the thread priority is raised to time critical.</summary>
+		property System::Boolean TimeCritical;
+		/// <summary>Gets or sets the processors (bits) the thread is allowed to run on. Zero leaves the affinity unchanged.</summary>
+		property System::UInt64 AffinityMask;
+		/// <summary>Gets or sets the preferred processor of the thread. -1 leaves it unchanged.</summary>
+		property System::Int32 IdealProcessor;
+	};
+
+	/// <summary>
+	/// The VstThreadGrant class reports which of the requested <see cref="VstThreadSettings"/> were applied.
+	/// </summary>
+	/// <remarks>Disposing the instance restores the original settings and leaves the MMCSS task.
+	/// Dispose it on the same thread it was granted on. A grant that is not disposed ends when its thread exits.</remarks>
+	public ref class VstThreadGrant sealed : System::IDisposable
+	{
+	public:
+		/// <summary>Restores the original thread settings.</summary>
+		/// <exception cref="System::InvalidOperationException">Thrown when called on another thread than the one the settings were applied to.</exception>
+		~VstThreadGrant();
+
+		/// <summary>Gets if the thread was registered with MMCSS.</summary>
+		property System::Boolean MultimediaClassGranted { System::Boolean get() { return _hTask != NULL; } }
+		/// <summary>Gets if the thread priority was raised to time critical.</summary>
+		property System::Boolean TimeCriticalGranted { System::Boolean get() { return _timeCriticalGranted; } }
+		/// <summary>Gets the processors the thread runs on after configuration.</summary>
+		property System::UInt64 AffinityMask { System::UInt64 get() { return _affinityMask; } }
+		/// <summary>Gets the preferred processor of the thread after configuration.</summary>
+		property System::Int32 IdealProcessor { System::Int32 get() { return _idealProcessor; } }
+		/// <summary>Gets a description of each requested setting that could not be applied.</summary>
+		property System::Collections::Generic::IList<System::String^>^ Failures
+		{ System::Collections::Generic::IList<System::String^>^ get() { return _failures; } }
+
+	internal:
+		VstThreadGrant();
+
+		DWORD _threadId;	// 0 when restored
+		HANDLE _hTask;
+		DWORD _taskIndex;
+		int _originalPriority;
+		DWORD_PTR _originalAffinityMask;
+		DWORD _originalIdealProcessor;
+
+		System::Boolean _timeCriticalGranted;
+		System::UInt64 _affinityMask;
+		System::Int32 _idealProcessor;
+		System::Collections::Generic::List<System::String^>^ _failures;
+
+		void AddFailure(System::String^ setting);
+	};
+
+	/// <summary>
+	/// The VstEngineThread class configures host engine (audio and worker) threads for real-time processing.
+	/// </summary>
+	/// <remarks>Use <see cref="VstAudioBufferManager::LockMemory"/> to keep the audio buffers resident.</remarks>
+	public ref class VstEngineThread abstract sealed
+	{
+	public:
+		/// <summary>Applies the <paramref name="settings"/> to the calling thread.</summary>
+		/// <param name="settings">The requested settings. Must not be null.</param>
+		/// <returns>Returns what was granted. Dispose the grant to restore the original settings.</returns>
+		/// <remarks>Settings that cannot be applied are reported in <see cref="VstThreadGrant::Failures"/>; no exception is thrown.</remarks>
+		static VstThreadGrant^ ConfigureCurrentThread(VstThreadSettings^ settings);
+
+		/// <summary>Gets the processors (bits) the process is allowed to run on.</summary>
+		static System::UInt64 GetProcessAffinityMask();
+
+	internal:
+		// locks the memory range into physical memory, growing the working set when needed.
+		// pGrowth receives the number of bytes the working set was grown by, to pass to UnlockMemory.
+		static bool LockMemory(void* pMemory, size_t size, size_t* pGrowth);
+		// unlocks the memory range and shrinks the working set by the growth of LockMemory.
+		static void UnlockMemory(void* pMemory, size_t size, size_t growth);
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
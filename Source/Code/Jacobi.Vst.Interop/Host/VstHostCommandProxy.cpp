@@ -18,7 +18,7 @@ VstHostCommandProxy::VstHostCommandProxy(Jacobi::Vst::Core::Host::IVstHostComman
 	// unmanaged structures
 	_pTimeInfo = new ::Vst2TimeInfo();
 	_directory = NULL;
-	_pArrangement = new ::Vst2SpeakerArrangement();
+	_arrangementCache = gcnew Jacobi::Vst::Interop::SpeakerArrangementCache();
 
 	_traceCtx = gcnew Jacobi::Vst::Core::Diagnostics::TraceContext("Host.HostCommandProxy", Jacobi::Vst::Core::Host::IVstHostCommandStub::typeid);
 }
@@ -42,10 +42,9 @@ VstHostCommandProxy::!VstHostCommandProxy()
 		_directory = NULL;
 	}
 
-	if(_pArrangement != NULL)
+	if(_arrangementCache != nullptr)
 	{
-		delete _pArrangement;
-		_pArrangement = NULL;
+		_arrangementCache->Clear();
 	}
 }
 
@@ -85,6 +84,11 @@ VstHostCommandProxy::!VstHostCommandProxy()
 				if(timeInfo != nullptr)
 				{
 					TypeConverter::ToUnmanagedTimeInfo(_pTimeInfo, timeInfo);
+
+					if(TimeInfoSampleOffset != 0)
+					{
+						AdvanceTimeInfo(_pTimeInfo, TimeInfoSampleOffset);
+					}
 					result = (Vst2IntPtr)_pTimeInfo;
 				}
 			}	break;
@@ -232,8 +236,7 @@ VstHostCommandProxy::!VstHostCommandProxy()
 			break;
 		case Vst2HostCommands::GetOutputSpeakerArrangement:
 		{	Jacobi::Vst::Core::VstSpeakerArrangement^ arrangement = _legacyCmdStub->GetOutputSpeakerArrangement();
-		TypeConverter::ToUnmanagedSpeakerArrangement(_pArrangement, arrangement);
-			result = (Vst2IntPtr)_pArrangement;
+			result = (Vst2IntPtr)_arrangementCache->ToUnmanaged(arrangement, false);
 		}	break;
 		case Vst2HostCommands::SetIcon:
 		{
@@ -256,8 +259,7 @@ VstHostCommandProxy::!VstHostCommandProxy()
 		}	break;
 		case Vst2HostCommands::GetInputSpeakerArrangement:
 		{	auto arrangement = _legacyCmdStub->GetInputSpeakerArrangement();
-		TypeConverter::ToUnmanagedSpeakerArrangement(_pArrangement, arrangement);
-			result = (Vst2IntPtr)_pArrangement;
+			result = (Vst2IntPtr)_arrangementCache->ToUnmanaged(arrangement, true);
 		}	break;
 		default:
 			// unknown command
@@ -276,4 +278,29 @@ VstHostCommandProxy::!VstHostCommandProxy()
 	return result;
 }
 
+// moves the time info to the start of a sub-block, sampleOffset samples later.
+void VstHostCommandProxy::AdvanceTimeInfo(::Vst2TimeInfo* pTimeInfo, int32_t sampleOffset)
+{
+	pTimeInfo->samplePosition += sampleOffset;
+
+	if(pTimeInfo->sampleRate <= 0)
+	{
+		return;
+	}
+
+	double seconds = sampleOffset / pTimeInfo->sampleRate;
+	int32_t flags = (int32_t)pTimeInfo->flags;
+
+	if((flags & (int32_t)Vst2TimeInfoFlags::NanosValid) != 0)
+	{
+		pTimeInfo->nanoSeconds += seconds * 1000000000.0;
+	}
+
+	if((flags & (int32_t)Vst2TimeInfoFlags::PpqPosValid) != 0 &&
+		(flags & (int32_t)Vst2TimeInfoFlags::TempoValid) != 0)
+	{
+		pTimeInfo->ppqPosition += seconds * pTimeInfo->tempo / 60.0;
+	}
+}
+
 }}}} // Jacobi::Vst::Host::Interop
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../SpeakerArrangementCache.h"
+
 namespace Jacobi {
 namespace Vst {
 namespace Host {
@@ -31,13 +33,18 @@ public:
 	/// <see cref="Jacobi::Vst::Core::Host::IVstHostCommandStub"/> interface.</returns>
 	Vst2IntPtr Dispatch(int32_t opcode, int32_t index, Vst2IntPtr value, void* ptr, float opt);
 
+	/// <summary>Gets or sets the number of samples the time info is advanced by (sub-blocks of a split process call).</summary>
+	property System::Int32 TimeInfoSampleOffset;
+
 private:
+	void AdvanceTimeInfo(::Vst2TimeInfo* pTimeInfo, int32_t sampleOffset);
+
 	Jacobi::Vst::Core::Host::IVstHostCommandStub^ _hostCmdStub;
 	Jacobi::Vst::Core::Legacy::IVstHostCommandsLegacy20^ _legacyCmdStub;
 
 	::Vst2TimeInfo* _pTimeInfo;
 	char* _directory;
-	::Vst2SpeakerArrangement* _pArrangement;
+	Jacobi::Vst::Interop::SpeakerArrangementCache^ _arrangementCache;
 
 	Vst2IntPtr DispatchLegacy(Vst2HostCommands command, int32_t index, Vst2IntPtr value, void* ptr, float opt);
 
@@ -2,7 +2,6 @@
 
 #include "../pch.h"
 #include "UnmanagedArray.h"
-#include "../MemoryTracker.h"
 #include "VstPluginCommandsImpl.h"
 
 namespace Jacobi {
@@ -45,6 +44,11 @@ internal:
     /// <summary>Constructs a new instance based on an <b>Vst2Plugin</b> structure.</summary>
     VstPluginCommandStub(::Vst2Plugin* pPlugin);
 
+    /// <summary>Gets the native command implementation.</summary>
+    property Jacobi::Vst::Host::Interop::VstPluginCommandsImpl^ CommandsImpl {
+        Jacobi::Vst::Host::Interop::VstPluginCommandsImpl^ get() { return _commands; }
+    }
+
 private:
     Jacobi::Vst::Host::Interop::VstPluginCommandsImpl^ _commands;
 };
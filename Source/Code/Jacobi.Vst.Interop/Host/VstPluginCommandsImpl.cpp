@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "UnmanagedArray.h"
 #include "VstPluginCommandStub.h"
+#include "VstChunkCompressor.h"
+#include "VstUnmanagedPluginContext.h"
 #include "..\TypeConverter.h"
 #include "..\UnmanagedString.h"
 #include "..\UnmanagedPointer.h"
@@ -17,17 +19,34 @@ namespace Interop {
 		_emptyAudio32 = new float* [0];
 		_emptyAudio64 = new double* [0];
 
-		_memoryTracker = gcnew Jacobi::Vst::Interop::MemoryTracker();
+		_pChunkArena = new MemoryArena();
+		_pEventArena = new MemoryArena();
+		_pEventSplitter = new BlockEventSplitter();
+		_loadMeter = gcnew VstProcessLoadMeter();
+		_arrangementCache = gcnew Jacobi::Vst::Interop::SpeakerArrangementCache();
+		_autoSuspend = gcnew VstAutoSuspend();
+		_blockSplitter = gcnew VstBlockSplitter();
+		_callRecorder = gcnew VstCallRecorder(plugin);
+		_pStatistics = LiveStatistics::AcquireSlot(LiveStatisticsKind::Host,
+			plugin != NULL ? plugin->id : 0, plugin != NULL ? plugin->version : 0);
 
 		_traceCtx = gcnew Jacobi::Vst::Core::Diagnostics::TraceContext("Host.PluginCommandStub", Jacobi::Vst::Core::Host::IVstPluginCommandStub::typeid);
 	}
 
 	void VstPluginCommandsImpl::ClearCurrentEvents()
 	{
-		if (_currentEvents != NULL)
+		// the plugin no longer uses the events of the previous call.
+		_currentEvents = NULL;
+		_eventsDeferred = false;
+
+		if (_pEventSplitter != NULL)
+		{
+			_pEventSplitter->ClearDeferred();
+		}
+
+		if (_pEventArena != NULL)
 		{
-			TypeConverter::DeleteUnmanagedEvents(_currentEvents);
-			_currentEvents = NULL;
+			_pEventArena->Reset();
 		}
 	}
 
@@ -39,8 +58,24 @@ namespace Interop {
 
 		int32_t inputSampleCount = CopyBufferPointers(ppInputs, inputs);
 		int32_t outputSampleCount = CopyBufferPointers(ppOutputs, outputs);
+		int32_t sampleFrames = max(inputSampleCount, outputSampleCount);
+
+		if (_autoSuspend->Enabled && SkipSilentBlock(ppInputs, inputs->Length, ppOutputs, outputs->Length, sampleFrames))
+		{
+			return;
+		}
 
-		CallProcess32(ppInputs, ppOutputs, max(inputSampleCount, outputSampleCount));
+		if (_blockSplitter->Enabled)
+		{
+			ProcessSplit(ppInputs, inputs->Length, ppOutputs, outputs->Length, sampleFrames);
+		}
+		else
+		{
+			// events deferred while the splitter was enabled.
+			DispatchDeferredEvents(0, sampleFrames, true);
+			CallProcess32(ppInputs, ppOutputs, sampleFrames);
+		}
+		_eventsPending = false;
 	}
 
 	void VstPluginCommandsImpl::ProcessReplacing(array<Jacobi::Vst::Core::VstAudioPrecisionBuffer^>^ inputs, array<Jacobi::Vst::Core::VstAudioPrecisionBuffer^>^ outputs)
@@ -50,8 +85,67 @@ namespace Interop {
 
 		int32_t inputSampleCount = CopyBufferPointers(ppInputs, inputs);
 		int32_t outputSampleCount = CopyBufferPointers(ppOutputs, outputs);
+		int32_t sampleFrames = max(inputSampleCount, outputSampleCount);
+
+		if (_autoSuspend->Enabled && SkipSilentBlock(ppInputs, inputs->Length, ppOutputs, outputs->Length, sampleFrames))
+		{
+			return;
+		}
 
-		CallProcess64(ppInputs, ppOutputs, max(inputSampleCount, outputSampleCount));
+		if (_blockSplitter->Enabled)
+		{
+			ProcessSplit(ppInputs, inputs->Length, ppOutputs, outputs->Length, sampleFrames);
+		}
+		else
+		{
+			// events deferred while the splitter was enabled.
+			DispatchDeferredEvents(0, sampleFrames, true);
+			CallProcess64(ppInputs, ppOutputs, sampleFrames);
+		}
+		_eventsPending = false;
+	}
+
+	// passes the deferred events that fall in the sub-block [offset, offset + sampleCount) to the plugin.
+	// events before the block go with the first, events past the block with the last sub-block.
+	// After the last sub-block the arena is released by the next ProcessEvents call.
+	void VstPluginCommandsImpl::DispatchDeferredEvents(int32_t offset, int32_t sampleCount, bool isLast)
+	{
+		if (!_eventsDeferred)
+		{
+			return;
+		}
+
+		// rebased copies: the deferred events keep the deltaFrames of the whole block.
+		auto pSubEvents = _pEventSplitter->GetSubBlock(_pEventSplitter->GetDeferred(), offset, sampleCount, isLast);
+
+		if (isLast)
+		{
+			_eventsDeferred = false;
+			_pEventSplitter->ClearDeferred();
+		}
+
+		if (pSubEvents != NULL)
+		{
+			CallDispatch(Vst2PluginCommands::ProcessEvents, 0, 0, (void*)pSubEvents, 0);
+		}
+	}
+
+	// the time info the plugin requests is advanced to the start of the sub-block.
+	void VstPluginCommandsImpl::SetTimeInfoOffset(int32_t offset)
+	{
+		if (_hostCommandProxy != nullptr)
+		{
+			_hostCommandProxy->TimeInfoSampleOffset = offset;
+		}
+	}
+
+	void VstPluginCommandsImpl::PluginContext::set(Jacobi::Vst::Core::Host::IVstPluginContext^ value)
+	{
+		_pluginContext = value;
+
+		// resolved once instead of on every sub-block.
+		auto context = dynamic_cast<VstUnmanagedPluginContext^>(value);
+		_hostCommandProxy = context != nullptr ? context->HostCommandProxy : nullptr;
 	}
 
 	void VstPluginCommandsImpl::SetParameter(System::Int32 index, System::Single value)
@@ -74,7 +168,10 @@ namespace Interop {
 	{
 		CallDispatch(Vst2PluginCommands::Close, 0, 0, 0, 0);
 
-		_memoryTracker->ClearAll();
+		// nothing is called after Close.
+		_callRecorder->Stop();
+		_pStatistics = LiveStatistics::DetachSlot(_pStatistics);
+		_pChunkArena->Reset();
 		ClearCurrentEvents();
 	}
 
@@ -147,17 +244,33 @@ namespace Interop {
 
 	void VstPluginCommandsImpl::SetSampleRate(System::Single sampleRate)
 	{
+		_loadMeter->SetSampleRate(sampleRate);
+		_pStatistics->sampleRate = sampleRate;
+
 		CallDispatch(Vst2PluginCommands::SampleRateSet, 0, 0, 0, sampleRate);
 	}
 
 	void VstPluginCommandsImpl::SetBlockSize(System::Int32 blockSize)
 	{
+		_loadMeter->SetBlockSize(blockSize);
+		_pStatistics->blockSize = blockSize;
+		_blockSplitter->MaxBlockSize = blockSize;
+
 		CallDispatch(Vst2PluginCommands::BlockSizeSet, 0, blockSize, 0, 0);
 	}
 
 	void VstPluginCommandsImpl::MainsChanged(System::Boolean onoff)
 	{
 		CallDispatch(Vst2PluginCommands::OnOff, 0, onoff ? 1 : 0, 0, 0);
+
+		// the plugin is done with the chunks that were set before.
+		_pChunkArena->Reset();
+
+		// the tail may change with the plugin's settings. Queried here, not on the audio thread.
+		if (onoff)
+		{
+			_autoSuspend->State->SetTailSize(GetTailSize());
+		}
 	}
 
 	System::Boolean VstPluginCommandsImpl::EditorGetRect([System::Runtime::InteropServices::Out] System::Drawing::Rectangle% rect)
@@ -202,6 +315,7 @@ namespace Interop {
 
 		if (length > 0)
 		{
+			_pStatistics->AddMarshaled(length);
 			return TypeConverter::PtrToByteArray(pBuffer, length);
 		}
 
@@ -210,20 +324,76 @@ namespace Interop {
 
 	System::Int32 VstPluginCommandsImpl::SetChunk(array<System::Byte>^ data, System::Boolean isPreset)
 	{
-		char* dataArr = TypeConverter::ByteArrayToPtr(data);
-
 		// we need to hold on to the unmanaged memory until suspend/resume is called.
-		_memoryTracker->RegisterArray(dataArr);
+		char* dataArr = TypeConverter::ByteArrayToPtr(data, _pChunkArena);
+		_pStatistics->AddAllocation(data->Length);
+		_pStatistics->AddMarshaled(data->Length);
 
 		return safe_cast<System::Int32>(CallDispatch(Vst2PluginCommands::ChunkSet, isPreset ? 1 : 0, data->Length, dataArr, 0));
 	}
 
+	array<System::Byte>^ VstPluginCommandsImpl::GetChunkCompressed(System::Boolean isPreset)
+	{
+		// we don't own the memory passed to us
+		char* pBuffer = NULL;
+
+		int32_t length = (int32_t)CallDispatch(Vst2PluginCommands::ChunkGet, isPreset ? 1 : 0, 0, &pBuffer, 0);
+
+		if (length > 0 && pBuffer != NULL)
+		{
+			_pStatistics->AddMarshaled(length);
+			return VstChunkCompressor::Compress((const uint8_t*)pBuffer, length);
+		}
+
+		return nullptr;
+	}
+
+	System::Int32 VstPluginCommandsImpl::SetChunkCompressed(array<System::Byte>^ data, System::Boolean isPreset)
+	{
+		int32_t length = VstChunkCompressor::GetUncompressedLength(data);
+
+		// we need to hold on to the unmanaged memory until suspend/resume is called.
+		char* dataArr = (char*)_pChunkArena->Allocate(length);
+		if (dataArr == NULL)
+		{
+			throw gcnew System::OutOfMemoryException();
+		}
+
+		VstChunkCompressor::Decompress(data, (uint8_t*)dataArr, length);
+		_pStatistics->AddAllocation(length);
+		_pStatistics->AddMarshaled(length);
+
+		return safe_cast<System::Int32>(CallDispatch(Vst2PluginCommands::ChunkSet, isPreset ? 1 : 0, length, dataArr, 0));
+	}
+
 	// IVstPluginCommands20
 	System::Boolean VstPluginCommandsImpl::ProcessEvents(array<Jacobi::Vst::Core::VstEvent^>^ events)
 	{
-		ClearCurrentEvents();
+		// deferred events of earlier calls for the same block stay in the arena.
+		if (!_eventsDeferred)
+		{
+			ClearCurrentEvents();
+		}
 
-		_currentEvents = TypeConverter::AllocUnmanagedEvents(events);
+		// the retained arena block is reused: no heap allocation per call once it is large enough.
+		size_t reservedSize = _pEventArena->GetReservedSize();
+		_currentEvents = TypeConverter::AllocUnmanagedEvents(events, _pEventArena);
+		_pStatistics->AddEvents(_currentEvents);
+
+		// only a new arena block is a native allocation.
+		if (_pEventArena->GetReservedSize() > reservedSize)
+		{
+			_pStatistics->AddAllocation((int64_t)(_pEventArena->GetReservedSize() - reservedSize));
+		}
+		_eventsPending = true;
+
+		// delivered per sub-block during the next process call, after the events of earlier calls.
+		if (_blockSplitter->Enabled || _eventsDeferred)
+		{
+			_pEventSplitter->Defer(_currentEvents);
+			_eventsDeferred = true;
+			return true;
+		}
 
 		return (CallDispatch(Vst2PluginCommands::ProcessEvents, 0, 0, _currentEvents, 0) != 0);
 	}
@@ -289,10 +459,11 @@ namespace Interop {
 	System::Boolean VstPluginCommandsImpl::SetSpeakerArrangement(Jacobi::Vst::Core::VstSpeakerArrangement^ saInput,
 		Jacobi::Vst::Core::VstSpeakerArrangement^ saOutput)
 	{
-		UnmanagedPointer<::Vst2SpeakerArrangement> pInput(TypeConverter::AllocUnmanagedSpeakerArrangement(saInput));
-		UnmanagedPointer<::Vst2SpeakerArrangement> pOutput(TypeConverter::AllocUnmanagedSpeakerArrangement(saOutput));
+		// owned by the cache, reused on the next call.
+		::Vst2SpeakerArrangement* pInput = _arrangementCache->ToUnmanaged(saInput, true);
+		::Vst2SpeakerArrangement* pOutput = _arrangementCache->ToUnmanaged(saOutput, false);
 
-		return (CallDispatch(Vst2PluginCommands::SetSpeakerArrangement, 0, (Vst2IntPtr)(::Vst2SpeakerArrangement*)pInput, pOutput, 0) != 0);
+		return (CallDispatch(Vst2PluginCommands::SetSpeakerArrangement, 0, (Vst2IntPtr)pInput, pOutput, 0) != 0);
 	}
 
 	System::Boolean VstPluginCommandsImpl::SetBypass(System::Boolean bypass)
@@ -468,10 +639,11 @@ namespace Interop {
 	// IVstPluginCommands23
 	System::Boolean VstPluginCommandsImpl::GetSpeakerArrangement([System::Runtime::InteropServices::Out] Jacobi::Vst::Core::VstSpeakerArrangement^% input, [System::Runtime::InteropServices::Out] Jacobi::Vst::Core::VstSpeakerArrangement^% output)
 	{
-		UnmanagedPointer<::Vst2SpeakerArrangement> pInput;
-		UnmanagedPointer<::Vst2SpeakerArrangement> pOutput;
+		// the plugin returns pointers to arrangements it owns.
+		::Vst2SpeakerArrangement* pInput = NULL;
+		::Vst2SpeakerArrangement* pOutput = NULL;
 
-		if (CallDispatch(Vst2PluginCommands::GetSpeakerArrangement, 0, (Vst2IntPtr)(::Vst2SpeakerArrangement*)pInput, pOutput, 0))
+		if (CallDispatch(Vst2PluginCommands::GetSpeakerArrangement, 0, (Vst2IntPtr)&pInput, &pOutput, 0))
 		{
 			input = TypeConverter::ToManagedSpeakerArrangement(pInput);
 			output = TypeConverter::ToManagedSpeakerArrangement(pOutput);
@@ -554,6 +726,62 @@ namespace Interop {
 		return safe_cast<System::Int32>(CallDispatch(Vst2PluginCommands::MidiGetOutputChannelCount, 0, 0, 0, 0));
 	}
 
+	// IVstPluginCommandsVariableIo
+	System::Boolean VstPluginCommandsImpl::ProcessVariableIo(array<Jacobi::Vst::Core::VstAudioBuffer^>^ inputs,
+		array<Jacobi::Vst::Core::VstAudioBuffer^>^ outputs, System::Int32% inputSamplesProcessed, System::Int32% outputSamplesProcessed)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(inputs, "inputs");
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(outputs, "outputs");
+
+		int32_t inputProcessed = 0;
+		int32_t outputProcessed = 0;
+
+		::Vst2VariableIo varIo;
+		varIo.inputs = inputs->Length == 0 ? _emptyAudio32 : _audioInputs.GetArray(inputs->Length);
+		varIo.outputs = outputs->Length == 0 ? _emptyAudio32 : _audioOutputs.GetArray(outputs->Length);
+		varIo.sampleInputCount = CopyBufferPointers(varIo.inputs, inputs);
+		varIo.sampleOutputCount = CopyBufferPointers(varIo.outputs, outputs);
+		varIo.sampleInputProcessedCount = &inputProcessed;
+		varIo.sampleOutputProcessedCount = &outputProcessed;
+
+		bool result = ProcessVariableIo(&varIo);
+
+		inputSamplesProcessed = inputProcessed;
+		outputSamplesProcessed = outputProcessed;
+
+		return result;
+	}
+
+	bool VstPluginCommandsImpl::ProcessVariableIo(::Vst2VariableIo* pVarIo)
+	{
+		if (_pPlugin == NULL || _pPlugin->command == NULL)
+		{
+			return false;
+		}
+
+		_traceCtx->WriteProcess(_pPlugin->inputCount, _pPlugin->outputCount, pVarIo->sampleInputCount, pVarIo->sampleOutputCount);
+		_callRecorder->WriteProcessVariableIo(pVarIo);
+		DispatchDeferredEvents(0, pVarIo->sampleInputCount, true);
+
+		int64_t startTime = VstProcessLoadMeter::Begin();
+
+		TimelineTrace::Begin(TimelineSpan::ProcessVariableIo, _pPlugin, 0, pVarIo->sampleInputCount);
+		bool result = _pPlugin->command(_pPlugin, Vst2PluginCommands::ProcessVariableIo, 0, 0, pVarIo, 0) != 0;
+		TimelineTrace::End(TimelineSpan::ProcessVariableIo, _pPlugin, 0, result ? 1 : 0);
+
+		_loadMeter->End(startTime, pVarIo->sampleOutputCount);
+		PublishProcess(pVarIo->sampleOutputCount);
+		_eventsPending = false;
+
+		return result;
+	}
+
+	void VstPluginCommandsImpl::SetInstanceName(System::String^ name)
+	{
+		TypeConverter::StringToChar(name, _pStatistics->name, LiveStatisticsNameLength);
+		TimelineTrace::SetInstanceName(_pPlugin, _pStatistics->name);
+	}
+
 	//
 	// Legacy support
 	//
@@ -567,6 +795,7 @@ namespace Interop {
 		int32_t inputSampleCount = CopyBufferPointers(ppInputs, inputs);
 		int32_t outputSampleCount = CopyBufferPointers(ppOutputs, outputs);
 
+		DispatchDeferredEvents(0, inputSampleCount, true);
 		CallProcess32Acc(ppInputs, ppOutputs, inputSampleCount);
 	}
 
@@ -633,6 +862,12 @@ namespace Interop {
 
 	System::Boolean VstPluginCommandsImpl::SetBlockSizeAndSampleRate(System::Int32 blockSize, System::Single sampleRate)
 	{
+		_loadMeter->SetBlockSize(blockSize);
+		_loadMeter->SetSampleRate(sampleRate);
+		_pStatistics->blockSize = blockSize;
+		_pStatistics->sampleRate = sampleRate;
+		_blockSplitter->MaxBlockSize = blockSize;
+
 		return (CallDispatch(Vst2PluginCommands::SetBlockSizeAndSampleRate, 0, blockSize, 0, sampleRate) != 0);
 	}
 
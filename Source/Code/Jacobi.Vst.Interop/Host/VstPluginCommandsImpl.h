@@ -4,13 +4,23 @@
 
 #include "../pch.h"
 #include "UnmanagedArray.h"
-#include "../MemoryTracker.h"
+#include "../MemoryArena.h"
+#include "../SpeakerArrangementCache.h"
+#include "../LiveStatistics.h"
+#include "../TimelineTrace.h"
+#include "VstProcessLoadMeter.h"
+#include "VstAutoSuspend.h"
+#include "VstBlockSplitter.h"
+#include "BlockEventSplitter.h"
+#include "VstCallRecorder.h"
 
 namespace Jacobi {
 namespace Vst {
 namespace Host {
 namespace Interop {
 
+    ref class VstHostCommandProxy;
+
     /// <summary>
     /// The VstPluginCommandStub class implements the <see cref="Jacobi::Vst::Core::Host::IVstPluginCommandStub"/>
     /// interface that is called by the host to access the Plugin.
@@ -20,6 +30,7 @@ namespace Interop {
     /// interface for legacy method support.
     /// </remarks>
     private ref class VstPluginCommandsImpl : Jacobi::Vst::Core::IVstPluginCommands24,
+        Jacobi::Vst::Core::IVstPluginCommandsVariableIo,
         Jacobi::Vst::Core::Legacy::IVstPluginCommandsLegacy20, System::IDisposable
     {
     public:
@@ -29,10 +40,18 @@ namespace Interop {
         }
         !VstPluginCommandsImpl()
         {
-            _memoryTracker->ClearAll();
+            delete _pChunkArena;
+            _pChunkArena = NULL;
+            delete _pEventSplitter;
+            _pEventSplitter = NULL;
+            _arrangementCache->Clear();
             ClearCurrentEvents();
+            delete _pEventArena;
+            _pEventArena = NULL;
             delete[] _emptyAudio32;
             delete[] _emptyAudio64;
+            LiveStatistics::ReleaseSlot(_pStatistics);
+            _pStatistics = NULL;
         }
 
         // IVstPluginCommandsBase
@@ -403,11 +422,29 @@ namespace Interop {
         /// <returns>Returns the number of Midi Out channels, or 0 (zero) if not supported.</returns>
         virtual System::Int32 GetNumberOfMidiOutputChannels();
 
+        // IVstPluginCommandsVariableIo
+        /// <summary>
+        /// Called by the host to process a variable number of input samples into a variable number of output samples.
+        /// </summary>
+        /// <param name="inputs">An array with audio input buffers. The sample count is the number of input samples available.</param>
+        /// <param name="outputs">An array with audio output buffers. The sample count is the number of output samples requested.</param>
+        /// <param name="inputSamplesProcessed">Receives the number of input samples the plugin consumed.</param>
+        /// <param name="outputSamplesProcessed">Receives the number of output samples the plugin produced.</param>
+        /// <returns>Returns true if the plugin supports variable io and processed the audio.</returns>
+        virtual System::Boolean ProcessVariableIo(array<Jacobi::Vst::Core::VstAudioBuffer^>^ inputs,
+            array<Jacobi::Vst::Core::VstAudioBuffer^>^ outputs,
+            [System::Runtime::InteropServices::Out] System::Int32% inputSamplesProcessed,
+            [System::Runtime::InteropServices::Out] System::Int32% outputSamplesProcessed);
+
         // IVstPluginCommandStub
         /// <summary>
         /// Gets or sets the Plugin Context for this implementation.
         /// </summary>
-        virtual property Jacobi::Vst::Core::Host::IVstPluginContext^ PluginContext;
+        virtual property Jacobi::Vst::Core::Host::IVstPluginContext^ PluginContext
+        {
+            Jacobi::Vst::Core::Host::IVstPluginContext^ get() { return _pluginContext; }
+            void set(Jacobi::Vst::Core::Host::IVstPluginContext^ value);
+        }
 
         //
         // Legacy support
@@ -530,11 +567,46 @@ namespace Interop {
         /// <summary>Constructs a new instance based on an <b>Vst2Plugin</b> structure.</summary>
         VstPluginCommandsImpl(::Vst2Plugin* pPlugin);
 
+        // compresses the chunk directly from the plugin's memory.
+        array<System::Byte>^ GetChunkCompressed(System::Boolean isPreset);
+        // decompresses the chunk directly into the buffer passed to the plugin.
+        System::Int32 SetChunkCompressed(array<System::Byte>^ data, System::Boolean isPreset);
+        // passes the unmanaged variable io structure to the plugin (no managed buffers involved).
+        bool ProcessVariableIo(::Vst2VariableIo* pVarIo);
+        // names the instance in the live statistics segment and the timeline trace.
+        void SetInstanceName(System::String^ name);
+
+        /// <summary>Gets the meter that measures the process calls.</summary>
+        property VstProcessLoadMeter^ LoadMeter
+        { VstProcessLoadMeter^ get() { return _loadMeter; } }
+
+        /// <summary>Gets the settings for skipping process calls on silent input.</summary>
+        property VstAutoSuspend^ AutoSuspend
+        { VstAutoSuspend^ get() { return _autoSuspend; } }
+
+        /// <summary>Gets the settings for splitting large process calls.</summary>
+        property VstBlockSplitter^ BlockSplitter
+        { VstBlockSplitter^ get() { return _blockSplitter; } }
+
+        /// <summary>Gets the recorder for the calls into the plugin.</summary>
+        property VstCallRecorder^ CallRecorder
+        { VstCallRecorder^ get() { return _callRecorder; } }
+
+        /// <summary>Gets the unmanaged plugin structure.</summary>
+        property ::Vst2Plugin* Plugin
+        { ::Vst2Plugin* get() { return _pPlugin; } }
+
     private:
         ::Vst2Plugin* _pPlugin;	// the unmanaged plugin structure
 
-        // unmanaged events passed in during ProcessEvents. Will be deleted after the processing call.
+        Jacobi::Vst::Core::Host::IVstPluginContext^ _pluginContext;
+        // the host command proxy of an unmanaged plugin context (null otherwise); receives the sub-block time offset.
+        VstHostCommandProxy^ _hostCommandProxy;
+
+        // unmanaged events passed in during ProcessEvents, in _pEventArena.
+        // Released at the next ProcessEvents call that does not add to deferred events, suspend/resume and Close.
         ::Vst2Events* _currentEvents;
+        ::MemoryArena* _pEventArena;
         void ClearCurrentEvents();
 
         // an empty audio buffer array
@@ -591,14 +663,97 @@ namespace Interop {
             return sampleCount;
         }
 
+        // events passed to the plugin since the last process call.
+        bool _eventsPending;
+
+        // returns true (and clears the outputs) when the plugin does not have to be called.
+        template<typename T>
+        bool SkipSilentBlock(T** ppInputs, int32_t inputCount, T** ppOutputs, int32_t outputCount, int32_t sampleFrames)
+        {
+            bool eventsPending = _eventsPending;
+            _eventsPending = false;
+
+            if (!_autoSuspend->State->Update(ppInputs, inputCount, sampleFrames, eventsPending))
+            {
+                return false;
+            }
+
+            for (int32_t i = 0; i < outputCount; i++)
+            {
+                ZeroMemory(ppOutputs[i], sampleFrames * sizeof(T));
+            }
+
+            return true;
+        }
+
+        // events held back by ProcessEvents until the next process call; collected in _pEventSplitter.
+        bool _eventsDeferred;
+        // the events of one sub-block and the sub-block buffer pointers
+        BlockEventSplitter* _pEventSplitter;
+        UnmanagedArray<void*> _splitBuffers;
+
+        void DispatchDeferredEvents(int32_t offset, int32_t sampleCount, bool isLast);
+        void SetTimeInfoOffset(int32_t offset);
+
+        // passes the block in sub-blocks of at most MaxBlockSize samples, using pointer offsets.
+        template<typename T>
+        void ProcessSplit(T** ppInputs, int32_t inputCount, T** ppOutputs, int32_t outputCount, int32_t sampleFrames)
+        {
+            int32_t maxBlockSize = _blockSplitter->MaxBlockSize;
+
+            if (maxBlockSize <= 0 || sampleFrames <= maxBlockSize)
+            {
+                DispatchDeferredEvents(0, sampleFrames, true);
+                CallProcess(ppInputs, ppOutputs, sampleFrames);
+                return;
+            }
+
+            T** ppSubInputs = (T**)_splitBuffers.GetArray(inputCount + outputCount + 1);
+            T** ppSubOutputs = ppSubInputs + inputCount;
+
+            for (int32_t offset = 0; offset < sampleFrames; offset += maxBlockSize)
+            {
+                int32_t count = min(maxBlockSize, sampleFrames - offset);
+
+                for (int32_t i = 0; i < inputCount; i++)
+                {
+                    ppSubInputs[i] = ppInputs[i] + offset;
+                }
+                for (int32_t i = 0; i < outputCount; i++)
+                {
+                    ppSubOutputs[i] = ppOutputs[i] + offset;
+                }
+
+                DispatchDeferredEvents(offset, count, offset + count == sampleFrames);
+                SetTimeInfoOffset(offset);
+
+                CallProcess(ppSubInputs, ppSubOutputs, count);
+            }
+
+            SetTimeInfoOffset(0);
+            _blockSplitter->IncrementSplitCount();
+        }
+
         // helper methods for calling the plugin
+        void CallProcess(float** inputs, float** outputs, ::int32_t sampleFrames)
+        {
+            CallProcess32(inputs, outputs, sampleFrames);
+        }
+        void CallProcess(double** inputs, double** outputs, ::int32_t sampleFrames)
+        {
+            CallProcess64(inputs, outputs, sampleFrames);
+        }
         ::Vst2IntPtr CallDispatch(::Vst2PluginCommands command, ::int32_t index, ::Vst2IntPtr value, void* ptr, float opt)
         {
             if (_pPlugin && _pPlugin->command)
             {
                 _traceCtx->WriteDispatchBegin(safe_cast<System::Int32>(command), index, System::IntPtr(value), System::IntPtr(ptr), opt);
+                _callRecorder->WriteDispatch(command, index, value, ptr, opt);
+                _pStatistics->AddDispatch((int32_t)command);
 
+                TimelineTrace::Begin(TimelineSpan::Dispatch, _pPlugin, (int32_t)command, index);
                 ::Vst2IntPtr result = _pPlugin->command(_pPlugin, command, index, value, ptr, opt);
+                TimelineTrace::End(TimelineSpan::Dispatch, _pPlugin, (int32_t)command, result);
 
                 _traceCtx->WriteDispatchEnd(System::IntPtr(result));
 
@@ -612,8 +767,16 @@ namespace Interop {
             if (_pPlugin && _pPlugin->replace)
             {
                 _traceCtx->WriteProcess(_pPlugin->inputCount, _pPlugin->outputCount, sampleFrames, sampleFrames);
+                _callRecorder->WriteProcess(inputs, sampleFrames, false);
 
+                int64_t startTime = VstProcessLoadMeter::Begin();
+
+                TimelineTrace::Begin(TimelineSpan::Process32, _pPlugin, 0, sampleFrames);
                 _pPlugin->replace(_pPlugin, inputs, outputs, sampleFrames);
+                TimelineTrace::End(TimelineSpan::Process32, _pPlugin, 0, 0);
+
+                _loadMeter->End(startTime, sampleFrames);
+                PublishProcess(sampleFrames);
             }
         }
         void CallProcess64(double** inputs, double** outputs, ::int32_t sampleFrames)
@@ -621,8 +784,16 @@ namespace Interop {
             if (_pPlugin && _pPlugin->replaceDouble)
             {
                 _traceCtx->WriteProcess(_pPlugin->inputCount, _pPlugin->inputCount, sampleFrames, sampleFrames);
+                _callRecorder->WriteProcess(inputs, sampleFrames);
+
+                int64_t startTime = VstProcessLoadMeter::Begin();
 
+                TimelineTrace::Begin(TimelineSpan::Process64, _pPlugin, 0, sampleFrames);
                 _pPlugin->replaceDouble(_pPlugin, inputs, outputs, sampleFrames);
+                TimelineTrace::End(TimelineSpan::Process64, _pPlugin, 0, 0);
+
+                _loadMeter->End(startTime, sampleFrames);
+                PublishProcess(sampleFrames);
             }
         }
         void CallSetParameter(::int32_t index, float parameter)
@@ -630,8 +801,12 @@ namespace Interop {
             if (_pPlugin && _pPlugin->parameterSet)
             {
                 _traceCtx->WriteSetParameter(index, parameter);
+                _callRecorder->WriteSetParameter(index, parameter);
+                _pStatistics->parameterCount++;
 
+                TimelineTrace::Begin(TimelineSpan::SetParameter, _pPlugin, 0, index);
                 _pPlugin->parameterSet(_pPlugin, index, parameter);
+                TimelineTrace::End(TimelineSpan::SetParameter, _pPlugin, 0, 0);
             }
         }
         float CallGetParameter(::int32_t index)
@@ -639,8 +814,12 @@ namespace Interop {
             if (_pPlugin && _pPlugin->parameterGet)
             {
                 _traceCtx->WriteGetParameterBegin(index);
+                _callRecorder->WriteGetParameter(index);
+                _pStatistics->parameterCount++;
 
+                TimelineTrace::Begin(TimelineSpan::GetParameter, _pPlugin, 0, index);
                 float result = _pPlugin->parameterGet(_pPlugin, index);
+                TimelineTrace::End(TimelineSpan::GetParameter, _pPlugin, 0, 0);
 
                 _traceCtx->WriteGetParameterEnd(result);
 
@@ -656,13 +835,36 @@ namespace Interop {
             if (_pPlugin && _pPlugin->process)
             {
                 _traceCtx->WriteProcess(_pPlugin->inputCount, _pPlugin->outputCount, sampleFrames, sampleFrames);
+                _callRecorder->WriteProcess(inputs, sampleFrames, true);
+
+                int64_t startTime = VstProcessLoadMeter::Begin();
 
+                TimelineTrace::Begin(TimelineSpan::ProcessAccumulating, _pPlugin, 0, sampleFrames);
                 _pPlugin->process(_pPlugin, inputs, outputs, sampleFrames);
+                TimelineTrace::End(TimelineSpan::ProcessAccumulating, _pPlugin, 0, 0);
+
+                _loadMeter->End(startTime, sampleFrames);
+                PublishProcess(sampleFrames);
             }
         }
 
-        Jacobi::Vst::Interop::MemoryTracker^ _memoryTracker;
+        // the chunks passed to ChunkSet, released at suspend/resume and Close.
+        ::MemoryArena* _pChunkArena;
         Jacobi::Vst::Core::Diagnostics::TraceContext^ _traceCtx;
+        VstProcessLoadMeter^ _loadMeter;
+        Jacobi::Vst::Interop::SpeakerArrangementCache^ _arrangementCache;
+        VstAutoSuspend^ _autoSuspend;
+        VstBlockSplitter^ _blockSplitter;
+        VstCallRecorder^ _callRecorder;
+
+        // the counters of this instance in the live statistics segment.
+        ::LiveStatisticsSlot* _pStatistics;
+
+        void PublishProcess(int32_t sampleFrames)
+        {
+            _pStatistics->AddProcess(sampleFrames);
+            _pStatistics->SetLoad(_loadMeter->LastLoad, _loadMeter->PeakLoad, _loadMeter->DeadlineMissCount);
+        }
     };
 
 }}}} // Jacobi::Vst::Host::Interop
\ No newline at end of file
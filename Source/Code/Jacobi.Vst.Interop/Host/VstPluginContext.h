@@ -1,5 +1,10 @@
 #pragma once
 
+#include "VstProcessLoadMeter.h"
+#include "VstAutoSuspend.h"
+#include "VstBlockSplitter.h"
+#include "VstCallRecorder.h"
+
 namespace Jacobi {
 namespace Vst {
 namespace Host {
@@ -52,6 +57,34 @@ namespace Interop {
 			throw gcnew System::NotSupportedException("Shell Plugin support is only available for unmanaged plugins.");
 		}
 
+		/// <summary>
+		/// Gets the meter that measures the load of the plugin's process calls.
+		/// </summary>
+		/// <remarks>Returns null when the plugin does not support it (managed plugins).</remarks>
+		virtual property VstProcessLoadMeter^ ProcessLoadMeter
+		{ VstProcessLoadMeter^ get() { return nullptr; } }
+
+		/// <summary>
+		/// Gets the settings for suspending the plugin while its input is silent.
+		/// </summary>
+		/// <remarks>Returns null when the plugin does not support it (managed plugins).</remarks>
+		virtual property VstAutoSuspend^ AutoSuspend
+		{ VstAutoSuspend^ get() { return nullptr; } }
+
+		/// <summary>
+		/// Gets the settings for splitting process calls that are larger than the plugin's block size.
+		/// </summary>
+		/// <remarks>Returns null when the plugin does not support it (managed plugins).</remarks>
+		virtual property VstBlockSplitter^ BlockSplitter
+		{ VstBlockSplitter^ get() { return nullptr; } }
+
+		/// <summary>
+		/// Gets the recorder for the calls the host makes into the plugin.
+		/// </summary>
+		/// <remarks>Returns null when the plugin does not support it (managed plugins).</remarks>
+		virtual property VstCallRecorder^ CallRecorder
+		{ VstCallRecorder^ get() { return nullptr; } }
+
 		// IVstPluginContext interface implementation
 		/// <summary>
 		/// Sets a new <paramref name="value"/> for the <paramref name="keyName"/> property.
@@ -0,0 +1,107 @@
+#include "pch.h"
+#include "VstPluginPreloader.h"
+#include "NativePluginLoader.h"
+#include <vcclr.h>
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	VstPluginPreloader::VstPluginPreloader()
+	{}
+
+	VstPluginPreloader::~VstPluginPreloader()
+	{
+		this->!VstPluginPreloader();
+	}
+
+	VstPluginPreloader::!VstPluginPreloader()
+	{
+		if(_pHandles != NULL)
+		{
+			for(int32_t i = 0; i < _handleCount; i++)
+			{
+				NativePluginLoader::Unload(_pHandles[i]);
+			}
+
+			delete[] _pHandles;
+			_pHandles = NULL;
+		}
+	}
+
+	VstPluginPreloader^ VstPluginPreloader::Preload(System::Collections::Generic::IEnumerable<System::String^>^ pluginPaths, System::Int32 threadCount)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(pluginPaths, "pluginPaths");
+
+		auto paths = gcnew System::Collections::Generic::List<System::String^>(pluginPaths);
+		int32_t count = paths->Count;
+
+		auto preloader = gcnew VstPluginPreloader();
+		preloader->_paths = paths->AsReadOnly();
+
+		auto handles = gcnew array<System::Runtime::InteropServices::GCHandle>(count);
+		auto ppPaths = new const wchar_t*[count];
+		auto pModules = new NativePluginModule[count];
+		auto pResults = new NativeLoadResult[count];
+
+		try
+		{
+			// pin the strings for the duration of the (blocking) preload; their characters are passed as is.
+			for(int32_t i = 0; i < count; i++)
+			{
+				Jacobi::Vst::Core::Throw::IfArgumentIsNullOrEmpty(paths[i], "pluginPaths");
+
+				handles[i] = System::Runtime::InteropServices::GCHandle::Alloc(paths[i], System::Runtime::InteropServices::GCHandleType::Pinned);
+				ppPaths[i] = (const wchar_t*)handles[i].AddrOfPinnedObject().ToPointer();
+			}
+
+			preloader->_loadedCount = NativePluginLoader::Preload(ppPaths, count, pModules, pResults, threadCount);
+
+			preloader->_pHandles = new void*[count];
+			preloader->_handleCount = count;
+
+			auto status = gcnew array<VstPluginPreloadStatus>(count);
+
+			for(int32_t i = 0; i < count; i++)
+			{
+				preloader->_pHandles[i] = pModules[i].handle;
+
+				switch(pResults[i])
+				{
+				case NativeLoadResult::Success:
+					status[i] = VstPluginPreloadStatus::Loaded;
+					break;
+				case NativeLoadResult::BadImageFormat:
+					status[i] = VstPluginPreloadStatus::BadImageFormat;
+					break;
+				case NativeLoadResult::EntryPointNotFound:
+					status[i] = VstPluginPreloadStatus::EntryPointNotFound;
+					break;
+				default:
+					status[i] = VstPluginPreloadStatus::LoadFailed;
+					break;
+				}
+			}
+
+			preloader->_status = System::Array::AsReadOnly(status);
+		}
+		finally
+		{
+			for(int32_t i = 0; i < count; i++)
+			{
+				if(handles[i].IsAllocated)
+				{
+					handles[i].Free();
+				}
+			}
+
+			delete[] ppPaths;
+			delete[] pModules;
+			delete[] pResults;
+		}
+
+		return preloader;
+	}
+
+}}}} // Jacobi::Vst::Host::Interop
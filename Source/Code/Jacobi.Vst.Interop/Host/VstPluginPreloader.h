@@ -0,0 +1,77 @@
+#pragma once
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	/// <summary>
+	/// The result of preloading a single plugin library.
+	/// </summary>
+	public enum class VstPluginPreloadStatus
+	{
+		/// <summary>The library is loaded and exports a VST2 entry point.</summary>
+		Loaded,
+		/// <summary>The library could not be opened (missing file or dependency).</summary>
+		LoadFailed,
+		/// <summary>The file is not a library for this process (32/64 bit mismatch).</summary>
+		BadImageFormat,
+		/// <summary>The library exports neither 'VSTPluginMain' nor 'main'.</summary>
+		EntryPointNotFound,
+	};
+
+	/// <summary>
+	/// The VstPluginPreloader class loads unmanaged plugin libraries in parallel and verifies their entry points.
+	/// </summary>
+	/// <remarks>The libraries stay loaded until the instance is disposed. A <see cref="VstPluginContext::Create"/>
+	/// call for a preloaded path then only increments the load count of the library, which makes
+	/// loading a large set of plugins (a scan or a project) a lot faster.
+	/// The plugins' entry points are not called; that happens on <see cref="VstPluginContext::Create"/>.</remarks>
+	public ref class VstPluginPreloader sealed : System::IDisposable
+	{
+	public:
+		/// <summary>
+		/// Loads the <paramref name="pluginPaths"/> on one thread per processor.
+		/// </summary>
+		/// <param name="pluginPaths">The full paths to the plugin libraries. Must not be null.</param>
+		/// <returns>Returns the loaded libraries. Dispose the instance to unload them.</returns>
+		static VstPluginPreloader^ Preload(System::Collections::Generic::IEnumerable<System::String^>^ pluginPaths)
+		{ return Preload(pluginPaths, 0); }
+
+		/// <summary>
+		/// Loads the <paramref name="pluginPaths"/> on up to <paramref name="threadCount"/> threads.
+		/// </summary>
+		/// <param name="pluginPaths">The full paths to the plugin libraries. Must not be null.</param>
+		/// <param name="threadCount">The maximum number of threads. Zero uses one thread per processor.</param>
+		/// <returns>Returns the loaded libraries. Dispose the instance to unload them.</returns>
+		static VstPluginPreloader^ Preload(System::Collections::Generic::IEnumerable<System::String^>^ pluginPaths, System::Int32 threadCount);
+
+		/// <summary>Unloads all libraries.</summary>
+		~VstPluginPreloader();
+		/// <summary>Unloads all libraries.</summary>
+		!VstPluginPreloader();
+
+		/// <summary>Gets the preloaded paths in the order they were passed in.</summary>
+		property System::Collections::Generic::IList<System::String^>^ PluginPaths
+		{ System::Collections::Generic::IList<System::String^>^ get() { return _paths; } }
+
+		/// <summary>Gets the preload status for each of the <see cref="PluginPaths"/>.</summary>
+		property System::Collections::Generic::IList<VstPluginPreloadStatus>^ Status
+		{ System::Collections::Generic::IList<VstPluginPreloadStatus>^ get() { return _status; } }
+
+		/// <summary>Gets the number of libraries that are loaded and export an entry point.</summary>
+		property System::Int32 LoadedCount { System::Int32 get() { return _loadedCount; } }
+
+	private:
+		VstPluginPreloader();
+
+		System::Collections::Generic::IList<System::String^>^ _paths;
+		System::Collections::Generic::IList<VstPluginPreloadStatus>^ _status;
+		System::Int32 _loadedCount;
+
+		// one handle per path (NULL when not loaded).
+		void** _pHandles;
+		int32_t _handleCount;
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,306 @@
+#include "pch.h"
+#include "VstPresetFileReader.h"
+#include "..\Properties\Resources.h"
+#include <vcclr.h>
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	VstPresetFileReader::VstPresetFileReader(System::String^ filePath)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNullOrEmpty(filePath, "filePath");
+
+		_filePath = filePath;
+
+		pin_ptr<const wchar_t> pFilePath = PtrToStringChars(filePath);
+
+		_hFile = ::CreateFileW(pFilePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+
+		if(_hFile == INVALID_HANDLE_VALUE)
+		{
+			_hFile = NULL;
+			throw gcnew System::IO::FileNotFoundException(filePath);
+		}
+
+		try
+		{
+			LARGE_INTEGER fileSize;
+			if(!::GetFileSizeEx(_hFile, &fileSize) ||
+				fileSize.QuadPart < (LONGLONG)sizeof(::Vst2PresetProgramHeader))
+			{
+				ThrowInvalidData();
+			}
+
+			_viewSize = fileSize.QuadPart;
+
+			// map the whole file, pages are loaded on first access.
+			_hMapping = ::CreateFileMappingW(_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+			if(_hMapping != NULL)
+			{
+				_pView = (const uint8_t*)::MapViewOfFile(_hMapping, FILE_MAP_READ, 0, 0, 0);
+			}
+
+			if(_pView == NULL)
+			{
+				throw gcnew System::IO::IOException(
+					System::String::Format(
+						Jacobi::Vst::Interop::Properties::Resources::VstPresetFileReader_MapFailed, filePath));
+			}
+
+			ParseHeader();
+		}
+		catch(...)
+		{
+			Unmap();
+
+			throw;
+		}
+	}
+
+	VstPresetFileReader::~VstPresetFileReader()
+	{
+		this->!VstPresetFileReader();
+	}
+
+	VstPresetFileReader::!VstPresetFileReader()
+	{
+		Unmap();
+	}
+
+	// only reads the header(s), programs are located by offset.
+	void VstPresetFileReader::ParseHeader()
+	{
+		auto pHeader = (const ::Vst2PresetProgramHeader*)_pView;
+
+		if(::Vst2PresetSwap(pHeader->chunkMagic) != ::Vst2PresetChunkMagic)
+		{
+			ThrowInvalidData();
+		}
+
+		_pluginId = ::Vst2PresetSwap(pHeader->pluginId);
+		_pluginVersion = ::Vst2PresetSwap(pHeader->pluginVersion);
+
+		switch(::Vst2PresetSwap(pHeader->fxMagic))
+		{
+		case ::Vst2PresetProgramMagic:
+			_fileType = VstPresetFileType::Program;
+			_programCount = 1;
+			_parameterCount = ::Vst2PresetSwap(pHeader->parameterCount);
+			_programOffset = 0;
+			_programStride = ::Vst2PresetProgramSize(_parameterCount);
+			break;
+		case ::Vst2PresetProgramChunkMagic:
+			_fileType = VstPresetFileType::ProgramChunk;
+			_programCount = 1;
+			_programOffset = 0;
+			_chunkOffset = sizeof(::Vst2PresetProgramHeader);
+			break;
+		case ::Vst2PresetBankMagic:
+		case ::Vst2PresetBankChunkMagic:
+		{
+			if(_viewSize < (int64_t)sizeof(::Vst2PresetBankHeader))
+			{
+				ThrowInvalidData();
+			}
+
+			auto pBankHeader = (const ::Vst2PresetBankHeader*)_pView;
+
+			_programCount = ::Vst2PresetSwap(pBankHeader->programCount);
+			if(::Vst2PresetSwap(pBankHeader->version) >= 2)
+			{
+				_currentProgram = ::Vst2PresetSwap(pBankHeader->currentProgram);
+			}
+
+			if(::Vst2PresetSwap(pBankHeader->fxMagic) == ::Vst2PresetBankChunkMagic)
+			{
+				_fileType = VstPresetFileType::BankChunk;
+				_chunkOffset = sizeof(::Vst2PresetBankHeader);
+			}
+			else
+			{
+				_fileType = VstPresetFileType::Bank;
+				_programOffset = sizeof(::Vst2PresetBankHeader);
+
+				// all programs in a bank have the same number of parameters.
+				if(_programCount > 0)
+				{
+					if(_viewSize < _programOffset + (int64_t)sizeof(::Vst2PresetProgramHeader))
+					{
+						ThrowInvalidData();
+					}
+
+					auto pFirst = (const ::Vst2PresetProgramHeader*)(_pView + _programOffset);
+					_parameterCount = ::Vst2PresetSwap(pFirst->parameterCount);
+				}
+
+				_programStride = ::Vst2PresetProgramSize(_parameterCount);
+			}
+		}	break;
+		default:
+			ThrowInvalidData();
+			break;
+		}
+
+		if(_programCount < 0 || _parameterCount < 0)
+		{
+			ThrowInvalidData();
+		}
+
+		if(_chunkOffset != 0)
+		{
+			if(_viewSize < _chunkOffset + ::Vst2PresetChunkSizeLen)
+			{
+				ThrowInvalidData();
+			}
+
+			_chunkSize = ::Vst2PresetSwap(*(const int32_t*)(_pView + _chunkOffset));
+			_chunkOffset += ::Vst2PresetChunkSizeLen;
+
+			if(_chunkSize < 0 || _viewSize < _chunkOffset + _chunkSize)
+			{
+				ThrowInvalidData();
+			}
+		}
+		// the counts come from the file: divide instead of multiply so a large count cannot overflow.
+		else if(_viewSize < _programOffset || _programCount > (_viewSize - _programOffset) / _programStride)
+		{
+			ThrowInvalidData();
+		}
+	}
+
+	const ::Vst2PresetProgramHeader* VstPresetFileReader::GetProgramHeader(System::Int32 index)
+	{
+		ThrowIfDisposed();
+
+		if(index < 0 || index >= _programCount)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("index");
+		}
+
+		if(_fileType == VstPresetFileType::BankChunk)
+		{
+			throw gcnew System::InvalidOperationException(
+				Jacobi::Vst::Interop::Properties::Resources::VstPresetFileReader_NoProgramData);
+		}
+
+		auto pHeader = (const ::Vst2PresetProgramHeader*)(_pView + _programOffset + (_programStride * index));
+
+		// the bank header promised this layout, verify it when the program is actually used.
+		if(::Vst2PresetSwap(pHeader->chunkMagic) != ::Vst2PresetChunkMagic)
+		{
+			ThrowInvalidData();
+		}
+
+		if(_fileType == VstPresetFileType::Bank &&
+			(::Vst2PresetSwap(pHeader->fxMagic) != ::Vst2PresetProgramMagic ||
+			::Vst2PresetSwap(pHeader->parameterCount) != _parameterCount))
+		{
+			ThrowInvalidData();
+		}
+
+		return pHeader;
+	}
+
+	System::String^ VstPresetFileReader::GetProgramName(System::Int32 index)
+	{
+		auto pHeader = GetProgramHeader(index);
+
+		return gcnew System::String((char*)pHeader->name, 0, (int)strnlen(pHeader->name, ::Vst2PresetProgramNameLen));
+	}
+
+	void VstPresetFileReader::ReadParameters(System::Int32 index, array<System::Single>^ parameters)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(parameters, "parameters");
+
+		auto pHeader = GetProgramHeader(index);
+
+		if(_fileType == VstPresetFileType::ProgramChunk)
+		{
+			throw gcnew System::InvalidOperationException(
+				Jacobi::Vst::Interop::Properties::Resources::VstPresetFileReader_NoProgramData);
+		}
+
+		if(parameters->Length < _parameterCount)
+		{
+			throw gcnew System::ArgumentException(
+				Jacobi::Vst::Interop::Properties::Resources::VstPresetFileReader_ParameterArrayTooSmall, "parameters");
+		}
+
+		auto pValues = (const uint32_t*)(pHeader + 1);
+
+		for(int n = 0; n < _parameterCount; n++)
+		{
+			parameters[n] = ::Vst2PresetFloatFromFile(pValues[n]);
+		}
+	}
+
+	array<System::Single>^ VstPresetFileReader::ReadParameters(System::Int32 index)
+	{
+		auto parameters = gcnew array<System::Single>(_parameterCount);
+
+		ReadParameters(index, parameters);
+
+		return parameters;
+	}
+
+	System::IO::UnmanagedMemoryStream^ VstPresetFileReader::OpenProgram(System::Int32 index)
+	{
+		auto pHeader = GetProgramHeader(index);
+
+		int64_t length = _fileType == VstPresetFileType::ProgramChunk ? _viewSize : _programStride;
+
+		return gcnew System::IO::UnmanagedMemoryStream((unsigned char*)pHeader, length);
+	}
+
+	System::IO::UnmanagedMemoryStream^ VstPresetFileReader::OpenChunk()
+	{
+		ThrowIfDisposed();
+
+		if(_chunkOffset == 0)
+		{
+			throw gcnew System::InvalidOperationException(
+				Jacobi::Vst::Interop::Properties::Resources::VstPresetFileReader_NoChunkData);
+		}
+
+		return gcnew System::IO::UnmanagedMemoryStream((unsigned char*)(_pView + _chunkOffset), _chunkSize);
+	}
+
+	void VstPresetFileReader::ThrowInvalidData()
+	{
+		throw gcnew System::IO::InvalidDataException(
+			System::String::Format(
+				Jacobi::Vst::Interop::Properties::Resources::VstPresetFileReader_InvalidFormat, _filePath));
+	}
+
+	void VstPresetFileReader::ThrowIfDisposed()
+	{
+		if(_pView == NULL)
+		{
+			throw gcnew System::ObjectDisposedException("VstPresetFileReader");
+		}
+	}
+
+	void VstPresetFileReader::Unmap()
+	{
+		if(_pView != NULL)
+		{
+			::UnmapViewOfFile(_pView);
+			_pView = NULL;
+		}
+
+		if(_hMapping != NULL)
+		{
+			::CloseHandle(_hMapping);
+			_hMapping = NULL;
+		}
+
+		if(_hFile != NULL)
+		{
+			::CloseHandle(_hFile);
+			_hFile = NULL;
+		}
+	}
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Vst2PresetFormat.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	/// <summary>
+	/// Indicates the type of content stored in a preset (fxp/fxb) file.
+	/// </summary>
+	public enum class VstPresetFileType
+	{
+		/// <summary>A single program with parameter values (fxp).</summary>
+		Program,
+		/// <summary>A single program stored as an opaque plugin chunk (fxp).</summary>
+		ProgramChunk,
+		/// <summary>A bank of programs with parameter values (fxb).</summary>
+		Bank,
+		/// <summary>A bank stored as an opaque plugin chunk (fxb).</summary>
+		BankChunk,
+	};
+
+	/// <summary>
+	/// The VstPresetFileReader class provides read access to a preset (fxp) or bank (fxb) file
+	/// without loading the file into memory.
+	/// </summary>
+	/// <remarks>The file is memory-mapped and only the file header is parsed on construction.
+	/// Program names and parameter values are decoded (from big-endian) when they are requested.
+	/// The streams returned by <see cref="OpenProgram"/> and <see cref="OpenChunk"/> are views
+	/// on the mapped file and become invalid when this instance is disposed.</remarks>
+	public ref class VstPresetFileReader sealed : System::IDisposable
+	{
+	public:
+		/// <summary>Opens the preset file at <paramref name="filePath"/> and reads its header.</summary>
+		/// <param name="filePath">The path to an fxp or fxb file. Must not be null or empty.</param>
+		/// <exception cref="System::IO::FileNotFoundException">Thrown when the file cannot be opened.</exception>
+		/// <exception cref="System::IO::InvalidDataException">Thrown when the file is not a valid preset file.</exception>
+		VstPresetFileReader(System::String^ filePath);
+		/// <summary>Disposes the instance and unmaps the file.</summary>
+		~VstPresetFileReader();
+		/// <summary>Unmaps the file.</summary>
+		!VstPresetFileReader();
+
+		/// <summary>Gets the type of content of the preset file.</summary>
+		property VstPresetFileType FileType { VstPresetFileType get() { return _fileType; } }
+		/// <summary>Gets the unique plugin id the preset file was written for.</summary>
+		property System::Int32 PluginID { System::Int32 get() { return _pluginId; } }
+		/// <summary>Gets the version of the plugin the preset file was written with.</summary>
+		property System::Int32 PluginVersion { System::Int32 get() { return _pluginVersion; } }
+		/// <summary>Gets the number of programs. Returns 1 for program (fxp) files.</summary>
+		property System::Int32 ProgramCount { System::Int32 get() { return _programCount; } }
+		/// <summary>Gets the number of parameter values per program. Returns 0 for chunk files.</summary>
+		property System::Int32 ParameterCount { System::Int32 get() { return _parameterCount; } }
+		/// <summary>Gets the index of the current program stored in a bank (version 2 only).</summary>
+		property System::Int32 CurrentProgram { System::Int32 get() { return _currentProgram; } }
+
+		/// <summary>Decodes the name of the program at <paramref name="index"/>.</summary>
+		/// <param name="index">A zero-based index smaller than <see cref="ProgramCount"/>.</param>
+		/// <returns>Returns the program name.</returns>
+		/// <exception cref="System::InvalidOperationException">Thrown for <see cref="VstPresetFileType"/>.BankChunk files.</exception>
+		System::String^ GetProgramName(System::Int32 index);
+
+		/// <summary>Decodes the parameter values of the program at <paramref name="index"/> into <paramref name="parameters"/>.</summary>
+		/// <param name="index">A zero-based index smaller than <see cref="ProgramCount"/>.</param>
+		/// <param name="parameters">Receives the values. Must not be null and must hold
+		/// at least <see cref="ParameterCount"/> elements.</param>
+		/// <exception cref="System::InvalidOperationException">Thrown for chunk files.</exception>
+		void ReadParameters(System::Int32 index, array<System::Single>^ parameters);
+
+		/// <summary>Decodes the parameter values of the program at <paramref name="index"/>.</summary>
+		/// <param name="index">A zero-based index smaller than <see cref="ProgramCount"/>.</param>
+		/// <returns>Returns a new array with <see cref="ParameterCount"/> values.</returns>
+		/// <exception cref="System::InvalidOperationException">Thrown for chunk files.</exception>
+		array<System::Single>^ ReadParameters(System::Int32 index);
+
+		/// <summary>Opens a read-only view on the raw (encoded) program data at <paramref name="index"/>, including its header.</summary>
+		/// <param name="index">A zero-based index smaller than <see cref="ProgramCount"/>.</param>
+		/// <returns>Returns a stream that does not copy the file data.</returns>
+		/// <remarks>The content of the view can be written to an fxp file as is.</remarks>
+		/// <exception cref="System::InvalidOperationException">Thrown for <see cref="VstPresetFileType"/>.BankChunk files.</exception>
+		System::IO::UnmanagedMemoryStream^ OpenProgram(System::Int32 index);
+
+		/// <summary>Opens a read-only view on the opaque plugin chunk.</summary>
+		/// <returns>Returns a stream that does not copy the file data.</returns>
+		/// <exception cref="System::InvalidOperationException">Thrown when the file is not a chunk file.</exception>
+		System::IO::UnmanagedMemoryStream^ OpenChunk();
+
+	private:
+		System::String^ _filePath;
+
+		HANDLE _hFile;
+		HANDLE _hMapping;
+		const uint8_t* _pView;
+		int64_t _viewSize;
+
+		VstPresetFileType _fileType;
+		System::Int32 _pluginId;
+		System::Int32 _pluginVersion;
+		System::Int32 _programCount;
+		System::Int32 _parameterCount;
+		System::Int32 _currentProgram;
+
+		// location of the first program and the distance between programs.
+		int64_t _programOffset;
+		int64_t _programStride;
+		// location of the opaque chunk data.
+		int64_t _chunkOffset;
+		int32_t _chunkSize;
+
+		void ParseHeader();
+		const Vst2PresetProgramHeader* GetProgramHeader(System::Int32 index);
+		void ThrowInvalidData();
+		void ThrowIfDisposed();
+		void Unmap();
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,231 @@
+#include "pch.h"
+#include "VstPresetFileWriter.h"
+#include "..\TypeConverter.h"
+#include "..\Properties\Resources.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	VstPresetFileWriter::VstPresetFileWriter(System::IO::Stream^ output)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(output, "output");
+
+		_output = output;
+		_buffer = gcnew array<System::Byte>(sizeof(::Vst2PresetBankHeader));
+	}
+
+	void VstPresetFileWriter::WriteProgram(System::Int32 pluginId, System::Int32 pluginVersion, System::String^ name, array<System::Single>^ parameters)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(parameters, "parameters");
+		ThrowIfInBank();
+
+		WriteProgramInternal(pluginId, pluginVersion, name, parameters);
+	}
+
+	void VstPresetFileWriter::WriteProgramChunk(System::Int32 pluginId, System::Int32 pluginVersion, System::String^ name, array<System::Byte>^ chunk)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(chunk, "chunk");
+		ThrowIfInBank();
+
+		WriteChunkInternal(::Vst2PresetProgramChunkMagic, pluginId, pluginVersion, name, 0, 0, chunk);
+	}
+
+	void VstPresetFileWriter::WriteBankChunk(System::Int32 pluginId, System::Int32 pluginVersion, System::Int32 programCount,
+		System::Int32 currentProgram, array<System::Byte>^ chunk)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(chunk, "chunk");
+		ThrowIfInBank();
+
+		WriteChunkInternal(::Vst2PresetBankChunkMagic, pluginId, pluginVersion, nullptr, programCount, currentProgram, chunk);
+	}
+
+	void VstPresetFileWriter::BeginBank(System::Int32 pluginId, System::Int32 pluginVersion, System::Int32 programCount,
+		System::Int32 parameterCount, System::Int32 currentProgram)
+	{
+		ThrowIfInBank();
+
+		if(programCount < 0)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("programCount");
+		}
+		if(parameterCount < 0)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("parameterCount");
+		}
+
+		// the total size is known up front, so the header never has to be patched (no seek).
+		int64_t byteSize = sizeof(::Vst2PresetBankHeader) + (::Vst2PresetProgramSize(parameterCount) * programCount)
+			- (2 * sizeof(int32_t));
+		if(byteSize > System::Int32::MaxValue)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("programCount");
+		}
+
+		{
+			pin_ptr<System::Byte> pBuffer = &_buffer[0];
+			auto pHeader = (::Vst2PresetBankHeader*)pBuffer;
+			memset(pHeader, 0, sizeof(::Vst2PresetBankHeader));
+
+			pHeader->chunkMagic = ::Vst2PresetSwap(::Vst2PresetChunkMagic);
+			pHeader->byteSize = ::Vst2PresetSwap((int32_t)byteSize);
+			pHeader->fxMagic = ::Vst2PresetSwap(::Vst2PresetBankMagic);
+			pHeader->version = ::Vst2PresetSwap(2);
+			pHeader->pluginId = ::Vst2PresetSwap(pluginId);
+			pHeader->pluginVersion = ::Vst2PresetSwap(pluginVersion);
+			pHeader->programCount = ::Vst2PresetSwap(programCount);
+			pHeader->currentProgram = ::Vst2PresetSwap(currentProgram);
+		}
+
+		_output->Write(_buffer, 0, sizeof(::Vst2PresetBankHeader));
+
+		_pluginId = pluginId;
+		_pluginVersion = pluginVersion;
+		_bankParameterCount = parameterCount;
+		_bankProgramsToWrite = programCount;
+		_inBank = true;
+	}
+
+	void VstPresetFileWriter::WriteBankProgram(System::String^ name, array<System::Single>^ parameters)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(parameters, "parameters");
+
+		if(!_inBank || _bankProgramsToWrite == 0)
+		{
+			throw gcnew System::InvalidOperationException(
+				Jacobi::Vst::Interop::Properties::Resources::VstPresetFileWriter_NoBankProgramExpected);
+		}
+
+		if(parameters->Length != _bankParameterCount)
+		{
+			throw gcnew System::ArgumentException(
+				Jacobi::Vst::Interop::Properties::Resources::VstPresetFileWriter_ParameterCountMismatch, "parameters");
+		}
+
+		WriteProgramInternal(_pluginId, _pluginVersion, name, parameters);
+
+		_bankProgramsToWrite--;
+	}
+
+	void VstPresetFileWriter::EndBank()
+	{
+		if(!_inBank)
+		{
+			throw gcnew System::InvalidOperationException(
+				Jacobi::Vst::Interop::Properties::Resources::VstPresetFileWriter_NoBankStarted);
+		}
+
+		if(_bankProgramsToWrite != 0)
+		{
+			throw gcnew System::InvalidOperationException(
+				Jacobi::Vst::Interop::Properties::Resources::VstPresetFileWriter_BankIncomplete);
+		}
+
+		_inBank = false;
+		_output->Flush();
+	}
+
+	void VstPresetFileWriter::WriteProgramInternal(System::Int32 pluginId, System::Int32 pluginVersion, System::String^ name, array<System::Single>^ parameters)
+	{
+		int64_t size = ::Vst2PresetProgramSize(parameters->Length);
+		if(size > System::Int32::MaxValue)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("parameters");
+		}
+
+		EnsureBuffer((int)size);
+
+		{
+			pin_ptr<System::Byte> pBuffer = &_buffer[0];
+			auto pHeader = (::Vst2PresetProgramHeader*)pBuffer;
+			memset(pHeader, 0, sizeof(::Vst2PresetProgramHeader));
+
+			pHeader->chunkMagic = ::Vst2PresetSwap(::Vst2PresetChunkMagic);
+			pHeader->byteSize = ::Vst2PresetSwap((int32_t)(size - (2 * sizeof(int32_t))));
+			pHeader->fxMagic = ::Vst2PresetSwap(::Vst2PresetProgramMagic);
+			pHeader->version = ::Vst2PresetSwap(1);
+			pHeader->pluginId = ::Vst2PresetSwap(pluginId);
+			pHeader->pluginVersion = ::Vst2PresetSwap(pluginVersion);
+			pHeader->parameterCount = ::Vst2PresetSwap(parameters->Length);
+			TypeConverter::StringToChar(name, pHeader->name, ::Vst2PresetProgramNameLen);
+
+			auto pValues = (uint32_t*)(pHeader + 1);
+			for(int n = 0; n < parameters->Length; n++)
+			{
+				pValues[n] = ::Vst2PresetFloatToFile(parameters[n]);
+			}
+		}
+
+		_output->Write(_buffer, 0, (int)size);
+	}
+
+	void VstPresetFileWriter::WriteChunkInternal(System::Int32 fxMagic, System::Int32 pluginId, System::Int32 pluginVersion, System::String^ name,
+		System::Int32 programCount, System::Int32 currentProgram, array<System::Byte>^ chunk)
+	{
+		bool isBank = fxMagic == ::Vst2PresetBankChunkMagic;
+		int headerSize = isBank ? sizeof(::Vst2PresetBankHeader) : sizeof(::Vst2PresetProgramHeader);
+
+		int64_t byteSize = (int64_t)headerSize + ::Vst2PresetChunkSizeLen + chunk->Length - (2 * sizeof(int32_t));
+		if(byteSize > System::Int32::MaxValue)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("chunk");
+		}
+
+		EnsureBuffer(headerSize + ::Vst2PresetChunkSizeLen);
+
+		{
+			pin_ptr<System::Byte> pBuffer = &_buffer[0];
+			memset(pBuffer, 0, headerSize);
+
+			if(isBank)
+			{
+				auto pHeader = (::Vst2PresetBankHeader*)pBuffer;
+				pHeader->chunkMagic = ::Vst2PresetSwap(::Vst2PresetChunkMagic);
+				pHeader->byteSize = ::Vst2PresetSwap((int32_t)byteSize);
+				pHeader->fxMagic = ::Vst2PresetSwap(fxMagic);
+				pHeader->version = ::Vst2PresetSwap(2);
+				pHeader->pluginId = ::Vst2PresetSwap(pluginId);
+				pHeader->pluginVersion = ::Vst2PresetSwap(pluginVersion);
+				pHeader->programCount = ::Vst2PresetSwap(programCount);
+				pHeader->currentProgram = ::Vst2PresetSwap(currentProgram);
+			}
+			else
+			{
+				auto pHeader = (::Vst2PresetProgramHeader*)pBuffer;
+				pHeader->chunkMagic = ::Vst2PresetSwap(::Vst2PresetChunkMagic);
+				pHeader->byteSize = ::Vst2PresetSwap((int32_t)byteSize);
+				pHeader->fxMagic = ::Vst2PresetSwap(fxMagic);
+				pHeader->version = ::Vst2PresetSwap(1);
+				pHeader->pluginId = ::Vst2PresetSwap(pluginId);
+				pHeader->pluginVersion = ::Vst2PresetSwap(pluginVersion);
+				TypeConverter::StringToChar(name, pHeader->name, ::Vst2PresetProgramNameLen);
+			}
+
+			*(int32_t*)(pBuffer + headerSize) = ::Vst2PresetSwap(chunk->Length);
+		}
+
+		// the chunk itself is opaque and written straight from the caller's array.
+		_output->Write(_buffer, 0, headerSize + ::Vst2PresetChunkSizeLen);
+		_output->Write(chunk, 0, chunk->Length);
+		_output->Flush();
+	}
+
+	void VstPresetFileWriter::EnsureBuffer(int length)
+	{
+		if(_buffer->Length < length)
+		{
+			_buffer = gcnew array<System::Byte>(length);
+		}
+	}
+
+	void VstPresetFileWriter::ThrowIfInBank()
+	{
+		if(_inBank)
+		{
+			throw gcnew System::InvalidOperationException(
+				Jacobi::Vst::Interop::Properties::Resources::VstPresetFileWriter_BankIncomplete);
+		}
+	}
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Vst2PresetFormat.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	/// <summary>
+	/// The VstPresetFileWriter class writes preset (fxp) and bank (fxb) files to a stream.
+	/// </summary>
+	/// <remarks>Banks are written one program at a time: call <see cref="BeginBank"/>,
+	/// <see cref="WriteBankProgram"/> for each program and finally <see cref="EndBank"/>.
+	/// No program is held in memory longer than the call that writes it.
+	/// The output stream does not have to be seekable.</remarks>
+	public ref class VstPresetFileWriter sealed
+	{
+	public:
+		/// <summary>Constructs a new instance on the <paramref name="output"/> stream.</summary>
+		/// <param name="output">Receives the file data. Must not be null.</param>
+		VstPresetFileWriter(System::IO::Stream^ output);
+
+		/// <summary>Writes a program file (fxp) with parameter values.</summary>
+		/// <param name="pluginId">The unique plugin id.</param>
+		/// <param name="pluginVersion">The plugin version.</param>
+		/// <param name="name">The program name. Truncated to 27 characters.</param>
+		/// <param name="parameters">The parameter values. Must not be null.</param>
+		void WriteProgram(System::Int32 pluginId, System::Int32 pluginVersion, System::String^ name, array<System::Single>^ parameters);
+
+		/// <summary>Writes a program file (fxp) with an opaque plugin chunk.</summary>
+		/// <param name="pluginId">The unique plugin id.</param>
+		/// <param name="pluginVersion">The plugin version.</param>
+		/// <param name="name">The program name. Truncated to 27 characters.</param>
+		/// <param name="chunk">The chunk data as returned by GetChunk. Must not be null.</param>
+		void WriteProgramChunk(System::Int32 pluginId, System::Int32 pluginVersion, System::String^ name, array<System::Byte>^ chunk);
+
+		/// <summary>Writes a bank file (fxb) with an opaque plugin chunk.</summary>
+		/// <param name="pluginId">The unique plugin id.</param>
+		/// <param name="pluginVersion">The plugin version.</param>
+		/// <param name="programCount">The number of programs in the bank.</param>
+		/// <param name="currentProgram">The index of the current program.</param>
+		/// <param name="chunk">The chunk data as returned by GetChunk. Must not be null.</param>
+		void WriteBankChunk(System::Int32 pluginId, System::Int32 pluginVersion, System::Int32 programCount,
+			System::Int32 currentProgram, array<System::Byte>^ chunk);
+
+		/// <summary>Writes the header of a bank file (fxb) with parameter values.</summary>
+		/// <param name="pluginId">The unique plugin id.</param>
+		/// <param name="pluginVersion">The plugin version.</param>
+		/// <param name="programCount">The number of programs that will follow.</param>
+		/// <param name="parameterCount">The number of parameter values of each program.</param>
+		/// <param name="currentProgram">The index of the current program.</param>
+		/// <exception cref="System::InvalidOperationException">Thrown when a bank is already being written.</exception>
+		void BeginBank(System::Int32 pluginId, System::Int32 pluginVersion, System::Int32 programCount,
+			System::Int32 parameterCount, System::Int32 currentProgram);
+
+		/// <summary>Writes the next program of the bank started with <see cref="BeginBank"/>.</summary>
+		/// <param name="name">The program name. Truncated to 27 characters.</param>
+		/// <param name="parameters">The parameter values. Must not be null and contain
+		/// exactly the number of values passed to <see cref="BeginBank"/>.</param>
+		/// <exception cref="System::InvalidOperationException">Thrown when no bank was started or all programs were written.</exception>
+		void WriteBankProgram(System::String^ name, array<System::Single>^ parameters);
+
+		/// <summary>Completes the bank started with <see cref="BeginBank"/>.</summary>
+		/// <exception cref="System::InvalidOperationException">Thrown when no bank was started or not all programs were written.</exception>
+		void EndBank();
+
+	private:
+		System::IO::Stream^ _output;
+		// reused encoding buffer
+		array<System::Byte>^ _buffer;
+
+		// bank state
+		System::Int32 _pluginId;
+		System::Int32 _pluginVersion;
+		System::Int32 _bankParameterCount;
+		System::Int32 _bankProgramsToWrite;
+		System::Boolean _inBank;
+
+		void WriteProgramInternal(System::Int32 pluginId, System::Int32 pluginVersion, System::String^ name, array<System::Single>^ parameters);
+		void WriteChunkInternal(System::Int32 fxMagic, System::Int32 pluginId, System::Int32 pluginVersion, System::String^ name,
+			System::Int32 programCount, System::Int32 currentProgram, array<System::Byte>^ chunk);
+		void EnsureBuffer(int length);
+		void ThrowIfInBank();
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,54 @@
+#include "pch.h"
+#include "VstProcessLoadMeter.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	VstProcessLoadMeter::VstProcessLoadMeter()
+	{
+		LARGE_INTEGER frequency;
+		::QueryPerformanceFrequency(&frequency);
+		_ticksPerSecond = (double)frequency.QuadPart;
+
+		_pWindow = new ProcessLoadWindow();
+	}
+
+	VstProcessLoadMeter::~VstProcessLoadMeter()
+	{
+		this->!VstProcessLoadMeter();
+	}
+
+	VstProcessLoadMeter::!VstProcessLoadMeter()
+	{
+		delete _pWindow;
+		_pWindow = NULL;
+	}
+
+	void VstProcessLoadMeter::End(int64_t startTime, int32_t sampleFrames)
+	{
+		int64_t endTime = Begin();
+
+		if(_pWindow != NULL)
+		{
+			_pWindow->Record((endTime - startTime) / _ticksPerSecond, _sampleRate, sampleFrames);
+		}
+	}
+
+	System::Single VstProcessLoadMeter::GetLoadPercentile(System::Double percentile)
+	{
+		if(percentile < 0 || percentile > 100)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("percentile");
+		}
+
+		return _pWindow->GetPercentile(percentile);
+	}
+
+	void VstProcessLoadMeter::Reset()
+	{
+		_pWindow->Reset();
+	}
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ProcessLoadWindow.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	/// <summary>
+	/// The VstProcessLoadMeter class measures the time a plugin spends in its process calls
+	/// relative to the duration of the audio block (the deadline).
+	/// </summary>
+	/// <remarks>A load of 1.0 means the plugin took as long as the block lasts.
+	/// The most recent <see cref="WindowSize"/> measurements are kept for percentile queries.
+	/// Measurements are written on the audio thread without locking; values read from another
+	/// thread are a (slightly stale) snapshot.</remarks>
+	public ref class VstProcessLoadMeter sealed
+	{
+	public:
+		/// <summary>The number of most recent process calls used for <see cref="GetLoadPercentile"/>.</summary>
+		static const System::Int32 WindowSize = ProcessLoadWindow::WindowSize;
+
+		/// <summary>Disposes the instance.</summary>
+		~VstProcessLoadMeter();
+		/// <summary>Frees the measurement window.</summary>
+		!VstProcessLoadMeter();
+
+		/// <summary>Gets the sample rate set on the plugin.</summary>
+		property System::Single SampleRate { System::Single get() { return _sampleRate; } }
+		/// <summary>Gets the block size set on the plugin.</summary>
+		property System::Int32 BlockSize { System::Int32 get() { return _blockSize; } }
+		/// <summary>Gets the duration of a block of <see cref="BlockSize"/> samples in seconds.</summary>
+		property System::Double BlockPeriod { System::Double get() { return _sampleRate > 0 ? _blockSize / _sampleRate : 0.0; } }
+
+		/// <summary>Gets or sets the load above which a process call counts as a deadline miss.</summary>
+		/// <remarks>The default is 1.0. Set a lower value to account for the time the rest of the host needs.</remarks>
+		property System::Single DeadlineThreshold
+		{
+			System::Single get() { return _pWindow->GetDeadlineThreshold(); }
+			void set(System::Single value) { _pWindow->SetDeadlineThreshold(value); }
+		}
+
+		/// <summary>Gets the number of process calls measured since the last <see cref="Reset"/>.</summary>
+		property System::Int64 ProcessCount { System::Int64 get() { return _pWindow->GetProcessCount(); } }
+		/// <summary>Gets the number of process calls that exceeded the <see cref="DeadlineThreshold"/>.</summary>
+		property System::Int64 DeadlineMissCount { System::Int64 get() { return _pWindow->GetDeadlineMissCount(); } }
+		/// <summary>Gets the load of the last process call.</summary>
+		property System::Single LastLoad { System::Single get() { return _pWindow->GetLastLoad(); } }
+		/// <summary>Gets the highest load since the last <see cref="Reset"/>.</summary>
+		property System::Single PeakLoad { System::Single get() { return _pWindow->GetPeakLoad(); } }
+
+		/// <summary>Calculates the load percentile over the most recent process calls.</summary>
+		/// <param name="percentile">A value between 0 and 100, for instance 50, 99 or 99.9.</param>
+		/// <returns>Returns the load or 0 when no process calls were measured.</returns>
+		/// <remarks>Sorts a copy of the window; do not call this on the audio thread.</remarks>
+		/// <exception cref="System::ArgumentOutOfRangeException">Thrown when <paramref name="percentile"/> is not between 0 and 100.</exception>
+		System::Single GetLoadPercentile(System::Double percentile);
+
+		/// <summary>Clears all measurements.</summary>
+		void Reset();
+
+	internal:
+		VstProcessLoadMeter();
+
+		void SetSampleRate(float sampleRate)
+		{ _sampleRate = sampleRate; }
+		void SetBlockSize(int32_t blockSize)
+		{ _blockSize = blockSize; }
+
+		// returns the start timestamp of a process call.
+		static int64_t Begin()
+		{
+			LARGE_INTEGER counter;
+			::QueryPerformanceCounter(&counter);
+			return counter.QuadPart;
+		}
+
+		// records the process call that started at startTime.
+		void End(int64_t startTime, int32_t sampleFrames);
+
+	private:
+		double _ticksPerSecond;
+		float _sampleRate;
+		int32_t _blockSize;
+
+		ProcessLoadWindow* _pWindow;
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,55 @@
+#include "pch.h"
+#include "VstTimelineCapture.h"
+#include "..\Properties\Resources.h"
+#include <vcclr.h>
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	void VstTimelineCapture::Start()
+	{
+		Start(DefaultCapacity);
+	}
+
+	void VstTimelineCapture::Start(System::Int32 capacity)
+	{
+		if(capacity <= 0)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("capacity");
+		}
+
+		if(!TimelineTrace::Start(capacity))
+		{
+			throw gcnew System::OutOfMemoryException();
+		}
+	}
+
+	void VstTimelineCapture::Stop()
+	{
+		TimelineTrace::Stop();
+	}
+
+	void VstTimelineCapture::Export(System::String^ filePath)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNullOrEmpty(filePath, "filePath");
+
+		pin_ptr<const wchar_t> pPath = PtrToStringChars(filePath);
+
+		FILE* pFile = NULL;
+		bool written = ::_wfopen_s(&pFile, pPath, L"wb") == 0 && TimelineTrace::WriteChromeJson(pFile);
+
+		if(pFile != NULL && fclose(pFile) != 0)
+		{
+			written = false;
+		}
+
+		if(!written)
+		{
+			throw gcnew System::IO::IOException(System::String::Format(
+				Jacobi::Vst::Interop::Properties::Resources::VstTimelineCapture_ExportFailed, filePath));
+		}
+	}
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "..\TimelineTrace.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	/// <summary>
+	/// The VstTimelineCapture class records the calls between the host and its plugins on a timeline.
+	/// </summary>
+	/// <remarks>Each dispatcher, process and parameter call into an (unmanaged) plugin and each call of a plugin
+	/// to the host (GetTime, Automate, ...) is recorded as a span with its start, end and the thread it was made on.
+	/// A call the plugin makes while it processes shows up nested inside the process call, and calls on the audio and
+	/// UI threads show up side by side. <see cref="Export"/> writes the capture in the Chrome trace event format
+	/// that chrome://tracing and Perfetto (ui.perfetto.dev) open.
+	/// The capture covers all plugins of the process. Recording does not lock or allocate:
+	/// calls made when the capture is full are not recorded (see <see cref="DroppedEventCount"/>).</remarks>
+	public ref class VstTimelineCapture abstract sealed
+	{
+	public:
+		/// <summary>The number of events <see cref="Start()"/> makes room for (a call is two events).</summary>
+		literal System::Int32 DefaultCapacity = 1000000;
+
+		/// <summary>
+		/// Starts a new capture with room for <see cref="DefaultCapacity"/> events. The previous capture is discarded.
+		/// </summary>
+		static void Start();
+		/// <summary>
+		/// Starts a new capture with room for <paramref name="capacity"/> events. The previous capture is discarded.
+		/// </summary>
+		/// <param name="capacity">The number of events (a call is two events). Must be greater than zero.</param>
+		/// <exception cref="System::OutOfMemoryException">Thrown when the capture buffer cannot be allocated.</exception>
+		static void Start(System::Int32 capacity);
+
+		/// <summary>Stops recording. The capture is kept for <see cref="Export"/>.</summary>
+		static void Stop();
+
+		/// <summary>
+		/// Writes the capture to a new file at <paramref name="filePath"/> in the Chrome trace event (JSON) format.
+		/// </summary>
+		/// <param name="filePath">The path to the trace file. Must not be null or empty. A file that exists is overwritten.</param>
+		/// <remarks>Call <see cref="Stop"/> first; calls that have not returned are closed at the last recorded time.</remarks>
+		/// <exception cref="System::IO::IOException">Thrown when the file cannot be written.</exception>
+		static void Export(System::String^ filePath);
+
+		/// <summary>Gets if calls are being recorded.</summary>
+		static property System::Boolean IsRecording
+		{ System::Boolean get() { return TimelineTrace::IsRecording(); } }
+		/// <summary>Gets the number of events in the capture.</summary>
+		static property System::Int64 EventCount
+		{ System::Int64 get() { return TimelineTrace::GetEventCount(); } }
+		/// <summary>Gets the number of events that did not fit the capture.</summary>
+		static property System::Int64 DroppedEventCount
+		{ System::Int64 get() { return TimelineTrace::GetDroppedCount(); } }
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
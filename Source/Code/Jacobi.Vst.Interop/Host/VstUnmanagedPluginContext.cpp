@@ -1,7 +1,9 @@
 #include "pch.h"
 #include "VstUnmanagedPluginContext.h"
 #include "..\TypeConverter.h"
+#include "..\TimelineTrace.h"
 #include "..\Properties\Resources.h"
+#include <vcclr.h>
 
 namespace Jacobi {
 namespace Vst {
@@ -67,68 +69,27 @@ namespace Interop {
 				Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_AlreadyInitialized);
 		}
 
-		char* pPluginPath = NULL;
-
 		try
 		{
-			pPluginPath = TypeConverter::AllocateString(pluginPath);
-
-			// Load plugin dll
-			_hLib = ::LoadLibraryA(pPluginPath);
+			NativePluginModule module;
 
-			if(_hLib == NULL)
+			// the pinned string is passed to LoadLibraryW as is; no unmanaged copy of the path is made.
 			{
-				if (::GetLastError() == 193)	// bad file format
-				{
-					throw gcnew System::BadImageFormatException(
-						System::String::Format(
-							Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_LoadPluginFailed,
-							pluginPath));
-				}
-
-				throw gcnew System::ArgumentException(
-					System::String::Format(
-						Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_LoadPluginFailed,
-						pluginPath));
+				pin_ptr<const wchar_t> pPluginPath = PtrToStringChars(pluginPath);
+				ThrowIfFailed(NativePluginLoader::Load(pPluginPath, &module), pluginPath);
 			}
-				
-			// check entry point
-			_pluginMain = (Vst2PluginMain)::GetProcAddress(_hLib, "VSTPluginMain");
 
-			if(_pluginMain == NULL)
-			{
-				// check old entry point
-				_pluginMain = (Vst2PluginMain)::GetProcAddress(_hLib, "main");
-			}
+			_hLib = module.handle;
+			_pluginMain = module.pluginMain;
 
-			if(_pluginMain == NULL)
-			{
-				throw gcnew System::EntryPointNotFoundException(
-					System::String::Format(
-						Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_EntryPointNotFound,
-						pluginPath));
-			}
-			
 			LoadingPlugin = this;
 
 			// call main and retrieve Vst2Plugin*
-			_pEffect = _pluginMain(&HostCommandHandler);
+			::Vst2Plugin* pEffect = NULL;
+			auto result = NativePluginLoader::CreatePlugin(_pluginMain, &HostCommandHandler, &pEffect);
+			_pEffect = pEffect;
 
-			if(_pEffect == NULL)
-			{
-				throw gcnew System::OperationCanceledException(
-					System::String::Format(
-						Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_PluginReturnedNull,
-						pluginPath));
-			}
-
-			if(_pEffect->VstP != Vst2FourCharacterCode)
-			{
-				throw gcnew System::OperationCanceledException(
-					System::String::Format(
-						Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_MagicNumberMismatch,
-						pluginPath));
-			}
+			ThrowIfFailed(result, pluginPath);
 
 			auto ctxHandle = System::Runtime::InteropServices::GCHandle::Alloc(this);
 
@@ -152,6 +113,9 @@ namespace Interop {
 			AcceptPluginInfoData(false);
 
 			Set(VstPluginContext::PluginPathContextVar, pluginPath);
+
+			safe_cast<VstPluginCommandStub^>(PluginCommandStub)->CommandsImpl->SetInstanceName(
+				System::IO::Path::GetFileNameWithoutExtension(pluginPath));
 		}
 		catch(...)
 		{
@@ -165,15 +129,44 @@ namespace Interop {
 		}
 		finally
 		{
-			if(pPluginPath != NULL)
-			{
-				TypeConverter::DeallocateString(pPluginPath);
-			}
-
 			LoadingPlugin = nullptr;
 		}
 	}
 
+	void VstUnmanagedPluginContext::ThrowIfFailed(NativeLoadResult result, System::String^ pluginPath)
+	{
+		switch(result)
+		{
+		case NativeLoadResult::Success:
+			return;
+		case NativeLoadResult::BadImageFormat:
+			throw gcnew System::BadImageFormatException(
+				System::String::Format(
+					Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_LoadPluginFailed,
+					pluginPath));
+		case NativeLoadResult::EntryPointNotFound:
+			throw gcnew System::EntryPointNotFoundException(
+				System::String::Format(
+					Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_EntryPointNotFound,
+					pluginPath));
+		case NativeLoadResult::PluginReturnedNull:
+			throw gcnew System::OperationCanceledException(
+				System::String::Format(
+					Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_PluginReturnedNull,
+					pluginPath));
+		case NativeLoadResult::MagicNumberMismatch:
+			throw gcnew System::OperationCanceledException(
+				System::String::Format(
+					Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_MagicNumberMismatch,
+					pluginPath));
+		default:
+			throw gcnew System::ArgumentException(
+				System::String::Format(
+					Jacobi::Vst::Interop::Properties::Resources::VstUnmanagedPluginContext_LoadPluginFailed,
+					pluginPath));
+		}
+	}
+
 	void VstUnmanagedPluginContext::AcceptPluginInfoData(System::Boolean raiseEvents)
 	{
 		Jacobi::Vst::Core::Legacy::VstPluginLegacyInfo^ legacyInfo =
@@ -292,7 +285,11 @@ Vst2IntPtr HostCommandHandler(::Vst2Plugin* pPlugin, ::int32_t opcode, ::int32_t
 	// dispatch call to plugin context and its Host Proxy.
 	if(context != nullptr)
 	{
-		return context->HostCommandProxy->Dispatch(opcode, index, value, ptr, opt);
+		TimelineTrace::Begin(TimelineSpan::HostCallback, pPlugin, opcode, index);
+		::Vst2IntPtr result = context->HostCommandProxy->Dispatch(opcode, index, value, ptr, opt);
+		TimelineTrace::End(TimelineSpan::HostCallback, pPlugin, opcode, result);
+
+		return result;
 	}
 
 	// no-one there to answer...
@@ -3,9 +3,7 @@
 #include "VstPluginContext.h"
 #include "VstPluginCommandStub.h"
 #include "VstHostCommandProxy.h"
-
-// typedef for the main exported function from a plugin dll
-typedef ::Vst2Plugin* (*Vst2PluginMain)(::Vst2HostCallback);
+#include "NativePluginLoader.h"
 
 // static callback function
 static Vst2IntPtr Vst2Handler HostCommandHandler(Vst2Plugin* pPlugin, int32_t opcode, int32_t index, Vst2IntPtr value, void* ptr, float opt);
@@ -46,6 +44,54 @@ namespace Interop {
 		/// retrieved by calling the <see cref="Jacobi::Vst::Core::IVstPluginCommands23::GetNextPlugin"/> method.</remarks>
 		virtual VstPluginContext^ ShellCreate(Jacobi::Vst::Core::Host::IVstHostCommandStub^ hostCmdStub) override;
 
+		/// <summary>
+		/// Gets the meter that measures the load of the plugin's process calls.
+		/// </summary>
+		virtual property VstProcessLoadMeter^ ProcessLoadMeter
+		{
+			VstProcessLoadMeter^ get() override
+			{
+				auto pluginCmdStub = dynamic_cast<VstPluginCommandStub^>(PluginCommandStub);
+				return pluginCmdStub != nullptr ? pluginCmdStub->CommandsImpl->LoadMeter : nullptr;
+			}
+		}
+
+		/// <summary>
+		/// Gets the settings for suspending the plugin while its input is silent.
+		/// </summary>
+		virtual property VstAutoSuspend^ AutoSuspend
+		{
+			VstAutoSuspend^ get() override
+			{
+				auto pluginCmdStub = dynamic_cast<VstPluginCommandStub^>(PluginCommandStub);
+				return pluginCmdStub != nullptr ? pluginCmdStub->CommandsImpl->AutoSuspend : nullptr;
+			}
+		}
+
+		/// <summary>
+		/// Gets the settings for splitting process calls that are larger than the plugin's block size.
+		/// </summary>
+		virtual property VstBlockSplitter^ BlockSplitter
+		{
+			VstBlockSplitter^ get() override
+			{
+				auto pluginCmdStub = dynamic_cast<VstPluginCommandStub^>(PluginCommandStub);
+				return pluginCmdStub != nullptr ? pluginCmdStub->CommandsImpl->BlockSplitter : nullptr;
+			}
+		}
+
+		/// <summary>
+		/// Gets the recorder for the calls the host makes into the plugin.
+		/// </summary>
+		virtual property VstCallRecorder^ CallRecorder
+		{
+			VstCallRecorder^ get() override
+			{
+				auto pluginCmdStub = dynamic_cast<VstPluginCommandStub^>(PluginCommandStub);
+				return pluginCmdStub != nullptr ? pluginCmdStub->CommandsImpl->CallRecorder : nullptr;
+			}
+		}
+
 	internal:
 		/// <summary>Gets or sets the plugin context of the plugin that is currently loading.</summary>
 		/// <remarks>Only set during loading of plugin (Create)</remarks>
@@ -81,14 +127,17 @@ namespace Interop {
 		virtual void Uninitialize() override;
 
 	private:
-		HMODULE _hLib;
+		void* _hLib;
 		::Vst2Plugin* _pEffect;
 		Vst2PluginMain _pluginMain;
 
 		VstHostCommandProxy^ _hostCmdProxy;
 
+		// throws the exception that matches the (failed) result.
+		static void ThrowIfFailed(NativeLoadResult result, System::String^ pluginPath);
+
 		void CloseLibrary()
-		{ if(_hLib != NULL) { ::FreeLibrary(_hLib); _hLib = NULL; } }
+		{ NativePluginLoader::Unload(_hLib); _hLib = NULL; }
 	};
 
 }}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,199 @@
+#include "pch.h"
+#include "VstVariableIoProcessor.h"
+#include "VstPluginCommandStub.h"
+#include "..\TypeConverter.h"
+#include "..\Properties\Resources.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	VstVariableIoProcessor::VstVariableIoProcessor(Jacobi::Vst::Core::Host::IVstPluginCommandStub^ pluginCmdStub, System::Int32 inputCount, System::Int32 capacity)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(pluginCmdStub, "pluginCmdStub");
+
+		if(inputCount < 0)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("inputCount");
+		}
+
+		if(capacity <= 0)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("capacity");
+		}
+
+		_commands = dynamic_cast<Jacobi::Vst::Core::IVstPluginCommandsVariableIo^>(pluginCmdStub->Commands);
+		if(_commands == nullptr)
+		{
+			throw gcnew System::ArgumentException(
+				Jacobi::Vst::Interop::Properties::Resources::VstVariableIoProcessor_NotSupported, "pluginCmdStub");
+		}
+
+		auto unmanagedStub = dynamic_cast<VstPluginCommandStub^>(pluginCmdStub);
+		if(unmanagedStub != nullptr)
+		{
+			_commandsImpl = unmanagedStub->CommandsImpl;
+		}
+
+		_inputCount = inputCount;
+		_capacity = capacity;
+
+		if(_inputCount > 0)
+		{
+			float* pBuffer = _inputBuffer.GetArray(_inputCount * _capacity);
+			ZeroMemory(pBuffer, _inputBuffer.GetByteLength());
+
+			_inputPointers.GetArray(_inputCount);
+		}
+	}
+
+	VstVariableIoProcessor::~VstVariableIoProcessor()
+	{
+		// destroys the contained UnmanagedArrays.
+	}
+
+	System::Int32 VstVariableIoProcessor::Write(array<Jacobi::Vst::Core::VstAudioBuffer^>^ inputs)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(inputs, "inputs");
+
+		if(inputs->Length != _inputCount)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("inputs");
+		}
+
+		if(_inputCount == 0)
+		{
+			return 0;
+		}
+
+		int32_t sampleCount = inputs[0]->SampleCount;
+
+		if(_writePosition + sampleCount > _capacity)
+		{
+			Compact();
+		}
+
+		int32_t count = min(sampleCount, _capacity - _writePosition);
+		float* pBuffer = _inputBuffer.GetArray();
+
+		for(int32_t n = 0; n < _inputCount; n++)
+		{
+			auto inputBuffer = safe_cast<Jacobi::Vst::Core::IDirectBufferAccess32^>(inputs[n]);
+			int32_t channelCount = min(count, inputBuffer->SampleCount);
+
+			memcpy(pBuffer + (n * _capacity) + _writePosition, inputBuffer->Buffer, channelCount * sizeof(float));
+		}
+
+		_writePosition += count;
+
+		return count;
+	}
+
+	System::Int32 VstVariableIoProcessor::Process(array<Jacobi::Vst::Core::VstAudioBuffer^>^ outputs)
+	{
+		Jacobi::Vst::Core::Throw::IfArgumentIsNull(outputs, "outputs");
+
+		int32_t inputProcessed = 0;
+		int32_t outputProcessed = 0;
+
+		// point the plugin at the pending input, no copy.
+		float* pBuffer = _inputBuffer.GetArray();
+		float** ppInputs = _inputPointers.GetArray();
+		for(int32_t n = 0; n < _inputCount; n++)
+		{
+			ppInputs[n] = pBuffer + (n * _capacity) + _readPosition;
+		}
+
+		float** ppOutputs = _outputPointers.GetArray(max(outputs->Length, 1));
+		int32_t outputSampleCount = 0;
+		for(int32_t n = 0; n < outputs->Length; n++)
+		{
+			auto outputBuffer = safe_cast<Jacobi::Vst::Core::IDirectBufferAccess32^>(outputs[n]);
+
+			ppOutputs[n] = outputBuffer->Buffer;
+			outputSampleCount = n == 0 ? outputBuffer->SampleCount : min(outputSampleCount, outputBuffer->SampleCount);
+		}
+
+		::Vst2VariableIo varIo;
+		varIo.inputs = ppInputs;
+		varIo.outputs = ppOutputs;
+		varIo.sampleInputCount = PendingInputCount;
+		varIo.sampleOutputCount = outputSampleCount;
+		varIo.sampleInputProcessedCount = &inputProcessed;
+		varIo.sampleOutputProcessedCount = &outputProcessed;
+
+		if(!CallPlugin(&varIo, outputs))
+		{
+			return -1;
+		}
+
+		// guard against plugins reporting more than they were given.
+		inputProcessed = max(0, min(inputProcessed, varIo.sampleInputCount));
+		outputProcessed = max(0, min(outputProcessed, outputSampleCount));
+
+		_readPosition += inputProcessed;
+		if(_readPosition == _writePosition)
+		{
+			_readPosition = _writePosition = 0;
+		}
+
+		_totalInputProcessed += inputProcessed;
+		_totalOutputProcessed += outputProcessed;
+
+		return outputProcessed;
+	}
+
+	void VstVariableIoProcessor::Clear()
+	{
+		_readPosition = 0;
+		_writePosition = 0;
+	}
+
+	// moves the pending input to the start of each channel.
+	void VstVariableIoProcessor::Compact()
+	{
+		int32_t pendingCount = PendingInputCount;
+
+		if(_readPosition == 0)
+		{
+			return;
+		}
+
+		if(pendingCount > 0)
+		{
+			float* pBuffer = _inputBuffer.GetArray();
+
+			for(int32_t n = 0; n < _inputCount; n++)
+			{
+				float* pChannel = pBuffer + (n * _capacity);
+				memmove(pChannel, pChannel + _readPosition, pendingCount * sizeof(float));
+			}
+		}
+
+		_readPosition = 0;
+		_writePosition = pendingCount;
+	}
+
+	bool VstVariableIoProcessor::CallPlugin(::Vst2VariableIo* pVarIo, array<Jacobi::Vst::Core::VstAudioBuffer^>^ outputs)
+	{
+		if(_commandsImpl != nullptr)
+		{
+			return _commandsImpl->ProcessVariableIo(pVarIo);
+		}
+
+		// managed plugin: wrap the pending input.
+		auto inputs = TypeConverter::ToManagedAudioBufferArray(pVarIo->inputs, pVarIo->sampleInputCount, _inputCount, false);
+
+		int inputProcessed = 0;
+		int outputProcessed = 0;
+
+		bool result = _commands->ProcessVariableIo(inputs, outputs, inputProcessed, outputProcessed);
+
+		*pVarIo->sampleInputProcessedCount = inputProcessed;
+		*pVarIo->sampleOutputProcessedCount = outputProcessed;
+
+		return result;
+	}
+
+}}}} // Jacobi::Vst::Host::Interop
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "UnmanagedArray.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Host {
+namespace Interop {
+
+	ref class VstPluginCommandsImpl;
+
+	/// <summary>
+	/// The VstVariableIoProcessor class drives variable input/output (offline) processing of a plugin,
+	/// for instance for resampling or time-stretching.
+	/// </summary>
+	/// <remarks>The input is collected in an unmanaged buffer per input channel (<see cref="Write"/>).
+	/// Each <see cref="Process"/> call passes all pending input to the plugin and the plugin reports how many
+	/// input samples it consumed and how many output samples it produced. The input that was not consumed
+	/// stays pending for the next call; it is only moved to the front of the buffer when new input does not fit.
+	/// The output is written directly into the caller's buffers.</remarks>
+	public ref class VstVariableIoProcessor sealed : System::IDisposable
+	{
+	public:
+		/// <summary>Constructs a new instance for the plugin.</summary>
+		/// <param name="pluginCmdStub">The command stub of the plugin. Its commands must implement
+		/// <see cref="Jacobi::Vst::Core::IVstPluginCommandsVariableIo"/>. Must not be null.</param>
+		/// <param name="inputCount">The number of input channels of the plugin.</param>
+		/// <param name="capacity">The maximum number of pending input samples per channel.</param>
+		VstVariableIoProcessor(Jacobi::Vst::Core::Host::IVstPluginCommandStub^ pluginCmdStub, System::Int32 inputCount, System::Int32 capacity);
+		/// <summary>Disposes the instance and free's the unmanaged memory.</summary>
+		~VstVariableIoProcessor();
+
+		/// <summary>Appends input to the pending input.</summary>
+		/// <param name="inputs">One buffer for each input channel. Must not be null.</param>
+		/// <returns>Returns the number of samples per channel that were accepted, which is less than the
+		/// sample count of the <paramref name="inputs"/> when the pending input would exceed the <see cref="Capacity"/>.</returns>
+		System::Int32 Write(array<Jacobi::Vst::Core::VstAudioBuffer^>^ inputs);
+		/// <summary>Calls the plugin to process the pending input into the <paramref name="outputs"/>.</summary>
+		/// <param name="outputs">One buffer for each output channel. The sample count is the number of output samples requested. Must not be null.</param>
+		/// <returns>Returns the number of output samples the plugin produced, or -1 when the plugin failed.</returns>
+		System::Int32 Process(array<Jacobi::Vst::Core::VstAudioBuffer^>^ outputs);
+		/// <summary>Discards all pending input.</summary>
+		void Clear();
+
+		/// <summary>Gets the number of input channels.</summary>
+		property System::Int32 InputCount { System::Int32 get() { return _inputCount; } }
+		/// <summary>Gets the maximum number of pending input samples per channel.</summary>
+		property System::Int32 Capacity { System::Int32 get() { return _capacity; } }
+		/// <summary>Gets the number of input samples per channel that have not been consumed by the plugin.</summary>
+		property System::Int32 PendingInputCount { System::Int32 get() { return _writePosition - _readPosition; } }
+		/// <summary>Gets the total number of input samples the plugin consumed.</summary>
+		property System::Int64 TotalInputProcessed { System::Int64 get() { return _totalInputProcessed; } }
+		/// <summary>Gets the total number of output samples the plugin produced.</summary>
+		property System::Int64 TotalOutputProcessed { System::Int64 get() { return _totalOutputProcessed; } }
+
+	private:
+		Jacobi::Vst::Core::IVstPluginCommandsVariableIo^ _commands;
+		VstPluginCommandsImpl^ _commandsImpl;	// null for managed plugins
+
+		System::Int32 _inputCount;
+		System::Int32 _capacity;
+		System::Int32 _readPosition;
+		System::Int32 _writePosition;
+		System::Int64 _totalInputProcessed;
+		System::Int64 _totalOutputProcessed;
+
+		// one block of capacity samples per input channel
+		UnmanagedArray<float> _inputBuffer;
+		UnmanagedArray<float*> _inputPointers;
+		UnmanagedArray<float*> _outputPointers;
+
+		void Compact();
+		bool CallPlugin(::Vst2VariableIo* pVarIo, array<Jacobi::Vst::Core::VstAudioBuffer^>^ outputs);
+	};
+
+}}}} // Jacobi::Vst::Host::Interop
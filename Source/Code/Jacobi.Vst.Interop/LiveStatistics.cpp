@@ -0,0 +1,508 @@
+// compiled without /clr and without the precompiled header (uses <atomic>, <mutex> and <chrono>).
+#include "LiveStatistics.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	const size_t SegmentSize = sizeof(LiveStatisticsHeader) + LiveStatisticsSlotCount * sizeof(LiveStatisticsSlot);
+
+	// the segment as mapped by this module (each interop dll has its own copy).
+	std::mutex s_lock;
+	LiveStatisticsHeader* s_pHeader = NULL;
+	int32_t s_acquiredCount = 0;
+#ifdef _WIN32
+	HANDLE s_hMapping = NULL;
+#endif
+
+	LiveStatisticsSlot* GetSlots(const LiveStatisticsHeader* pHeader)
+	{
+		return (LiveStatisticsSlot*)(pHeader + 1);
+	}
+
+#ifdef _WIN32
+	uint32_t GetOwnProcessId()
+	{
+		return ::GetCurrentProcessId();
+	}
+
+	void GetSegmentName(uint32_t processId, wchar_t* pName, size_t length)
+	{
+		swprintf_s(pName, length, L"Local\\Jacobi.Vst.LiveStatistics.%u", processId);
+	}
+
+	int32_t Increment(volatile int32_t* pValue)
+	{
+		return ::InterlockedIncrement((volatile LONG*)pValue);
+	}
+
+	int32_t Decrement(volatile int32_t* pValue)
+	{
+		return ::InterlockedDecrement((volatile LONG*)pValue);
+	}
+
+	bool CompareExchange(volatile LiveStatisticsKind* pKind, LiveStatisticsKind kind, LiveStatisticsKind comparand)
+	{
+		return ::InterlockedCompareExchange((volatile LONG*)pKind, (LONG)kind, (LONG)comparand) == (LONG)comparand;
+	}
+
+	bool CompareExchange(volatile uint64_t* pValue, uint64_t value, uint64_t comparand)
+	{
+		return (uint64_t)::InterlockedCompareExchange64((volatile LONG64*)pValue, (LONG64)value, (LONG64)comparand) == comparand;
+	}
+
+	uint64_t GetProcessStartTime()
+	{
+		FILETIME creation, exit, kernel, user;
+		if(!::GetProcessTimes(::GetCurrentProcess(), &creation, &exit, &kernel, &user))
+		{
+			return 0;
+		}
+		return ((uint64_t)creation.dwHighDateTime << 32) | creation.dwLowDateTime;
+	}
+
+	LiveStatisticsHeader* MapSegment(bool* pCreated)
+	{
+		wchar_t name[64];
+		GetSegmentName(GetOwnProcessId(), name, 64);
+
+		s_hMapping = ::CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)SegmentSize, name);
+		if(s_hMapping == NULL)
+		{
+			return NULL;
+		}
+
+		*pCreated = ::GetLastError() != ERROR_ALREADY_EXISTS;
+
+		void* pView = ::MapViewOfFile(s_hMapping, FILE_MAP_ALL_ACCESS, 0, 0, SegmentSize);
+		if(pView == NULL)
+		{
+			::CloseHandle(s_hMapping);
+			s_hMapping = NULL;
+		}
+
+		return (LiveStatisticsHeader*)pView;
+	}
+
+	// the mapping is removed by Windows when the last handle closes.
+	void UnmapSegment(LiveStatisticsHeader* pHeader, bool /*isLast*/)
+	{
+		::UnmapViewOfFile(pHeader);
+		::CloseHandle(s_hMapping);
+		s_hMapping = NULL;
+	}
+#else
+	uint32_t GetOwnProcessId()
+	{
+		return (uint32_t)::getpid();
+	}
+
+	void GetSegmentName(uint32_t processId, char* pName, size_t length)
+	{
+		snprintf(pName, length, "/Jacobi.Vst.LiveStatistics.%u", processId);
+	}
+
+	int32_t Increment(volatile int32_t* pValue)
+	{
+		return __sync_add_and_fetch(pValue, 1);
+	}
+
+	int32_t Decrement(volatile int32_t* pValue)
+	{
+		return __sync_sub_and_fetch(pValue, 1);
+	}
+
+	bool CompareExchange(volatile LiveStatisticsKind* pKind, LiveStatisticsKind kind, LiveStatisticsKind comparand)
+	{
+		return __sync_bool_compare_and_swap((volatile uint32_t*)pKind, (uint32_t)comparand, (uint32_t)kind);
+	}
+
+	bool CompareExchange(volatile uint64_t* pValue, uint64_t value, uint64_t comparand)
+	{
+		return __sync_bool_compare_and_swap(pValue, comparand, value);
+	}
+
+	// the start time in clock ticks since boot (field 22 of /proc/self/stat).
+	uint64_t GetProcessStartTime()
+	{
+		FILE* pFile = fopen("/proc/self/stat", "r");
+		if(pFile == NULL)
+		{
+			return 0;
+		}
+
+		char buffer[1024];
+		size_t length = fread(buffer, 1, sizeof(buffer) - 1, pFile);
+		fclose(pFile);
+		buffer[length] = 0;
+
+		// the command name (field 2) is in parentheses and may contain spaces.
+		const char* pField = strrchr(buffer, ')');
+		unsigned long long startTime = 0;
+		if(pField == NULL || sscanf(pField + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu",
+			&startTime) != 1)
+		{
+			return 0;
+		}
+		return startTime;
+	}
+
+	LiveStatisticsHeader* MapSegment(bool* pCreated)
+	{
+		char name[64];
+		GetSegmentName(GetOwnProcessId(), name, 64);
+
+		int fd = ::shm_open(name, O_RDWR | O_CREAT, 0644);
+		if(fd < 0)
+		{
+			return NULL;
+		}
+
+		// a new object has size 0; ftruncate zero-fills.
+		struct stat info;
+		if(::fstat(fd, &info) != 0)
+		{
+			::close(fd);
+			return NULL;
+		}
+
+		*pCreated = info.st_size == 0;
+		if(info.st_size < (off_t)SegmentSize && ::ftruncate(fd, SegmentSize) != 0)
+		{
+			::close(fd);
+			return NULL;
+		}
+
+		void* pView = ::mmap(NULL, SegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+
+		return pView == MAP_FAILED ? NULL : (LiveStatisticsHeader*)pView;
+	}
+
+	// a shared memory object outlives the process unless it is unlinked
+	// (a process that crashed leaves its segment behind until the id is reused).
+	void UnmapSegment(LiveStatisticsHeader* pHeader, bool isLast)
+	{
+		::munmap(pHeader, SegmentSize);
+
+		if(isLast)
+		{
+			char name[64];
+			GetSegmentName(GetOwnProcessId(), name, 64);
+			::shm_unlink(name);
+		}
+	}
+#endif
+
+	bool Attach()
+	{
+		bool created = false;
+		LiveStatisticsHeader* pHeader = MapSegment(&created);
+		if(pHeader == NULL)
+		{
+			return false;
+		}
+
+		if(created)
+		{
+			pHeader->version = LiveStatisticsVersion;
+			pHeader->headerSize = sizeof(LiveStatisticsHeader);
+			pHeader->slotSize = sizeof(LiveStatisticsSlot);
+			pHeader->slotCount = LiveStatisticsSlotCount;
+			pHeader->processId = GetOwnProcessId();
+			pHeader->processStartTime = GetProcessStartTime();
+			std::atomic_thread_fence(std::memory_order_release);
+			pHeader->magic = LiveStatisticsMagic;
+		}
+		else
+		{
+			// another module of this process is still filling in the header.
+			for(int i = 0; i < 1000 && *(volatile uint32_t*)&pHeader->magic == 0; i++)
+			{
+				std::this_thread::yield();
+			}
+
+			if(pHeader->magic != LiveStatisticsMagic || pHeader->version != LiveStatisticsVersion ||
+				pHeader->slotSize != sizeof(LiveStatisticsSlot) || pHeader->slotCount != (uint32_t)LiveStatisticsSlotCount)
+			{
+				// created by a module with another layout version.
+				UnmapSegment(pHeader, false);
+				return false;
+			}
+
+			// a process that crashed does not unlink its segment (Linux). When its id is reused, this process
+			// finds the old slots; the first module to attach takes the segment over and clears them.
+			uint64_t startTime = GetProcessStartTime();
+			uint64_t segmentStartTime = pHeader->processStartTime;
+			if(startTime != 0 && segmentStartTime != startTime &&
+				CompareExchange(&pHeader->processStartTime, startTime, segmentStartTime))
+			{
+				memset(GetSlots(pHeader), 0, LiveStatisticsSlotCount * sizeof(LiveStatisticsSlot));
+				pHeader->attachCount = 0;
+				std::atomic_thread_fence(std::memory_order_release);
+			}
+		}
+
+		Increment(&pHeader->attachCount);
+		s_pHeader = pHeader;
+		return true;
+	}
+
+	void Detach()
+	{
+		bool isLast = Decrement(&s_pHeader->attachCount) == 0;
+		UnmapSegment(s_pHeader, isLast);
+		s_pHeader = NULL;
+	}
+
+	LiveStatisticsSlot* CreatePrivateSlot(LiveStatisticsKind kind, int32_t pluginId, int32_t pluginVersion)
+	{
+		auto pSlot = new LiveStatisticsSlot();
+
+		pSlot->kind = kind;
+		pSlot->pluginId = pluginId;
+		pSlot->pluginVersion = pluginVersion;
+		return pSlot;
+	}
+}
+
+LiveStatisticsSlot* LiveStatistics::AcquireSlot(LiveStatisticsKind kind, int32_t pluginId, int32_t pluginVersion)
+{
+	std::lock_guard<std::mutex> guard(s_lock);
+
+	if(s_pHeader != NULL || Attach())
+	{
+		LiveStatisticsSlot* pSlots = GetSlots(s_pHeader);
+
+		for(int32_t i = 0; i < LiveStatisticsSlotCount; i++)
+		{
+			// other modules of this process take slots without our lock.
+			if(CompareExchange(&pSlots[i].kind, kind, LiveStatisticsKind::None))
+			{
+				LiveStatisticsSlot* pSlot = &pSlots[i];
+				uint32_t sequence = pSlot->sequence + 1;
+
+				memset((char*)pSlot + offsetof(LiveStatisticsSlot, pluginId), 0,
+					sizeof(LiveStatisticsSlot) - offsetof(LiveStatisticsSlot, pluginId));
+				pSlot->pluginId = pluginId;
+				pSlot->pluginVersion = pluginVersion;
+				pSlot->sequence = sequence;
+
+				s_acquiredCount++;
+				return pSlot;
+			}
+		}
+
+		if(s_acquiredCount == 0)
+		{
+			Detach();
+		}
+	}
+
+	return CreatePrivateSlot(kind, pluginId, pluginVersion);
+}
+
+void LiveStatistics::ReleaseSlot(LiveStatisticsSlot* pSlot)
+{
+	if(pSlot == NULL)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(s_lock);
+
+	if(s_pHeader != NULL && pSlot >= GetSlots(s_pHeader) && pSlot < GetSlots(s_pHeader) + LiveStatisticsSlotCount)
+	{
+		pSlot->kind = LiveStatisticsKind::None;
+
+		if(--s_acquiredCount == 0)
+		{
+			Detach();
+		}
+	}
+	else
+	{
+		delete pSlot;
+	}
+}
+
+LiveStatisticsSlot* LiveStatistics::DetachSlot(LiveStatisticsSlot* pSlot)
+{
+	if(pSlot == NULL || !IsPublished(pSlot))
+	{
+		return pSlot;
+	}
+
+	auto pCopy = new LiveStatisticsSlot();
+	memcpy((void*)pCopy, (const void*)pSlot, sizeof(LiveStatisticsSlot));
+
+	ReleaseSlot(pSlot);
+	return pCopy;
+}
+
+bool LiveStatistics::IsPublished(const LiveStatisticsSlot* pSlot)
+{
+	std::lock_guard<std::mutex> guard(s_lock);
+
+	return s_pHeader != NULL && pSlot >= GetSlots(s_pHeader) && pSlot < GetSlots(s_pHeader) + LiveStatisticsSlotCount;
+}
+
+int64_t LiveStatistics::GetTicks()
+{
+	return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+double LiveStatistics::GetTicksPerSecond()
+{
+	return (double)std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num;
+}
+
+void LiveStatistics::EndProcess(LiveStatisticsSlot* pSlot, int64_t startTicks, int32_t sampleFrames)
+{
+	int64_t endTicks = GetTicks();
+
+	pSlot->AddProcess(sampleFrames);
+
+	if(pSlot->sampleRate <= 0 || sampleFrames <= 0)
+	{
+		return;
+	}
+
+	float load = (float)((endTicks - startTicks) / GetTicksPerSecond() * pSlot->sampleRate / sampleFrames);
+
+	pSlot->SetLoad(load, load > pSlot->peakLoad ? load : pSlot->peakLoad,
+		pSlot->deadlineMissCount + (load > 1.0f ? 1 : 0));
+}
+
+//-----------------------------------------------------------------------------
+
+LiveStatisticsReader::LiveStatisticsReader()
+	: _pHeader(NULL), _size(0)
+#ifdef _WIN32
+	, _hMapping(NULL)
+#endif
+{}
+
+LiveStatisticsReader::~LiveStatisticsReader()
+{
+	Close();
+}
+
+bool LiveStatisticsReader::Open(uint32_t processId)
+{
+	Close();
+
+#ifdef _WIN32
+	wchar_t name[64];
+	GetSegmentName(processId, name, 64);
+
+	_hMapping = ::OpenFileMappingW(FILE_MAP_READ, FALSE, name);
+	if(_hMapping == NULL)
+	{
+		return false;
+	}
+
+	_pHeader = (const LiveStatisticsHeader*)::MapViewOfFile(_hMapping, FILE_MAP_READ, 0, 0, SegmentSize);
+#else
+	char name[64];
+	GetSegmentName(processId, name, 64);
+
+	int fd = ::shm_open(name, O_RDONLY, 0);
+	if(fd < 0)
+	{
+		return false;
+	}
+
+	struct stat info;
+	if(::fstat(fd, &info) == 0 && info.st_size >= (off_t)SegmentSize)
+	{
+		void* pView = ::mmap(NULL, SegmentSize, PROT_READ, MAP_SHARED, fd, 0);
+		_pHeader = pView == MAP_FAILED ? NULL : (const LiveStatisticsHeader*)pView;
+	}
+	::close(fd);
+#endif
+
+	if(_pHeader == NULL)
+	{
+		Close();
+		return false;
+	}
+
+	_size = SegmentSize;
+
+	if(_pHeader->magic != LiveStatisticsMagic || _pHeader->version != LiveStatisticsVersion ||
+		_pHeader->slotSize != sizeof(LiveStatisticsSlot) || _pHeader->slotCount != (uint32_t)LiveStatisticsSlotCount)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void LiveStatisticsReader::Close()
+{
+#ifdef _WIN32
+	if(_pHeader != NULL)
+	{
+		::UnmapViewOfFile(_pHeader);
+	}
+	if(_hMapping != NULL)
+	{
+		::CloseHandle(_hMapping);
+		_hMapping = NULL;
+	}
+#else
+	if(_pHeader != NULL)
+	{
+		::munmap((void*)_pHeader, _size);
+	}
+#endif
+
+	_pHeader = NULL;
+	_size = 0;
+}
+
+const LiveStatisticsHeader* LiveStatisticsReader::GetHeader() const
+{
+	return _pHeader;
+}
+
+bool LiveStatisticsReader::ReadSlot(int32_t index, LiveStatisticsSlot* pSlot) const
+{
+	if(_pHeader == NULL || index < 0 || index >= (int32_t)_pHeader->slotCount)
+	{
+		return false;
+	}
+
+	const LiveStatisticsSlot* pSource = GetSlots(_pHeader) + index;
+
+	// retry when the slot was handed to another instance while copying.
+	for(int attempt = 0; attempt < 3; attempt++)
+	{
+		uint32_t sequence = pSource->sequence;
+		memcpy(pSlot, (const void*)pSource, sizeof(LiveStatisticsSlot));
+
+		if(pSource->sequence == sequence)
+		{
+			break;
+		}
+	}
+
+	return pSlot->kind != LiveStatisticsKind::None;
+}
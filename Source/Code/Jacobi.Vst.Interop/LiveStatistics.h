@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Vst2400.h"
+
+#include <stddef.h>
+
+// Live statistics are counters that each plugin instance publishes in a named shared memory segment,
+// one segment per process: 'Local\Jacobi.Vst.LiveStatistics.<process id>' on Windows
+// ('/Jacobi.Vst.LiveStatistics.<process id>' for shm_open elsewhere).
+// An external tool opens the segment read-only to show what every instance is doing;
+// no debugger or TraceContext is needed. The layout is fixed per version:
+//   LiveStatisticsHeader
+//   LiveStatisticsSlot, repeated slotCount times.
+// Both the host (Jacobi.Vst.Host.Interop) and plugin (Jacobi.Vst.Interop) side use the same segment.
+// Counters are written by the instance without locking; readers get a (slightly stale) snapshot.
+
+const uint32_t LiveStatisticsMagic = 'V' | 'N' << 8 | 'L' << 16 | 'S' << 24;
+const uint32_t LiveStatisticsVersion = 1;
+const int32_t LiveStatisticsSlotCount = 64;
+// dispatcher opcodes are counted individually up to this number, higher opcodes in the last entry.
+const int32_t LiveStatisticsOpcodeCount = 128;
+const int32_t LiveStatisticsNameLength = 64;
+
+struct LiveStatisticsHeader
+{
+	// written last by the process that created the segment.
+	uint32_t magic;
+	uint32_t version;
+	uint32_t headerSize;
+	uint32_t slotSize;
+	uint32_t slotCount;
+	uint32_t processId;
+	// the number of modules in the process that have the segment mapped.
+	volatile int32_t attachCount;
+	uint32_t reserved;
+	// identifies the process instance (its start time), to recognize a segment that a crashed process
+	// with the same id left behind.
+	volatile uint64_t processStartTime;
+	uint8_t reserved2[24];
+};
+
+// The kind of instance that uses a slot. A free slot is None.
+enum class LiveStatisticsKind : uint32_t
+{
+	None,
+	// a plugin loaded by a VST.NET host.
+	Host,
+	// a VST.NET plugin loaded by a host.
+	Plugin,
+};
+
+struct LiveStatisticsSlot
+{
+	volatile LiveStatisticsKind kind;
+	// incremented each time the slot is taken, so a reader can tell the instance changed.
+	volatile uint32_t sequence;
+	int32_t pluginId;
+	int32_t pluginVersion;
+	// zero terminated, in the ANSI code page like the other strings the interop passes on.
+	char name[LiveStatisticsNameLength];
+
+	int64_t processCount;
+	int64_t processFrames;
+	int64_t dispatchCount;
+	int64_t parameterCount;
+	// events passed to the plugin and the number of ProcessEvents calls they came in.
+	int64_t eventCount;
+	int64_t eventBlockCount;
+	int32_t lastEventCount;
+	int32_t maxEventCount;
+	// bytes copied between the host and the plugin (chunks and events).
+	int64_t marshaledBytes;
+	// native memory the interop allocated on behalf of the plugin.
+	int64_t allocationCount;
+	int64_t allocatedBytes;
+	// process calls that took longer than the block lasts (the load meter's threshold on the host side).
+	int64_t deadlineMissCount;
+	// the load of the last process call and the highest load (1.0: the call took as long as the block lasts).
+	float load;
+	float peakLoad;
+	float sampleRate;
+	int32_t blockSize;
+	int64_t reserved[9];
+
+	int64_t dispatchCounts[LiveStatisticsOpcodeCount];
+
+	void AddDispatch(int32_t opcode)
+	{
+		dispatchCount++;
+		dispatchCounts[(uint32_t)opcode < (uint32_t)LiveStatisticsOpcodeCount ? opcode : LiveStatisticsOpcodeCount - 1]++;
+	}
+
+	void AddProcess(int32_t sampleFrames)
+	{
+		processCount++;
+		processFrames += sampleFrames;
+	}
+
+	// returns the size of the events in bytes.
+	int64_t AddEvents(const ::Vst2Events* pEvents)
+	{
+		if(pEvents == NULL)
+		{
+			return 0;
+		}
+
+		int64_t size = sizeof(::Vst2Events) + pEvents->eventCount * sizeof(::Vst2Event*);
+		for(int32_t i = 0; i < pEvents->eventCount; i++)
+		{
+			size += pEvents->events[i]->sizeInBytes;
+			if(pEvents->events[i]->kind == ::Vst2EventKind::SystemExclusive)
+			{
+				size += ((const ::Vst2MidiSysExEvent*)pEvents->events[i])->dumpInBytes;
+			}
+		}
+
+		eventBlockCount++;
+		eventCount += pEvents->eventCount;
+		lastEventCount = pEvents->eventCount;
+		if(pEvents->eventCount > maxEventCount)
+		{
+			maxEventCount = pEvents->eventCount;
+		}
+		marshaledBytes += size;
+		return size;
+	}
+
+	void AddMarshaled(int64_t size)
+	{
+		marshaledBytes += size;
+	}
+
+	void AddAllocation(int64_t size)
+	{
+		allocationCount++;
+		allocatedBytes += size;
+	}
+
+	void SetLoad(float lastLoad, float peak, int64_t deadlineMisses)
+	{
+		load = lastLoad;
+		peakLoad = peak;
+		deadlineMissCount = deadlineMisses;
+	}
+};
+
+static_assert(sizeof(LiveStatisticsHeader) == 64, "LiveStatisticsHeader layout changed: increment LiveStatisticsVersion.");
+static_assert(offsetof(LiveStatisticsSlot, processCount) == 80, "LiveStatisticsSlot layout changed: increment LiveStatisticsVersion.");
+static_assert(offsetof(LiveStatisticsSlot, load) == 168, "LiveStatisticsSlot layout changed: increment LiveStatisticsVersion.");
+static_assert(offsetof(LiveStatisticsSlot, dispatchCounts) == 256, "LiveStatisticsSlot layout changed: increment LiveStatisticsVersion.");
+static_assert(sizeof(LiveStatisticsSlot) == 1280, "LiveStatisticsSlot layout changed: increment LiveStatisticsVersion.");
+
+// Hands out the slots of the segment of the current process.
+// Does not depend on the CLR; the same code is used by the Linux test harness.
+class LiveStatistics
+{
+public:
+	// Takes a free slot, creating (or opening) the segment on first use.
+	// Returns a private slot that is not published when the segment is full or cannot be created,
+	// so the caller always gets a slot to write to.
+	static LiveStatisticsSlot* AcquireSlot(LiveStatisticsKind kind, int32_t pluginId, int32_t pluginVersion);
+
+	// Frees the slot. The segment is unmapped when the module releases its last slot.
+	static void ReleaseSlot(LiveStatisticsSlot* pSlot);
+
+	// Frees the slot for other instances and returns a private copy for calls that still follow (after Close).
+	static LiveStatisticsSlot* DetachSlot(LiveStatisticsSlot* pSlot);
+
+	// Returns true when pSlot is published in the segment.
+	static bool IsPublished(const LiveStatisticsSlot* pSlot);
+
+	// Returns the current time in ticks of GetTicksPerSecond.
+	static int64_t GetTicks();
+	static double GetTicksPerSecond();
+
+	// Updates the load of the plugin side, where there is no load meter.
+	static void EndProcess(LiveStatisticsSlot* pSlot, int64_t startTicks, int32_t sampleFrames);
+};
+
+// Reads the segment of a (another) process.
+class LiveStatisticsReader
+{
+public:
+	LiveStatisticsReader();
+	~LiveStatisticsReader();
+
+	// Opens the segment of the process read-only.
+	// Returns false when the process has no segment or the segment has another layout version.
+	bool Open(uint32_t processId);
+	void Close();
+
+	const LiveStatisticsHeader* GetHeader() const;
+
+	// Copies the slot at index. Returns false when the slot is free.
+	bool ReadSlot(int32_t index, LiveStatisticsSlot* pSlot) const;
+
+private:
+	LiveStatisticsReader(const LiveStatisticsReader&) = delete;
+	LiveStatisticsReader& operator=(const LiveStatisticsReader&) = delete;
+
+	const LiveStatisticsHeader* _pHeader;
+	size_t _size;
+#ifdef _WIN32
+	void* _hMapping;
+#endif
+};
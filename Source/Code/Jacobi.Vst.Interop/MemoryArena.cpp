@@ -0,0 +1,108 @@
+// compiled without /clr and without the precompiled header (also built by the native tests).
+#include "MemoryArena.h"
+
+#include <new>
+
+namespace
+{
+	const size_t Alignment = 16;
+
+	size_t Align(size_t size)
+	{
+		return (size + Alignment - 1) & ~(Alignment - 1);
+	}
+}
+
+struct MemoryArena::Block
+{
+	Block* pNext;
+	size_t size;
+	size_t used;
+
+	char* GetData()
+	{
+		return reinterpret_cast<char*>(this) + Align(sizeof(Block));
+	}
+};
+
+MemoryArena::MemoryArena(size_t blockSize, size_t retainSize)
+	: _pBlocks(NULL), _blockSize(Align(blockSize > 0 ? blockSize : DefaultBlockSize)), _retainSize(retainSize),
+	_allocatedSize(0), _reservedSize(0), _generation(0)
+{
+}
+
+MemoryArena::~MemoryArena()
+{
+	while(_pBlocks != NULL)
+	{
+		Block* pBlock = _pBlocks;
+		_pBlocks = pBlock->pNext;
+		::operator delete(pBlock);
+	}
+}
+
+void* MemoryArena::Allocate(size_t size)
+{
+	size = Align(size > 0 ? size : 1);
+
+	if(_pBlocks == NULL || _pBlocks->size - _pBlocks->used < size)
+	{
+		size_t blockSize = size > _blockSize ? size : _blockSize;
+
+		Block* pBlock = static_cast<Block*>(::operator new(Align(sizeof(Block)) + blockSize, std::nothrow));
+		if(pBlock == NULL)
+		{
+			return NULL;
+		}
+
+		pBlock->pNext = _pBlocks;
+		pBlock->size = blockSize;
+		pBlock->used = 0;
+		_pBlocks = pBlock;
+		_reservedSize += blockSize;
+	}
+
+	void* pMem = _pBlocks->GetData() + _pBlocks->used;
+	_pBlocks->used += size;
+	_allocatedSize += size;
+
+	return pMem;
+}
+
+void MemoryArena::Reset()
+{
+	// keep the largest block that is within the retain size. Usually there is only one.
+	Block* pKeep = NULL;
+	Block* pBlock = _pBlocks;
+
+	while(pBlock != NULL)
+	{
+		Block* pNext = pBlock->pNext;
+
+		if(pBlock->size <= _retainSize && (pKeep == NULL || pBlock->size > pKeep->size))
+		{
+			if(pKeep != NULL)
+			{
+				::operator delete(pKeep);
+			}
+			pKeep = pBlock;
+		}
+		else
+		{
+			::operator delete(pBlock);
+		}
+
+		pBlock = pNext;
+	}
+
+	if(pKeep != NULL)
+	{
+		pKeep->pNext = NULL;
+		pKeep->used = 0;
+	}
+
+	_pBlocks = pKeep;
+	_reservedSize = pKeep != NULL ? pKeep->size : 0;
+	_allocatedSize = 0;
+	_generation++;
+}
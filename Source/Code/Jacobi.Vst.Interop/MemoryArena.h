@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The MemoryArena hands out native memory for data that is passed to the other side of the interop
+// and has to outlive the call (a chunk for ChunkSet or the result of ChunkGet).
+// Allocations are bumped from blocks and are never freed individually: Reset releases all of them at once
+// and starts a new generation. The owner decides when a generation ends: at suspend/resume (MainsChanged)
+// or at the start of the next call that returns the same out-parameter (a per-call scratch arena).
+// Reset keeps one block (up to the retain size) so the next generation does not allocate again,
+// which keeps the memory bounded for sessions that never suspend.
+// Not thread safe: an arena belongs to one instance and is used from its dispatcher calls.
+class MemoryArena
+{
+public:
+	static const size_t DefaultBlockSize = 64 * 1024;
+	static const size_t DefaultRetainSize = 1024 * 1024;
+
+	// blockSize is the minimum size of a block; larger allocations get a block of their own.
+	// A block larger than retainSize is freed on Reset.
+	MemoryArena(size_t blockSize = DefaultBlockSize, size_t retainSize = DefaultRetainSize);
+	~MemoryArena();
+
+	// Returns size bytes (aligned for any type) that stay valid until Reset. Returns NULL when out of memory.
+	void* Allocate(size_t size);
+
+	// Releases all allocations and starts a new generation.
+	void Reset();
+
+	// The number of Reset calls.
+	uint32_t GetGeneration() const
+	{
+		return _generation;
+	}
+
+	// The bytes allocated in the current generation.
+	size_t GetAllocatedSize() const
+	{
+		return _allocatedSize;
+	}
+
+	// The bytes held in blocks (including the retained block).
+	size_t GetReservedSize() const
+	{
+		return _reservedSize;
+	}
+
+private:
+	MemoryArena(const MemoryArena&) = delete;
+	MemoryArena& operator=(const MemoryArena&) = delete;
+
+	struct Block;
+
+	Block* _pBlocks;	// the block allocations are bumped from is first.
+	size_t _blockSize;
+	size_t _retainSize;
+	size_t _allocatedSize;
+	size_t _reservedSize;
+	uint32_t _generation;
+};
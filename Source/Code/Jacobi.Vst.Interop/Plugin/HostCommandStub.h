@@ -40,10 +40,10 @@ namespace Interop {
 
     internal:
         HostCommandStub(::Vst2HostCommand hostCommandHandler);
-        void Initialize(::Vst2Plugin* pluginInfo) 
+        void Initialize(::Vst2Plugin* pluginInfo, int32_t processBlockDelay) 
         {
             if(pluginInfo == NULL) { throw gcnew System::ArgumentNullException("pluginInfo"); } 
-            _commands = gcnew Jacobi::Vst::Plugin::Interop::HostCommandsImpl(_hostCommand, pluginInfo);
+            _commands = gcnew Jacobi::Vst::Plugin::Interop::HostCommandsImpl(_hostCommand, pluginInfo, processBlockDelay);
         }
 
         bool IsInitialized() { return (_commands != nullptr); }
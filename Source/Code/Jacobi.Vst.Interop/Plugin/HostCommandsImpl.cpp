@@ -11,10 +11,11 @@ namespace Plugin {
 namespace Interop {
 
 // Creates a new instance based on a native callback function pointer.
-HostCommandsImpl::HostCommandsImpl(::Vst2HostCommand hostCommand, Vst2Plugin* pluginInfo)
+HostCommandsImpl::HostCommandsImpl(::Vst2HostCommand hostCommand, Vst2Plugin* pluginInfo, int32_t processBlockDelay)
 {
 	_hostCommand = hostCommand;
 	_pluginInfo = pluginInfo;
+	_processBlockDelay = processBlockDelay;
 
 	_timeInfo = gcnew Jacobi::Vst::Core::VstTimeInfo();
 	_traceCtx = gcnew Jacobi::Vst::Core::Diagnostics::TraceContext(
@@ -51,11 +52,11 @@ System::Boolean HostCommandsImpl::UpdatePluginInfo(Jacobi::Vst::Core::Plugin::Vs
 
 		if (_pluginInfo->inputCount != pluginInfo->AudioInputCount ||
 			_pluginInfo->outputCount != pluginInfo->AudioOutputCount ||
-			_pluginInfo->startupDelay != pluginInfo->InitialDelay)
+			_pluginInfo->startupDelay != pluginInfo->InitialDelay + _processBlockDelay)
 		{
 			_pluginInfo->inputCount = pluginInfo->AudioInputCount;
 			_pluginInfo->outputCount = pluginInfo->AudioOutputCount;
-			_pluginInfo->startupDelay = pluginInfo->InitialDelay;
+			_pluginInfo->startupDelay = pluginInfo->InitialDelay + _processBlockDelay;
 
 			return IoChanged();
 		}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "..\TimelineTrace.h"
+
 namespace Jacobi {
 namespace Vst {
 namespace Plugin {
@@ -278,20 +280,24 @@ namespace Interop {
         virtual Jacobi::Vst::Core::VstSpeakerArrangement^ GetInputSpeakerArrangement();
 
     internal:
-        HostCommandsImpl(::Vst2HostCommand hostCommandHandler, Vst2Plugin* pluginInfo);
+        HostCommandsImpl(::Vst2HostCommand hostCommandHandler, Vst2Plugin* pluginInfo, int32_t processBlockDelay);
 
         bool IsInitialized() { return (_pluginInfo != NULL); }
 
     private:
         Vst2Plugin* _pluginInfo;
         Vst2HostCommand _hostCommand;
+        // latency added by block coalescing, reported on top of the InitialDelay.
+        int32_t _processBlockDelay;
 
         void ThrowIfNotInitialized();
         Vst2IntPtr CallHost(Vst2HostCommands command, int32_t index, Vst2IntPtr value, void* ptr, float opt)
         {
             _traceCtx->WriteDispatchBegin(System::Int32(command), index, System::IntPtr(value), System::IntPtr(ptr), opt);
 
+            TimelineTrace::Begin(TimelineSpan::HostCallback, _pluginInfo, (int32_t)command, index);
             Vst2IntPtr result = _hostCommand(_pluginInfo, command, index, value, ptr, opt);
+            TimelineTrace::End(TimelineSpan::HostCallback, _pluginInfo, (int32_t)command, result);
 
             _traceCtx->WriteDispatchEnd(System::IntPtr(result));
 
@@ -2,9 +2,13 @@
 #include "../Bootstrapper.h"
 #include "PluginCommandProxy.h"
 #include "HostCommandStub.h"
+#include "PluginInfoCache.h"
 #include "../TimeCriticalScope.h"
+#include "../TimelineTrace.h"
+#include "../TypeConverter.h"
 #include "../Utils.h"
 #include "../Properties/Resources.h"
+#include <vcclr.h>
 
 namespace Jacobi {
 namespace Vst {
@@ -12,10 +16,16 @@ namespace Interop {
 
 // fwd ref
 Vst2Plugin* CreateAudioEffectInfo(Jacobi::Vst::Core::Plugin::VstPluginInfo^ pluginInfo);
+Vst2Plugin* AttachPluginProxy(Jacobi::Vst::Plugin::Interop::HostCommandStub^ hostStub,
+	Jacobi::Vst::Core::Plugin::VstPluginInfo^ pluginInfo, Jacobi::Vst::Plugin::Interop::PluginCommandProxy^ proxy);
+void StartTimelineTrace();
+void WriteTimelineTrace();
 
 // main exported method called by host to create the plugin
 Vst2Plugin* VSTPluginMain (::Vst2HostCommand hostCommandHandler)
 {
+	StartTimelineTrace();
+
 	// create the host command stub (sends commands to host)
 	auto hostStub = gcnew Jacobi::Vst::Plugin::Interop::HostCommandStub(hostCommandHandler);
 
@@ -24,6 +34,16 @@ Vst2Plugin* VSTPluginMain (::Vst2HostCommand hostCommandHandler)
 		// retrieve the current plugin file name (interop)
 		auto interopAssemblyFileName = Utils::GetCurrentFileName();
 
+		// when the plugin info is cached the managed plugin assembly and its configuration
+		// are loaded when the host first needs the plugin (not while scanning).
+		auto pluginInfoCache = Jacobi::Vst::Plugin::Interop::PluginInfoCache::Load(interopAssemblyFileName);
+
+		if (pluginInfoCache != nullptr)
+		{
+			return AttachPluginProxy(hostStub, pluginInfoCache->PluginInfo,
+				gcnew Jacobi::Vst::Plugin::Interop::PluginCommandProxy(pluginInfoCache, hostStub, interopAssemblyFileName));
+		}
+
 		// create the managed type that implements the Plugin Command Stub interface (sends commands to plugin)
 		auto commandStub = Bootstrapper::LoadManagedPlugin(interopAssemblyFileName);
 		
@@ -34,21 +54,12 @@ Vst2Plugin* VSTPluginMain (::Vst2HostCommand hostCommandHandler)
 
 			if (pluginInfo)
 			{
-				// create the native audio effect struct based on the plugin info
-				::Vst2Plugin* pPlugin = CreateAudioEffectInfo(pluginInfo);
-
-				// initialize host stub with plugin info
-				hostStub->Initialize(pPlugin);
-
-				// connect the plugin command stub to the command proxy and construct a handle
-				auto proxyHandle = System::Runtime::InteropServices::GCHandle::Alloc(
-					gcnew Jacobi::Vst::Plugin::Interop::PluginCommandProxy(commandStub), 
-					System::Runtime::InteropServices::GCHandleType::Normal);
+				// speed up the next instance
+				Jacobi::Vst::Plugin::Interop::PluginInfoCache::Save(interopAssemblyFileName, pluginInfo, commandStub->Commands);
 
-				// maintain the proxy reference as part of the effect struct
-				pPlugin->user = System::Runtime::InteropServices::GCHandle::ToIntPtr(proxyHandle).ToPointer();
-
-				return pPlugin;
+				// connect the plugin command stub to the command proxy
+				return AttachPluginProxy(hostStub, pluginInfo,
+					gcnew Jacobi::Vst::Plugin::Interop::PluginCommandProxy(commandStub));
 			}
 			else
 			{
@@ -78,7 +89,33 @@ Vst2IntPtr DispatcherProc(Vst2Plugin* pluginInfo, Vst2PluginCommands command, in
 		auto proxy = (Jacobi::Vst::Plugin::Interop::PluginCommandProxy^)
 			System::Runtime::InteropServices::GCHandle::FromIntPtr(System::IntPtr(pluginInfo->user)).Target;
 
-		return proxy->Dispatch(safe_cast<int32_t>(command), index, value, ptr, opt);
+		// variable io is audio processing and needs the channel counts
+		if (command == Vst2PluginCommands::ProcessVariableIo)
+		{
+			TimeCriticalScope scope;
+
+			auto pVarIo = (Vst2VariableIo*)ptr;
+			TimelineTrace::Begin(TimelineSpan::ProcessVariableIo, pluginInfo, 0, pVarIo != NULL ? pVarIo->sampleInputCount : 0);
+			Vst2IntPtr result = proxy->ProcessVariableIo(pVarIo, pluginInfo->inputCount, pluginInfo->outputCount);
+			TimelineTrace::End(TimelineSpan::ProcessVariableIo, pluginInfo, 0, result);
+
+			return result;
+		}
+
+		TimelineTrace::Begin(TimelineSpan::Dispatch, pluginInfo, (int32_t)command, index);
+		Vst2IntPtr result = proxy->Dispatch(safe_cast<int32_t>(command), index, value, ptr, opt);
+		TimelineTrace::End(TimelineSpan::Dispatch, pluginInfo, (int32_t)command, result);
+
+		if (command == Vst2PluginCommands::Close)
+		{
+			WriteTimelineTrace();
+
+			// the proxy has disposed itself; release it for collection.
+			System::Runtime::InteropServices::GCHandle::FromIntPtr(System::IntPtr(pluginInfo->user)).Free();
+			pluginInfo->user = NULL;
+		}
+
+		return result;
 	}
 
 	return 0;
@@ -95,7 +132,9 @@ void Process32Proc(Vst2Plugin* pluginInfo, float** inputs, float** outputs, int3
 		auto proxy = (Jacobi::Vst::Plugin::Interop::PluginCommandProxy^)
 			System::Runtime::InteropServices::GCHandle::FromIntPtr(System::IntPtr(pluginInfo->user)).Target;
 
+		TimelineTrace::Begin(TimelineSpan::Process32, pluginInfo, 0, sampleFrames);
 		proxy->Process(inputs, outputs, sampleFrames, pluginInfo->inputCount, pluginInfo->outputCount);
+		TimelineTrace::End(TimelineSpan::Process32, pluginInfo, 0, 0);
 	}
 }
 
@@ -110,7 +149,9 @@ void Process64Proc(Vst2Plugin* pluginInfo, double** inputs, double** outputs, in
 		auto proxy = (Jacobi::Vst::Plugin::Interop::PluginCommandProxy^)
 			System::Runtime::InteropServices::GCHandle::FromIntPtr(System::IntPtr(pluginInfo->user)).Target;
 
+		TimelineTrace::Begin(TimelineSpan::Process64, pluginInfo, 0, sampleFrames);
 		proxy->Process(inputs, outputs, sampleFrames, pluginInfo->inputCount, pluginInfo->outputCount);
+		TimelineTrace::End(TimelineSpan::Process64, pluginInfo, 0, 0);
 	}
 }
 
@@ -122,7 +163,9 @@ void SetParameterProc(Vst2Plugin* pluginInfo, int32_t index, float value)
 		auto proxy = (Jacobi::Vst::Plugin::Interop::PluginCommandProxy^)
 			System::Runtime::InteropServices::GCHandle::FromIntPtr(System::IntPtr(pluginInfo->user)).Target;
 
+		TimelineTrace::Begin(TimelineSpan::SetParameter, pluginInfo, 0, index);
 		proxy->SetParameter(index, value);
+		TimelineTrace::End(TimelineSpan::SetParameter, pluginInfo, 0, 0);
 	}
 }
 
@@ -134,7 +177,11 @@ float GetParameterProc(Vst2Plugin* pluginInfo, int32_t index)
 		auto proxy = (Jacobi::Vst::Plugin::Interop::PluginCommandProxy^)
 			System::Runtime::InteropServices::GCHandle::FromIntPtr(System::IntPtr(pluginInfo->user)).Target;
 
-		return proxy->GetParameter(index);
+		TimelineTrace::Begin(TimelineSpan::GetParameter, pluginInfo, 0, index);
+		float result = proxy->GetParameter(index);
+		TimelineTrace::End(TimelineSpan::GetParameter, pluginInfo, 0, 0);
+
+		return result;
 	}
 
 	return 0.0;
@@ -151,10 +198,40 @@ void Process32AccProc(Vst2Plugin* pluginInfo, float** inputs, float** outputs, i
 		auto proxy = (Jacobi::Vst::Plugin::Interop::PluginCommandProxy^)
 			System::Runtime::InteropServices::GCHandle::FromIntPtr(System::IntPtr(pluginInfo->user)).Target;
 
+		TimelineTrace::Begin(TimelineSpan::ProcessAccumulating, pluginInfo, 0, sampleFrames);
 		proxy->ProcessAcc(inputs, outputs, sampleFrames, pluginInfo->inputCount, pluginInfo->outputCount);
+		TimelineTrace::End(TimelineSpan::ProcessAccumulating, pluginInfo, 0, 0);
 	}
 }
 
+// Helper method to create the Vst2Plugin structure and connect the proxy to it.
+Vst2Plugin* AttachPluginProxy(Jacobi::Vst::Plugin::Interop::HostCommandStub^ hostStub,
+	Jacobi::Vst::Core::Plugin::VstPluginInfo^ pluginInfo, Jacobi::Vst::Plugin::Interop::PluginCommandProxy^ proxy)
+{
+	// create the native audio effect struct based on the plugin info
+	::Vst2Plugin* pPlugin = CreateAudioEffectInfo(pluginInfo);
+
+	// block coalescing adds one block of latency
+	int32_t processBlockSize = max(pluginInfo->ProcessBlockSize, 0);
+
+	// initialize host stub with plugin info
+	hostStub->Initialize(pPlugin, processBlockSize);
+
+	proxy->SetProcessBlockSize(processBlockSize);
+
+	// construct a handle and maintain the proxy reference as part of the effect struct
+	auto proxyHandle = System::Runtime::InteropServices::GCHandle::Alloc(
+		proxy, System::Runtime::InteropServices::GCHandleType::Normal);
+
+	pPlugin->user = System::Runtime::InteropServices::GCHandle::ToIntPtr(proxyHandle).ToPointer();
+
+	char name[64];
+	TypeConverter::StringToChar(Utils::GetPluginName(), name, sizeof(name));
+	TimelineTrace::SetInstanceName(pPlugin, name);
+
+	return pPlugin;
+}
+
 // Helper method to create the Vst2Plugin structure based on the pluginInfo.
 Vst2Plugin* CreateAudioEffectInfo(Jacobi::Vst::Core::Plugin::VstPluginInfo^ pluginInfo)
 {
@@ -172,7 +249,7 @@ Vst2Plugin* CreateAudioEffectInfo(Jacobi::Vst::Core::Plugin::VstPluginInfo^ plug
 
 	// assign info data
 	pEffect->flags = (Vst2PluginFlags)pluginInfo->Flags;
-	pEffect->startupDelay = pluginInfo->InitialDelay;
+	pEffect->startupDelay = pluginInfo->InitialDelay + max(pluginInfo->ProcessBlockSize, 0);
 	pEffect->inputCount = pluginInfo->AudioInputCount;
 	pEffect->outputCount = pluginInfo->AudioOutputCount;
 	pEffect->parameterCount = pluginInfo->ParameterCount;
@@ -196,4 +273,47 @@ Vst2Plugin* CreateAudioEffectInfo(Jacobi::Vst::Core::Plugin::VstPluginInfo^ plug
 	return pEffect;
 }
 
+// The timeline trace is recorded when the VSTNET_TIMELINE environment variable holds a folder.
+// The trace of all instances is (re)written to <folder>/<plugin name>.<process id>.json each time an instance closes.
+System::String^ GetTimelineTracePath()
+{
+	auto folder = System::Environment::GetEnvironmentVariable("VSTNET_TIMELINE");
+	if (System::String::IsNullOrEmpty(folder))
+	{
+		return nullptr;
+	}
+
+	return System::IO::Path::Combine(folder, System::String::Format("{0}.{1}.json",
+		Utils::GetPluginName(), System::Diagnostics::Process::GetCurrentProcess()->Id));
+}
+
+void StartTimelineTrace()
+{
+	// started once; the following instances are recorded in the same capture.
+	if (TimelineTrace::IsRecording() || GetTimelineTracePath() == nullptr)
+	{
+		return;
+	}
+
+	TimelineTrace::Start(1000000);
+}
+
+void WriteTimelineTrace()
+{
+	auto path = GetTimelineTracePath();
+	if (path == nullptr || !TimelineTrace::IsRecording())
+	{
+		return;
+	}
+
+	pin_ptr<const wchar_t> pPath = PtrToStringChars(path);
+
+	FILE* pFile = NULL;
+	if (::_wfopen_s(&pFile, pPath, L"wb") == 0)
+	{
+		TimelineTrace::WriteChromeJson(pFile);
+		fclose(pFile);
+	}
+}
+
 }}} // Jacobi::Vst::Interop
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include "pch.h"
 #include "PluginCommandProxy.h"
+#include "PluginInfoCache.h"
+#include "HostCommandStub.h"
+#include "..\Bootstrapper.h"
+#include "..\Properties\Resources.h"
 #include "..\TypeConverter.h"
 #include "..\Utils.h"
 #include<vcclr.h>
@@ -17,12 +21,40 @@ PluginCommandProxy::PluginCommandProxy(Jacobi::Vst::Core::Plugin::IVstPluginComm
 		throw gcnew System::ArgumentNullException("cmdStub");
 	}
 
+	Initialize(cmdStub);
+}
+
+// constructs a new instance that loads the managed plugin on demand.
+PluginCommandProxy::PluginCommandProxy(PluginInfoCache^ pluginInfoCache, HostCommandStub^ hostStub, System::String^ pluginPath)
+{
+	if(pluginInfoCache == nullptr)
+	{
+		throw gcnew System::ArgumentNullException("pluginInfoCache");
+	}
+	if(hostStub == nullptr)
+	{
+		throw gcnew System::ArgumentNullException("hostStub");
+	}
+
+	_pluginInfoCache = pluginInfoCache;
+	_hostStub = hostStub;
+	_pluginPath = pluginPath;
+
+	Initialize(nullptr);
+}
+
+void PluginCommandProxy::Initialize(Jacobi::Vst::Core::Plugin::IVstPluginCommandStub^ cmdStub)
+{
 	_commandStub = cmdStub;
 	_legacyCmdStub = dynamic_cast<Jacobi::Vst::Core::Legacy::IVstPluginCommandsLegacy20^>(cmdStub);
 
-	_memTracker = gcnew Jacobi::Vst::Interop::MemoryTracker();
+	_pChunkArena = new MemoryArena();
+	_arrangementCache = gcnew Jacobi::Vst::Interop::SpeakerArrangementCache();
 	_pEditorRect = new Vst2Rectangle();
 
+	_pStatistics = LiveStatistics::AcquireSlot(LiveStatisticsKind::Plugin, 0, 0);
+	TypeConverter::StringToChar(Utils::GetPluginName(), _pStatistics->name, LiveStatisticsNameLength);
+
 	// construct a trace source for this command stub specific to the plugin its attached to.
 	_traceCtx = gcnew Jacobi::Vst::Core::Diagnostics::TraceContext(Utils::GetPluginName() + ".Plugin.PluginCommandProxy", Jacobi::Vst::Core::Plugin::IVstPluginCommandStub::typeid);
 }
@@ -35,7 +67,12 @@ PluginCommandProxy::~PluginCommandProxy()
 PluginCommandProxy::!PluginCommandProxy()
 {
 	Cleanup();
+	delete _pChunkArena;
+	_pChunkArena = NULL;
 	delete _pEditorRect;
+	DeleteCoalescers();
+	LiveStatistics::ReleaseSlot(_pStatistics);
+	_pStatistics = NULL;
 }
 
 // Dispatches an opcode to the plugin command stub.
@@ -45,6 +82,27 @@ Vst2IntPtr PluginCommandProxy::Dispatch(int32_t opcode, int32_t index, ::Vst2Int
 	::Vst2IntPtr result = 0;
 
 	_traceCtx->WriteDispatchBegin(opcode, index, System::IntPtr(value), System::IntPtr(ptr), opt);
+	_pStatistics->AddDispatch(opcode);
+
+	if(_commandStub == nullptr && _pluginInfoCache != nullptr)
+	{
+		try
+		{
+			if(DispatchFromCache(safe_cast<Vst2PluginCommands>(opcode), ptr, result))
+			{
+				_traceCtx->WriteDispatchEnd(System::IntPtr(result));
+				return result;
+			}
+		}
+		catch(System::Exception^ e)
+		{
+			_traceCtx->WriteError(e);
+
+			Utils::ShowError(e);
+		}
+
+		EnsurePluginLoaded();
+	}
 
 	if(_commandStub != nullptr)
 	{
@@ -90,15 +148,18 @@ Vst2IntPtr PluginCommandProxy::Dispatch(int32_t opcode, int32_t index, ::Vst2Int
 				result = 1;
 				break;
 			case Vst2PluginCommands::SampleRateSet:
+				_pStatistics->sampleRate = opt;
 				_commandStub->Commands->SetSampleRate(opt);
 				result = 1;
 				break;
 			case Vst2PluginCommands::BlockSizeSet:
+				_pStatistics->blockSize = safe_cast<int32_t>(value);
 				_commandStub->Commands->SetBlockSize(safe_cast<System::Int32>(value));
 				result = 1;
 				break;
 			case Vst2PluginCommands::OnOff:
-				_memTracker->ClearAll(); // safe to delete allocated memory during suspend/resume
+				_pChunkArena->Reset(); // safe to delete allocated memory during suspend/resume
+				ResetCoalescers();
 				_commandStub->Commands->MainsChanged(value != 0);
 				result = 1;
 				break;
@@ -125,12 +186,16 @@ Vst2IntPtr PluginCommandProxy::Dispatch(int32_t opcode, int32_t index, ::Vst2Int
 				break;
 			case Vst2PluginCommands::ChunkGet:
 			{
+				// the host has copied the previous chunk.
+				_pChunkArena->Reset();
+
 				array<System::Byte>^ buffer = _commandStub->Commands->GetChunk(index != 0);
 				if(buffer != nullptr)
 				{
-					*(void**)ptr = TypeConverter::ByteArrayToPtr(buffer);
-				
-					_memTracker->RegisterArray(*(void**)ptr);
+					*(void**)ptr = TypeConverter::ByteArrayToPtr(buffer, _pChunkArena);
+
+					_pStatistics->AddAllocation(buffer->Length);
+					_pStatistics->AddMarshaled(buffer->Length);
 
 					result = buffer->Length;
 				}
@@ -138,10 +203,22 @@ Vst2IntPtr PluginCommandProxy::Dispatch(int32_t opcode, int32_t index, ::Vst2Int
 			case Vst2PluginCommands::ChunkSet:
 			{
 				auto buffer = TypeConverter::PtrToByteArray((char*)ptr, safe_cast<System::Int32>(value));
+				_pStatistics->AddMarshaled(buffer->Length);
 				result = _commandStub->Commands->SetChunk(buffer, index != 0) ? 1 : 0;
 			}	break;
 			case Vst2PluginCommands::ProcessEvents:
-				result = _commandStub->Commands->ProcessEvents(TypeConverter::ToManagedEventArray((Vst2Events*)ptr)) ? 1 : 0;
+				_pStatistics->AddEvents((Vst2Events*)ptr);
+				if(_processBlockSize > 0)
+				{
+					// the events belong to the next host block which starts at the current block position.
+					// they are passed to the plugin right before the coalesced block they fall in is processed.
+					_pEventQueue->Add((Vst2Events*)ptr, _processBlockPosition);
+					result = 1;
+				}
+				else
+				{
+					result = _commandStub->Commands->ProcessEvents(TypeConverter::ToManagedEventArray((Vst2Events*)ptr)) ? 1 : 0;
+				}
 				break;
 			case Vst2PluginCommands::ParameterCanBeAutomated:
 				result = _commandStub->Commands->CanParameterBeAutomated(index) ? 1 : 0;
@@ -301,12 +378,9 @@ Vst2IntPtr PluginCommandProxy::Dispatch(int32_t opcode, int32_t index, ::Vst2Int
 				result = _commandStub->Commands->GetSpeakerArrangement(inputArr, outputArr) ? 1 : 0;
 				if(result)
 				{
-					// NOTE: register retvals with the memory tracker to be deleted later.
-					*ppInput = TypeConverter::AllocUnmanagedSpeakerArrangement(inputArr);
-					_memTracker->RegisterObject(*ppInput);
-
-					*ppOutput = TypeConverter::AllocUnmanagedSpeakerArrangement(outputArr);
-					_memTracker->RegisterObject(*ppOutput);
+					// NOTE: retvals are owned by the cache and reused on the next call.
+					*ppInput = _arrangementCache->ToUnmanaged(inputArr, true);
+					*ppOutput = _arrangementCache->ToUnmanaged(outputArr, false);
 				}
 			}	break;
 			//case Vst2PluginCommands::ShellGetNextPlugin:
@@ -355,6 +429,11 @@ Vst2IntPtr PluginCommandProxy::Dispatch(int32_t opcode, int32_t index, ::Vst2Int
 			Utils::ShowError(e);
 		}
 	}
+	else if(opcode == safe_cast<int32_t>(Vst2PluginCommands::Close))
+	{
+		// the deferred load failed: there is no plugin to close, but this instance is released all the same.
+		delete this;
+	}
 	else
 	{
 		_traceCtx->WriteEvent(System::Diagnostics::TraceEventType::Warning, "Plugin Command Stub was not set.");
@@ -422,6 +501,8 @@ Vst2IntPtr PluginCommandProxy::DispatchLegacy(Vst2PluginCommands command, int32_
 			}
 		}	break;
 		case Vst2PluginCommands::SetBlockSizeAndSampleRate:
+			_pStatistics->blockSize = safe_cast<int32_t>(value);
+			_pStatistics->sampleRate = opt;
 			result = _legacyCmdStub->SetBlockSizeAndSampleRate(safe_cast<System::Int32>(value), opt) ? 1 : 0;
 			break;
 		case Vst2PluginCommands::GetErrorText:
@@ -474,6 +555,20 @@ Vst2IntPtr PluginCommandProxy::DispatchLegacy(Vst2PluginCommands command, int32_
 // Takes care of marshaling from C++ to Managed .NET and visa versa.
 void PluginCommandProxy::Process(float** inputs, float** outputs, int32_t sampleFrames, int32_t numInputs, int32_t numOutputs)
 {
+	if(!EnsurePluginLoaded())
+	{
+		return;
+	}
+
+	int64_t startTicks = LiveStatistics::GetTicks();
+
+	if(_processBlockSize > 0)
+	{
+		ProcessCoalesced(inputs, outputs, sampleFrames, numInputs, numOutputs);
+		LiveStatistics::EndProcess(_pStatistics, startTicks, sampleFrames);
+		return;
+	}
+
 	_traceCtx->WriteProcess(numInputs, numOutputs, sampleFrames, sampleFrames);
 
 	try
@@ -489,12 +584,28 @@ void PluginCommandProxy::Process(float** inputs, float** outputs, int32_t sample
 
 		Utils::ShowError(e);
 	}
+
+	LiveStatistics::EndProcess(_pStatistics, startTicks, sampleFrames);
 }
 
 // Calls the plugin command stub to process audio.
 // Takes care of marshaling from C++ to Managed .NET and visa versa.
 void PluginCommandProxy::Process(double** inputs, double** outputs, int32_t sampleFrames, int32_t numInputs, int32_t numOutputs)
 {
+	if(!EnsurePluginLoaded())
+	{
+		return;
+	}
+
+	int64_t startTicks = LiveStatistics::GetTicks();
+
+	if(_processBlockSize > 0)
+	{
+		ProcessCoalesced(inputs, outputs, sampleFrames, numInputs, numOutputs);
+		LiveStatistics::EndProcess(_pStatistics, startTicks, sampleFrames);
+		return;
+	}
+
 	_traceCtx->WriteProcess(numInputs, numOutputs, sampleFrames, sampleFrames);
 
 	try
@@ -510,6 +621,312 @@ void PluginCommandProxy::Process(double** inputs, double** outputs, int32_t samp
 
 		Utils::ShowError(e);
 	}
+
+	LiveStatistics::EndProcess(_pStatistics, startTicks, sampleFrames);
+}
+
+// Answers the host's scan queries from the cache. Open is remembered and passed on when the plugin is loaded.
+// Returns false when the managed plugin is needed.
+bool PluginCommandProxy::DispatchFromCache(Vst2PluginCommands command, void* ptr, Vst2IntPtr% result)
+{
+	switch(command)
+	{
+	case Vst2PluginCommands::Open:
+		_isOpenPending = true;
+		result = 0;
+		return true;
+	case Vst2PluginCommands::Close:
+		_isOpenPending = false;
+		result = 0;
+		// call Dispose() on this instance
+		delete this;
+		return true;
+	case Vst2PluginCommands::PluginGetName:
+		result = 0;
+		if(_pluginInfoCache->EffectName != nullptr)
+		{
+			TypeConverter::StringToChar(_pluginInfoCache->EffectName, (char*)ptr, Vst2MaxEffectNameLen);
+			result = 1;
+		}
+		return true;
+	case Vst2PluginCommands::VendorGetString:
+		result = 0;
+		if(_pluginInfoCache->VendorString != nullptr)
+		{
+			TypeConverter::StringToChar(_pluginInfoCache->VendorString, (char*)ptr, Vst2MaxVendorStrLen);
+			result = 1;
+		}
+		return true;
+	case Vst2PluginCommands::ProductGetString:
+		result = 0;
+		if(_pluginInfoCache->ProductString != nullptr)
+		{
+			TypeConverter::StringToChar(_pluginInfoCache->ProductString, (char*)ptr, Vst2MaxProductStrLen);
+			result = 1;
+		}
+		return true;
+	case Vst2PluginCommands::VendorGetVersion:
+		result = _pluginInfoCache->VendorVersion;
+		return true;
+	case Vst2PluginCommands::PluginGetCategory:
+		result = _pluginInfoCache->Category;
+		return true;
+	case Vst2PluginCommands::GetVstVersion:
+		result = _pluginInfoCache->VstVersion;
+		return true;
+	}
+
+	return false;
+}
+
+// Loads the managed plugin assembly and configuration, the second phase of a cached startup.
+void PluginCommandProxy::LoadDeferredPlugin()
+{
+	if(_commandStub != nullptr || _pluginInfoCache == nullptr)
+	{
+		return;
+	}
+
+	auto commandStub = Bootstrapper::LoadManagedPlugin(_pluginPath);
+	if(commandStub == nullptr)
+	{
+		throw gcnew System::InvalidOperationException(
+			Jacobi::Vst::Interop::Properties::Resources::VstInteropMain_CouldNotCreatePluginCmdStub);
+	}
+
+	auto pluginInfo = commandStub->GetPluginInfo(_hostStub);
+	if(pluginInfo == nullptr)
+	{
+		throw gcnew System::InvalidOperationException(
+			Jacobi::Vst::Interop::Properties::Resources::VstInteropMain_GetPluginInfoNull);
+	}
+
+	_commandStub = commandStub;
+	_legacyCmdStub = dynamic_cast<Jacobi::Vst::Core::Legacy::IVstPluginCommandsLegacy20^>(commandStub);
+	_pluginInfoCache = nullptr;
+	_hostStub = nullptr;
+
+	if(_isOpenPending)
+	{
+		_isOpenPending = false;
+		_commandStub->Commands->Open();
+	}
+}
+
+// Loads a deferred plugin, reports failures. Returns true when the plugin can be called.
+bool PluginCommandProxy::EnsurePluginLoaded()
+{
+	if(_commandStub == nullptr && _pluginInfoCache != nullptr)
+	{
+		try
+		{
+			LoadDeferredPlugin();
+		}
+		catch(System::Exception^ e)
+		{
+			// do not retry for every call.
+			_pluginInfoCache = nullptr;
+
+			_traceCtx->WriteError(e);
+
+			Utils::ShowError(e);
+		}
+	}
+
+	return _commandStub != nullptr;
+}
+
+void PluginCommandProxy::SetProcessBlockSize(int32_t blockSize)
+{
+	DeleteCoalescers();
+
+	_processBlockSize = max(blockSize, 0);
+
+	if(_processBlockSize > 0)
+	{
+		_pEventQueue = new ProcessEventQueue();
+	}
+}
+
+// Collects the host block into the coalescer and calls the plugin command stub for each full block.
+// The coalescer (and its managed wrappers) are only (re)created when the channel count changes.
+void PluginCommandProxy::ProcessCoalesced(float** inputs, float** outputs, int32_t sampleFrames, int32_t numInputs, int32_t numOutputs)
+{
+	try
+	{
+		if(_pCoalescer32 == NULL || !_pCoalescer32->Matches(numInputs, numOutputs))
+		{
+			delete _pCoalescer32;
+			_pCoalescer32 = new ProcessBlockCoalescer<float>(_processBlockSize, numInputs, numOutputs);
+
+			_blockInputs32 = TypeConverter::ToManagedAudioBufferArray(_pCoalescer32->GetInputs(), _processBlockSize, numInputs, false);
+			_blockOutputs32 = TypeConverter::ToManagedAudioBufferArray(_pCoalescer32->GetOutputs(), _processBlockSize, numOutputs, true);
+		}
+
+		int32_t offset = 0;
+		while(offset < sampleFrames)
+		{
+			offset += _pCoalescer32->Exchange(inputs, outputs, offset, sampleFrames - offset);
+
+			if(_pCoalescer32->IsBlockFull())
+			{
+				_traceCtx->WriteProcess(numInputs, numOutputs, _processBlockSize, _processBlockSize);
+
+				DispatchBlockEvents();
+				_commandStub->Commands->ProcessReplacing(_blockInputs32, _blockOutputs32);
+				_pCoalescer32->NextBlock();
+			}
+		}
+
+		_processBlockPosition = _pCoalescer32->GetPosition();
+	}
+	catch(System::Exception^ e)
+	{
+		_traceCtx->WriteError(e);
+
+		Utils::ShowError(e);
+	}
+}
+
+void PluginCommandProxy::ProcessCoalesced(double** inputs, double** outputs, int32_t sampleFrames, int32_t numInputs, int32_t numOutputs)
+{
+	try
+	{
+		if(_pCoalescer64 == NULL || !_pCoalescer64->Matches(numInputs, numOutputs))
+		{
+			delete _pCoalescer64;
+			_pCoalescer64 = new ProcessBlockCoalescer<double>(_processBlockSize, numInputs, numOutputs);
+
+			_blockInputs64 = TypeConverter::ToManagedAudioBufferArray(_pCoalescer64->GetInputs(), _processBlockSize, numInputs, false);
+			_blockOutputs64 = TypeConverter::ToManagedAudioBufferArray(_pCoalescer64->GetOutputs(), _processBlockSize, numOutputs, true);
+		}
+
+		int32_t offset = 0;
+		while(offset < sampleFrames)
+		{
+			offset += _pCoalescer64->Exchange(inputs, outputs, offset, sampleFrames - offset);
+
+			if(_pCoalescer64->IsBlockFull())
+			{
+				_traceCtx->WriteProcess(numInputs, numOutputs, _processBlockSize, _processBlockSize);
+
+				DispatchBlockEvents();
+				_commandStub->Commands->ProcessReplacing(_blockInputs64, _blockOutputs64);
+				_pCoalescer64->NextBlock();
+			}
+		}
+
+		_processBlockPosition = _pCoalescer64->GetPosition();
+	}
+	catch(System::Exception^ e)
+	{
+		_traceCtx->WriteError(e);
+
+		Utils::ShowError(e);
+	}
+}
+
+// clears the collected audio, for instance when the plugin is switched off.
+void PluginCommandProxy::ResetCoalescers()
+{
+	if(_pCoalescer32 != NULL)
+	{
+		_pCoalescer32->Reset();
+	}
+	if(_pCoalescer64 != NULL)
+	{
+		_pCoalescer64->Reset();
+	}
+	if(_pEventQueue != NULL)
+	{
+		_pEventQueue->Clear();
+	}
+
+	_processBlockPosition = 0;
+}
+
+void PluginCommandProxy::DeleteCoalescers()
+{
+	delete _pCoalescer32;
+	_pCoalescer32 = NULL;
+	delete _pCoalescer64;
+	_pCoalescer64 = NULL;
+	delete _pEventQueue;
+	_pEventQueue = NULL;
+
+	_blockInputs32 = nullptr;
+	_blockOutputs32 = nullptr;
+	_blockInputs64 = nullptr;
+	_blockOutputs64 = nullptr;
+	_processBlockPosition = 0;
+}
+
+// passes the events of the full coalesced block to the plugin, as one list.
+void PluginCommandProxy::DispatchBlockEvents()
+{
+	auto pEvents = const_cast<::Vst2Events*>(_pEventQueue->TakeBlock(_processBlockSize));
+
+	if(pEvents->eventCount > 0)
+	{
+		_commandStub->Commands->ProcessEvents(TypeConverter::ToManagedEventArray(pEvents));
+	}
+}
+
+// Calls the plugin command stub to process a variable number of input and output samples.
+// Takes care of marshaling from C++ to Managed .NET and visa versa.
+Vst2IntPtr PluginCommandProxy::ProcessVariableIo(Vst2VariableIo* pVarIo, int32_t numInputs, int32_t numOutputs)
+{
+	if(pVarIo == NULL)
+	{
+		return 0;
+	}
+
+	_traceCtx->WriteProcess(numInputs, numOutputs, pVarIo->sampleInputCount, pVarIo->sampleOutputCount);
+
+	if(!EnsurePluginLoaded())
+	{
+		return 0;
+	}
+
+	auto commands = dynamic_cast<Jacobi::Vst::Core::IVstPluginCommandsVariableIo^>(_commandStub->Commands);
+	if(commands == nullptr)
+	{
+		return 0;
+	}
+
+	// the load of a variable io call is not measured: its in- and output durations differ.
+	_pStatistics->AddProcess(pVarIo->sampleOutputCount);
+
+	try
+	{
+		auto inputBuffers = TypeConverter::ToManagedAudioBufferArray(pVarIo->inputs, pVarIo->sampleInputCount, numInputs, false);
+		auto outputBuffers = TypeConverter::ToManagedAudioBufferArray(pVarIo->outputs, pVarIo->sampleOutputCount, numOutputs, true);
+
+		int inputProcessed = 0;
+		int outputProcessed = 0;
+
+		if(commands->ProcessVariableIo(inputBuffers, outputBuffers, inputProcessed, outputProcessed))
+		{
+			if(pVarIo->sampleInputProcessedCount != NULL)
+			{
+				*pVarIo->sampleInputProcessedCount = inputProcessed;
+			}
+			if(pVarIo->sampleOutputProcessedCount != NULL)
+			{
+				*pVarIo->sampleOutputProcessedCount = outputProcessed;
+			}
+
+			return 1;
+		}
+	}
+	catch(System::Exception^ e)
+	{
+		_traceCtx->WriteError(e);
+
+		Utils::ShowError(e);
+	}
+
+	return 0;
 }
 
 // Calls the plugin command stub to assign the parameter.
@@ -517,6 +934,12 @@ void PluginCommandProxy::Process(double** inputs, double** outputs, int32_t samp
 void PluginCommandProxy::SetParameter(int32_t index, float value)
 {
 	_traceCtx->WriteSetParameter(index, value);
+	_pStatistics->parameterCount++;
+
+	if(!EnsurePluginLoaded())
+	{
+		return;
+	}
 
 	try
 	{
@@ -535,6 +958,12 @@ void PluginCommandProxy::SetParameter(int32_t index, float value)
 float PluginCommandProxy::GetParameter(int32_t index)
 {
 	_traceCtx->WriteGetParameterBegin(index);
+	_pStatistics->parameterCount++;
+
+	if(!EnsurePluginLoaded())
+	{
+		return 0.0f;
+	}
 
 	try
 	{
@@ -562,6 +991,8 @@ void PluginCommandProxy::ProcessAcc(float** inputs, float** outputs, int32_t sam
 
 	_traceCtx->WriteProcess(numInputs, numOutputs, sampleFrames, sampleFrames);
 
+	int64_t startTicks = LiveStatistics::GetTicks();
+
 	try
 	{
 		auto inputBuffers = TypeConverter::ToManagedAudioBufferArray(inputs, sampleFrames, numInputs, false);
@@ -575,18 +1006,27 @@ void PluginCommandProxy::ProcessAcc(float** inputs, float** outputs, int32_t sam
 
 		Utils::ShowError(e);
 	}
+
+	LiveStatistics::EndProcess(_pStatistics, startTicks, sampleFrames);
 }
 
 // Cleans up any delayed memory deletes.
 void PluginCommandProxy::Cleanup()
 {
-	if(_memTracker != nullptr)
+	if(_pChunkArena != NULL)
+	{
+		_pChunkArena->Reset();
+	}
+
+	if(_arrangementCache != nullptr)
 	{
-		_memTracker->ClearAll();
-		_memTracker = nullptr;
+		_arrangementCache->Clear();
+		_arrangementCache = nullptr;
 	}
 
 	_commandStub = nullptr;
+	_pluginInfoCache = nullptr;
+	_hostStub = nullptr;
 }
 
 }}}} // Jacobi::Vst::Plugin::Interop
\ No newline at end of file
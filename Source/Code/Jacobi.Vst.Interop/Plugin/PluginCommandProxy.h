@@ -1,12 +1,19 @@
 #pragma once
 
-#include "..\MemoryTracker.h"
+#include "..\MemoryArena.h"
+#include "..\SpeakerArrangementCache.h"
+#include "..\LiveStatistics.h"
+#include "ProcessBlockCoalescer.h"
+#include "ProcessEventQueue.h"
 
 namespace Jacobi {
 namespace Vst {
 namespace Plugin {
 namespace Interop {
 
+	ref class HostCommandStub;
+	ref class PluginInfoCache;
+
 	/// <summary>
 	/// The PluginCommandProxy dispatches calls to the Plugin.
 	/// </summary>
@@ -17,6 +24,11 @@ namespace Interop {
 		/// Constructs a new instance that calls the <paramref name="cmdStub"/>.
 		/// </summary>
 		PluginCommandProxy(Jacobi::Vst::Core::Plugin::IVstPluginCommandStub^ cmdStub);
+		/// <summary>
+		/// Constructs a new instance that answers the host from the <paramref name="pluginInfoCache"/>
+		/// and loads the managed plugin from <paramref name="pluginPath"/> when the host first needs it.
+		/// </summary>
+		PluginCommandProxy(PluginInfoCache^ pluginInfoCache, HostCommandStub^ hostStub, System::String^ pluginPath);
 		~PluginCommandProxy();
 		!PluginCommandProxy();
 
@@ -45,22 +57,68 @@ namespace Interop {
 		/// Calls the plugin for 32 bit accumulating audio processing (legacy).
 		/// </summary>
 		void ProcessAcc(float** inputs, float** outputs, int32_t sampleFrames, int32_t numInputs, int32_t numOutputs);
+		/// <summary>
+		/// Calls the plugin for 32 bit audio processing with a different number of input and output samples.
+		/// </summary>
+		/// <returns>Returns 1 when the plugin processed the audio, otherwise 0.</returns>
+		Vst2IntPtr ProcessVariableIo(Vst2VariableIo* pVarIo, int32_t numInputs, int32_t numOutputs);
+
+		/// <summary>
+		/// Collects the host blocks into blocks of <paramref name="blockSize"/> samples before calling the plugin.
+		/// </summary>
+		/// <remarks>Zero (default) calls the plugin for each host block. The caller reports the added latency to the host.</remarks>
+		void SetProcessBlockSize(int32_t blockSize);
 
 	private:
 		void Cleanup();
+		void Initialize(Jacobi::Vst::Core::Plugin::IVstPluginCommandStub^ cmdStub);
+
+		// deferred loading (scan fast path)
+		bool DispatchFromCache(Vst2PluginCommands command, void* ptr, Vst2IntPtr% result);
+		void LoadDeferredPlugin();
+		bool EnsurePluginLoaded();
+
+		PluginInfoCache^ _pluginInfoCache;
+		HostCommandStub^ _hostStub;
+		System::String^ _pluginPath;
+		bool _isOpenPending;
 
 		/// <summary>
 		/// Dispatches the opcode to one of the Plugin legacy methods.
 		/// </summary>
 		Vst2IntPtr DispatchLegacy(Vst2PluginCommands command, int32_t index, Vst2IntPtr value, void* ptr, float opt);
 
+		// block coalescing (ProcessBlockSize)
+		void ProcessCoalesced(float** inputs, float** outputs, int32_t sampleFrames, int32_t numInputs, int32_t numOutputs);
+		void ProcessCoalesced(double** inputs, double** outputs, int32_t sampleFrames, int32_t numInputs, int32_t numOutputs);
+		void ResetCoalescers();
+		void DeleteCoalescers();
+		void DispatchBlockEvents();
+
 		Jacobi::Vst::Core::Plugin::IVstPluginCommandStub^ _commandStub;
 		Jacobi::Vst::Core::Legacy::IVstPluginCommandsLegacy20^ _legacyCmdStub;
 
-		Jacobi::Vst::Interop::MemoryTracker^ _memTracker;
+		// the result of ChunkGet, valid until the next ChunkGet, suspend/resume or Close.
+		::MemoryArena* _pChunkArena;
+		Jacobi::Vst::Interop::SpeakerArrangementCache^ _arrangementCache;
 		Vst2Rectangle* _pEditorRect;
 
+		int32_t _processBlockSize;
+		int32_t _processBlockPosition;	// of the last process call, where the events of the next host block start
+		ProcessBlockCoalescer<float>* _pCoalescer32;
+		ProcessBlockCoalescer<double>* _pCoalescer64;
+		// the events for the coalesced blocks (of either coalescer)
+		ProcessEventQueue* _pEventQueue;
+		// managed wrappers around the coalescer blocks, reused for each call
+		array<Jacobi::Vst::Core::VstAudioBuffer^>^ _blockInputs32;
+		array<Jacobi::Vst::Core::VstAudioBuffer^>^ _blockOutputs32;
+		array<Jacobi::Vst::Core::VstAudioPrecisionBuffer^>^ _blockInputs64;
+		array<Jacobi::Vst::Core::VstAudioPrecisionBuffer^>^ _blockOutputs64;
+
 		Jacobi::Vst::Core::Diagnostics::TraceContext^ _traceCtx;
+
+		// the counters of this instance in the live statistics segment.
+		::LiveStatisticsSlot* _pStatistics;
 	};
 
 }}}} // Jacobi::Vst::Plugin::Interop
\ No newline at end of file
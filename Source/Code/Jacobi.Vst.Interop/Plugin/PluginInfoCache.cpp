@@ -0,0 +1,192 @@
+#include "pch.h"
+#include "PluginInfoCache.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Plugin {
+namespace Interop {
+
+// 'VNPI' and format version
+static const int32_t CacheFileMagic = 0x49504E56;
+static const int32_t CacheFileVersion = 1;
+
+PluginInfoCache^ PluginInfoCache::Load(System::String^ pluginPath)
+{
+	return Load(pluginPath, DefaultCacheFolder);
+}
+
+PluginInfoCache^ PluginInfoCache::Load(System::String^ pluginPath, System::String^ cacheFolder)
+{
+	try
+	{
+		auto filePath = GetCacheFilePath(pluginPath, cacheFolder);
+		if(!System::IO::File::Exists(filePath))
+		{
+			return nullptr;
+		}
+
+		auto stream = System::IO::File::OpenRead(filePath);
+		auto reader = gcnew System::IO::BinaryReader(stream);
+
+		try
+		{
+			if(reader->ReadInt32() != CacheFileMagic ||
+				reader->ReadInt32() != CacheFileVersion ||
+				reader->ReadInt64() != GetFilesStamp(pluginPath))
+			{
+				return nullptr;
+			}
+
+			auto pluginInfo = gcnew Jacobi::Vst::Core::Plugin::VstPluginInfo();
+			pluginInfo->Flags = safe_cast<Jacobi::Vst::Core::VstPluginFlags>(reader->ReadInt32());
+			pluginInfo->ProgramCount = reader->ReadInt32();
+			pluginInfo->ParameterCount = reader->ReadInt32();
+			pluginInfo->AudioInputCount = reader->ReadInt32();
+			pluginInfo->AudioOutputCount = reader->ReadInt32();
+			pluginInfo->InitialDelay = reader->ReadInt32();
+			pluginInfo->PluginID = reader->ReadInt32();
+			pluginInfo->PluginVersion = reader->ReadInt32();
+			pluginInfo->ProcessBlockSize = reader->ReadInt32();
+
+			auto cache = gcnew PluginInfoCache();
+			cache->PluginInfo = pluginInfo;
+			cache->EffectName = ReadString(reader);
+			cache->VendorString = ReadString(reader);
+			cache->ProductString = ReadString(reader);
+			cache->VendorVersion = reader->ReadInt32();
+			cache->Category = reader->ReadInt32();
+			cache->VstVersion = reader->ReadInt32();
+
+			return cache;
+		}
+		finally
+		{
+			delete reader;
+			delete stream;
+		}
+	}
+	catch(System::Exception^)
+	{
+		// corrupt or unreadable cache: load the plugin.
+		return nullptr;
+	}
+}
+
+void PluginInfoCache::Save(System::String^ pluginPath, Jacobi::Vst::Core::Plugin::VstPluginInfo^ pluginInfo,
+	Jacobi::Vst::Core::IVstPluginCommands24^ commands)
+{
+	Save(pluginPath, pluginInfo, commands, DefaultCacheFolder);
+}
+
+void PluginInfoCache::Save(System::String^ pluginPath, Jacobi::Vst::Core::Plugin::VstPluginInfo^ pluginInfo,
+	Jacobi::Vst::Core::IVstPluginCommands24^ commands, System::String^ cacheFolder)
+{
+	// the legacy members are not cached.
+	if(pluginInfo == nullptr || commands == nullptr ||
+		dynamic_cast<Jacobi::Vst::Core::Legacy::VstPluginLegacyInfo^>(pluginInfo) != nullptr)
+	{
+		return;
+	}
+
+	try
+	{
+		auto filePath = GetCacheFilePath(pluginPath, cacheFolder);
+		System::IO::Directory::CreateDirectory(cacheFolder);
+
+		// write to a temp file first, another instance may be reading.
+		auto tempPath = filePath + "." + System::Diagnostics::Process::GetCurrentProcess()->Id + ".tmp";
+		auto stream = System::IO::File::Create(tempPath);
+		auto writer = gcnew System::IO::BinaryWriter(stream);
+
+		try
+		{
+			writer->Write(CacheFileMagic);
+			writer->Write(CacheFileVersion);
+			writer->Write(GetFilesStamp(pluginPath));
+
+			writer->Write(safe_cast<System::Int32>(pluginInfo->Flags));
+			writer->Write(pluginInfo->ProgramCount);
+			writer->Write(pluginInfo->ParameterCount);
+			writer->Write(pluginInfo->AudioInputCount);
+			writer->Write(pluginInfo->AudioOutputCount);
+			writer->Write(pluginInfo->InitialDelay);
+			writer->Write(pluginInfo->PluginID);
+			writer->Write(pluginInfo->PluginVersion);
+			writer->Write(pluginInfo->ProcessBlockSize);
+
+			WriteString(writer, commands->GetEffectName());
+			WriteString(writer, commands->GetVendorString());
+			WriteString(writer, commands->GetProductString());
+			writer->Write(commands->GetVendorVersion());
+			writer->Write(safe_cast<System::Int32>(commands->GetCategory()));
+			writer->Write(commands->GetVstVersion());
+		}
+		finally
+		{
+			delete writer;
+			delete stream;
+		}
+
+		if(System::IO::File::Exists(filePath))
+		{
+			System::IO::File::Delete(filePath);
+		}
+		System::IO::File::Move(tempPath, filePath);
+	}
+	catch(System::Exception^)
+	{
+		// not cached, no harm done.
+	}
+}
+
+System::String^ PluginInfoCache::DefaultCacheFolder::get()
+{
+	return System::IO::Path::Combine(
+		System::Environment::GetFolderPath(System::Environment::SpecialFolder::LocalApplicationData), "VST.NET", "PluginInfo");
+}
+
+// <cache folder>\<name>.<path hash>.cache
+System::String^ PluginInfoCache::GetCacheFilePath(System::String^ pluginPath, System::String^ cacheFolder)
+{
+	// string::GetHashCode is randomized per process, use FNV-1a.
+	uint32_t hash = 2166136261u;
+	for each(System::Char c in pluginPath->ToUpperInvariant())
+	{
+		hash = (hash ^ c) * 16777619u;
+	}
+
+	return System::IO::Path::Combine(cacheFolder,
+		System::String::Format("{0}.{1:X8}.cache", System::IO::Path::GetFileNameWithoutExtension(pluginPath), hash));
+}
+
+// combines the size and write times of all files that belong to the plugin (<name>.*).
+System::Int64 PluginInfoCache::GetFilesStamp(System::String^ pluginPath)
+{
+	auto directory = gcnew System::IO::DirectoryInfo(System::IO::Path::GetDirectoryName(pluginPath));
+	auto pattern = System::IO::Path::GetFileNameWithoutExtension(pluginPath) + ".*";
+
+	System::Int64 stamp = 0;
+	for each(System::IO::FileInfo^ file in directory->GetFiles(pattern))
+	{
+		// order independent
+		stamp += file->LastWriteTimeUtc.Ticks ^ (file->Length << 20);
+	}
+
+	return stamp;
+}
+
+void PluginInfoCache::WriteString(System::IO::BinaryWriter^ writer, System::String^ value)
+{
+	writer->Write(value != nullptr);
+	if(value != nullptr)
+	{
+		writer->Write(value);
+	}
+}
+
+System::String^ PluginInfoCache::ReadString(System::IO::BinaryReader^ reader)
+{
+	return reader->ReadBoolean() ? reader->ReadString() : nullptr;
+}
+
+}}}} // Jacobi::Vst::Plugin::Interop
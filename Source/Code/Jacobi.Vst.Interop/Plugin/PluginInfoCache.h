@@ -0,0 +1,68 @@
+#pragma once
+
+namespace Jacobi {
+namespace Vst {
+namespace Plugin {
+namespace Interop {
+
+	/// <summary>
+	/// The PluginInfoCache class stores the plugin information a host queries while scanning.
+	/// </summary>
+	/// <remarks>The information is written after the managed plugin has been loaded for the first time
+	/// and is read back by later instances, so they can answer the host without loading the managed
+	/// plugin assembly and its configuration. The cache is invalidated when any of the plugin's files
+	/// (interop, managed assembly, configuration) is changed.</remarks>
+	ref class PluginInfoCache
+	{
+	public:
+		/// <summary>
+		/// Reads the cached information for the plugin.
+		/// </summary>
+		/// <param name="pluginPath">The full path to the interop (plugin) file.</param>
+		/// <returns>Returns null when there is no cache or it is out of date.</returns>
+		static PluginInfoCache^ Load(System::String^ pluginPath);
+		/// <summary>
+		/// Reads the cached information for the plugin from the <paramref name="cacheFolder"/>.
+		/// </summary>
+		/// <param name="pluginPath">The full path to the interop (plugin) file.</param>
+		/// <param name="cacheFolder">The folder with the cache files.</param>
+		/// <returns>Returns null when there is no cache or it is out of date.</returns>
+		static PluginInfoCache^ Load(System::String^ pluginPath, System::String^ cacheFolder);
+		/// <summary>
+		/// Writes the information of a loaded plugin to the cache.
+		/// </summary>
+		/// <param name="pluginPath">The full path to the interop (plugin) file.</param>
+		/// <param name="pluginInfo">The plugin info returned by the plugin.</param>
+		/// <param name="commands">The plugin commands to query the strings.</param>
+		/// <remarks>Failures are ignored, the plugin just loads the slow way next time.</remarks>
+		static void Save(System::String^ pluginPath, Jacobi::Vst::Core::Plugin::VstPluginInfo^ pluginInfo,
+			Jacobi::Vst::Core::IVstPluginCommands24^ commands);
+		/// <summary>
+		/// Writes the information of a loaded plugin to the cache in the <paramref name="cacheFolder"/>.
+		/// </summary>
+		/// <remarks>Failures are ignored, the plugin just loads the slow way next time.</remarks>
+		static void Save(System::String^ pluginPath, Jacobi::Vst::Core::Plugin::VstPluginInfo^ pluginInfo,
+			Jacobi::Vst::Core::IVstPluginCommands24^ commands, System::String^ cacheFolder);
+
+		/// <summary>
+		/// Gets the folder the cache files are written to: %LocalAppData%\VST.NET\PluginInfo.
+		/// </summary>
+		static property System::String^ DefaultCacheFolder { System::String^ get(); }
+
+		property Jacobi::Vst::Core::Plugin::VstPluginInfo^ PluginInfo;
+		property System::String^ EffectName;
+		property System::String^ VendorString;
+		property System::String^ ProductString;
+		property System::Int32 VendorVersion;
+		property System::Int32 Category;
+		property System::Int32 VstVersion;
+
+	private:
+		static System::String^ GetCacheFilePath(System::String^ pluginPath, System::String^ cacheFolder);
+		static System::Int64 GetFilesStamp(System::String^ pluginPath);
+
+		static void WriteString(System::IO::BinaryWriter^ writer, System::String^ value);
+		static System::String^ ReadString(System::IO::BinaryReader^ reader);
+	};
+
+}}}} // Jacobi::Vst::Plugin::Interop
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+
+// Collects the host's audio blocks into fixed size blocks for the plugin.
+// The input of the host block is copied into the input block and the output of the previous
+// plugin block is copied out, which delays the audio by exactly one block (blockSize samples).
+// The events for each block are kept by a ProcessEventQueue.
+// Only used on the audio thread, so no locking is needed.
+template<typename T>
+class ProcessBlockCoalescer
+{
+public:
+	ProcessBlockCoalescer(int32_t blockSize, int32_t inputCount, int32_t outputCount)
+		: _blockSize(blockSize), _inputCount(inputCount), _outputCount(outputCount), _position(0)
+	{
+		// one allocation for all channels: inputs followed by outputs
+		_pBuffer = new T[(size_t)(_inputCount + _outputCount) * _blockSize];
+		_ppInputs = new T*[_inputCount > 0 ? _inputCount : 1];
+		_ppOutputs = new T*[_outputCount > 0 ? _outputCount : 1];
+
+		for(int32_t n = 0; n < _inputCount; n++)
+		{
+			_ppInputs[n] = _pBuffer + (n * _blockSize);
+		}
+		for(int32_t n = 0; n < _outputCount; n++)
+		{
+			_ppOutputs[n] = _pBuffer + ((_inputCount + n) * _blockSize);
+		}
+
+		Reset();
+	}
+
+	~ProcessBlockCoalescer()
+	{
+		delete[] _ppOutputs;
+		delete[] _ppInputs;
+		delete[] _pBuffer;
+	}
+
+	T** GetInputs() { return _ppInputs; }
+	T** GetOutputs() { return _ppOutputs; }
+	int32_t GetBlockSize() { return _blockSize; }
+	// the number of samples collected for the current block
+	int32_t GetPosition() { return _position; }
+	bool IsBlockFull() { return _position == _blockSize; }
+
+	bool Matches(int32_t inputCount, int32_t outputCount)
+	{
+		return _inputCount == inputCount && _outputCount == outputCount;
+	}
+
+	// copies host input into the block and block output to the host, up to the end of the block.
+	// returns the number of samples exchanged.
+	int32_t Exchange(T** ppInputs, T** ppOutputs, int32_t offset, int32_t sampleCount)
+	{
+		int32_t count = (std::min)(sampleCount, _blockSize - _position);
+
+		// read all inputs first: the host may pass the same buffers for input and output.
+		for(int32_t n = 0; n < _inputCount; n++)
+		{
+			memcpy(_ppInputs[n] + _position, ppInputs[n] + offset, count * sizeof(T));
+		}
+		for(int32_t n = 0; n < _outputCount; n++)
+		{
+			memcpy(ppOutputs[n] + offset, _ppOutputs[n] + _position, count * sizeof(T));
+		}
+
+		_position += count;
+		return count;
+	}
+
+	// starts collecting the next block, after the plugin has processed the full block.
+	void NextBlock()
+	{
+		_position = 0;
+	}
+
+	// clears all audio, the first block outputs silence.
+	void Reset()
+	{
+		memset(_pBuffer, 0, (size_t)(_inputCount + _outputCount) * _blockSize * sizeof(T));
+		_position = 0;
+	}
+
+private:
+	int32_t _blockSize;
+	int32_t _inputCount;
+	int32_t _outputCount;
+	int32_t _position;
+
+	T* _pBuffer;
+	T** _ppInputs;
+	T** _ppOutputs;
+
+	// not copyable
+	ProcessBlockCoalescer(const ProcessBlockCoalescer&);
+	ProcessBlockCoalescer& operator=(const ProcessBlockCoalescer&);
+};
@@ -0,0 +1,171 @@
+// compiled without /clr and without the precompiled header (runs on the audio thread, also built by the native tests).
+#include "ProcessEventQueue.h"
+
+#include <string.h>
+
+ProcessEventQueue::ProcessEventQueue(int32_t capacity, int32_t sysExCapacity)
+	: _capacity(capacity > 0 ? capacity : 1), _sysExCapacity(sysExCapacity > 0 ? sysExCapacity : 0),
+	_count(0), _takenCount(0), _takenBlockSize(0), _droppedCount(0), _dumpsUsed(0)
+{
+	_pEntries = new Entry[_capacity];
+	_pDumps = new char[_sysExCapacity > 0 ? _sysExCapacity : 1];
+	_pSpareDumps = new char[_sysExCapacity > 0 ? _sysExCapacity : 1];
+
+	// Vst2Events declares 2 event pointers.
+	_pTaken = (::Vst2Events*)new char[sizeof(::Vst2Events) + _capacity * sizeof(::Vst2Event*)];
+	memset(_pTaken, 0, sizeof(::Vst2Events));
+}
+
+ProcessEventQueue::~ProcessEventQueue()
+{
+	delete[] (char*)_pTaken;
+	delete[] _pSpareDumps;
+	delete[] _pDumps;
+	delete[] _pEntries;
+}
+
+void ProcessEventQueue::Add(const ::Vst2Events* pEvents, int32_t blockPosition)
+{
+	Release();
+
+	if(pEvents == NULL)
+	{
+		return;
+	}
+
+	for(int32_t n = 0; n < pEvents->eventCount; n++)
+	{
+		const ::Vst2Event* pEvent = pEvents->events[n];
+		if(pEvent == NULL)
+		{
+			continue;
+		}
+
+		Insert(pEvent, blockPosition + (pEvent->deltaFrames > 0 ? pEvent->deltaFrames : 0));
+	}
+}
+
+void ProcessEventQueue::Insert(const ::Vst2Event* pEvent, int32_t position)
+{
+	const ::Vst2MidiSysExEvent* pSysEx = pEvent->kind == ::Vst2EventKind::SystemExclusive ?
+		(const ::Vst2MidiSysExEvent*)pEvent : NULL;
+	int32_t dumpSize = pSysEx != NULL && pSysEx->dump != NULL && pSysEx->dumpInBytes > 0 ? pSysEx->dumpInBytes : 0;
+
+	if(_count == _capacity || dumpSize > _sysExCapacity - _dumpsUsed)
+	{
+		_droppedCount++;
+		return;
+	}
+
+	// after all entries at the same position: keeps the order of the host.
+	int32_t index = _count;
+	while(index > 0 && _pEntries[index - 1].position > position)
+	{
+		index--;
+	}
+	memmove(_pEntries + index + 1, _pEntries + index, (_count - index) * sizeof(Entry));
+	_count++;
+
+	Entry& entry = _pEntries[index];
+	entry.position = position;
+	entry.dumpOffset = 0;
+
+	if(pSysEx != NULL)
+	{
+		entry.data.sysExEvent = *pSysEx;
+		entry.data.sysExEvent.dumpInBytes = dumpSize;
+		entry.data.sysExEvent.dump = NULL;
+		entry.dumpOffset = _dumpsUsed;
+
+		memcpy(_pDumps + _dumpsUsed, pSysEx->dump, dumpSize);
+		_dumpsUsed += dumpSize;
+	}
+	else
+	{
+		// midi and legacy events fit in Vst2Event; the data of a legacy event is at most its 16 bytes.
+		entry.data.event = *pEvent;
+
+		const int32_t maxSize = sizeof(::Vst2Event) - 2 * sizeof(int32_t);
+		if(pEvent->kind != ::Vst2EventKind::Midi && entry.data.event.sizeInBytes > maxSize)
+		{
+			entry.data.event.sizeInBytes = maxSize;
+		}
+	}
+}
+
+const ::Vst2Events* ProcessEventQueue::TakeBlock(int32_t blockSize)
+{
+	Release();
+
+	int32_t takenCount = 0;
+	while(takenCount < _count && _pEntries[takenCount].position < blockSize)
+	{
+		Entry& entry = _pEntries[takenCount];
+		entry.data.event.deltaFrames = entry.position;
+
+		if(entry.data.event.kind == ::Vst2EventKind::SystemExclusive)
+		{
+			entry.data.sysExEvent.dump = _pDumps + entry.dumpOffset;
+		}
+
+		_pTaken->events[takenCount] = &entry.data.event;
+		takenCount++;
+	}
+
+	_pTaken->eventCount = takenCount;
+	_takenCount = takenCount;
+	_takenBlockSize = blockSize;
+
+	return _pTaken;
+}
+
+void ProcessEventQueue::Clear()
+{
+	_count = 0;
+	_takenCount = 0;
+	_takenBlockSize = 0;
+	_dumpsUsed = 0;
+	_pTaken->eventCount = 0;
+}
+
+// removes the entries of the last block that was taken; the rest moves on to the next block.
+void ProcessEventQueue::Release()
+{
+	if(_takenBlockSize == 0)
+	{
+		return;
+	}
+
+	int32_t remaining = _count - _takenCount;
+	memmove(_pEntries, _pEntries + _takenCount, remaining * sizeof(Entry));
+	_count = remaining;
+	_takenCount = 0;
+
+	for(int32_t n = 0; n < _count; n++)
+	{
+		_pEntries[n].position -= _takenBlockSize;
+	}
+	_takenBlockSize = 0;
+
+	if(_dumpsUsed > 0)
+	{
+		int32_t used = 0;
+		for(int32_t n = 0; n < _count; n++)
+		{
+			Entry& entry = _pEntries[n];
+			if(entry.data.event.kind == ::Vst2EventKind::SystemExclusive)
+			{
+				memcpy(_pSpareDumps + used, _pDumps + entry.dumpOffset, entry.data.sysExEvent.dumpInBytes);
+				entry.dumpOffset = used;
+				used += entry.data.sysExEvent.dumpInBytes;
+			}
+		}
+
+		char* pDumps = _pDumps;
+		_pDumps = _pSpareDumps;
+		_pSpareDumps = pDumps;
+		_dumpsUsed = used;
+	}
+
+	_pTaken->eventCount = 0;
+}
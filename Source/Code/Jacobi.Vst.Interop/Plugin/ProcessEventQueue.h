@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../Vst2400.h"
+
+// Holds the events the host passes with ProcessEvents for a plugin that processes coalesced blocks
+// (see ProcessBlockCoalescer), until the block they fall in is processed.
+// An event of the next host block at deltaFrames lands at blockPosition + deltaFrames of the coalesced block
+// that is being collected, which can be one of the later blocks. TakeBlock returns the events of one full block
+// as a single list ordered by deltaFrames (events of several ProcessEvents calls are merged, events at the
+// same position keep the host's order) and moves the rest on to the next block.
+// Events and sysex dumps are copied into preallocated storage; events that do not fit are dropped.
+// Only used on the audio thread, so no locking is needed.
+class ProcessEventQueue
+{
+public:
+	static const int32_t DefaultCapacity = 1024;
+	static const int32_t DefaultSysExCapacity = 64 * 1024;
+
+	ProcessEventQueue(int32_t capacity = DefaultCapacity, int32_t sysExCapacity = DefaultSysExCapacity);
+	~ProcessEventQueue();
+
+	// Queues the events of the next host block, which starts at blockPosition in the block being collected.
+	void Add(const ::Vst2Events* pEvents, int32_t blockPosition);
+
+	// Returns the events of the block of blockSize samples that is about to be processed, with deltaFrames
+	// relative to the start of that block, and moves the remaining events on to the next block.
+	// Call once for every block, also when there are no events. The list stays valid until the next call
+	// to Add, TakeBlock or Clear.
+	const ::Vst2Events* TakeBlock(int32_t blockSize);
+
+	// Drops all queued events.
+	void Clear();
+
+	// The number of queued events (not counting the last block that was taken).
+	int32_t GetCount() const { return _count - _takenCount; }
+	// The number of events that were dropped because the queue was full.
+	int64_t GetDroppedCount() const { return _droppedCount; }
+
+private:
+	union EventData
+	{
+		::Vst2Event event;
+		::Vst2MidiEvent midiEvent;
+		::Vst2MidiSysExEvent sysExEvent;
+	};
+
+	struct Entry
+	{
+		int32_t position;	// in the block being collected (may be beyond it)
+		int32_t dumpOffset;	// sysex only
+		EventData data;
+	};
+
+	int32_t _capacity;
+	int32_t _sysExCapacity;
+	Entry* _pEntries;	// ordered by position
+	int32_t _count;
+	int32_t _takenCount;	// entries at the front that were returned by TakeBlock
+	int32_t _takenBlockSize;
+	int64_t _droppedCount;
+
+	// sysex dumps; copied to the spare buffer when taken entries are released.
+	char* _pDumps;
+	char* _pSpareDumps;
+	int32_t _dumpsUsed;
+
+	::Vst2Events* _pTaken;
+
+	void Insert(const ::Vst2Event* pEvent, int32_t position);
+	void Release();
+
+	ProcessEventQueue(const ProcessEventQueue&) = delete;
+	ProcessEventQueue& operator=(const ProcessEventQueue&) = delete;
+};
@@ -0,0 +1,8 @@
+#include "pch.h"
+
+using namespace System::Reflection;
+using namespace System::Runtime::CompilerServices;
+using namespace System::Runtime::InteropServices;
+
+[assembly:AssemblyTitleAttribute("Jacobi.Vst.Benchmark.Interop")] ;
+[assembly:AssemblyDescriptionAttribute("VST.NET2 Interop marshaling benchmarks")] ;
@@ -128,6 +128,142 @@ namespace Properties {
 			}
 		}
 
+		static property System::String^ VstPresetFileReader_MapFailed
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstPresetFileReader_MapFailed", Culture);
+			}
+		}
+
+		static property System::String^ VstPresetFileReader_InvalidFormat
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstPresetFileReader_InvalidFormat", Culture);
+			}
+		}
+
+		static property System::String^ VstPresetFileReader_NoProgramData
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstPresetFileReader_NoProgramData", Culture);
+			}
+		}
+
+		static property System::String^ VstPresetFileReader_NoChunkData
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstPresetFileReader_NoChunkData", Culture);
+			}
+		}
+
+		static property System::String^ VstPresetFileReader_ParameterArrayTooSmall
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstPresetFileReader_ParameterArrayTooSmall", Culture);
+			}
+		}
+
+		static property System::String^ VstPresetFileWriter_NoBankProgramExpected
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstPresetFileWriter_NoBankProgramExpected", Culture);
+			}
+		}
+
+		static property System::String^ VstPresetFileWriter_ParameterCountMismatch
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstPresetFileWriter_ParameterCountMismatch", Culture);
+			}
+		}
+
+		static property System::String^ VstPresetFileWriter_BankIncomplete
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstPresetFileWriter_BankIncomplete", Culture);
+			}
+		}
+
+		static property System::String^ VstPresetFileWriter_NoBankStarted
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstPresetFileWriter_NoBankStarted", Culture);
+			}
+		}
+
+		static property System::String^ VstChunkCompressor_InvalidData
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstChunkCompressor_InvalidData", Culture);
+			}
+		}
+
+		static property System::String^ VstEngineThread_SettingFailed
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstEngineThread_SettingFailed", Culture);
+			}
+		}
+
+		static property System::String^ VstEngineThread_WrongThread
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstEngineThread_WrongThread", Culture);
+			}
+		}
+
+		static property System::String^ VstVariableIoProcessor_NotSupported
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstVariableIoProcessor_NotSupported", Culture);
+			}
+		}
+
+		static property System::String^ VstCallRecorder_OpenFailed
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstCallRecorder_OpenFailed", Culture);
+			}
+		}
+
+		static property System::String^ VstCallReplayer_InvalidFormat
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstCallReplayer_InvalidFormat", Culture);
+			}
+		}
+
+		static property System::String^ VstCallReplayer_NotSupported
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstCallReplayer_NotSupported", Culture);
+			}
+		}
+
+		static property System::String^ VstTimelineCapture_ExportFailed
+		{
+			System::String^ get()
+			{
+				return ResourceManager->GetString("VstTimelineCapture_ExportFailed", Culture);
+			}
+		}
+
 		//---------------------------------------------------------------------
 
 		static property System::Resources::ResourceManager^ ResourceManager
@@ -0,0 +1,64 @@
+#include "pch.h"
+#include "SpeakerArrangementCache.h"
+#include "TypeConverter.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Interop {
+
+// default ctor.
+SpeakerArrangementCache::SpeakerArrangementCache(void)
+{
+	_pSlots = new SpeakerArrangementSlots();
+}
+
+SpeakerArrangementCache::~SpeakerArrangementCache()
+{
+	this->!SpeakerArrangementCache();
+}
+
+SpeakerArrangementCache::!SpeakerArrangementCache()
+{
+	delete _pSlots;
+	_pSlots = NULL;
+}
+
+// fills the cached unmanaged arrangement for the type and direction, grows it when needed.
+::Vst2SpeakerArrangement* SpeakerArrangementCache::ToUnmanaged(Jacobi::Vst::Core::VstSpeakerArrangement^ arrangement, bool isInput)
+{
+	if(arrangement == nullptr)
+	{
+		return NULL;
+	}
+
+	int channelCount = arrangement->Speakers != nullptr ? arrangement->Speakers->Length : 0;
+
+	auto pArrangement = _pSlots->Get(safe_cast<int32_t>(arrangement->Type), isInput, channelCount);
+	if(pArrangement == NULL)
+	{
+		throw gcnew System::OutOfMemoryException();
+	}
+
+	if(arrangement->Speakers != nullptr)
+	{
+		TypeConverter::ToUnmanagedSpeakerArrangement(pArrangement, arrangement);
+	}
+	else
+	{
+		pArrangement->kind = safe_cast<::Vst2SpeakerArrangementKind>(arrangement->Type);
+		pArrangement->channelCount = 0;
+	}
+
+	return pArrangement;
+}
+
+// deletes all cached arrangements.
+void SpeakerArrangementCache::Clear()
+{
+	if(_pSlots != NULL)
+	{
+		_pSlots->Clear();
+	}
+}
+
+}}} // Jacobi::Vst::Interop
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "SpeakerArrangementSlots.h"
+
+namespace Jacobi {
+namespace Vst {
+namespace Interop {
+
+/// <summary>
+/// The SpeakerArrangementCache class maintains reusable unmanaged speaker arrangements of any channel count.
+/// </summary>
+/// <remarks>One unmanaged arrangement is kept per arrangement type and direction (input/output).
+/// It is only reallocated when a larger channel count is requested, so repeated calls
+/// do not allocate. Is a managed wrapper around the native SpeakerArrangementSlots
+/// because it is used as a member of a managed class.</remarks>
+private ref class SpeakerArrangementCache
+{
+public:
+	/// <summary>
+	/// Constructs a new instance.
+	/// </summary>
+	SpeakerArrangementCache(void);
+	/// <summary>
+	/// Deletes all unmanaged arrangements.
+	/// </summary>
+	~SpeakerArrangementCache();
+	/// <summary>
+	/// Deletes all unmanaged arrangements.
+	/// </summary>
+	!SpeakerArrangementCache();
+
+	/// <summary>
+	/// Returns an unmanaged copy of the <paramref name="arrangement"/>.
+	/// </summary>
+	/// <returns>Returns NULL when <paramref name="arrangement"/> is null. The pointer is owned by the cache and
+	/// stays valid until the next call for the same type and direction.</returns>
+	::Vst2SpeakerArrangement* ToUnmanaged(Jacobi::Vst::Core::VstSpeakerArrangement^ arrangement, bool isInput);
+	/// <summary>
+	/// Deletes all unmanaged arrangements.
+	/// </summary>
+	void Clear();
+
+private:
+	SpeakerArrangementSlots* _pSlots;
+};
+
+}}} // Jacobi::Vst::Interop
@@ -0,0 +1,96 @@
+// compiled without /clr and without the precompiled header (also built by the native tests).
+#include "SpeakerArrangementSlots.h"
+
+#include <new>
+#include <string.h>
+
+namespace
+{
+	::Vst2SpeakerArrangement* Allocate(int32_t capacity)
+	{
+		size_t size = SpeakerArrangementSlots::GetSize(capacity);
+		auto pArrangement = (::Vst2SpeakerArrangement*)new(std::nothrow) char[size];
+		if(pArrangement != NULL)
+		{
+			memset(pArrangement, 0, size);
+		}
+
+		return pArrangement;
+	}
+
+	void Delete(::Vst2SpeakerArrangement* pArrangement)
+	{
+		delete[] (char*)pArrangement;
+	}
+}
+
+SpeakerArrangementSlots::SpeakerArrangementSlots()
+	: _allocationCount(0)
+{
+}
+
+SpeakerArrangementSlots::~SpeakerArrangementSlots()
+{
+	Clear();
+}
+
+::Vst2SpeakerArrangement* SpeakerArrangementSlots::Get(int32_t kind, bool isInput, int32_t channelCount)
+{
+	if(channelCount < 0)
+	{
+		channelCount = 0;
+	}
+
+	Slot* pSlot = NULL;
+	for(Slot& slot : _slots)
+	{
+		if(slot.kind == kind && slot.isInput == isInput)
+		{
+			pSlot = &slot;
+			break;
+		}
+	}
+
+	if(pSlot != NULL && pSlot->capacity >= channelCount)
+	{
+		return pSlot->pArrangement;
+	}
+
+	::Vst2SpeakerArrangement* pArrangement = Allocate(channelCount);
+	if(pArrangement == NULL)
+	{
+		return NULL;
+	}
+	_allocationCount++;
+
+	if(pSlot != NULL)
+	{
+		Delete(pSlot->pArrangement);
+		pSlot->capacity = channelCount;
+		pSlot->pArrangement = pArrangement;
+	}
+	else
+	{
+		_slots.push_back(Slot{ kind, isInput, channelCount, pArrangement });
+	}
+
+	return pArrangement;
+}
+
+void SpeakerArrangementSlots::Clear()
+{
+	for(Slot& slot : _slots)
+	{
+		Delete(slot.pArrangement);
+	}
+
+	_slots.clear();
+}
+
+size_t SpeakerArrangementSlots::GetSize(int32_t channelCount)
+{
+	const int32_t declaredCount = sizeof(::Vst2SpeakerArrangement::speakers) / sizeof(::Vst2SpeakerProperties);
+
+	return sizeof(::Vst2SpeakerArrangement) +
+		(channelCount > declaredCount ? (channelCount - declaredCount) * sizeof(::Vst2SpeakerProperties) : 0);
+}
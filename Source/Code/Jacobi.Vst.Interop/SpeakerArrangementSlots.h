@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Vst2400.h"
+
+#include <stddef.h>
+#include <vector>
+
+// Keeps one unmanaged speaker arrangement per arrangement kind and direction (input/output) for SpeakerArrangementCache.
+// An arrangement is only reallocated when a larger channel count is requested than it has room for,
+// so repeated requests for the same kind and direction do not allocate.
+class SpeakerArrangementSlots
+{
+public:
+	SpeakerArrangementSlots();
+	~SpeakerArrangementSlots();
+
+	// Returns the arrangement for kind and direction with room for at least channelCount speakers.
+	// The arrangement is owned by the slots and stays valid until the next call for the same kind and direction
+	// (or Clear). Returns NULL when out of memory.
+	::Vst2SpeakerArrangement* Get(int32_t kind, bool isInput, int32_t channelCount);
+
+	// Deletes all arrangements.
+	void Clear();
+
+	// The number of arrangements that are kept.
+	size_t GetCount() const { return _slots.size(); }
+	// The number of arrangements that were allocated since construction.
+	int64_t GetAllocationCount() const { return _allocationCount; }
+
+	// The number of bytes an unmanaged speaker arrangement with channelCount speakers occupies.
+	// The ::Vst2SpeakerArrangement struct declares 8 speakers, larger arrangements extend past the struct.
+	static size_t GetSize(int32_t channelCount);
+
+private:
+	struct Slot
+	{
+		int32_t kind;
+		bool isInput;
+		int32_t capacity;
+		::Vst2SpeakerArrangement* pArrangement;
+	};
+
+	// a handful of kinds are in use, a linear search is fine.
+	std::vector<Slot> _slots;
+	int64_t _allocationCount;
+
+	SpeakerArrangementSlots(const SpeakerArrangementSlots&) = delete;
+	SpeakerArrangementSlots& operator=(const SpeakerArrangementSlots&) = delete;
+};
@@ -0,0 +1,402 @@
+// compiled without /clr and without the precompiled header (uses <atomic>, <mutex> and <chrono>).
+#include "TimelineTrace.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+volatile bool TimelineTrace::_isRecording = false;
+
+namespace
+{
+	struct TimelineEvent
+	{
+		int64_t ticks;
+		const void* pInstance;
+		int64_t value;
+		uint32_t threadId;
+		int32_t opcode;
+		TimelineSpan span;
+		// 'B' or 'E', written last: 0 while the event is being written.
+		std::atomic<char> phase;
+	};
+
+	struct TimelineCapture
+	{
+		std::unique_ptr<TimelineEvent[]> pEvents;
+		int64_t capacity;
+		int64_t startTicks;
+		std::atomic<int64_t> next;
+		std::atomic<int64_t> dropped;
+	};
+
+	std::mutex s_lock;
+	std::atomic<TimelineCapture*> s_pCapture(nullptr);
+	std::unique_ptr<TimelineCapture> s_current;
+	// a thread that began writing just before a new capture started may still write to the previous one.
+	std::unique_ptr<TimelineCapture> s_previous;
+	std::map<const void*, std::string> s_instanceNames;
+
+	const char* const PluginCommandNames[] =
+	{
+		"Open", "Close", "ProgramSet", "ProgramGet", "ProgramSetName", "ProgramGetName",
+		"ParameterGetLabel", "ParameterGetDisplay", "ParameterGetName", "VuGet", "SampleRateSet", "BlockSizeSet",
+		"OnOff", "EditorGetRectangle", "EditorOpen", "EditorClose", "EditorDraw", "EditorMouse",
+		"EditorKey", "EditorIdle", "EditorTop", "EditorSleep", "Identify", "ChunkGet",
+		"ChunkSet", "ProcessEvents", "ParameterCanBeAutomated", "ParameterFromString", "ProgramGetCategoriesCount", "ProgramGetNameByIndex",
+		"ProgramCopy", "ConnectInput", "ConnectOutput", "GetInputProperties", "GetOutputProperties", "PluginGetCategory",
+		"GetCurrentPosition", "GetDestinationBuffer", "OfflineNotify", "OfflinePrepare", "OfflineRun", "ProcessVariableIo",
+		"SetSpeakerArrangement", "SetBlockSizeAndSampleRate", "SetBypass", "PluginGetName", "GetErrorText", "VendorGetString",
+		"ProductGetString", "VendorGetVersion", "VendorSpecific", "CanDo", "GetTailSizeInSamples", "Idle",
+		"GetIcon", "SetViewPosition", "ParameterGetProperties", "KeysRequired", "GetVstVersion", "EditorKeyDown",
+		"EditorKeyUp", "SetKnobMode", "MidiProgramGetName", "MidiProgramGetCurrent", "MidiProgramGetCategory", "MidiProgramsChanged",
+		"MidiKeyGetName", "BeginSetProgram", "EndSetProgram", "GetSpeakerArrangement", "GetNextPlugin", "ProcessStart",
+		"ProcessStop", "SetTotalFramesToProcess", "SetPanLaw", "BeginLoadBank", "BeginLoadProgram", "SetProcessPrecision",
+		"MidiGetInputChannelCount", "MidiGetOutputChannelCount",
+	};
+
+	const char* const HostCommandNames[] =
+	{
+		"Automate", "Version", "CurrentId", "Idle", "PinConnected", "Reserved1",
+		"WantMidi", "GetTime", "ProcessEvents", "SetTime", "TempoAt", "GetAutomatableParameterCount",
+		"GetParameterQuantization", "IoChanged", "NeedIdle", "SizeWindow", "GetSampleRate", "GetBlockSize",
+		"GetInputLatency", "GetOutputLatency", "PluginGetPrevious", "PluginGetNext", "WillReplace", "GetCurrentProcessLevel",
+		"GetAutomationState", "OfflineStart", "OfflineRead", "OfflineWrite", "OfflineGetCurrentPass", "OfflineGetCurrentMetaPass",
+		"SetOutputSampleRate", "GetOutputSpeakerArrangement", "VendorGetString", "ProductGetString", "VendorGetVersion", "VendorSpecific",
+		"SetIcon", "CanDo", "GetLanguage", "WindowOpen", "WindowClose", "GetDirectory",
+		"UpdateDisplay", "EditBegin", "EditEnd", "FileSelectorOpen", "FileSelectorClose", "EditFile",
+		"GetChunkFile", "GetInputSpeakerArrangement",
+	};
+
+	static_assert(sizeof(PluginCommandNames) / sizeof(PluginCommandNames[0]) == (int)Vst2PluginCommands::MidiGetOutputChannelCount + 1,
+		"PluginCommandNames does not match Vst2PluginCommands.");
+	static_assert(sizeof(HostCommandNames) / sizeof(HostCommandNames[0]) == (int)Vst2HostCommands::GetInputSpeakerArrangement + 1,
+		"HostCommandNames does not match Vst2HostCommands.");
+
+	int64_t GetTicks()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+#ifdef _WIN32
+	uint32_t GetThreadId()
+	{
+		return ::GetCurrentThreadId();
+	}
+
+	uint32_t GetOwnProcessId()
+	{
+		return ::GetCurrentProcessId();
+	}
+#else
+	uint32_t GetThreadId()
+	{
+		thread_local uint32_t threadId = (uint32_t)::syscall(SYS_gettid);
+		return threadId;
+	}
+
+	uint32_t GetOwnProcessId()
+	{
+		return (uint32_t)::getpid();
+	}
+#endif
+
+	const char* GetOpcodeName(const char* const* ppNames, int32_t count, int32_t opcode, char* pBuffer, size_t length)
+	{
+		if(opcode >= 0 && opcode < count)
+		{
+			return ppNames[opcode];
+		}
+
+		snprintf(pBuffer, length, "Opcode%d", opcode);
+		return pBuffer;
+	}
+
+	// writes the name and category of a begin event.
+	void WriteName(FILE* pFile, const TimelineEvent& event)
+	{
+		char buffer[32];
+
+		switch(event.span)
+		{
+		case TimelineSpan::Dispatch:
+			fprintf(pFile, "\"name\":\"Dispatch %s\",\"cat\":\"dispatch\"",
+				GetOpcodeName(PluginCommandNames, sizeof(PluginCommandNames) / sizeof(PluginCommandNames[0]), event.opcode, buffer, sizeof(buffer)));
+			break;
+		case TimelineSpan::HostCallback:
+			fprintf(pFile, "\"name\":\"Callback %s\",\"cat\":\"callback\"",
+				GetOpcodeName(HostCommandNames, sizeof(HostCommandNames) / sizeof(HostCommandNames[0]), event.opcode, buffer, sizeof(buffer)));
+			break;
+		case TimelineSpan::Process32:
+			fputs("\"name\":\"Process32\",\"cat\":\"process\"", pFile);
+			break;
+		case TimelineSpan::Process64:
+			fputs("\"name\":\"Process64\",\"cat\":\"process\"", pFile);
+			break;
+		case TimelineSpan::ProcessAccumulating:
+			fputs("\"name\":\"ProcessAccumulating\",\"cat\":\"process\"", pFile);
+			break;
+		case TimelineSpan::ProcessVariableIo:
+			fputs("\"name\":\"ProcessVariableIo\",\"cat\":\"process\"", pFile);
+			break;
+		case TimelineSpan::SetParameter:
+			fputs("\"name\":\"SetParameter\",\"cat\":\"parameter\"", pFile);
+			break;
+		case TimelineSpan::GetParameter:
+			fputs("\"name\":\"GetParameter\",\"cat\":\"parameter\"", pFile);
+			break;
+		default:
+			fputs("\"name\":\"Unknown\",\"cat\":\"unknown\"", pFile);
+			break;
+		}
+	}
+
+	void WriteString(FILE* pFile, const char* pText)
+	{
+		fputc('"', pFile);
+		for(const char* p = pText; *p != 0; p++)
+		{
+			if(*p == '"' || *p == '\\')
+			{
+				fputc('\\', pFile);
+				fputc(*p, pFile);
+			}
+			else if((unsigned char)*p < 0x20)
+			{
+				fprintf(pFile, "\\u%04x", (unsigned char)*p);
+			}
+			else
+			{
+				fputc(*p, pFile);
+			}
+		}
+		fputc('"', pFile);
+	}
+
+	void WriteInstance(FILE* pFile, const void* pInstance)
+	{
+		auto found = s_instanceNames.find(pInstance);
+		if(found != s_instanceNames.end())
+		{
+			WriteString(pFile, found->second.c_str());
+		}
+		else
+		{
+			fprintf(pFile, "\"%p\"", pInstance);
+		}
+	}
+
+	// an end event that is truncated closes the begin event in event (recording stopped before the call returned).
+	void WriteEvent(FILE* pFile, const TimelineCapture& capture, const TimelineEvent& event, char phase, int64_t ticks, bool truncated, bool first)
+	{
+		fprintf(pFile, "%s{\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%u,\"tid\":%u,",
+			first ? "" : ",\n", phase, (ticks - capture.startTicks) / 1000.0, GetOwnProcessId(), event.threadId);
+
+		if(phase == 'B')
+		{
+			WriteName(pFile, event);
+			fputs(",\"args\":{\"instance\":", pFile);
+			WriteInstance(pFile, event.pInstance);
+
+			bool isProcess = event.span == TimelineSpan::Process32 || event.span == TimelineSpan::Process64 ||
+				event.span == TimelineSpan::ProcessAccumulating || event.span == TimelineSpan::ProcessVariableIo;
+			fprintf(pFile, ",\"%s\":%lld}}", isProcess ? "frames" : "index", (long long)event.value);
+		}
+		else if(truncated)
+		{
+			fputs("\"args\":{\"truncated\":true}}", pFile);
+		}
+		else if(event.span == TimelineSpan::Dispatch || event.span == TimelineSpan::HostCallback)
+		{
+			fprintf(pFile, "\"args\":{\"result\":%lld}}", (long long)event.value);
+		}
+		else
+		{
+			fputs("\"args\":{}}", pFile);
+		}
+	}
+}
+
+bool TimelineTrace::Start(int32_t capacity)
+{
+	if(capacity <= 0)
+	{
+		return false;
+	}
+
+	std::unique_ptr<TimelineCapture> pCapture(new(std::nothrow) TimelineCapture());
+	if(pCapture == NULL)
+	{
+		return false;
+	}
+
+	// value-initialized: all phases are 0.
+	pCapture->pEvents.reset(new(std::nothrow) TimelineEvent[capacity]());
+	if(pCapture->pEvents == NULL)
+	{
+		return false;
+	}
+
+	pCapture->capacity = capacity;
+	pCapture->next = 0;
+	pCapture->dropped = 0;
+
+	std::lock_guard<std::mutex> lock(s_lock);
+
+	_isRecording = false;
+
+	pCapture->startTicks = GetTicks();
+	s_previous = std::move(s_current);
+	s_current = std::move(pCapture);
+	s_pCapture.store(s_current.get(), std::memory_order_release);
+
+	_isRecording = true;
+	return true;
+}
+
+void TimelineTrace::Stop()
+{
+	_isRecording = false;
+}
+
+void TimelineTrace::SetInstanceName(const void* pInstance, const char* pName)
+{
+	std::lock_guard<std::mutex> lock(s_lock);
+
+	s_instanceNames[pInstance] = pName != NULL ? pName : "";
+}
+
+int64_t TimelineTrace::GetEventCount()
+{
+	TimelineCapture* pCapture = s_pCapture.load(std::memory_order_acquire);
+	if(pCapture == NULL)
+	{
+		return 0;
+	}
+
+	int64_t next = pCapture->next.load(std::memory_order_relaxed);
+	return next < pCapture->capacity ? next : pCapture->capacity;
+}
+
+int64_t TimelineTrace::GetDroppedCount()
+{
+	TimelineCapture* pCapture = s_pCapture.load(std::memory_order_acquire);
+	return pCapture != NULL ? pCapture->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+void TimelineTrace::Write(char phase, TimelineSpan span, const void* pInstance, int32_t opcode, int64_t value)
+{
+	TimelineCapture* pCapture = s_pCapture.load(std::memory_order_acquire);
+	if(pCapture == NULL)
+	{
+		return;
+	}
+
+	int64_t index = pCapture->next.fetch_add(1, std::memory_order_relaxed);
+	if(index >= pCapture->capacity)
+	{
+		pCapture->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	TimelineEvent& event = pCapture->pEvents[index];
+	event.ticks = GetTicks();
+	event.pInstance = pInstance;
+	event.value = value;
+	event.threadId = GetThreadId();
+	event.opcode = opcode;
+	event.span = span;
+	event.phase.store(phase, std::memory_order_release);
+}
+
+bool TimelineTrace::WriteChromeJson(FILE* pFile)
+{
+	if(pFile == NULL)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(s_lock);
+
+	fputs("{\"traceEvents\":[\n", pFile);
+
+	TimelineCapture* pCapture = s_current.get();
+	int64_t dropped = 0;
+
+	if(pCapture != NULL)
+	{
+		int64_t count = pCapture->next.load(std::memory_order_relaxed);
+		if(count > pCapture->capacity)
+		{
+			count = pCapture->capacity;
+		}
+
+		// the begin events that have not ended, per thread.
+		std::map<uint32_t, std::vector<const TimelineEvent*>> open;
+		int64_t lastTicks = pCapture->startTicks;
+		bool first = true;
+
+		for(int64_t i = 0; i < count; i++)
+		{
+			const TimelineEvent& event = pCapture->pEvents[i];
+			char phase = event.phase.load(std::memory_order_acquire);
+			if(phase == 0)
+			{
+				// still being written.
+				continue;
+			}
+
+			auto& stack = open[event.threadId];
+			if(phase == 'B')
+			{
+				stack.push_back(&event);
+			}
+			else if(stack.empty())
+			{
+				// the call began before recording started.
+				continue;
+			}
+			else
+			{
+				stack.pop_back();
+			}
+
+			WriteEvent(pFile, *pCapture, event, phase, event.ticks, false, first);
+			first = false;
+
+			if(event.ticks > lastTicks)
+			{
+				lastTicks = event.ticks;
+			}
+		}
+
+		for(auto& thread : open)
+		{
+			for(auto pEvent = thread.second.rbegin(); pEvent != thread.second.rend(); ++pEvent)
+			{
+				WriteEvent(pFile, *pCapture, **pEvent, 'E', lastTicks, true, first);
+				first = false;
+			}
+		}
+
+		dropped = pCapture->dropped.load(std::memory_order_relaxed);
+	}
+
+	fprintf(pFile, "\n],\n\"displayTimeUnit\":\"ns\",\n\"otherData\":{\"droppedEvents\":%lld}}\n", (long long)dropped);
+
+	return ferror(pFile) == 0;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Vst2400.h"
+
+#include <stdio.h>
+
+// The timeline trace records a begin and end event for each call between host and plugin
+// (dispatcher, process and parameter calls into the plugin and the plugin's calls to the host)
+// with the thread it was made on, so nested calls (the plugin asking GetTime during process)
+// and calls on different threads show up as they happened.
+// The capture is exported in the Chrome trace event (JSON) format, that chrome://tracing and Perfetto open.
+// Each interop module has its own capture. Recording does not lock or allocate:
+// events go into a buffer of fixed capacity and are dropped when it is full.
+
+// The kind of call a span is recorded for.
+enum class TimelineSpan : uint8_t
+{
+	None,
+	// a dispatcher call into the plugin (opcode is a Vst2PluginCommands).
+	Dispatch,
+	Process32,
+	Process64,
+	ProcessAccumulating,
+	ProcessVariableIo,
+	SetParameter,
+	GetParameter,
+	// a call of the plugin to the host (opcode is a Vst2HostCommands).
+	HostCallback,
+};
+
+class TimelineTrace
+{
+public:
+	// Starts a new capture that holds up to capacity events (a call is two events).
+	// The events of a previous capture are discarded. Returns false when the buffer cannot be allocated.
+	static bool Start(int32_t capacity);
+	// Stops recording. The events are kept for WriteChromeJson.
+	static void Stop();
+
+	static bool IsRecording()
+	{
+		return _isRecording;
+	}
+
+	// Records the start of a call. value is the index argument (dispatcher, callback and parameters)
+	// or the number of sample frames (process).
+	static void Begin(TimelineSpan span, const void* pInstance, int32_t opcode, int64_t value)
+	{
+		if(_isRecording) Write('B', span, pInstance, opcode, value);
+	}
+
+	// Records the end of a call. value is the result (dispatcher and callback).
+	static void End(TimelineSpan span, const void* pInstance, int32_t opcode, int64_t value)
+	{
+		if(_isRecording) Write('E', span, pInstance, opcode, value);
+	}
+
+	// Names the instance (its Vst2Plugin structure) in the exported trace. Not for the audio thread.
+	static void SetInstanceName(const void* pInstance, const char* pName);
+
+	// The number of events in the capture and the number that did not fit.
+	static int64_t GetEventCount();
+	static int64_t GetDroppedCount();
+
+	// Writes the capture in the Chrome trace event format to pFile.
+	// Spans that were still open when recording stopped (or when the buffer was full) are closed
+	// at the last recorded time; ends without a begin (the call started before Start) are left out.
+	// Returns false when writing failed.
+	static bool WriteChromeJson(FILE* pFile);
+
+private:
+	static void Write(char phase, TimelineSpan span, const void* pInstance, int32_t opcode, int64_t value);
+
+	static volatile bool _isRecording;
+};
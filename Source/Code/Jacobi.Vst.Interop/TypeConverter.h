@@ -1,5 +1,8 @@
 #pragma once
 
+#include "MemoryArena.h"
+#include "SpeakerArrangementSlots.h"
+
 class TypeConverter
 {
 public:
@@ -76,6 +79,26 @@ public:
 		return buffer;
 	}
 
+	// Copies a managed byteArray into memory from pArena.
+	// The memory is released when the arena is reset.
+	static char* ByteArrayToPtr(array<System::Byte>^ byteArray, MemoryArena* pArena)
+	{
+		int length = byteArray->Length;
+		char* buffer = (char*)pArena->Allocate(length);
+
+		if(buffer == NULL)
+		{
+			throw gcnew System::OutOfMemoryException();
+		}
+
+		if(length > 0)
+		{
+			System::Runtime::InteropServices::Marshal::Copy(byteArray, 0, System::IntPtr(buffer), length);
+		}
+
+		return buffer;
+	}
+
 	// Converts an unmanaged char pBuffer to a managed Byte array.
 	static array<System::Byte>^ PtrToByteArray(char *pBuffer, int length)
 	{
@@ -157,16 +180,23 @@ public:
 	}
 
 	// Converts a managed VstEvent array to an unmanaged VstEvent array.
-	// Call DeleteVstEvents on retval.
+	// Call DeleteUnmanagedEvents on retval.
 	static ::Vst2Events* AllocUnmanagedEvents(array<Jacobi::Vst::Core::VstEvent^>^ events)
 	{
+		return AllocUnmanagedEvents(events, NULL);
+	}
+
+	// Converts a managed VstEvent array to an unmanaged VstEvent array in memory from pArena (on the heap when NULL).
+	// The memory is released when the arena is reset; do not call DeleteUnmanagedEvents.
+	static ::Vst2Events* AllocUnmanagedEvents(array<Jacobi::Vst::Core::VstEvent^>^ events, MemoryArena* pArena)
+	{
+		// Vst2Events holds the first 2 event pointers.
 		int length = events->Length;
 		if(length > 2) length -= 2;
 
 		int totalLength = sizeof(Vst2Events) + (length * sizeof(Vst2Event*));
 
-		auto pEvents = (::Vst2Events*)new char[totalLength];
-		ZeroMemory(pEvents, totalLength);
+		auto pEvents = (::Vst2Events*)AllocateEventMemory(totalLength, pArena);
 
 		pEvents->eventCount = events->Length;
 
@@ -178,7 +208,7 @@ public:
 			case Jacobi::Vst::Core::VstEventTypes::MidiEvent:
 			{
 				auto midiEvent = (Jacobi::Vst::Core::VstMidiEvent^)evnt;
-				auto pMidiEvent = new ::Vst2MidiEvent();
+				auto pMidiEvent = (::Vst2MidiEvent*)AllocateEventMemory(sizeof(::Vst2MidiEvent), pArena);
 
 				pMidiEvent->sizeInBytes = sizeof(::Vst2MidiEvent);
 				pMidiEvent->flags = Vst2MidiEventFlags::None;
@@ -201,7 +231,7 @@ public:
 			case Jacobi::Vst::Core::VstEventTypes::MidiSysExEvent:
 			{
 				auto midiEvent = (Jacobi::Vst::Core::VstMidiSysExEvent^)evnt;
-				auto pMidiEvent = new ::Vst2MidiSysExEvent();
+				auto pMidiEvent = (::Vst2MidiSysExEvent*)AllocateEventMemory(sizeof(::Vst2MidiSysExEvent), pArena);
 
 				pMidiEvent->sizeInBytes = sizeof(::Vst2MidiSysExEvent);
 				pMidiEvent->flags = 0;
@@ -209,7 +239,7 @@ public:
 				pMidiEvent->kind = (Vst2EventKind)midiEvent->EventType;
 
 				pMidiEvent->dumpInBytes = midiEvent->Data->Length;
-				pMidiEvent->dump = new char[midiEvent->Data->Length];
+				pMidiEvent->dump = (char*)AllocateEventMemory(midiEvent->Data->Length, pArena);
 
 				for(int i = 0; i < midiEvent->Data->Length; i++)
 				{
@@ -227,7 +257,7 @@ public:
 				// incl.  type and byteSize
 				int structLength = dataLength + (2 * sizeof(int32_t));
 
-				::Vst2Event* pEvent = (::Vst2Event*)new char[structLength];
+				::Vst2Event* pEvent = (::Vst2Event*)AllocateEventMemory(structLength, pArena);
 
 				pEvent->kind = safe_cast<Vst2EventKind>(genericEvent->EventType);
 				pEvent->sizeInBytes = dataLength;
@@ -259,23 +289,14 @@ public:
 				// delete the sysex buffer
 				auto pMidiEvent = (::Vst2MidiSysExEvent*)pEvents->events[n];
 				delete[] pMidiEvent->dump;
-
-				// delete the event
-				delete pEvents->events[n];
-			}
-			else if(pEvents->events[n]->kind == Vst2EventKind::Midi)
-			{
-				// delete the midi event
-				delete pEvents->events[n];
-			}
-			else // legacy generic events
-			{
-				delete[] pEvents->events[n];
 			}
+
+			// delete the event (all kinds are allocated as char arrays)
+			delete[] (char*)pEvents->events[n];
 		}
 
 		// delete the array of events
-		delete[] pEvents;
+		delete[] (char*)pEvents;
 	}
 
 	// Assigns the values of the managed pinProps to the unmanaged pProps fields.
@@ -303,6 +324,11 @@ public:
 	// Converts an unmanaged speaker pArrangement to a managed VstSpeakerArrangement.
 	static Jacobi::Vst::Core::VstSpeakerArrangement^ ToManagedSpeakerArrangement(::Vst2SpeakerArrangement* pArrangement)
 	{
+		if(pArrangement == NULL)
+		{
+			return nullptr;
+		}
+
 		auto spkArr = gcnew Jacobi::Vst::Core::VstSpeakerArrangement();
 
 		spkArr->Type = safe_cast<Jacobi::Vst::Core::VstSpeakerArrangementType>(pArrangement->kind);
@@ -325,25 +351,37 @@ public:
 		return spkArr;
 	}
 
-	// Converts a managed speaker arrangement to an unmanaged VstSpeakerArrangement.
-	// delete retval
-	static ::Vst2SpeakerArrangement* AllocUnmanagedSpeakerArrangement(Jacobi::Vst::Core::VstSpeakerArrangement^ arrangement)
+	// Returns the number of bytes an unmanaged speaker arrangement with channelCount speakers occupies.
+	// The ::Vst2SpeakerArrangement struct declares 8 speakers, larger arrangements extend past the struct.
+	static size_t GetSpeakerArrangementSize(int32_t channelCount)
 	{
-		auto pArrangement = new ::Vst2SpeakerArrangement();
+		return SpeakerArrangementSlots::GetSize(channelCount);
+	}
 
-		ToUnmanagedSpeakerArrangement(pArrangement, arrangement);
+	// Allocates a zeroed unmanaged speaker arrangement with room for channelCount speakers.
+	// DeleteUnmanagedSpeakerArrangement retval
+	static ::Vst2SpeakerArrangement* AllocUnmanagedSpeakerArrangement(int32_t channelCount)
+	{
+		size_t size = GetSpeakerArrangementSize(channelCount);
+		auto pArrangement = (::Vst2SpeakerArrangement*)new char[size];
+		memset(pArrangement, 0, size);
 
 		return pArrangement;
 	}
 
+	static void DeleteUnmanagedSpeakerArrangement(::Vst2SpeakerArrangement* pArrangement)
+	{
+		delete[] (char*)pArrangement;
+	}
+
 	// copies the values from the managed arrangenment to the unmanaged pArrangement.
+	// pArrangement must have room for all speakers (see GetSpeakerArrangementSize).
 	static void ToUnmanagedSpeakerArrangement(::Vst2SpeakerArrangement* pArrangement, Jacobi::Vst::Core::VstSpeakerArrangement^ arrangement)
 	{
 		pArrangement->channelCount = arrangement->Speakers->Length;
 		pArrangement->kind = safe_cast<::Vst2SpeakerArrangementKind>(arrangement->Type);
 
-		// a maximum of 8 audio channels is supported in the ::Vst2SpeakerArrangement struct
-		for (int index = 0; index < pArrangement->channelCount && index < 8; index++)
+		for (int index = 0; index < pArrangement->channelCount; index++)
 		{
 			auto speakerProps = arrangement->Speakers[index];
 
@@ -699,4 +737,18 @@ public:
 
 private:
 	TypeConverter(){}
+
+	// zeroed memory for AllocUnmanagedEvents: from pArena or a char array on the heap.
+	static void* AllocateEventMemory(size_t size, MemoryArena* pArena)
+	{
+		void* pMemory = pArena != NULL ? pArena->Allocate(size) : new char[size];
+
+		if(pMemory == NULL)
+		{
+			throw gcnew System::OutOfMemoryException();
+		}
+
+		ZeroMemory(pMemory, size);
+		return pMemory;
+	}
 };
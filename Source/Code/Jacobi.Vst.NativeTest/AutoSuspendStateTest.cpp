@@ -0,0 +1,185 @@
+// Feeds silent and non-silent blocks to AutoSuspendState and checks when process calls are skipped.
+#include "../Jacobi.Vst.Interop/Host/AutoSuspendState.h"
+#include "NativeTest.h"
+
+#include <vector>
+
+namespace
+{
+	const int32_t BlockSize = 64;
+
+	// a stereo input that is silent unless Play is called.
+	struct Input
+	{
+		std::vector<float> left;
+		std::vector<float> right;
+		float* buffers[2];
+
+		Input()
+			: left(BlockSize, 0.0f), right(BlockSize, 0.0f)
+		{
+			buffers[0] = left.data();
+			buffers[1] = right.data();
+		}
+
+		void Play(bool isPlaying)
+		{
+			right[BlockSize / 2] = isPlaying ? 0.5f : 0.0f;
+		}
+	};
+
+	// runs silent blocks until a call is skipped; returns the number of calls that were not.
+	int32_t CountCallsUntilSuspended(AutoSuspendState& state, Input& input, int32_t maxCalls)
+	{
+		input.Play(false);
+
+		for(int32_t calls = 0; calls < maxCalls; calls++)
+		{
+			if(state.Update(input.buffers, 2, BlockSize, false))
+			{
+				return calls;
+			}
+		}
+
+		return -1;
+	}
+
+	void Test_Defaults()
+	{
+		AutoSuspendState state;
+		CHECK(state.GetThreshold() == 0.0f);
+		CHECK(state.GetDefaultTailSize() == 48000);
+		CHECK(!state.IsSuspended());
+		CHECK(state.GetSkippedCount() == 0);
+	}
+
+	void Test_Suspend_AfterTail()
+	{
+		AutoSuspendState state;
+		Input input;
+		state.SetTailSize(4 * BlockSize);
+
+		// the tail is rendered by 4 calls, the 5th silent block is skipped.
+		CHECK(CountCallsUntilSuspended(state, input, 100) == 4);
+		CHECK(state.IsSuspended());
+		CHECK(state.GetSkippedCount() == 1);
+
+		CHECK(state.Update(input.buffers, 2, BlockSize, false));
+		CHECK(state.GetSkippedCount() == 2);
+	}
+
+	void Test_Suspend_TailKinds()
+	{
+		AutoSuspendState state;
+		Input input;
+		state.SetDefaultTailSize(2 * BlockSize);
+
+		// not queried yet and 0 (unknown): the default tail.
+		CHECK(CountCallsUntilSuspended(state, input, 100) == 2);
+		state.SetTailSize(0);
+		CHECK(CountCallsUntilSuspended(state, input, 100) == 2);
+
+		// 1: no tail at all.
+		state.SetTailSize(1);
+		CHECK(CountCallsUntilSuspended(state, input, 100) == 0);
+	}
+
+	void Test_Resume_OnSound()
+	{
+		AutoSuspendState state;
+		Input input;
+		state.SetTailSize(1);
+		CHECK(CountCallsUntilSuspended(state, input, 100) == 0);
+
+		input.Play(true);
+		CHECK(!state.Update(input.buffers, 2, BlockSize, false));
+		CHECK(!state.IsSuspended());
+
+		// the tail starts again after the sound.
+		state.SetTailSize(3 * BlockSize);
+		CHECK(CountCallsUntilSuspended(state, input, 100) == 3);
+	}
+
+	void Test_Resume_OnEvents()
+	{
+		AutoSuspendState state;
+		Input input;
+		state.SetTailSize(1);
+		CHECK(CountCallsUntilSuspended(state, input, 100) == 0);
+
+		CHECK(!state.Update(input.buffers, 2, BlockSize, true));
+		CHECK(!state.IsSuspended());
+	}
+
+	void Test_Resume_Requested()
+	{
+		AutoSuspendState state;
+		Input input;
+		state.SetTailSize(2 * BlockSize);
+		CHECK(CountCallsUntilSuspended(state, input, 100) == 2);
+
+		// posted by another thread, applied by the next update.
+		state.RequestResume();
+		CHECK(state.IsSuspended());
+		CHECK(!state.Update(input.buffers, 2, BlockSize, false));
+		CHECK(!state.IsSuspended());
+		CHECK(CountCallsUntilSuspended(state, input, 100) == 1);
+	}
+
+	void Test_Threshold()
+	{
+		AutoSuspendState state;
+		Input input;
+		state.SetTailSize(1);
+		input.left[0] = 0.0005f;
+
+		CHECK(!state.Update(input.buffers, 2, BlockSize, false));
+
+		state.SetThreshold(0.001f);
+		CHECK(state.Update(input.buffers, 2, BlockSize, false));
+	}
+
+	void Test_NoInputs_NeverSuspended()
+	{
+		AutoSuspendState state;
+		state.SetTailSize(1);
+
+		// an instrument has no inputs to scan; its output may be anything.
+		for(int32_t i = 0; i < 10; i++)
+		{
+			CHECK(!state.Update((float**)NULL, 0, BlockSize, false));
+			CHECK(!state.Update((double**)NULL, 0, BlockSize, false));
+		}
+		CHECK(!state.IsSuspended());
+		CHECK(state.GetSkippedCount() == 0);
+	}
+
+	void Test_Double()
+	{
+		AutoSuspendState state;
+		std::vector<double> mono(BlockSize, 0.0);
+		double* buffers[] = { mono.data() };
+		state.SetTailSize(BlockSize);
+
+		CHECK(!state.Update(buffers, 1, BlockSize, false));
+		CHECK(state.Update(buffers, 1, BlockSize, false));
+
+		mono[BlockSize - 1] = 0.1;
+		CHECK(!state.Update(buffers, 1, BlockSize, false));
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Defaults),
+		TEST_CASE(Test_Suspend_AfterTail),
+		TEST_CASE(Test_Suspend_TailKinds),
+		TEST_CASE(Test_Resume_OnSound),
+		TEST_CASE(Test_Resume_OnEvents),
+		TEST_CASE(Test_Resume_Requested),
+		TEST_CASE(Test_Threshold),
+		TEST_CASE(Test_NoInputs_NeverSuspended),
+		TEST_CASE(Test_Double)
+	});
+}
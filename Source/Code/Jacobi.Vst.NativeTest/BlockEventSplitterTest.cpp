@@ -0,0 +1,242 @@
+// Splits the events of a host block over sub-blocks with a BlockEventSplitter and checks selection, rebasing, sysex copies
+// and the events collected over several ProcessEvents calls.
+#include "../Jacobi.Vst.Interop/Host/BlockEventSplitter.h"
+#include "NativeTest.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+	// a Vst2Events list with room for count event pointers (Vst2Events declares 2).
+	struct EventList
+	{
+		std::vector<char> storage;
+
+		EventList(const std::vector<::Vst2Event*>& events)
+			: storage(offsetof(::Vst2Events, events) + (events.size() + 2) * sizeof(::Vst2Event*))
+		{
+			Get()->eventCount = (int32_t)events.size();
+			if(!events.empty())
+			{
+				memcpy(storage.data() + offsetof(::Vst2Events, events), events.data(), events.size() * sizeof(::Vst2Event*));
+			}
+		}
+
+		::Vst2Events* Get() { return (::Vst2Events*)storage.data(); }
+	};
+
+	const ::Vst2Event* GetEvent(const ::Vst2Events* pEvents, int32_t index)
+	{
+		const ::Vst2Event* pEvent;
+		memcpy(&pEvent, (const char*)pEvents + offsetof(::Vst2Events, events) + index * sizeof(::Vst2Event*), sizeof(pEvent));
+		return pEvent;
+	}
+
+	::Vst2MidiEvent MakeNote(int32_t deltaFrames, uint8_t note)
+	{
+		::Vst2MidiEvent event = {};
+		event.kind = ::Vst2EventKind::Midi;
+		event.sizeInBytes = sizeof(::Vst2MidiEvent);
+		event.deltaFrames = deltaFrames;
+		event.midiData[0] = 0x90;
+		event.midiData[1] = note;
+		event.midiData[2] = 100;
+		return event;
+	}
+
+	void Test_SubBlocks()
+	{
+		auto early = MakeNote(-5, 1);
+		auto first = MakeNote(10, 2);
+		auto boundary = MakeNote(64, 3);
+		auto second = MakeNote(100, 4);
+		auto late = MakeNote(200, 5);
+		EventList list({ (::Vst2Event*)&early, (::Vst2Event*)&first, (::Vst2Event*)&boundary,
+			(::Vst2Event*)&second, (::Vst2Event*)&late });
+
+		BlockEventSplitter splitter;
+
+		// a block of 160 samples in sub-blocks of 64, 64 and 32.
+		auto pSub = splitter.GetSubBlock(list.Get(), 0, 64, false);
+		CHECK(pSub != NULL && pSub->eventCount == 2);
+		// events before the block are clamped to the start of the first sub-block.
+		CHECK(GetEvent(pSub, 0)->deltaFrames == 0);
+		CHECK(((const ::Vst2MidiEvent*)GetEvent(pSub, 0))->midiData[1] == 1);
+		CHECK(GetEvent(pSub, 1)->deltaFrames == 10);
+
+		pSub = splitter.GetSubBlock(list.Get(), 64, 64, false);
+		CHECK(pSub != NULL && pSub->eventCount == 2);
+		CHECK(GetEvent(pSub, 0)->deltaFrames == 0);
+		CHECK(((const ::Vst2MidiEvent*)GetEvent(pSub, 0))->midiData[1] == 3);
+		CHECK(GetEvent(pSub, 1)->deltaFrames == 36);
+
+		// events past the block are clamped to the end of the last sub-block.
+		pSub = splitter.GetSubBlock(list.Get(), 128, 32, true);
+		CHECK(pSub != NULL && pSub->eventCount == 1);
+		CHECK(GetEvent(pSub, 0)->deltaFrames == 31);
+		CHECK(((const ::Vst2MidiEvent*)GetEvent(pSub, 0))->midiData[1] == 5);
+	}
+
+	void Test_SourceIsNotChanged()
+	{
+		auto first = MakeNote(10, 1);
+		auto second = MakeNote(100, 2);
+		EventList list({ (::Vst2Event*)&first, (::Vst2Event*)&second });
+
+		BlockEventSplitter splitter;
+		splitter.GetSubBlock(list.Get(), 0, 64, false);
+		auto pSub = splitter.GetSubBlock(list.Get(), 64, 64, true);
+
+		// copies are rebased, the caller's events keep their position in the whole block.
+		CHECK(pSub != NULL && pSub->eventCount == 1);
+		CHECK(GetEvent(pSub, 0) != (const ::Vst2Event*)&second);
+		CHECK(GetEvent(pSub, 0)->deltaFrames == 36);
+		CHECK(first.deltaFrames == 10);
+		CHECK(second.deltaFrames == 100);
+		CHECK(GetEvent(list.Get(), 1) == (const ::Vst2Event*)&second);
+
+		// the same list can be split again, e.g. in sub-blocks of another size.
+		pSub = splitter.GetSubBlock(list.Get(), 96, 32, true);
+		CHECK(pSub != NULL && pSub->eventCount == 1);
+		CHECK(GetEvent(pSub, 0)->deltaFrames == 4);
+	}
+
+	void Test_NoEvents()
+	{
+		auto note = MakeNote(100, 1);
+		EventList list({ (::Vst2Event*)&note });
+		EventList empty({});
+
+		BlockEventSplitter splitter;
+		CHECK(splitter.GetSubBlock(NULL, 0, 64, true) == NULL);
+		CHECK(splitter.GetSubBlock(empty.Get(), 0, 64, true) == NULL);
+		CHECK(splitter.GetSubBlock(list.Get(), 0, 64, false) == NULL);
+		CHECK(splitter.GetSubBlock(list.Get(), 0, 0, true) == NULL);
+	}
+
+	void Test_SysEx()
+	{
+		char dump[] = { (char)0xF0, 0x7E, 0x7F, (char)0xF7 };
+		::Vst2MidiSysExEvent sysEx = {};
+		sysEx.kind = ::Vst2EventKind::SystemExclusive;
+		sysEx.sizeInBytes = sizeof(::Vst2MidiSysExEvent);
+		sysEx.deltaFrames = 70;
+		sysEx.dumpInBytes = sizeof(dump);
+		sysEx.dump = dump;
+		EventList list({ (::Vst2Event*)&sysEx });
+
+		BlockEventSplitter splitter;
+		auto pSub = splitter.GetSubBlock(list.Get(), 64, 64, true);
+		CHECK(pSub != NULL && pSub->eventCount == 1);
+
+		// the whole sysex event is copied, not just the Vst2Event header.
+		auto pCopy = (const ::Vst2MidiSysExEvent*)GetEvent(pSub, 0);
+		CHECK(pCopy->kind == ::Vst2EventKind::SystemExclusive);
+		CHECK(pCopy->deltaFrames == 6);
+		CHECK(pCopy->dumpInBytes == (int32_t)sizeof(dump));
+		CHECK(pCopy->dump == dump);
+		CHECK(sysEx.deltaFrames == 70);
+	}
+
+	void Test_Grows()
+	{
+		BlockEventSplitter splitter;
+
+		auto note = MakeNote(1, 1);
+		EventList small({ (::Vst2Event*)&note });
+		CHECK(splitter.GetSubBlock(small.Get(), 0, 64, true)->eventCount == 1);
+
+		std::vector<::Vst2MidiEvent> notes;
+		for(int32_t i = 0; i < 100; i++)
+		{
+			notes.push_back(MakeNote(i, (uint8_t)i));
+		}
+		std::vector<::Vst2Event*> pointers;
+		for(auto& event : notes)
+		{
+			pointers.push_back((::Vst2Event*)&event);
+		}
+		EventList large(pointers);
+
+		auto pSub = splitter.GetSubBlock(large.Get(), 32, 32, false);
+		CHECK(pSub != NULL && pSub->eventCount == 32);
+		CHECK(GetEvent(pSub, 31)->deltaFrames == 31);
+		CHECK(((const ::Vst2MidiEvent*)GetEvent(pSub, 31))->midiData[1] == 63);
+	}
+
+	void Test_Defer_TwoCalls()
+	{
+		auto first = MakeNote(10, 1);
+		auto second = MakeNote(100, 2);
+		auto third = MakeNote(20, 3);
+		EventList firstCall({ (::Vst2Event*)&first, (::Vst2Event*)&second });
+		EventList secondCall({ (::Vst2Event*)&third });
+
+		BlockEventSplitter splitter;
+		CHECK(splitter.GetDeferred() == NULL);
+
+		// two ProcessEvents calls before the process call of a block of 128 samples.
+		splitter.Defer(firstCall.Get());
+		splitter.Defer(secondCall.Get());
+		auto pDeferred = splitter.GetDeferred();
+		CHECK(pDeferred != NULL && pDeferred->eventCount == 3);
+		CHECK(GetEvent(pDeferred, 2) == (const ::Vst2Event*)&third);
+
+		auto pSub = splitter.GetSubBlock(pDeferred, 0, 64, false);
+		CHECK(pSub != NULL && pSub->eventCount == 2);
+		CHECK(((const ::Vst2MidiEvent*)GetEvent(pSub, 0))->midiData[1] == 1);
+		CHECK(((const ::Vst2MidiEvent*)GetEvent(pSub, 1))->midiData[1] == 3);
+
+		pSub = splitter.GetSubBlock(pDeferred, 64, 64, true);
+		CHECK(pSub != NULL && pSub->eventCount == 1);
+		CHECK(((const ::Vst2MidiEvent*)GetEvent(pSub, 0))->midiData[1] == 2);
+
+		// the next block starts with an empty list.
+		splitter.ClearDeferred();
+		CHECK(splitter.GetDeferred() == NULL);
+		splitter.Defer(secondCall.Get());
+		CHECK(splitter.GetDeferred()->eventCount == 1);
+	}
+
+	void Test_Defer_Grows()
+	{
+		std::vector<::Vst2MidiEvent> notes;
+		for(int32_t i = 0; i < 50; i++)
+		{
+			notes.push_back(MakeNote(i, (uint8_t)i));
+		}
+
+		BlockEventSplitter splitter;
+		for(auto& event : notes)
+		{
+			EventList call({ (::Vst2Event*)&event });
+			splitter.Defer(call.Get());
+		}
+
+		// the events deferred before the storage grew are kept.
+		auto pDeferred = splitter.GetDeferred();
+		CHECK(pDeferred != NULL && pDeferred->eventCount == 50);
+		CHECK(GetEvent(pDeferred, 0) == (const ::Vst2Event*)&notes[0]);
+		CHECK(GetEvent(pDeferred, 49) == (const ::Vst2Event*)&notes[49]);
+
+		EventList empty({});
+		splitter.Defer(empty.Get());
+		splitter.Defer(NULL);
+		CHECK(splitter.GetDeferred()->eventCount == 50);
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_SubBlocks),
+		TEST_CASE(Test_SourceIsNotChanged),
+		TEST_CASE(Test_NoEvents),
+		TEST_CASE(Test_SysEx),
+		TEST_CASE(Test_Grows),
+		TEST_CASE(Test_Defer_TwoCalls),
+		TEST_CASE(Test_Defer_Grows)
+	});
+}
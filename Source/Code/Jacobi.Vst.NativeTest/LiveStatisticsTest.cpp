@@ -0,0 +1,298 @@
+// Publishes counters through LiveStatistics and reads them back with LiveStatisticsReader.
+#include "../Jacobi.Vst.Interop/LiveStatistics.h"
+#include "NativeTest.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+	uint32_t OwnProcessId()
+	{
+		return (uint32_t)::getpid();
+	}
+
+	// returns the index of the published slot or -1.
+	int32_t FindSlot(const LiveStatisticsReader& reader, const LiveStatisticsSlot* pSlot, LiveStatisticsSlot* pCopy)
+	{
+		for(int32_t i = 0; i < (int32_t)reader.GetHeader()->slotCount; i++)
+		{
+			if(reader.ReadSlot(i, pCopy) && pCopy->sequence == pSlot->sequence &&
+				strcmp(pCopy->name, pSlot->name) == 0)
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	void Test_Segment_PublishesCounters()
+	{
+		LiveStatisticsSlot* pSlot = LiveStatistics::AcquireSlot(LiveStatisticsKind::Host, 'Test', 1200);
+		CHECK(LiveStatistics::IsPublished(pSlot));
+		strcpy(pSlot->name, "Published Plugin");
+
+		pSlot->AddDispatch((int32_t)Vst2PluginCommands::Open);
+		pSlot->AddDispatch((int32_t)Vst2PluginCommands::ProcessEvents);
+		pSlot->AddDispatch((int32_t)Vst2PluginCommands::ProcessEvents);
+		pSlot->AddDispatch(1000);
+		pSlot->AddDispatch(-1);
+		pSlot->AddProcess(256);
+		pSlot->AddProcess(128);
+		pSlot->AddAllocation(100);
+		pSlot->SetLoad(0.5f, 0.75f, 3);
+
+		LiveStatisticsReader reader;
+		CHECK(reader.Open(OwnProcessId()));
+		if(reader.GetHeader() == NULL) return;
+
+		CHECK(reader.GetHeader()->magic == LiveStatisticsMagic);
+		CHECK(reader.GetHeader()->version == LiveStatisticsVersion);
+		CHECK(reader.GetHeader()->processId == OwnProcessId());
+		CHECK(reader.GetHeader()->slotSize == sizeof(LiveStatisticsSlot));
+
+		LiveStatisticsSlot copy;
+		CHECK(FindSlot(reader, pSlot, &copy) >= 0);
+		CHECK(copy.kind == LiveStatisticsKind::Host);
+		CHECK(copy.pluginId == 'Test');
+		CHECK(copy.pluginVersion == 1200);
+		CHECK(copy.dispatchCount == 5);
+		CHECK(copy.dispatchCounts[(int32_t)Vst2PluginCommands::Open] == 1);
+		CHECK(copy.dispatchCounts[(int32_t)Vst2PluginCommands::ProcessEvents] == 2);
+		CHECK(copy.dispatchCounts[LiveStatisticsOpcodeCount - 1] == 2);
+		CHECK(copy.processCount == 2);
+		CHECK(copy.processFrames == 384);
+		CHECK(copy.allocationCount == 1);
+		CHECK(copy.allocatedBytes == 100);
+		CHECK(copy.load == 0.5f);
+		CHECK(copy.peakLoad == 0.75f);
+		CHECK(copy.deadlineMissCount == 3);
+
+		LiveStatistics::ReleaseSlot(pSlot);
+
+		// the module released its last slot: the segment is gone.
+		LiveStatisticsReader after;
+		CHECK(!after.Open(OwnProcessId()));
+	}
+
+	void Test_Slot_Events()
+	{
+		::Vst2MidiEvent noteOn = {};
+		noteOn.kind = ::Vst2EventKind::Midi;
+		noteOn.sizeInBytes = sizeof(::Vst2MidiEvent);
+
+		char dump[10] = {};
+		::Vst2MidiSysExEvent sysEx = {};
+		sysEx.kind = ::Vst2EventKind::SystemExclusive;
+		sysEx.sizeInBytes = sizeof(::Vst2MidiSysExEvent);
+		sysEx.dumpInBytes = sizeof(dump);
+		sysEx.dump = dump;
+
+		::Vst2Events events = {};
+		events.eventCount = 2;
+		events.events[0] = (::Vst2Event*)&sysEx;
+		events.events[1] = (::Vst2Event*)&noteOn;
+
+		LiveStatisticsSlot slot = {};
+		int64_t size = slot.AddEvents(&events);
+		CHECK(size == (int64_t)(sizeof(::Vst2Events) + 2 * sizeof(::Vst2Event*) +
+			sizeof(::Vst2MidiSysExEvent) + sizeof(dump) + sizeof(::Vst2MidiEvent)));
+		events.eventCount = 1;
+		events.events[0] = (::Vst2Event*)&noteOn;
+		slot.AddEvents(&events);
+		CHECK(slot.AddEvents(NULL) == 0);
+
+		CHECK(slot.eventBlockCount == 2);
+		CHECK(slot.eventCount == 3);
+		CHECK(slot.lastEventCount == 1);
+		CHECK(slot.maxEventCount == 2);
+		CHECK(slot.marshaledBytes == size + (int64_t)(sizeof(::Vst2Events) + sizeof(::Vst2Event*) + sizeof(::Vst2MidiEvent)));
+	}
+
+	void Test_Segment_FullGivesPrivateSlot()
+	{
+		std::vector<LiveStatisticsSlot*> slots;
+		for(int32_t i = 0; i < LiveStatisticsSlotCount; i++)
+		{
+			slots.push_back(LiveStatistics::AcquireSlot(LiveStatisticsKind::Plugin, i, 0));
+			CHECK(LiveStatistics::IsPublished(slots.back()));
+		}
+
+		LiveStatisticsSlot* pPrivate = LiveStatistics::AcquireSlot(LiveStatisticsKind::Plugin, 99, 0);
+		CHECK(!LiveStatistics::IsPublished(pPrivate));
+		CHECK(pPrivate->kind == LiveStatisticsKind::Plugin);
+		CHECK(pPrivate->pluginId == 99);
+		pPrivate->AddProcess(64);
+		LiveStatistics::ReleaseSlot(pPrivate);
+
+		// a freed slot is reused and cleared, with a new sequence.
+		LiveStatisticsSlot* pFirst = slots[0];
+		uint32_t sequence = pFirst->sequence;
+		pFirst->AddProcess(64);
+		LiveStatistics::ReleaseSlot(pFirst);
+
+		slots[0] = LiveStatistics::AcquireSlot(LiveStatisticsKind::Host, 7, 0);
+		CHECK(slots[0] == pFirst);
+		CHECK(slots[0]->sequence == sequence + 1);
+		CHECK(slots[0]->processCount == 0);
+		CHECK(slots[0]->kind == LiveStatisticsKind::Host);
+
+		LiveStatisticsReader reader;
+		CHECK(reader.Open(OwnProcessId()));
+
+		int32_t used = 0;
+		LiveStatisticsSlot copy;
+		for(int32_t i = 0; i < LiveStatisticsSlotCount; i++)
+		{
+			if(reader.ReadSlot(i, &copy)) used++;
+		}
+		CHECK(used == LiveStatisticsSlotCount);
+		CHECK(!reader.ReadSlot(LiveStatisticsSlotCount, &copy));
+
+		for(auto pSlot : slots)
+		{
+			LiveStatistics::ReleaseSlot(pSlot);
+		}
+
+		for(int32_t i = 0; i < LiveStatisticsSlotCount; i++)
+		{
+			CHECK(!reader.ReadSlot(i, &copy));
+		}
+	}
+
+	void Test_Slot_DetachKeepsCounting()
+	{
+		LiveStatisticsSlot* pSlot = LiveStatistics::AcquireSlot(LiveStatisticsKind::Host, 1, 0);
+		LiveStatisticsSlot* pKeep = LiveStatistics::AcquireSlot(LiveStatisticsKind::Host, 2, 0);
+		pSlot->AddProcess(32);
+
+		LiveStatisticsSlot* pDetached = LiveStatistics::DetachSlot(pSlot);
+		CHECK(pDetached != pSlot);
+		CHECK(!LiveStatistics::IsPublished(pDetached));
+		CHECK(pDetached->processCount == 1);
+		CHECK(pDetached->pluginId == 1);
+		pDetached->AddProcess(32);
+
+		// detaching a private slot does nothing.
+		CHECK(LiveStatistics::DetachSlot(pDetached) == pDetached);
+
+		LiveStatisticsReader reader;
+		CHECK(reader.Open(OwnProcessId()));
+
+		int32_t used = 0;
+		LiveStatisticsSlot copy;
+		for(int32_t i = 0; i < LiveStatisticsSlotCount; i++)
+		{
+			if(reader.ReadSlot(i, &copy)) used++;
+		}
+		CHECK(used == 1);
+
+		LiveStatistics::ReleaseSlot(pDetached);
+		LiveStatistics::ReleaseSlot(pKeep);
+	}
+
+	void Test_Slot_EndProcessLoad()
+	{
+		LiveStatisticsSlot slot = {};
+
+		// no sample rate: counted without load.
+		LiveStatistics::EndProcess(&slot, LiveStatistics::GetTicks(), 64);
+		CHECK(slot.processCount == 1);
+		CHECK(slot.load == 0.0f);
+
+		// two seconds for a block of 48000 samples at 48 kHz is twice the block.
+		slot.sampleRate = 48000.0f;
+		int64_t twoSecondsAgo = LiveStatistics::GetTicks() - 2 * (int64_t)LiveStatistics::GetTicksPerSecond();
+		LiveStatistics::EndProcess(&slot, twoSecondsAgo, 48000);
+		CHECK(slot.processCount == 2);
+		CHECK(slot.load >= 2.0f && slot.load < 2.1f);
+		CHECK(slot.peakLoad == slot.load);
+		CHECK(slot.deadlineMissCount == 1);
+
+		LiveStatistics::EndProcess(&slot, LiveStatistics::GetTicks(), 48000);
+		CHECK(slot.load < 0.5f);
+		CHECK(slot.peakLoad >= 2.0f);
+		CHECK(slot.deadlineMissCount == 1);
+	}
+
+	void Test_Segment_StaleFromCrashedProcess()
+	{
+		// the segment a crashed process with our id left behind, with an instance still in it.
+		char name[64];
+		snprintf(name, sizeof(name), "/Jacobi.Vst.LiveStatistics.%u", OwnProcessId());
+		size_t size = sizeof(LiveStatisticsHeader) + LiveStatisticsSlotCount * sizeof(LiveStatisticsSlot);
+
+		int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+		CHECK(fd >= 0);
+		if(fd < 0) return;
+		CHECK(::ftruncate(fd, size) == 0);
+		auto pHeader = (LiveStatisticsHeader*)::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+		CHECK(pHeader != MAP_FAILED);
+		if(pHeader == MAP_FAILED) return;
+
+		pHeader->version = LiveStatisticsVersion;
+		pHeader->headerSize = sizeof(LiveStatisticsHeader);
+		pHeader->slotSize = sizeof(LiveStatisticsSlot);
+		pHeader->slotCount = LiveStatisticsSlotCount;
+		pHeader->processId = OwnProcessId();
+		pHeader->processStartTime = 1;
+		pHeader->attachCount = 1;
+		pHeader->magic = LiveStatisticsMagic;
+		auto pGhost = (LiveStatisticsSlot*)(pHeader + 1) + 3;
+		pGhost->kind = LiveStatisticsKind::Host;
+		strcpy(pGhost->name, "Ghost");
+		::munmap(pHeader, size);
+
+		LiveStatisticsSlot* pSlot = LiveStatistics::AcquireSlot(LiveStatisticsKind::Plugin, 1, 0);
+		CHECK(LiveStatistics::IsPublished(pSlot));
+
+		// only the new instance is listed.
+		LiveStatisticsReader reader;
+		CHECK(reader.Open(OwnProcessId()));
+		int32_t used = 0;
+		LiveStatisticsSlot copy;
+		for(int32_t i = 0; i < LiveStatisticsSlotCount; i++)
+		{
+			if(reader.ReadSlot(i, &copy))
+			{
+				used++;
+				CHECK(strcmp(copy.name, "Ghost") != 0);
+			}
+		}
+		CHECK(used == 1);
+		reader.Close();
+
+		// the attach count of the crashed process is gone too: the last release removes the segment.
+		LiveStatistics::ReleaseSlot(pSlot);
+		CHECK(!reader.Open(OwnProcessId()));
+	}
+
+	void Test_Reader_NoSegment()
+	{
+		LiveStatisticsReader reader;
+		// no VST.NET module in the parent shell.
+		CHECK(!reader.Open((uint32_t)::getppid()));
+		CHECK(reader.GetHeader() == NULL);
+
+		LiveStatisticsSlot copy;
+		CHECK(!reader.ReadSlot(0, &copy));
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Segment_PublishesCounters),
+		TEST_CASE(Test_Slot_Events),
+		TEST_CASE(Test_Segment_FullGivesPrivateSlot),
+		TEST_CASE(Test_Slot_DetachKeepsCounting),
+		TEST_CASE(Test_Slot_EndProcessLoad),
+		TEST_CASE(Test_Segment_StaleFromCrashedProcess),
+		TEST_CASE(Test_Reader_NoSegment)
+	});
+}
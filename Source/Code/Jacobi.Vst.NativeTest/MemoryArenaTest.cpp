@@ -0,0 +1,107 @@
+// Allocates from a MemoryArena and checks the blocks it holds across generations.
+#include "../Jacobi.Vst.Interop/MemoryArena.h"
+#include "NativeTest.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+	bool IsAligned(void* pMem)
+	{
+		return ((uintptr_t)pMem % 16) == 0;
+	}
+
+	void Test_Allocate_Bump()
+	{
+		MemoryArena arena(1024, 4096);
+
+		char* pFirst = (char*)arena.Allocate(10);
+		char* pSecond = (char*)arena.Allocate(100);
+		CHECK(pFirst != NULL && pSecond != NULL);
+		CHECK(IsAligned(pFirst) && IsAligned(pSecond));
+		// both come from the same block.
+		CHECK(pSecond == pFirst + 16);
+		CHECK(arena.GetAllocatedSize() == 16 + 112);
+		CHECK(arena.GetReservedSize() == 1024);
+
+		memset(pFirst, 1, 10);
+		memset(pSecond, 2, 100);
+		CHECK(pFirst[9] == 1 && pSecond[0] == 2);
+
+		// an empty chunk still gets its own address.
+		CHECK(arena.Allocate(0) != NULL);
+	}
+
+	void Test_Allocate_NewBlock()
+	{
+		MemoryArena arena(1024, 4096);
+
+		arena.Allocate(1000);
+		char* pNext = (char*)arena.Allocate(100);
+		CHECK(pNext != NULL && IsAligned(pNext));
+		CHECK(arena.GetReservedSize() == 2048);
+
+		// larger than a block.
+		char* pLarge = (char*)arena.Allocate(3000);
+		CHECK(pLarge != NULL);
+		memset(pLarge, 3, 3000);
+		CHECK(arena.GetReservedSize() == 2048 + 3008);
+	}
+
+	void Test_Reset_RetainsBlock()
+	{
+		MemoryArena arena(1024, 4096);
+		CHECK(arena.GetGeneration() == 0);
+
+		char* pFirst = (char*)arena.Allocate(100);
+		arena.Allocate(1000);
+		arena.Allocate(3000);
+		arena.Reset();
+
+		// the largest block within the retain size is kept and reused.
+		CHECK(arena.GetGeneration() == 1);
+		CHECK(arena.GetAllocatedSize() == 0);
+		CHECK(arena.GetReservedSize() == 3008);
+		char* pAgain = (char*)arena.Allocate(100);
+		CHECK(pAgain != NULL && pAgain != pFirst);
+		CHECK(arena.GetReservedSize() == 3008);
+	}
+
+	void Test_Reset_Bounded()
+	{
+		MemoryArena arena(1024, 4096);
+
+		// a session that never suspends: one large chunk per generation.
+		for(int i = 0; i < 100; i++)
+		{
+			char* pChunk = (char*)arena.Allocate(100000);
+			CHECK(pChunk != NULL);
+			pChunk[99999] = 1;
+			arena.Reset();
+		}
+
+		// blocks over the retain size are freed.
+		CHECK(arena.GetGeneration() == 100);
+		CHECK(arena.GetReservedSize() == 0);
+
+		for(int i = 0; i < 100; i++)
+		{
+			arena.Allocate(500);
+			arena.Allocate(500);
+			arena.Reset();
+		}
+
+		CHECK(arena.GetReservedSize() == 1024);
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Allocate_Bump),
+		TEST_CASE(Test_Allocate_NewBlock),
+		TEST_CASE(Test_Reset_RetainsBlock),
+		TEST_CASE(Test_Reset_Bounded)
+	});
+}
@@ -0,0 +1,54 @@
+// Mock VST2 plugin library. The Makefile builds one shared object per MOCK_* variant.
+#include "../Jacobi.Vst.Interop/Vst2400.h"
+
+#define MOCK_EXPORT extern "C" __attribute__((visibility("default")))
+
+namespace
+{
+	Vst2IntPtr Vst2Handler Dispatch(Vst2Plugin*, Vst2PluginCommands, int32_t, Vst2IntPtr, void*, float)
+	{
+		return 0;
+	}
+
+	[[maybe_unused]] Vst2Plugin* CreatePlugin(Vst2HostCallback hostCallback, int32_t magic)
+	{
+		static Vst2Plugin plugin = {};
+		plugin.VstP = magic;
+		plugin.command = &Dispatch;
+		plugin.id = 'MOCK';
+		// ask the host for its version, like most plugins do in their main.
+		plugin.version = (int32_t)hostCallback(nullptr, 1, 0, 0, nullptr, 0);
+		return &plugin;
+	}
+}
+
+#if defined(MOCK_VALID)
+MOCK_EXPORT Vst2Plugin* VSTPluginMain(Vst2HostCallback hostCallback)
+{
+	return CreatePlugin(hostCallback, Vst2FourCharacterCode);
+}
+#elif defined(MOCK_LEGACY)
+// old plugins only export 'main'.
+MOCK_EXPORT Vst2Plugin* LegacyMain(Vst2HostCallback hostCallback) __asm__("main");
+Vst2Plugin* LegacyMain(Vst2HostCallback hostCallback)
+{
+	return CreatePlugin(hostCallback, Vst2FourCharacterCode);
+}
+#elif defined(MOCK_NULL)
+MOCK_EXPORT Vst2Plugin* VSTPluginMain(Vst2HostCallback)
+{
+	return nullptr;
+}
+#elif defined(MOCK_BAD_MAGIC)
+MOCK_EXPORT Vst2Plugin* VSTPluginMain(Vst2HostCallback hostCallback)
+{
+	return CreatePlugin(hostCallback, 'Junk');
+}
+#elif defined(MOCK_NO_ENTRY)
+MOCK_EXPORT int32_t NotAPlugin()
+{
+	return 0;
+}
+#else
+#error Define one of the MOCK_* variants.
+#endif
@@ -0,0 +1,109 @@
+// Drives the no-op benchmark plugin through NativeBenchmarkHost and checks the results.
+#include "../Jacobi.Vst.Interop/Benchmark/NativeBenchmarkHost.h"
+#include "NativeTest.h"
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+	std::string g_mockDir;
+
+	std::string MockPath(const char* pName)
+	{
+		return g_mockDir + "/" + pName;
+	}
+
+	void Test_Load_NoOpPlugin()
+	{
+		NativeBenchmarkHost host;
+		CHECK(host.Load(MockPath("noop_plugin.so").c_str()) == NativeLoadResult::Success);
+		CHECK(host.GetPlugin() != nullptr && host.GetPlugin()->id == 'NoOp');
+	}
+
+	void Test_Load_MissingFile()
+	{
+		NativeBenchmarkHost host;
+		CHECK(host.Load(MockPath("does_not_exist.so").c_str()) == NativeLoadResult::LoadFailed);
+		CHECK(host.GetPlugin() == nullptr);
+	}
+
+	void Test_Configure_ChannelCounts()
+	{
+		NativeBenchmarkHost host;
+		CHECK(host.Load(MockPath("noop_plugin.so").c_str()) == NativeLoadResult::Success);
+
+		const int32_t channelCounts[] = { 1, 2, 8, 16, 64, 2 };
+		for(auto channelCount : channelCounts)
+		{
+			CHECK(host.Configure(channelCount, 1024, 44100.0f));
+			CHECK(host.GetPlugin()->inputCount == channelCount);
+			CHECK(host.GetPlugin()->outputCount == channelCount);
+		}
+	}
+
+	void Test_Configure_ArrangementRejected()
+	{
+		// the loader mock ignores the speaker arrangement and has no channels.
+		NativeBenchmarkHost host;
+		CHECK(host.Load(MockPath("mock_valid.so").c_str()) == NativeLoadResult::Success);
+		CHECK(!host.Configure(2, 1024, 44100.0f));
+	}
+
+	void Test_Run_TimesEachBlock()
+	{
+		NativeBenchmarkHost host;
+		CHECK(host.Load(MockPath("noop_plugin.so").c_str()) == NativeLoadResult::Success);
+		CHECK(host.Configure(64, 8192, 48000.0f));
+
+		const int32_t eventCounts[] = { 0, 1, 1024 };
+		for(auto eventCount : eventCounts)
+		{
+			std::vector<double> nanoseconds(100, -1.0);
+			host.Run(8192, eventCount, false, nanoseconds.data(), 100);
+			host.Run(32, eventCount, true, nanoseconds.data(), 50);
+
+			for(auto duration : nanoseconds)
+			{
+				CHECK(duration >= 0.0);
+			}
+		}
+	}
+
+	void Test_Run_BlockSizeTooLarge()
+	{
+		NativeBenchmarkHost host;
+		CHECK(host.Load(MockPath("noop_plugin.so").c_str()) == NativeLoadResult::Success);
+		CHECK(host.Configure(2, 256, 44100.0f));
+
+		std::vector<double> nanoseconds(10, -1.0);
+		host.Run(512, 0, false, nanoseconds.data(), 10);
+		CHECK(nanoseconds[0] == -1.0);
+	}
+
+	void Test_Run_NotConfigured()
+	{
+		NativeBenchmarkHost host;
+		CHECK(host.Load(MockPath("noop_plugin.so").c_str()) == NativeLoadResult::Success);
+
+		std::vector<double> nanoseconds(10, -1.0);
+		host.Run(32, 0, false, nanoseconds.data(), 10);
+		CHECK(nanoseconds[0] == -1.0);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	g_mockDir = argc > 1 ? argv[1] : ".";
+
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Load_NoOpPlugin),
+		TEST_CASE(Test_Load_MissingFile),
+		TEST_CASE(Test_Configure_ChannelCounts),
+		TEST_CASE(Test_Configure_ArrangementRejected),
+		TEST_CASE(Test_Run_TimesEachBlock),
+		TEST_CASE(Test_Run_BlockSizeTooLarge),
+		TEST_CASE(Test_Run_NotConfigured)
+	});
+}
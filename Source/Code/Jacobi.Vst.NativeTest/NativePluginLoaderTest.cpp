@@ -0,0 +1,152 @@
+// Loads the mock plugin libraries through NativePluginLoader and checks the results.
+#include "../Jacobi.Vst.Interop/Host/NativePluginLoader.h"
+#include "NativeTest.h"
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+	std::string g_mockDir;
+
+	std::string MockPath(const char* pName)
+	{
+		return g_mockDir + "/" + pName;
+	}
+
+	Vst2IntPtr Vst2Handler HostCallback(Vst2Plugin*, int32_t opcode, int32_t, Vst2IntPtr, void*, float)
+	{
+		// Version
+		return opcode == 1 ? Vst2Version : 0;
+	}
+
+	NativeLoadResult LoadAndCreate(const char* pName, Vst2Plugin** ppPlugin)
+	{
+		NativePluginModule module;
+		auto result = NativePluginLoader::Load(MockPath(pName).c_str(), &module);
+		*ppPlugin = nullptr;
+
+		if(result == NativeLoadResult::Success)
+		{
+			CHECK(module.handle != nullptr);
+			CHECK(module.pluginMain != nullptr);
+			result = NativePluginLoader::CreatePlugin(module.pluginMain, &HostCallback, ppPlugin);
+			NativePluginLoader::Unload(module.handle);
+		}
+		else
+		{
+			CHECK(module.handle == nullptr);
+			CHECK(module.pluginMain == nullptr);
+		}
+
+		return result;
+	}
+
+	void Test_Load_VSTPluginMain()
+	{
+		Vst2Plugin* pPlugin;
+		CHECK(LoadAndCreate("mock_valid.so", &pPlugin) == NativeLoadResult::Success);
+		CHECK(pPlugin != nullptr);
+	}
+
+	void Test_Load_LegacyMain()
+	{
+		NativePluginModule module;
+		CHECK(NativePluginLoader::Load(MockPath("mock_legacy.so").c_str(), &module) == NativeLoadResult::Success);
+
+		Vst2Plugin* pPlugin = nullptr;
+		CHECK(NativePluginLoader::CreatePlugin(module.pluginMain, &HostCallback, &pPlugin) == NativeLoadResult::Success);
+		CHECK(pPlugin != nullptr && pPlugin->id == 'MOCK');
+		// the host callback was reachable from the entry point.
+		CHECK(pPlugin != nullptr && pPlugin->version == Vst2Version);
+
+		NativePluginLoader::Unload(module.handle);
+	}
+
+	void Test_Load_NoEntryPoint()
+	{
+		Vst2Plugin* pPlugin;
+		CHECK(LoadAndCreate("mock_no_entry.so", &pPlugin) == NativeLoadResult::EntryPointNotFound);
+	}
+
+	void Test_Create_ReturnsNull()
+	{
+		Vst2Plugin* pPlugin;
+		CHECK(LoadAndCreate("mock_null.so", &pPlugin) == NativeLoadResult::PluginReturnedNull);
+		CHECK(pPlugin == nullptr);
+	}
+
+	void Test_Create_MagicNumberMismatch()
+	{
+		Vst2Plugin* pPlugin;
+		CHECK(LoadAndCreate("mock_bad_magic.so", &pPlugin) == NativeLoadResult::MagicNumberMismatch);
+		CHECK(pPlugin != nullptr);
+	}
+
+	void Test_Load_MissingFile()
+	{
+		Vst2Plugin* pPlugin;
+		CHECK(LoadAndCreate("does_not_exist.so", &pPlugin) == NativeLoadResult::LoadFailed);
+	}
+
+	void Test_Load_NotALibrary()
+	{
+		Vst2Plugin* pPlugin;
+		CHECK(LoadAndCreate("not_a_library.so", &pPlugin) == NativeLoadResult::BadImageFormat);
+	}
+
+	void Test_Preload_Parallel()
+	{
+		const char* names[] = { "mock_valid.so", "mock_legacy.so", "mock_no_entry.so", "does_not_exist.so", "mock_null.so" };
+		const NativeLoadResult expected[] = { NativeLoadResult::Success, NativeLoadResult::Success,
+			NativeLoadResult::EntryPointNotFound, NativeLoadResult::LoadFailed, NativeLoadResult::Success };
+		const int32_t count = 40;
+
+		std::vector<std::string> paths;
+		std::vector<const char*> pathPointers;
+		for(int32_t i = 0; i < count; i++)
+		{
+			paths.push_back(MockPath(names[i % 5]));
+		}
+		for(auto& path : paths)
+		{
+			pathPointers.push_back(path.c_str());
+		}
+
+		std::vector<NativePluginModule> modules(count);
+		std::vector<NativeLoadResult> results(count);
+
+		auto loadedCount = NativePluginLoader::Preload(pathPointers.data(), count, modules.data(), results.data(), 4);
+		CHECK(loadedCount == count / 5 * 3);
+
+		for(int32_t i = 0; i < count; i++)
+		{
+			CHECK(results[i] == expected[i % 5]);
+			CHECK((modules[i].handle != nullptr) == (results[i] == NativeLoadResult::Success));
+			NativePluginLoader::Unload(modules[i].handle);
+		}
+	}
+
+	void Test_Preload_Empty()
+	{
+		CHECK(NativePluginLoader::Preload(nullptr, 0, nullptr, nullptr, 0) == 0);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	g_mockDir = argc > 1 ? argv[1] : ".";
+
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Load_VSTPluginMain),
+		TEST_CASE(Test_Load_LegacyMain),
+		TEST_CASE(Test_Load_NoEntryPoint),
+		TEST_CASE(Test_Create_ReturnsNull),
+		TEST_CASE(Test_Create_MagicNumberMismatch),
+		TEST_CASE(Test_Load_MissingFile),
+		TEST_CASE(Test_Load_NotALibrary),
+		TEST_CASE(Test_Preload_Parallel),
+		TEST_CASE(Test_Preload_Empty)
+	});
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// The check macro and test runner shared by the native tests.
+// A test is a void function that uses CHECK; main passes the tests to RunTests and returns its result.
+
+#include <initializer_list>
+#include <stdio.h>
+
+namespace NativeTest
+{
+	// the number of failed checks in this test program.
+	inline int g_failures = 0;
+
+	struct TestCase
+	{
+		const char* pName;
+		void (*test)();
+	};
+
+	// Runs the tests in order, prints the outcome and returns the exit code for main.
+	inline int RunTests(std::initializer_list<TestCase> tests)
+	{
+		for(const TestCase& testCase : tests)
+		{
+			printf("%s\n", testCase.pName);
+			testCase.test();
+		}
+
+		printf(g_failures == 0 ? "All tests passed.\n" : "%d check(s) failed.\n", g_failures);
+		return g_failures == 0 ? 0 : 1;
+	}
+}
+
+#define CHECK(condition) \
+	if(!(condition)) { printf("  FAILED: %s (line %d)\n", #condition, __LINE__); NativeTest::g_failures++; }
+
+// a TestCase named after the test function.
+#define TEST_CASE(test) NativeTest::TestCase{ #test, &test }
@@ -0,0 +1,345 @@
+// Collects host blocks with ProcessBlockCoalescer and queues their events in a ProcessEventQueue,
+// the way PluginCommandProxy does for a plugin with a ProcessBlockSize.
+#include "../Jacobi.Vst.Interop/Plugin/ProcessBlockCoalescer.h"
+#include "../Jacobi.Vst.Interop/Plugin/ProcessEventQueue.h"
+#include "NativeTest.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+	const int32_t BlockSize = 64;
+
+	// an unmanaged event list as a host passes it.
+	struct HostEvents
+	{
+		std::vector<Vst2MidiEvent> midiEvents;
+		std::vector<Vst2Event*> pointers;
+		std::vector<char> buffer;
+
+		void AddNote(int32_t deltaFrames, uint8_t status, uint8_t note)
+		{
+			Vst2MidiEvent midiEvent = {};
+			midiEvent.kind = Vst2EventKind::Midi;
+			midiEvent.sizeInBytes = sizeof(Vst2MidiEvent);
+			midiEvent.deltaFrames = deltaFrames;
+			midiEvent.midiData[0] = status;
+			midiEvent.midiData[1] = note;
+			midiEvents.push_back(midiEvent);
+		}
+
+		const Vst2Events* Get()
+		{
+			pointers.clear();
+			for(Vst2MidiEvent& midiEvent : midiEvents)
+			{
+				pointers.push_back((Vst2Event*)&midiEvent);
+			}
+
+			buffer.assign(sizeof(Vst2Events) + pointers.size() * sizeof(Vst2Event*), 0);
+			auto pEvents = (Vst2Events*)buffer.data();
+			pEvents->eventCount = (int32_t)pointers.size();
+			memcpy(pEvents->events, pointers.data(), pointers.size() * sizeof(Vst2Event*));
+			return pEvents;
+		}
+	};
+
+	// Vst2Events declares 2 event pointers, the list continues past the struct.
+	const Vst2Event* GetEvent(const Vst2Events* pEvents, int32_t index)
+	{
+		return ((Vst2Event* const*)((const char*)pEvents + offsetof(Vst2Events, events)))[index];
+	}
+
+	uint8_t GetNote(const Vst2Events* pEvents, int32_t index)
+	{
+		return ((const Vst2MidiEvent*)GetEvent(pEvents, index))->midiData[1];
+	}
+
+	void Test_Coalescer_DelaysOneBlock()
+	{
+		ProcessBlockCoalescer<float> coalescer(BlockSize, 1, 1);
+		std::vector<float> input(1000);
+		std::vector<float> output(1000, -1.0f);
+		for(size_t i = 0; i < input.size(); i++)
+		{
+			input[i] = (float)(i + 1);
+		}
+
+		// host blocks of different sizes; the plugin copies its input to its output.
+		const int32_t hostBlocks[] = { 100, 37, 5, 64, 200, 1, 90, 503 };
+		int32_t hostPosition = 0;
+
+		for(int32_t hostBlock : hostBlocks)
+		{
+			float* pInput = input.data() + hostPosition;
+			float* pOutput = output.data() + hostPosition;
+
+			int32_t offset = 0;
+			while(offset < hostBlock)
+			{
+				offset += coalescer.Exchange(&pInput, &pOutput, offset, hostBlock - offset);
+				CHECK(coalescer.GetPosition() <= BlockSize);
+
+				if(coalescer.IsBlockFull())
+				{
+					memcpy(coalescer.GetOutputs()[0], coalescer.GetInputs()[0], BlockSize * sizeof(float));
+					coalescer.NextBlock();
+				}
+			}
+			hostPosition += hostBlock;
+		}
+
+		// the first block is silent, then the input follows exactly one block later.
+		bool isDelayed = true;
+		for(int32_t i = 0; i < hostPosition; i++)
+		{
+			float expected = i < BlockSize ? 0.0f : input[i - BlockSize];
+			isDelayed = isDelayed && output[i] == expected;
+		}
+		CHECK(isDelayed);
+	}
+
+	void Test_Coalescer_InPlace()
+	{
+		ProcessBlockCoalescer<double> coalescer(4, 1, 1);
+		double buffer[4] = { 1, 2, 3, 4 };
+		double* pBuffer = buffer;
+
+		// the host passes the same buffer for input and output.
+		CHECK(coalescer.Exchange(&pBuffer, &pBuffer, 0, 4) == 4);
+		CHECK(coalescer.IsBlockFull());
+		CHECK(coalescer.GetInputs()[0][3] == 4.0);
+		CHECK(buffer[0] == 0.0 && buffer[3] == 0.0);
+
+		coalescer.Reset();
+		CHECK(coalescer.GetPosition() == 0);
+		CHECK(coalescer.GetInputs()[0][3] == 0.0);
+		CHECK(coalescer.Matches(1, 1) && !coalescer.Matches(2, 1));
+	}
+
+	void Test_Queue_BoundaryCrossing()
+	{
+		ProcessEventQueue queue;
+		HostEvents hostEvents;
+		hostEvents.AddNote(0, 0x90, 1);
+		hostEvents.AddNote(10, 0x90, 2);
+		hostEvents.AddNote(20, 0x80, 1);
+		hostEvents.AddNote(100, 0x80, 2);
+
+		// the next host block starts at 50 of the block being collected.
+		queue.Add(hostEvents.Get(), 50);
+		CHECK(queue.GetCount() == 4);
+
+		const Vst2Events* pEvents = queue.TakeBlock(BlockSize);
+		CHECK(pEvents->eventCount == 2);
+		CHECK(pEvents->events[0]->deltaFrames == 50 && GetNote(pEvents, 0) == 1);
+		CHECK(pEvents->events[1]->deltaFrames == 60 && GetNote(pEvents, 1) == 2);
+		CHECK(queue.GetCount() == 2);
+
+		// the note off of note 1 is not clamped into the first block.
+		pEvents = queue.TakeBlock(BlockSize);
+		CHECK(pEvents->eventCount == 1);
+		CHECK(pEvents->events[0]->deltaFrames == 6 && GetNote(pEvents, 0) == 1);
+
+		pEvents = queue.TakeBlock(BlockSize);
+		CHECK(pEvents->eventCount == 1);
+		CHECK(pEvents->events[0]->deltaFrames == 22 && GetNote(pEvents, 0) == 2);
+
+		pEvents = queue.TakeBlock(BlockSize);
+		CHECK(pEvents->eventCount == 0);
+		CHECK(queue.GetCount() == 0);
+	}
+
+	void Test_Queue_Merge()
+	{
+		ProcessEventQueue queue;
+
+		HostEvents first;
+		first.AddNote(30, 0x90, 1);
+		first.AddNote(5, 0x90, 2);
+		queue.Add(first.Get(), 0);
+
+		// a second ProcessEvents call before the next process call.
+		HostEvents second;
+		second.AddNote(10, 0x90, 3);
+		second.AddNote(5, 0x90, 4);
+		queue.Add(second.Get(), 0);
+
+		// one list, ordered by position; events at the same position in the order they arrived.
+		const Vst2Events* pEvents = queue.TakeBlock(BlockSize);
+		CHECK(pEvents->eventCount == 4);
+		CHECK(GetNote(pEvents, 0) == 2 && GetEvent(pEvents, 0)->deltaFrames == 5);
+		CHECK(GetNote(pEvents, 1) == 4 && GetEvent(pEvents, 1)->deltaFrames == 5);
+		CHECK(GetNote(pEvents, 2) == 3 && GetEvent(pEvents, 2)->deltaFrames == 10);
+		CHECK(GetNote(pEvents, 3) == 1 && GetEvent(pEvents, 3)->deltaFrames == 30);
+	}
+
+	void Test_Queue_EventsCopied()
+	{
+		ProcessEventQueue queue;
+		HostEvents hostEvents;
+		hostEvents.AddNote(3, 0x90, 60);
+		const Vst2Events* pHostEvents = hostEvents.Get();
+
+		queue.Add(pHostEvents, 0);
+
+		// the host reuses its events after the call.
+		hostEvents.midiEvents[0].midiData[1] = 0;
+		hostEvents.midiEvents[0].deltaFrames = 0;
+
+		const Vst2Events* pEvents = queue.TakeBlock(BlockSize);
+		CHECK(pEvents->eventCount == 1);
+		CHECK(GetNote(pEvents, 0) == 60 && pEvents->events[0]->deltaFrames == 3);
+	}
+
+	void Test_Queue_SysEx()
+	{
+		ProcessEventQueue queue;
+
+		char dump1[] = { (char)0xF0, 1, 2, (char)0xF7 };
+		char dump2[] = { (char)0xF0, 3, 4, 5, 6, (char)0xF7 };
+
+		Vst2MidiSysExEvent sysEx1 = {};
+		sysEx1.kind = Vst2EventKind::SystemExclusive;
+		sysEx1.deltaFrames = 10;
+		sysEx1.dumpInBytes = sizeof(dump1);
+		sysEx1.dump = dump1;
+		Vst2MidiSysExEvent sysEx2 = sysEx1;
+		sysEx2.deltaFrames = 80;
+		sysEx2.dumpInBytes = sizeof(dump2);
+		sysEx2.dump = dump2;
+
+		char buffer[sizeof(Vst2Events)] = {};
+		auto pHostEvents = (Vst2Events*)buffer;
+		pHostEvents->eventCount = 2;
+		pHostEvents->events[0] = (Vst2Event*)&sysEx1;
+		pHostEvents->events[1] = (Vst2Event*)&sysEx2;
+
+		queue.Add(pHostEvents, 0);
+		memset(dump1, 0, sizeof(dump1));
+		memset(dump2, 0, sizeof(dump2));
+
+		const Vst2Events* pEvents = queue.TakeBlock(BlockSize);
+		CHECK(pEvents->eventCount == 1);
+		auto pSysEx = (const Vst2MidiSysExEvent*)pEvents->events[0];
+		CHECK(pSysEx->dumpInBytes == 4 && pSysEx->dump[1] == 1 && pSysEx->dump[3] == (char)0xF7);
+
+		// the dump of the later event survives the release of the first block.
+		pEvents = queue.TakeBlock(BlockSize);
+		CHECK(pEvents->eventCount == 1);
+		pSysEx = (const Vst2MidiSysExEvent*)pEvents->events[0];
+		CHECK(pSysEx->deltaFrames == 16);
+		CHECK(pSysEx->dumpInBytes == 6 && pSysEx->dump[1] == 3 && pSysEx->dump[4] == 6);
+	}
+
+	void Test_Queue_Full()
+	{
+		ProcessEventQueue queue(4, 16);
+		HostEvents hostEvents;
+		for(int32_t i = 0; i < 6; i++)
+		{
+			hostEvents.AddNote(i, 0x90, (uint8_t)i);
+		}
+
+		queue.Add(hostEvents.Get(), 0);
+		CHECK(queue.GetCount() == 4);
+		CHECK(queue.GetDroppedCount() == 2);
+
+		// room again once a block has been taken (and released).
+		CHECK(queue.TakeBlock(BlockSize)->eventCount == 4);
+		queue.Add(hostEvents.Get(), 0);
+		CHECK(queue.GetCount() == 4);
+		CHECK(queue.GetDroppedCount() == 4);
+	}
+
+	void Test_Queue_Clear()
+	{
+		ProcessEventQueue queue;
+		HostEvents hostEvents;
+		hostEvents.AddNote(100, 0x90, 1);
+		queue.Add(hostEvents.Get(), 0);
+
+		queue.Clear();
+		CHECK(queue.GetCount() == 0);
+		CHECK(queue.TakeBlock(BlockSize)->eventCount == 0);
+		CHECK(queue.TakeBlock(BlockSize)->eventCount == 0);
+	}
+
+	// every event is sent together with an impulse at its sample; the plugin must get the event
+	// at the position of the impulse in the coalesced block.
+	void Test_EventsFollowAudio()
+	{
+		ProcessBlockCoalescer<float> coalescer(BlockSize, 1, 1);
+		ProcessEventQueue queue;
+
+		const int32_t hostBlocks[] = { 100, 37, 5, 64, 200, 1, 90, 150 };
+		int32_t processPosition = 0;	// the position of the coalesced block after the last host block
+		int32_t eventCount = 0;
+		int32_t deliveredCount = 0;
+		bool isAligned = true;
+
+		for(int32_t hostBlock : hostBlocks)
+		{
+			std::vector<float> input(hostBlock, 0.0f);
+			std::vector<float> output(hostBlock, 0.0f);
+			float* pInput = input.data();
+			float* pOutput = output.data();
+
+			// events at the start, the end and in between.
+			HostEvents hostEvents;
+			for(int32_t delta = 0; delta < hostBlock - 1; delta += 1 + hostBlock / 3)
+			{
+				eventCount++;
+				hostEvents.AddNote(delta, 0x90, (uint8_t)eventCount);
+				input[delta] = (float)eventCount;
+			}
+			hostEvents.AddNote(hostBlock - 1, 0x80, (uint8_t)++eventCount);
+			input[hostBlock - 1] = (float)eventCount;
+
+			queue.Add(hostEvents.Get(), processPosition);
+
+			int32_t offset = 0;
+			while(offset < hostBlock)
+			{
+				offset += coalescer.Exchange(&pInput, &pOutput, offset, hostBlock - offset);
+
+				if(coalescer.IsBlockFull())
+				{
+					const Vst2Events* pEvents = queue.TakeBlock(BlockSize);
+					for(int32_t n = 0; n < pEvents->eventCount; n++)
+					{
+						int32_t deltaFrames = GetEvent(pEvents, n)->deltaFrames;
+						isAligned = isAligned && deltaFrames >= 0 && deltaFrames < BlockSize &&
+							coalescer.GetInputs()[0][deltaFrames] == (float)GetNote(pEvents, n);
+						deliveredCount++;
+					}
+					coalescer.NextBlock();
+				}
+			}
+
+			processPosition = coalescer.GetPosition();
+		}
+
+		CHECK(isAligned);
+		// all events of the full blocks were delivered, the rest is still queued.
+		CHECK(deliveredCount + queue.GetCount() == eventCount);
+		CHECK(queue.GetCount() > 0);
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Coalescer_DelaysOneBlock),
+		TEST_CASE(Test_Coalescer_InPlace),
+		TEST_CASE(Test_Queue_BoundaryCrossing),
+		TEST_CASE(Test_Queue_Merge),
+		TEST_CASE(Test_Queue_EventsCopied),
+		TEST_CASE(Test_Queue_SysEx),
+		TEST_CASE(Test_Queue_Full),
+		TEST_CASE(Test_Queue_Clear),
+		TEST_CASE(Test_EventsFollowAudio)
+	});
+}
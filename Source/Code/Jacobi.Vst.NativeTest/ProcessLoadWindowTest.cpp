@@ -0,0 +1,142 @@
+// Records synthetic process durations in a ProcessLoadWindow and checks load, percentiles and deadline misses.
+#include "../Jacobi.Vst.Interop/Host/ProcessLoadWindow.h"
+#include "NativeTest.h"
+
+namespace
+{
+	const float SampleRate = 48000.0f;
+	// 10 ms.
+	const int32_t BlockSize = 480;
+
+	// records a call that took load times the block duration.
+	void RecordLoad(ProcessLoadWindow& window, double load)
+	{
+		window.Record(load * BlockSize / SampleRate, SampleRate, BlockSize);
+	}
+
+	bool IsNear(float value, float expected)
+	{
+		return value > expected - 0.0001f && value < expected + 0.0001f;
+	}
+
+	void Test_Record_Load()
+	{
+		ProcessLoadWindow window;
+		CHECK(window.GetPercentile(50) == 0.0f);
+
+		// 5 ms for a 10 ms block.
+		window.Record(0.005, SampleRate, BlockSize);
+		CHECK(window.GetProcessCount() == 1);
+		CHECK(IsNear(window.GetLastLoad(), 0.5f));
+		CHECK(IsNear(window.GetPeakLoad(), 0.5f));
+
+		// a shorter block has an earlier deadline.
+		window.Record(0.005, SampleRate, BlockSize / 4);
+		CHECK(IsNear(window.GetLastLoad(), 2.0f));
+		CHECK(IsNear(window.GetPeakLoad(), 2.0f));
+		CHECK(window.GetDeadlineMissCount() == 1);
+
+		RecordLoad(window, 0.25);
+		CHECK(IsNear(window.GetLastLoad(), 0.25f));
+		CHECK(IsNear(window.GetPeakLoad(), 2.0f));
+	}
+
+	void Test_Record_UnknownRateOrFrames()
+	{
+		ProcessLoadWindow window;
+		window.Record(0.005, 0.0f, BlockSize);
+		window.Record(0.005, SampleRate, 0);
+		CHECK(window.GetProcessCount() == 0);
+		CHECK(window.GetLastLoad() == 0.0f);
+	}
+
+	void Test_Percentile()
+	{
+		ProcessLoadWindow window;
+
+		// loads 0.01 .. 1.00, recorded out of order.
+		for(int i = 0; i < 100; i++)
+		{
+			RecordLoad(window, ((i * 37) % 100 + 1) / 100.0);
+		}
+
+		CHECK(IsNear(window.GetPercentile(0), 0.01f));
+		CHECK(IsNear(window.GetPercentile(50), 0.50f));
+		CHECK(IsNear(window.GetPercentile(99), 0.99f));
+		CHECK(IsNear(window.GetPercentile(99.5), 1.00f));
+		CHECK(IsNear(window.GetPercentile(100), 1.00f));
+	}
+
+	void Test_Percentile_RingBuffer()
+	{
+		ProcessLoadWindow window;
+
+		// one window of heavy calls followed by a full window of light calls.
+		for(int i = 0; i < ProcessLoadWindow::WindowSize; i++)
+		{
+			RecordLoad(window, 0.9);
+		}
+		for(int i = 0; i < ProcessLoadWindow::WindowSize; i++)
+		{
+			RecordLoad(window, 0.1);
+		}
+
+		// only the most recent window counts for percentiles, the peak is kept.
+		CHECK(window.GetProcessCount() == 2 * ProcessLoadWindow::WindowSize);
+		CHECK(IsNear(window.GetPercentile(100), 0.1f));
+		CHECK(IsNear(window.GetPeakLoad(), 0.9f));
+
+		RecordLoad(window, 0.5);
+		CHECK(IsNear(window.GetPercentile(100), 0.5f));
+		CHECK(IsNear(window.GetPercentile(99), 0.1f));
+	}
+
+	void Test_DeadlineThreshold()
+	{
+		ProcessLoadWindow window;
+		CHECK(window.GetDeadlineThreshold() == 1.0f);
+
+		RecordLoad(window, 0.8);
+		RecordLoad(window, 0.95);
+		RecordLoad(window, 1.2);
+		CHECK(window.GetDeadlineMissCount() == 1);
+
+		// leave room for the rest of the host.
+		window.SetDeadlineThreshold(0.75f);
+		RecordLoad(window, 0.8);
+		RecordLoad(window, 0.7);
+		CHECK(window.GetDeadlineMissCount() == 2);
+	}
+
+	void Test_Reset()
+	{
+		ProcessLoadWindow window;
+		window.SetDeadlineThreshold(0.5f);
+		RecordLoad(window, 0.9);
+		RecordLoad(window, 0.2);
+
+		window.Reset();
+		CHECK(window.GetProcessCount() == 0);
+		CHECK(window.GetDeadlineMissCount() == 0);
+		CHECK(window.GetLastLoad() == 0.0f);
+		CHECK(window.GetPeakLoad() == 0.0f);
+		CHECK(window.GetPercentile(100) == 0.0f);
+		// the threshold is a setting, not a measurement.
+		CHECK(window.GetDeadlineThreshold() == 0.5f);
+
+		RecordLoad(window, 0.3);
+		CHECK(IsNear(window.GetPercentile(100), 0.3f));
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Record_Load),
+		TEST_CASE(Test_Record_UnknownRateOrFrames),
+		TEST_CASE(Test_Percentile),
+		TEST_CASE(Test_Percentile_RingBuffer),
+		TEST_CASE(Test_DeadlineThreshold),
+		TEST_CASE(Test_Reset)
+	});
+}
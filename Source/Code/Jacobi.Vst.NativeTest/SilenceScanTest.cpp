@@ -0,0 +1,108 @@
+// Scans float and double buffers with SilenceScan, including the samples after the last full SSE2 vector.
+#include "../Jacobi.Vst.Interop/Host/SilenceScan.h"
+#include "NativeTest.h"
+
+#include <math.h>
+#include <vector>
+
+namespace
+{
+	void Test_Float_Silent()
+	{
+		std::vector<float> buffer(67, 0.0f);
+		CHECK(SilenceScan::IsSilent(buffer.data(), (int32_t)buffer.size(), 0.0f));
+		CHECK(SilenceScan::IsSilent(buffer.data(), 0, 0.0f));
+
+		// negative zero is silent too.
+		buffer[5] = -0.0f;
+		CHECK(SilenceScan::IsSilent(buffer.data(), (int32_t)buffer.size(), 0.0f));
+	}
+
+	void Test_Float_EverySample()
+	{
+		// a sound at any position is found, in the vector loop and in the remainder.
+		for(int32_t count = 1; count <= 11; count++)
+		{
+			for(int32_t position = 0; position < count; position++)
+			{
+				std::vector<float> buffer(count, 0.0f);
+				buffer[position] = position % 2 == 0 ? 0.5f : -0.5f;
+
+				CHECK(!SilenceScan::IsSilent(buffer.data(), count, 0.0f));
+				// samples after sampleCount are not scanned.
+				CHECK(SilenceScan::IsSilent(buffer.data(), position, 0.0f));
+			}
+		}
+	}
+
+	void Test_Float_Threshold()
+	{
+		std::vector<float> buffer(8, 0.001f);
+		buffer[6] = -0.001f;
+
+		CHECK(!SilenceScan::IsSilent(buffer.data(), 8, 0.0f));
+		CHECK(SilenceScan::IsSilent(buffer.data(), 8, 0.001f));
+
+		buffer[7] = -0.0011f;
+		CHECK(!SilenceScan::IsSilent(buffer.data(), 8, 0.001f));
+	}
+
+	void Test_Float_NaN()
+	{
+		std::vector<float> buffer(8, 0.0f);
+		buffer[2] = NAN;
+
+		// NaN never compares greater, like the scalar loop.
+		CHECK(SilenceScan::IsSilent(buffer.data(), 8, 0.0f));
+	}
+
+	void Test_Double_EverySample()
+	{
+		for(int32_t count = 1; count <= 7; count++)
+		{
+			for(int32_t position = 0; position < count; position++)
+			{
+				std::vector<double> buffer(count, 0.0);
+				buffer[position] = position % 2 == 0 ? 1e-3 : -1e-3;
+
+				CHECK(!SilenceScan::IsSilent(buffer.data(), count, 0.0f));
+				CHECK(SilenceScan::IsSilent(buffer.data(), count, 0.001f));
+				CHECK(SilenceScan::IsSilent(buffer.data(), position, 0.0f));
+			}
+		}
+	}
+
+	void Test_Buffers()
+	{
+		std::vector<float> left(16, 0.0f);
+		std::vector<float> right(16, 0.0f);
+		float* buffers[] = { left.data(), right.data() };
+
+		CHECK(SilenceScan::IsSilent(buffers, 2, 16, 0.0f));
+
+		right[15] = 0.25f;
+		CHECK(!SilenceScan::IsSilent(buffers, 2, 16, 0.0f));
+		CHECK(SilenceScan::IsSilent(buffers, 1, 16, 0.0f));
+
+		// no buffers at all is vacuously silent; AutoSuspendState decides what that means.
+		CHECK(SilenceScan::IsSilent((float**)NULL, 0, 16, 0.0f));
+
+		std::vector<double> mono(16, 0.0);
+		double* precisionBuffers[] = { mono.data() };
+		CHECK(SilenceScan::IsSilent(precisionBuffers, 1, 16, 0.0f));
+		mono[0] = -1.0;
+		CHECK(!SilenceScan::IsSilent(precisionBuffers, 1, 16, 0.0f));
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Float_Silent),
+		TEST_CASE(Test_Float_EverySample),
+		TEST_CASE(Test_Float_Threshold),
+		TEST_CASE(Test_Float_NaN),
+		TEST_CASE(Test_Double_EverySample),
+		TEST_CASE(Test_Buffers)
+	});
+}
@@ -0,0 +1,102 @@
+// Requests arrangements from SpeakerArrangementSlots and checks reuse, growth and Clear.
+#include "../Jacobi.Vst.Interop/SpeakerArrangementSlots.h"
+#include "NativeTest.h"
+
+namespace
+{
+	const int32_t Kind51 = 19;
+	const int32_t Kind71 = 23;
+
+	void Test_Get_Hit()
+	{
+		SpeakerArrangementSlots slots;
+
+		::Vst2SpeakerArrangement* pFirst = slots.Get(Kind51, false, 6);
+		CHECK(pFirst != NULL);
+		CHECK(pFirst->channelCount == 0);
+		CHECK(slots.GetAllocationCount() == 1);
+
+		// the same kind and direction is reused, also for fewer channels.
+		CHECK(slots.Get(Kind51, false, 6) == pFirst);
+		CHECK(slots.Get(Kind51, false, 2) == pFirst);
+		CHECK(slots.GetCount() == 1);
+		CHECK(slots.GetAllocationCount() == 1);
+	}
+
+	void Test_Get_Miss()
+	{
+		SpeakerArrangementSlots slots;
+
+		::Vst2SpeakerArrangement* pOutput = slots.Get(Kind51, false, 6);
+		::Vst2SpeakerArrangement* pInput = slots.Get(Kind51, true, 6);
+		::Vst2SpeakerArrangement* pOther = slots.Get(Kind71, false, 8);
+
+		// one arrangement per kind and direction.
+		CHECK(pInput != pOutput);
+		CHECK(pOther != pOutput && pOther != pInput);
+		CHECK(slots.GetCount() == 3);
+		CHECK(slots.GetAllocationCount() == 3);
+
+		CHECK(slots.Get(Kind51, true, 6) == pInput);
+		CHECK(slots.GetAllocationCount() == 3);
+	}
+
+	void Test_Get_Grow()
+	{
+		SpeakerArrangementSlots slots;
+
+		slots.Get(Kind71, false, 8);
+
+		// more channels than the struct declares; all speakers must be writable.
+		::Vst2SpeakerArrangement* pLarge = slots.Get(Kind71, false, 64);
+		CHECK(pLarge != NULL);
+		CHECK(slots.GetCount() == 1);
+		CHECK(slots.GetAllocationCount() == 2);
+
+		for(int32_t i = 0; i < 64; i++)
+		{
+			pLarge->speakers[i].azimuth = (float)i;
+			pLarge->speakers[i].name[0] = 'L';
+		}
+		pLarge->channelCount = 64;
+
+		CHECK(slots.Get(Kind71, false, 32) == pLarge);
+		CHECK(slots.GetAllocationCount() == 2);
+	}
+
+	void Test_Clear()
+	{
+		SpeakerArrangementSlots slots;
+
+		slots.Get(Kind51, false, 6);
+		slots.Get(Kind51, true, 6);
+
+		slots.Clear();
+		CHECK(slots.GetCount() == 0);
+
+		// a cleared kind is allocated again.
+		CHECK(slots.Get(Kind51, false, 6) != NULL);
+		CHECK(slots.GetCount() == 1);
+		CHECK(slots.GetAllocationCount() == 3);
+	}
+
+	void Test_GetSize()
+	{
+		size_t declaredSize = sizeof(::Vst2SpeakerArrangement);
+
+		CHECK(SpeakerArrangementSlots::GetSize(0) == declaredSize);
+		CHECK(SpeakerArrangementSlots::GetSize(8) == declaredSize);
+		CHECK(SpeakerArrangementSlots::GetSize(10) == declaredSize + 2 * sizeof(::Vst2SpeakerProperties));
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Get_Hit),
+		TEST_CASE(Test_Get_Miss),
+		TEST_CASE(Test_Get_Grow),
+		TEST_CASE(Test_Clear),
+		TEST_CASE(Test_GetSize)
+	});
+}
@@ -0,0 +1,183 @@
+// Records spans with TimelineTrace and checks the exported Chrome trace event JSON.
+#include "../Jacobi.Vst.Interop/TimelineTrace.h"
+#include "NativeTest.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+
+namespace
+{
+	// a stand-in for the Vst2Plugin structure that identifies an instance.
+	int g_plugin = 0;
+
+	std::string Export()
+	{
+		std::string json;
+		FILE* pFile = tmpfile();
+		if(pFile == NULL)
+		{
+			return json;
+		}
+
+		CHECK(TimelineTrace::WriteChromeJson(pFile));
+
+		rewind(pFile);
+		char buffer[4096];
+		size_t read;
+		while((read = fread(buffer, 1, sizeof(buffer), pFile)) > 0)
+		{
+			json.append(buffer, read);
+		}
+
+		fclose(pFile);
+		return json;
+	}
+
+	int32_t Count(const std::string& text, const char* pPart)
+	{
+		int32_t count = 0;
+		for(size_t pos = text.find(pPart); pos != std::string::npos; pos = text.find(pPart, pos + 1))
+		{
+			count++;
+		}
+		return count;
+	}
+
+	bool Contains(const std::string& text, const char* pPart)
+	{
+		return text.find(pPart) != std::string::npos;
+	}
+
+	void Test_Record_NestedCallback()
+	{
+		TimelineTrace::SetInstanceName(&g_plugin, "Test \"Synth\"");
+		CHECK(TimelineTrace::Start(100));
+		CHECK(TimelineTrace::IsRecording());
+
+		TimelineTrace::Begin(TimelineSpan::Dispatch, &g_plugin, (int32_t)Vst2PluginCommands::ProcessEvents, 0);
+		TimelineTrace::End(TimelineSpan::Dispatch, &g_plugin, (int32_t)Vst2PluginCommands::ProcessEvents, 1);
+
+		// the plugin asks for the time during process.
+		TimelineTrace::Begin(TimelineSpan::Process32, &g_plugin, 0, 256);
+		TimelineTrace::Begin(TimelineSpan::HostCallback, &g_plugin, (int32_t)Vst2HostCommands::GetTime, 0);
+		TimelineTrace::End(TimelineSpan::HostCallback, &g_plugin, (int32_t)Vst2HostCommands::GetTime, 1234);
+		TimelineTrace::End(TimelineSpan::Process32, &g_plugin, 0, 0);
+
+		TimelineTrace::Begin(TimelineSpan::SetParameter, &g_plugin, 0, 3);
+		TimelineTrace::End(TimelineSpan::SetParameter, &g_plugin, 0, 0);
+
+		TimelineTrace::Stop();
+		CHECK(!TimelineTrace::IsRecording());
+		CHECK(TimelineTrace::GetEventCount() == 8);
+		CHECK(TimelineTrace::GetDroppedCount() == 0);
+
+		// not recorded after Stop.
+		TimelineTrace::Begin(TimelineSpan::Dispatch, &g_plugin, 0, 0);
+		CHECK(TimelineTrace::GetEventCount() == 8);
+
+		std::string json = Export();
+		CHECK(json.compare(0, 16, "{\"traceEvents\":[") == 0);
+		CHECK(Count(json, "\"ph\":\"B\"") == 4);
+		CHECK(Count(json, "\"ph\":\"E\"") == 4);
+		CHECK(Contains(json, "\"name\":\"Dispatch ProcessEvents\",\"cat\":\"dispatch\""));
+		CHECK(Contains(json, "\"name\":\"Process32\",\"cat\":\"process\""));
+		CHECK(Contains(json, "\"name\":\"Callback GetTime\",\"cat\":\"callback\""));
+		CHECK(Contains(json, "\"name\":\"SetParameter\",\"cat\":\"parameter\""));
+		CHECK(Contains(json, "\"instance\":\"Test \\\"Synth\\\"\",\"frames\":256"));
+		CHECK(Contains(json, "\"args\":{\"result\":1234}"));
+		CHECK(Contains(json, "\"droppedEvents\":0"));
+		CHECK(!Contains(json, "truncated"));
+
+		// the callback begins after process began and ends before it ended.
+		size_t process = json.find("Process32");
+		size_t callback = json.find("Callback GetTime");
+		size_t result = json.find("\"result\":1234");
+		size_t parameter = json.find("SetParameter");
+		CHECK(process < callback && callback < result && result < parameter);
+	}
+
+	void Test_Record_Threads()
+	{
+		CHECK(TimelineTrace::Start(100));
+
+		TimelineTrace::Begin(TimelineSpan::Process64, &g_plugin, 0, 64);
+		std::thread other([]()
+		{
+			TimelineTrace::Begin(TimelineSpan::Dispatch, &g_plugin, (int32_t)Vst2PluginCommands::EditorIdle, 0);
+			TimelineTrace::End(TimelineSpan::Dispatch, &g_plugin, (int32_t)Vst2PluginCommands::EditorIdle, 0);
+		});
+		other.join();
+		TimelineTrace::End(TimelineSpan::Process64, &g_plugin, 0, 0);
+		TimelineTrace::Stop();
+
+		std::string json = Export();
+		CHECK(Count(json, "\"ph\":\"B\"") == 2);
+		CHECK(Count(json, "\"ph\":\"E\"") == 2);
+
+		// each call is on its own thread.
+		size_t process = json.find("Process64");
+		size_t idle = json.find("EditorIdle");
+		CHECK(process != std::string::npos && idle != std::string::npos);
+		std::string processTid = json.substr(json.rfind("\"tid\":", process), 12);
+		std::string idleTid = json.substr(json.rfind("\"tid\":", idle), 12);
+		CHECK(processTid != idleTid);
+	}
+
+	void Test_Buffer_Full()
+	{
+		CHECK(TimelineTrace::Start(3));
+
+		TimelineTrace::Begin(TimelineSpan::Process32, &g_plugin, 0, 64);
+		TimelineTrace::Begin(TimelineSpan::HostCallback, &g_plugin, (int32_t)Vst2HostCommands::Automate, 2);
+		TimelineTrace::End(TimelineSpan::HostCallback, &g_plugin, (int32_t)Vst2HostCommands::Automate, 1);
+		TimelineTrace::End(TimelineSpan::Process32, &g_plugin, 0, 0);
+		TimelineTrace::Begin(TimelineSpan::GetParameter, &g_plugin, 0, 1);
+		TimelineTrace::Stop();
+
+		CHECK(TimelineTrace::GetEventCount() == 3);
+		CHECK(TimelineTrace::GetDroppedCount() == 2);
+
+		// the process span that lost its end is closed.
+		std::string json = Export();
+		CHECK(Count(json, "\"ph\":\"B\"") == 2);
+		CHECK(Count(json, "\"ph\":\"E\"") == 2);
+		CHECK(Count(json, "\"truncated\":true") == 1);
+		CHECK(Contains(json, "\"droppedEvents\":2"));
+	}
+
+	void Test_Record_EndBeforeStart()
+	{
+		// a call that was in progress when recording started.
+		CHECK(TimelineTrace::Start(10));
+		TimelineTrace::End(TimelineSpan::Dispatch, &g_plugin, (int32_t)Vst2PluginCommands::Open, 1);
+		TimelineTrace::Begin(TimelineSpan::Dispatch, &g_plugin, 1000, 5);
+		TimelineTrace::End(TimelineSpan::Dispatch, &g_plugin, 1000, 0);
+		TimelineTrace::Stop();
+
+		std::string json = Export();
+		CHECK(Count(json, "\"ph\":\"B\"") == 1);
+		CHECK(Count(json, "\"ph\":\"E\"") == 1);
+		CHECK(Contains(json, "\"name\":\"Dispatch Opcode1000\""));
+		CHECK(Contains(json, "\"index\":5"));
+	}
+
+	void Test_Start_InvalidCapacity()
+	{
+		CHECK(!TimelineTrace::Start(0));
+		CHECK(!TimelineTrace::IsRecording());
+		CHECK(!TimelineTrace::WriteChromeJson(NULL));
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Record_NestedCallback),
+		TEST_CASE(Test_Record_Threads),
+		TEST_CASE(Test_Buffer_Full),
+		TEST_CASE(Test_Record_EndBeforeStart),
+		TEST_CASE(Test_Start_InvalidCapacity)
+	});
+}
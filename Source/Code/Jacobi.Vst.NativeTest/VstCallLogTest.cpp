@@ -0,0 +1,528 @@
+// Records calls with VstCallLogWriter, reads them back and replays them on an in-process fake plugin.
+#include "../Jacobi.Vst.Interop/Host/VstCallLogPlayer.h"
+#include "NativeTest.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	std::string g_outDir;
+
+	std::string LogPath(const char* pName)
+	{
+		return g_outDir + "/" + pName;
+	}
+
+	// a plugin that remembers what it was called with.
+	struct FakePlugin
+	{
+		::Vst2Plugin plugin;
+
+		std::vector<int32_t> commands;
+		float sampleRate;
+		std::string canDo;
+		std::vector<char> chunk;
+		std::vector<::Vst2MidiEvent> midiEvents;
+		std::vector<char> sysExDump;
+		int32_t inputChannels;
+		int32_t outputChannels;
+		float lastSpeakerAzimuth;
+		int32_t bankElementCount;
+		int32_t editorCalls;
+
+		int32_t processCalls;
+		int32_t processDoubleCalls;
+		int32_t sampleFrames;
+		std::vector<float> firstInput;
+		std::vector<double> firstInput64;
+		bool outputsCleared;
+
+		int32_t parameterIndex;
+		float parameterValue;
+		int32_t parameterGets;
+	};
+
+	FakePlugin* GetFake(::Vst2Plugin* pPlugin)
+	{
+		return (FakePlugin*)pPlugin->object;
+	}
+
+	Vst2IntPtr Vst2Handler FakeCommand(::Vst2Plugin* pPlugin, Vst2PluginCommands command, int32_t, Vst2IntPtr value, void* ptr, float opt)
+	{
+		auto pFake = GetFake(pPlugin);
+		pFake->commands.push_back((int32_t)command);
+
+		switch(command)
+		{
+		case Vst2PluginCommands::SampleRateSet:
+			pFake->sampleRate = opt;
+			break;
+		case Vst2PluginCommands::CanDo:
+			pFake->canDo = (const char*)ptr;
+			break;
+		case Vst2PluginCommands::ChunkSet:
+			pFake->chunk.assign((const char*)ptr, (const char*)ptr + value);
+			break;
+		case Vst2PluginCommands::ProcessEvents:
+		{
+			auto pEvents = (::Vst2Events*)ptr;
+			for(int32_t i = 0; i < pEvents->eventCount; i++)
+			{
+				if(pEvents->events[i]->kind == Vst2EventKind::SystemExclusive)
+				{
+					auto pSysEx = (::Vst2MidiSysExEvent*)pEvents->events[i];
+					pFake->sysExDump.assign(pSysEx->dump, pSysEx->dump + pSysEx->dumpInBytes);
+				}
+				else
+				{
+					pFake->midiEvents.push_back(*(::Vst2MidiEvent*)pEvents->events[i]);
+				}
+			}
+			break;
+		}
+		case Vst2PluginCommands::SetSpeakerArrangement:
+		{
+			auto pInput = (::Vst2SpeakerArrangement*)value;
+			auto pOutput = (::Vst2SpeakerArrangement*)ptr;
+			pFake->inputChannels = pInput->channelCount;
+			pFake->outputChannels = pOutput->channelCount;
+			pFake->lastSpeakerAzimuth = pOutput->speakers[pOutput->channelCount - 1].azimuth;
+			pPlugin->inputCount = pInput->channelCount;
+			pPlugin->outputCount = pOutput->channelCount;
+			return 1;
+		}
+		case Vst2PluginCommands::GetSpeakerArrangement:
+			// the host passes pointers that receive the arrangements.
+			*(::Vst2SpeakerArrangement**)value = NULL;
+			*(::Vst2SpeakerArrangement**)ptr = NULL;
+			break;
+		case Vst2PluginCommands::PluginGetName:
+			strcpy((char*)ptr, "Fake");
+			break;
+		case Vst2PluginCommands::BeginLoadBank:
+			pFake->bankElementCount = ((::Vst2PatchChunkInfo*)ptr)->elementCount;
+			break;
+		case Vst2PluginCommands::EditorOpen:
+		case Vst2PluginCommands::EditorIdle:
+		case Vst2PluginCommands::EditorClose:
+			pFake->editorCalls++;
+			break;
+		default:
+			break;
+		}
+
+		return 0;
+	}
+
+	template<typename T>
+	void Capture(FakePlugin* pFake, T** inputs, T** outputs, int32_t sampleFrames, std::vector<T>& firstInput)
+	{
+		pFake->sampleFrames = sampleFrames;
+		firstInput.assign(inputs[0], inputs[0] + sampleFrames);
+
+		for(int32_t i = 0; i < pFake->plugin.outputCount; i++)
+		{
+			for(int32_t n = 0; n < sampleFrames; n++)
+			{
+				pFake->outputsCleared = pFake->outputsCleared && outputs[i][n] == 0;
+				// the player must not reuse inputs as outputs.
+				outputs[i][n] = 1;
+			}
+		}
+	}
+
+	void Vst2Handler FakeProcess(::Vst2Plugin* pPlugin, float** inputs, float** outputs, int32_t sampleFrames)
+	{
+		auto pFake = GetFake(pPlugin);
+		pFake->processCalls++;
+		Capture(pFake, inputs, outputs, sampleFrames, pFake->firstInput);
+	}
+
+	void Vst2Handler FakeProcessDouble(::Vst2Plugin* pPlugin, double** inputs, double** outputs, int32_t sampleFrames)
+	{
+		auto pFake = GetFake(pPlugin);
+		pFake->processDoubleCalls++;
+		Capture(pFake, inputs, outputs, sampleFrames, pFake->firstInput64);
+	}
+
+	void Vst2Handler FakeSetParameter(::Vst2Plugin* pPlugin, int32_t index, float value)
+	{
+		GetFake(pPlugin)->parameterIndex = index;
+		GetFake(pPlugin)->parameterValue = value;
+	}
+
+	float Vst2Handler FakeGetParameter(::Vst2Plugin* pPlugin, int32_t)
+	{
+		GetFake(pPlugin)->parameterGets++;
+		return 0.5f;
+	}
+
+	void InitFake(FakePlugin& fake, int32_t channelCount)
+	{
+		fake = FakePlugin();
+		fake.plugin.VstP = Vst2FourCharacterCode;
+		fake.plugin.command = &FakeCommand;
+		fake.plugin.replace = &FakeProcess;
+		fake.plugin.replaceDouble = &FakeProcessDouble;
+		fake.plugin.parameterSet = &FakeSetParameter;
+		fake.plugin.parameterGet = &FakeGetParameter;
+		fake.plugin.inputCount = channelCount;
+		fake.plugin.outputCount = channelCount;
+		fake.plugin.id = 'Fake';
+		fake.plugin.version = 3;
+		fake.plugin.object = &fake;
+		fake.outputsCleared = true;
+	}
+
+	// more than 8 channels extend past the declared Vst2SpeakerArrangement.
+	std::vector<char> CreateArrangement(int32_t channelCount)
+	{
+		std::vector<char> buffer(sizeof(::Vst2SpeakerArrangement) + (channelCount > 8 ? channelCount - 8 : 0) * sizeof(::Vst2SpeakerProperties));
+		auto pArrangement = (::Vst2SpeakerArrangement*)buffer.data();
+		pArrangement->kind = ArrUserDefined;
+		pArrangement->channelCount = channelCount;
+		pArrangement->speakers[channelCount - 1].azimuth = 1.5f;
+		return buffer;
+	}
+
+	// records a session of every kind of call on a 2 channel plugin.
+	bool RecordSession(const std::string& path, ::Vst2Plugin* pPlugin)
+	{
+		VstCallLogWriter writer;
+		if(!writer.Open(path.c_str(), pPlugin))
+		{
+			return false;
+		}
+
+		writer.WriteDispatch(Vst2PluginCommands::Open, 0, 0, NULL, 0);
+		writer.WriteDispatch(Vst2PluginCommands::SampleRateSet, 0, 0, NULL, 48000.0f);
+		writer.WriteDispatch(Vst2PluginCommands::CanDo, 0, 0, "receiveVstMidiEvent", 0);
+
+		const char chunk[] = { 1, 2, 3, 4, 5 };
+		writer.WriteDispatch(Vst2PluginCommands::ChunkSet, 0, sizeof(chunk), chunk, 0);
+
+		::Vst2PatchChunkInfo chunkInfo = {};
+		chunkInfo.elementCount = 7;
+		writer.WriteDispatch(Vst2PluginCommands::BeginLoadBank, 0, 0, &chunkInfo, 0);
+
+		auto input = CreateArrangement(16);
+		auto output = CreateArrangement(16);
+		writer.WriteDispatch(Vst2PluginCommands::SetSpeakerArrangement, 0, (Vst2IntPtr)input.data(), output.data(), 0);
+		writer.WriteDispatch(Vst2PluginCommands::SetSpeakerArrangement, 0, (Vst2IntPtr)CreateArrangement(2).data(), CreateArrangement(2).data(), 0);
+
+		char name[64] = "overwritten";
+		writer.WriteDispatch(Vst2PluginCommands::PluginGetName, 0, 0, name, 0);
+		::Vst2SpeakerArrangement* pInput = NULL;
+		::Vst2SpeakerArrangement* pOutput = NULL;
+		writer.WriteDispatch(Vst2PluginCommands::GetSpeakerArrangement, 0, (Vst2IntPtr)&pInput, &pOutput, 0);
+
+		int window = 0;
+		writer.WriteDispatch(Vst2PluginCommands::EditorOpen, 0, 0, &window, 0);
+		writer.WriteDispatch(Vst2PluginCommands::EditorIdle, 0, 0, NULL, 0);
+
+		::Vst2MidiEvent noteOn = {};
+		noteOn.kind = Vst2EventKind::Midi;
+		noteOn.sizeInBytes = sizeof(::Vst2MidiEvent);
+		noteOn.deltaFrames = 17;
+		noteOn.midiData[0] = 0x90;
+		noteOn.midiData[1] = 60;
+		noteOn.midiData[2] = 100;
+
+		char dump[] = { (char)0xF0, 0x7E, 0x7F, 0x09, 0x01, (char)0xF7 };
+		::Vst2MidiSysExEvent sysEx = {};
+		sysEx.kind = Vst2EventKind::SystemExclusive;
+		sysEx.sizeInBytes = sizeof(::Vst2MidiSysExEvent);
+		sysEx.dumpInBytes = sizeof(dump);
+		sysEx.dump = dump;
+
+		std::vector<char> eventList(sizeof(::Vst2Events) + 2 * sizeof(::Vst2Event*));
+		auto pEvents = (::Vst2Events*)eventList.data();
+		pEvents->eventCount = 2;
+		pEvents->events[0] = (::Vst2Event*)&noteOn;
+		pEvents->events[1] = (::Vst2Event*)&sysEx;
+		writer.WriteDispatch(Vst2PluginCommands::ProcessEvents, 0, 0, pEvents, 0);
+
+		std::vector<float> left(64), right(64);
+		for(int n = 0; n < 64; n++)
+		{
+			left[n] = n * 0.25f;
+			right[n] = -n * 0.25f;
+		}
+		const float* inputs32[] = { left.data(), right.data() };
+		writer.WriteProcess(inputs32, 2, 2, 64, false);
+
+		std::vector<double> left64(32, 0.25), right64(32, -0.25);
+		const double* inputs64[] = { left64.data(), right64.data() };
+		writer.WriteProcess(inputs64, 2, 2, 32);
+
+		writer.WriteSetParameter(3, 0.75f);
+		writer.WriteGetParameter(3);
+		writer.WriteDispatch(Vst2PluginCommands::Close, 0, 0, NULL, 0);
+
+		return writer.GetRecordCount() == 17;
+	}
+
+	void Test_Writer_RoundTrip()
+	{
+		FakePlugin fake;
+		InitFake(fake, 2);
+		auto path = LogPath("roundtrip.vstlog");
+		CHECK(RecordSession(path, &fake.plugin));
+
+		VstCallLogReader reader;
+		CHECK(reader.Open(path.c_str()));
+		CHECK(reader.GetHeader().pluginId == 'Fake');
+		CHECK(reader.GetHeader().pluginVersion == 3);
+		CHECK(reader.GetHeader().inputCount == 2);
+
+		const VstCallLogRecord* pRecord;
+		const uint8_t* pPayload;
+		std::vector<VstCallLogRecordKind> kinds;
+		std::vector<VstCallLogData> dataKinds;
+		int64_t lastTime = 0;
+
+		while(reader.Next(&pRecord, &pPayload))
+		{
+			kinds.push_back(pRecord->kind);
+			CHECK(pRecord->payloadSize % 8 == 0);
+			CHECK(pRecord->time >= lastTime);
+			lastTime = pRecord->time;
+
+			if(pRecord->kind == VstCallLogRecordKind::Dispatch)
+			{
+				dataKinds.push_back(((const VstCallLogDispatch*)pPayload)->data);
+			}
+			if(pRecord->kind == VstCallLogRecordKind::Process32)
+			{
+				auto pProcess = (const VstCallLogProcess*)pPayload;
+				auto pSamples = (const float*)(pPayload + sizeof(VstCallLogProcess));
+				CHECK(pProcess->inputCount == 2 && pProcess->outputCount == 2 && pProcess->inputFrames == 64);
+				CHECK(pSamples[10] == 2.5f && pSamples[64 + 10] == -2.5f);
+			}
+		}
+
+		CHECK(kinds.size() == 17);
+		CHECK(kinds[12] == VstCallLogRecordKind::Process32);
+		CHECK(kinds[13] == VstCallLogRecordKind::Process64);
+		CHECK(kinds[14] == VstCallLogRecordKind::SetParameter);
+		CHECK(kinds[15] == VstCallLogRecordKind::GetParameter);
+
+		const VstCallLogData expected[] = {
+			VstCallLogData::None, VstCallLogData::None, VstCallLogData::String, VstCallLogData::Bytes,
+			VstCallLogData::Struct, VstCallLogData::SpeakerArrangements, VstCallLogData::SpeakerArrangements,
+			VstCallLogData::Output, VstCallLogData::SpeakerArrangementOutput,
+			VstCallLogData::NotReplayable, VstCallLogData::NotReplayable, VstCallLogData::Events, VstCallLogData::None };
+		CHECK(dataKinds.size() == sizeof(expected) / sizeof(expected[0]));
+		for(size_t i = 0; i < dataKinds.size() && i < sizeof(expected) / sizeof(expected[0]); i++)
+		{
+			CHECK(dataKinds[i] == expected[i]);
+		}
+
+		reader.Rewind();
+		CHECK(reader.Next(&pRecord, &pPayload) && ((const VstCallLogDispatch*)pPayload)->command == (int32_t)Vst2PluginCommands::Open);
+	}
+
+	void Test_Player_ReplaysCalls()
+	{
+		FakePlugin fake;
+		InitFake(fake, 2);
+		auto path = LogPath("replay.vstlog");
+		CHECK(RecordSession(path, &fake.plugin));
+
+		VstCallLogReader reader;
+		CHECK(reader.Open(path.c_str()));
+
+		InitFake(fake, 2);
+		VstCallLogPlayer player;
+		VstCallLogStats stats;
+		player.Play(reader, &fake.plugin, VstCallLogTiming::AsFastAsPossible, &stats);
+
+		// Open, Close and the 2 editor calls are skipped.
+		CHECK(stats.dispatchCount == 9);
+		CHECK(stats.skippedCount == 4);
+		CHECK(stats.processCount == 2);
+		CHECK(stats.parameterCount == 2);
+		CHECK(stats.processNanoseconds.size() == 2);
+		CHECK(fake.editorCalls == 0);
+		CHECK(fake.commands.size() == 9);
+
+		CHECK(fake.sampleRate == 48000.0f);
+		CHECK(fake.canDo == "receiveVstMidiEvent");
+		CHECK(fake.chunk.size() == 5 && fake.chunk[4] == 5);
+		CHECK(fake.bankElementCount == 7);
+		CHECK(fake.inputChannels == 2 && fake.outputChannels == 2);
+
+		CHECK(fake.midiEvents.size() == 1);
+		CHECK(fake.midiEvents.size() == 1 && fake.midiEvents[0].deltaFrames == 17 &&
+			fake.midiEvents[0].midiData[0] == 0x90 && fake.midiEvents[0].midiData[1] == 60);
+		CHECK(fake.sysExDump.size() == 6 && (uint8_t)fake.sysExDump[0] == 0xF0 && (uint8_t)fake.sysExDump[5] == 0xF7);
+
+		CHECK(fake.processCalls == 1 && fake.processDoubleCalls == 1);
+		CHECK(fake.firstInput.size() == 64 && fake.firstInput[10] == 2.5f);
+		CHECK(fake.firstInput64.size() == 32 && fake.firstInput64[0] == 0.25);
+		CHECK(fake.outputsCleared);
+
+		CHECK(fake.parameterIndex == 3 && fake.parameterValue == 0.75f);
+		CHECK(fake.parameterGets == 1);
+	}
+
+	void Test_Player_WideArrangement()
+	{
+		FakePlugin fake;
+		InitFake(fake, 2);
+		auto path = LogPath("arrangement.vstlog");
+
+		VstCallLogWriter writer;
+		CHECK(writer.Open(path.c_str(), &fake.plugin));
+		auto input = CreateArrangement(16);
+		auto output = CreateArrangement(16);
+		writer.WriteDispatch(Vst2PluginCommands::SetSpeakerArrangement, 0, (Vst2IntPtr)input.data(), output.data(), 0);
+		writer.Close();
+
+		VstCallLogReader reader;
+		CHECK(reader.Open(path.c_str()));
+		VstCallLogPlayer player;
+		VstCallLogStats stats;
+		player.Play(reader, &fake.plugin, VstCallLogTiming::AsFastAsPossible, &stats);
+
+		CHECK(fake.inputChannels == 16 && fake.outputChannels == 16);
+		CHECK(fake.lastSpeakerAzimuth == 1.5f);
+	}
+
+	void Test_Player_MoreChannelsThanRecorded()
+	{
+		FakePlugin fake;
+		InitFake(fake, 1);
+		auto path = LogPath("channels.vstlog");
+
+		VstCallLogWriter writer;
+		CHECK(writer.Open(path.c_str(), &fake.plugin));
+		std::vector<float> mono(128, 0.5f);
+		const float* inputs[] = { mono.data() };
+		writer.WriteProcess(inputs, 1, 1, 128, false);
+		writer.Close();
+
+		// the 'upgraded' plugin has 8 channels: the extra channels get silent buffers.
+		InitFake(fake, 8);
+		VstCallLogReader reader;
+		CHECK(reader.Open(path.c_str()));
+		VstCallLogPlayer player;
+		VstCallLogStats stats;
+		player.Play(reader, &fake.plugin, VstCallLogTiming::AsFastAsPossible, &stats);
+
+		CHECK(stats.processCount == 1);
+		CHECK(fake.firstInput.size() == 128 && fake.firstInput[127] == 0.5f);
+		CHECK(fake.outputsCleared);
+	}
+
+	void Test_Player_RecordedTiming()
+	{
+		FakePlugin fake;
+		InitFake(fake, 2);
+		auto path = LogPath("timing.vstlog");
+
+		VstCallLogWriter writer;
+		CHECK(writer.Open(path.c_str(), &fake.plugin));
+		writer.WriteSetParameter(0, 0.0f);
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		writer.WriteSetParameter(0, 1.0f);
+		writer.Close();
+
+		VstCallLogReader reader;
+		CHECK(reader.Open(path.c_str()));
+		VstCallLogPlayer player;
+		VstCallLogStats stats;
+
+		player.Play(reader, &fake.plugin, VstCallLogTiming::Recorded, &stats);
+		CHECK(stats.parameterCount == 2);
+		CHECK(stats.durationNanoseconds >= 20000000);
+
+		reader.Rewind();
+		player.Play(reader, &fake.plugin, VstCallLogTiming::AsFastAsPossible, &stats);
+		CHECK(stats.parameterCount == 2);
+		CHECK(stats.durationNanoseconds < 20000000);
+	}
+
+	void Test_Reader_TruncatedLog()
+	{
+		FakePlugin fake;
+		InitFake(fake, 2);
+		auto path = LogPath("truncated.vstlog");
+		CHECK(RecordSession(path, &fake.plugin));
+
+		VstCallLogReader complete;
+		CHECK(complete.Open(path.c_str()));
+
+		FILE* pFile = fopen(path.c_str(), "rb");
+		std::vector<uint8_t> data(64 * 1024);
+		data.resize(fread(data.data(), 1, data.size(), pFile));
+		fclose(pFile);
+
+		// cut the last record (Close) in half.
+		VstCallLogReader reader;
+		CHECK(reader.Open(data.data(), data.size() - 20));
+
+		const VstCallLogRecord* pRecord;
+		const uint8_t* pPayload;
+		int count = 0;
+		while(reader.Next(&pRecord, &pPayload))
+		{
+			count++;
+		}
+		CHECK(count == 16);
+	}
+
+	void Test_Reader_NotALog()
+	{
+		VstCallLogReader reader;
+		CHECK(!reader.Open(LogPath("does_not_exist.vstlog").c_str()));
+		CHECK(!reader.Open(LogPath("not_a_library.so").c_str()));
+
+		VstCallLogHeader header = {};
+		header.magic = VstCallLogMagic;
+		header.version = VstCallLogVersion + 1;
+		header.pointerSize = sizeof(void*);
+		CHECK(!reader.Open((const uint8_t*)&header, sizeof(header)));
+
+		header.version = VstCallLogVersion;
+		CHECK(reader.Open((const uint8_t*)&header, sizeof(header)));
+
+		const VstCallLogRecord* pRecord;
+		const uint8_t* pPayload;
+		CHECK(!reader.Next(&pRecord, &pPayload));
+	}
+
+	void Test_Writer_NotOpen()
+	{
+		FakePlugin fake;
+		InitFake(fake, 2);
+
+		VstCallLogWriter writer;
+		CHECK(!writer.IsOpen());
+		writer.WriteSetParameter(0, 1.0f);
+		CHECK(writer.GetRecordCount() == 0);
+		CHECK(!writer.Open(LogPath("missing_dir/log.vstlog").c_str(), &fake.plugin));
+		CHECK(!writer.IsOpen());
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	g_outDir = argc > 1 ? argv[1] : ".";
+
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Writer_RoundTrip),
+		TEST_CASE(Test_Player_ReplaysCalls),
+		TEST_CASE(Test_Player_WideArrangement),
+		TEST_CASE(Test_Player_MoreChannelsThanRecorded),
+		TEST_CASE(Test_Player_RecordedTiming),
+		TEST_CASE(Test_Reader_TruncatedLog),
+		TEST_CASE(Test_Reader_NotALog),
+		TEST_CASE(Test_Writer_NotOpen)
+	});
+}
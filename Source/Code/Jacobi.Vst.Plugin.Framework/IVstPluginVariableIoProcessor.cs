@@ -0,0 +1,23 @@
+﻿namespace Jacobi.Vst.Plugin.Framework
+{
+    using Jacobi.Vst.Core;
+
+    /// <summary>
+    /// A plugin implements this interface when it can consume a different number of
+    /// input samples than the number of output samples it produces (offline processing).
+    /// </summary>
+    /// <remarks>Typically implemented by resampling and time-stretching plugins.
+    /// The host keeps track of the input that was not consumed and passes it in again on the next call.</remarks>
+    public interface IVstPluginVariableIoProcessor
+    {
+        /// <summary>
+        /// Called by the host to process the available input into the requested output.
+        /// </summary>
+        /// <param name="inChannels">The audio input. The sample count of the channels is the number of input samples available.</param>
+        /// <param name="outChannels">The audio output. The sample count of the channels is the number of output samples requested.</param>
+        /// <param name="inputSamplesProcessed">Receives the number of input samples consumed.</param>
+        /// <param name="outputSamplesProcessed">Receives the number of output samples produced.</param>
+        /// <returns>Returns true if the call was successful.</returns>
+        bool Process(VstAudioBuffer[] inChannels, VstAudioBuffer[] outChannels, out int inputSamplesProcessed, out int outputSamplesProcessed);
+    }
+}
@@ -7,7 +7,7 @@ namespace Jacobi.Vst.Plugin.Framework.Plugin
     /// <summary>
     /// Implements the VST 2.4 commands for the Framework.
     /// </summary>
-    public class VstPluginCommands : IVstPluginCommands24
+    public class VstPluginCommands : IVstPluginCommands24, IVstPluginCommandsVariableIo
     {
         private readonly VstPluginContext _pluginCtx;
 
@@ -1256,6 +1256,33 @@ namespace Jacobi.Vst.Plugin.Framework.Plugin
 
         #endregion
 
+        #region IVstPluginCommandsVariableIo Members
+
+        /// <summary>
+        /// Called by the host to process a variable number of input samples into a variable number of output samples.
+        /// </summary>
+        /// <param name="inputs">An array with audio input buffers.</param>
+        /// <param name="outputs">An array with audio output buffers.</param>
+        /// <param name="inputSamplesProcessed">Receives the number of input samples the plugin consumed.</param>
+        /// <param name="outputSamplesProcessed">Receives the number of output samples the plugin produced.</param>
+        /// <returns>Returns true if the call was successful.</returns>
+        /// <remarks>The implementation calls the <see cref="IVstPluginVariableIoProcessor"/> interface.</remarks>
+        public virtual bool ProcessVariableIo(VstAudioBuffer[] inputs, VstAudioBuffer[] outputs, out int inputSamplesProcessed, out int outputSamplesProcessed)
+        {
+            var variableIoProcessor = _pluginCtx.Plugin.GetInstance<IVstPluginVariableIoProcessor>();
+
+            if (variableIoProcessor != null)
+            {
+                return variableIoProcessor.Process(inputs, outputs, out inputSamplesProcessed, out outputSamplesProcessed);
+            }
+
+            inputSamplesProcessed = 0;
+            outputSamplesProcessed = 0;
+            return false;
+        }
+
+        #endregion
+
         #region IVstPluginCommandsBase Members
 
         /// <summary>
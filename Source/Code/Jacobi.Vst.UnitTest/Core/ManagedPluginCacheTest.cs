@@ -0,0 +1,123 @@
+﻿using FluentAssertions;
+using Jacobi.Vst.Core;
+using Jacobi.Vst.Core.Plugin;
+using Microsoft.Extensions.Configuration;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.IO;
+
+namespace Jacobi.Vst.UnitTest.Core
+{
+    [TestClass]
+    public class ManagedPluginCacheTest
+    {
+        private class StubPluginCommandStub : IVstPluginCommandStub
+        {
+            public VstPluginInfo GetPluginInfo(IVstHostCommandProxy hostCmdProxy) => null;
+
+            public IConfiguration PluginConfiguration { get; set; }
+
+            public IVstPluginCommands24 Commands => null;
+        }
+
+        // counts the assembly loads instead of loading a plugin assembly.
+        private class StubManagedPluginCache : ManagedPluginCache
+        {
+            public int LoadCount { get; private set; }
+
+            protected override Func<IVstPluginCommandStub> LoadCommandStubFactory(string interopAssemblyPath)
+            {
+                LoadCount++;
+                return () => new StubPluginCommandStub();
+            }
+        }
+
+        private string _pluginFolder;
+
+        [TestInitialize]
+        public void Setup()
+        {
+            _pluginFolder = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            Directory.CreateDirectory(_pluginFolder);
+
+            File.WriteAllText(Path.Combine(_pluginFolder, "TestPlugin.appsettings.json"),
+                "{ \"Gain\": \"0.5\", \"Editor\": { \"Width\": \"400\" } }");
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            Directory.Delete(_pluginFolder, true);
+        }
+
+        [TestMethod]
+        public void Test_ManagedPluginCache_LoadsOncePerPath()
+        {
+            var cache = new StubManagedPluginCache();
+            var pluginPath = Path.Combine(_pluginFolder, "TestPlugin.dll");
+
+            var first = cache.CreatePluginCommandStub(pluginPath);
+            var second = cache.CreatePluginCommandStub(pluginPath.ToUpperInvariant());
+
+            first.Should().NotBeSameAs(second);
+            cache.LoadCount.Should().Be(1);
+            cache.Count.Should().Be(1);
+
+            cache.CreatePluginCommandStub(Path.Combine(_pluginFolder, "OtherPlugin.dll"));
+            cache.LoadCount.Should().Be(2);
+            cache.Count.Should().Be(2);
+        }
+
+        [TestMethod]
+        public void Test_ManagedPluginCache_ReadsSettings()
+        {
+            var cache = new StubManagedPluginCache();
+
+            var config = cache.CreatePluginCommandStub(Path.Combine(_pluginFolder, "TestPlugin.dll")).PluginConfiguration;
+
+            config["Gain"].Should().Be("0.5");
+            config.GetSection("Editor")["Width"].Should().Be("400");
+        }
+
+        [TestMethod]
+        public void Test_ManagedPluginCache_ConfigurationPerInstance()
+        {
+            var cache = new StubManagedPluginCache();
+            var pluginPath = Path.Combine(_pluginFolder, "TestPlugin.dll");
+
+            var first = cache.CreatePluginCommandStub(pluginPath).PluginConfiguration;
+            var second = cache.CreatePluginCommandStub(pluginPath).PluginConfiguration;
+            first.Should().NotBeSameAs(second);
+
+            // a change made by one instance is not seen by the others.
+            first["Gain"] = "1.0";
+            first["Added"] = "yes";
+            second["Gain"].Should().Be("0.5");
+            second["Added"].Should().BeNull();
+            cache.CreatePluginCommandStub(pluginPath).PluginConfiguration["Gain"].Should().Be("0.5");
+        }
+
+        [TestMethod]
+        public void Test_ManagedPluginCache_SettingsReadOnce()
+        {
+            var cache = new StubManagedPluginCache();
+            var pluginPath = Path.Combine(_pluginFolder, "TestPlugin.dll");
+
+            cache.CreatePluginCommandStub(pluginPath);
+            File.Delete(Path.Combine(_pluginFolder, "TestPlugin.appsettings.json"));
+
+            cache.CreatePluginCommandStub(pluginPath).PluginConfiguration["Gain"].Should().Be("0.5");
+        }
+
+        [TestMethod]
+        public void Test_ManagedPluginCache_NoSettingsFile()
+        {
+            var cache = new StubManagedPluginCache();
+
+            var config = cache.CreatePluginCommandStub(Path.Combine(_pluginFolder, "OtherPlugin.dll")).PluginConfiguration;
+
+            config.Should().NotBeNull();
+            config["Gain"].Should().BeNull();
+        }
+    }
+}
@@ -106,5 +106,20 @@ namespace Jacobi.Vst.UnitTest.Interop.Host
             counter.Should().Be(_bufferCount);
             bufferMgr.Buffers.Should().HaveCount(_bufferCount);
         }
+
+        [TestMethod]
+        public void Test_VstAudioBufferManager_LockMemory()
+        {
+            using (var bufferMgr = CreateNew(_testValue))
+            {
+                bufferMgr.LockMemory().Should().BeTrue();
+                bufferMgr.IsMemoryLocked.Should().BeTrue();
+
+                AssertAllBuffersHasValue(bufferMgr, _testValue);
+
+                bufferMgr.UnlockMemory();
+                bufferMgr.IsMemoryLocked.Should().BeFalse();
+            }
+        }
     }
 }
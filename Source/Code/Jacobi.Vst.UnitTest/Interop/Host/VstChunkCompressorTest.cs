@@ -0,0 +1,63 @@
+﻿
+using FluentAssertions;
+using Jacobi.Vst.Host.Interop;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System.IO;
+
+namespace Jacobi.Vst.UnitTest.Interop.Host
+{
+    [TestClass]
+    public class VstChunkCompressorTest
+    {
+        private static byte[] CreateChunk(int length)
+        {
+            var chunk = new byte[length];
+            for (int i = 0; i < length; i++)
+            {
+                chunk[i] = (byte)((i / 16) % 7);
+            }
+            return chunk;
+        }
+
+        [TestMethod]
+        public void Test_VstChunkCompressor_RoundTrip()
+        {
+            var chunk = CreateChunk(64 * 1024);
+
+            var data = VstChunkCompressor.Compress(chunk);
+
+            VstChunkCompressor.IsCompressed(data).Should().BeTrue();
+            VstChunkCompressor.GetUncompressedLength(data).Should().Be(chunk.Length);
+            data.Length.Should().BeLessThan(chunk.Length / 5);
+
+            VstChunkCompressor.Decompress(data).Should().Equal(chunk);
+        }
+
+        [TestMethod]
+        public void Test_VstChunkCompressor_Empty_RoundTrip()
+        {
+            var data = VstChunkCompressor.Compress(new byte[0]);
+
+            VstChunkCompressor.Decompress(data).Should().BeEmpty();
+        }
+
+        [TestMethod]
+        public void Test_VstChunkCompressor_RawData_PassesThrough()
+        {
+            var chunk = CreateChunk(100);
+
+            VstChunkCompressor.IsCompressed(chunk).Should().BeFalse();
+            VstChunkCompressor.Decompress(chunk).Should().BeSameAs(chunk);
+        }
+
+        [TestMethod]
+        public void Test_VstChunkCompressor_Truncated_Throws()
+        {
+            var data = VstChunkCompressor.Compress(CreateChunk(4096));
+            System.Array.Resize(ref data, data.Length - 1);
+
+            System.Action act = () => VstChunkCompressor.Decompress(data);
+            act.Should().Throw<InvalidDataException>();
+        }
+    }
+}
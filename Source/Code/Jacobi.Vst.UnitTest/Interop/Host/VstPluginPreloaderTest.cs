@@ -0,0 +1,40 @@
+﻿using FluentAssertions;
+using Jacobi.Vst.Host.Interop;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System.IO;
+using System.Reflection;
+
+namespace Jacobi.Vst.UnitTest.Interop.Host
+{
+    [TestClass]
+    public class VstPluginPreloaderTest
+    {
+        [TestMethod]
+        public void Test_VstPluginPreloader_ReportsStatusPerPath()
+        {
+            var notaPluginFile = Assembly.GetExecutingAssembly().Location;
+            var missingFile = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName() + ".dll");
+            var paths = new[] { notaPluginFile, missingFile, notaPluginFile };
+
+            using (var preloader = VstPluginPreloader.Preload(paths, 2))
+            {
+                preloader.PluginPaths.Should().Equal(paths);
+                preloader.Status.Should().Equal(
+                    VstPluginPreloadStatus.EntryPointNotFound,
+                    VstPluginPreloadStatus.LoadFailed,
+                    VstPluginPreloadStatus.EntryPointNotFound);
+                preloader.LoadedCount.Should().Be(0);
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstPluginPreloader_Empty()
+        {
+            using (var preloader = VstPluginPreloader.Preload(new string[0]))
+            {
+                preloader.Status.Should().BeEmpty();
+                preloader.LoadedCount.Should().Be(0);
+            }
+        }
+    }
+}
@@ -0,0 +1,192 @@
+﻿
+using FluentAssertions;
+using Jacobi.Vst.Host.Interop;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.IO;
+
+namespace Jacobi.Vst.UnitTest.Interop.Host
+{
+    [TestClass]
+    public class VstPresetFileTest
+    {
+        private const int _pluginId = 0x4A565354;
+        private const int _pluginVersion = 1200;
+        private const int _programCount = 3;
+        private const int _parameterCount = 4;
+
+        private static float GetValue(int program, int parameter)
+        {
+            return (program * _parameterCount + parameter) / 16.0f;
+        }
+
+        [TestMethod]
+        public void Test_VstPresetFile_Bank_RoundTrip()
+        {
+            var path = Path.GetTempFileName();
+            try
+            {
+                using (var stream = File.Create(path))
+                {
+                    var writer = new VstPresetFileWriter(stream);
+                    writer.BeginBank(_pluginId, _pluginVersion, _programCount, _parameterCount, 1);
+
+                    for (int p = 0; p < _programCount; p++)
+                    {
+                        var values = new float[_parameterCount];
+                        for (int i = 0; i < _parameterCount; i++)
+                        {
+                            values[i] = GetValue(p, i);
+                        }
+
+                        writer.WriteBankProgram("Program " + p, values);
+                    }
+
+                    writer.EndBank();
+                }
+
+                using (var reader = new VstPresetFileReader(path))
+                {
+                    reader.FileType.Should().Be(VstPresetFileType.Bank);
+                    reader.PluginID.Should().Be(_pluginId);
+                    reader.PluginVersion.Should().Be(_pluginVersion);
+                    reader.ProgramCount.Should().Be(_programCount);
+                    reader.ParameterCount.Should().Be(_parameterCount);
+                    reader.CurrentProgram.Should().Be(1);
+
+                    for (int p = 0; p < _programCount; p++)
+                    {
+                        reader.GetProgramName(p).Should().Be("Program " + p);
+
+                        var values = reader.ReadParameters(p);
+                        for (int i = 0; i < _parameterCount; i++)
+                        {
+                            values[i].Should().Be(GetValue(p, i));
+                        }
+                    }
+                }
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstPresetFile_ProgramChunk_RoundTrip()
+        {
+            var path = Path.GetTempFileName();
+            var chunk = new byte[] { 1, 2, 3, 4, 5, 6, 7 };
+            try
+            {
+                using (var stream = File.Create(path))
+                {
+                    var writer = new VstPresetFileWriter(stream);
+                    writer.WriteProgramChunk(_pluginId, _pluginVersion, "Chunk", chunk);
+                }
+
+                using (var reader = new VstPresetFileReader(path))
+                {
+                    reader.FileType.Should().Be(VstPresetFileType.ProgramChunk);
+                    reader.GetProgramName(0).Should().Be("Chunk");
+
+                    using (var chunkStream = reader.OpenChunk())
+                    {
+                        var data = new byte[chunkStream.Length];
+                        chunkStream.Read(data, 0, data.Length);
+                        data.Should().Equal(chunk);
+                    }
+                }
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstPresetFile_EndBank_Incomplete_Throws()
+        {
+            using (var stream = new MemoryStream())
+            {
+                var writer = new VstPresetFileWriter(stream);
+                writer.BeginBank(_pluginId, _pluginVersion, _programCount, _parameterCount, 0);
+
+                writer.Invoking(w => w.EndBank()).Should().Throw<System.InvalidOperationException>();
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstPresetFile_EndBank_NotStarted_Throws()
+        {
+            using (var stream = new MemoryStream())
+            {
+                var writer = new VstPresetFileWriter(stream);
+
+                writer.Invoking(w => w.EndBank()).Should().Throw<System.InvalidOperationException>()
+                    .WithMessage("No bank was started.");
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstPresetFile_Program_NaN_RoundTrip()
+        {
+            var path = Path.GetTempFileName();
+            // a signaling NaN that must come back with the same bits.
+            var nan = BitConverter.Int32BitsToSingle(0x7F800001);
+            try
+            {
+                using (var stream = File.Create(path))
+                {
+                    var writer = new VstPresetFileWriter(stream);
+                    writer.WriteProgram(_pluginId, _pluginVersion, "NaN", new[] { nan, 0.5f });
+                }
+
+                using (var reader = new VstPresetFileReader(path))
+                {
+                    var values = reader.ReadParameters(0);
+                    BitConverter.SingleToInt32Bits(values[0]).Should().Be(0x7F800001);
+                    values[1].Should().Be(0.5f);
+                }
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstPresetFile_Bank_HugeCounts_Throws()
+        {
+            var path = Path.GetTempFileName();
+            try
+            {
+                // a bank header followed by one program header, both claiming the maximum counts.
+                var data = new byte[156 + 56];
+                WriteBigEndian(data, 0, 0x43636E4B);        // CcnK
+                WriteBigEndian(data, 8, 0x4678426B);        // FxBk
+                WriteBigEndian(data, 12, 1);
+                WriteBigEndian(data, 24, int.MaxValue);     // programCount
+                WriteBigEndian(data, 156, 0x43636E4B);
+                WriteBigEndian(data, 164, 0x4678436B);      // FxCk
+                WriteBigEndian(data, 180, int.MaxValue);    // parameterCount
+                File.WriteAllBytes(path, data);
+
+                Action open = () => new VstPresetFileReader(path).Dispose();
+                open.Should().Throw<InvalidDataException>();
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        private static void WriteBigEndian(byte[] data, int offset, int value)
+        {
+            data[offset] = (byte)(value >> 24);
+            data[offset + 1] = (byte)(value >> 16);
+            data[offset + 2] = (byte)(value >> 8);
+            data[offset + 3] = (byte)value;
+        }
+    }
+}
@@ -0,0 +1,258 @@
+﻿using FluentAssertions;
+using Jacobi.Vst.Core;
+using Jacobi.Vst.Core.Host;
+using Jacobi.Vst.Host.Interop;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Linq;
+using System.Reflection;
+
+namespace Jacobi.Vst.UnitTest.Interop.Host
+{
+    [TestClass]
+    public class VstVariableIoProcessorTest
+    {
+        private const int Capacity = 256;
+
+        // the commands of a (managed) plugin that only implements variable io.
+        public interface IVariableIoCommands : IVstPluginCommands24, IVstPluginCommandsVariableIo
+        { }
+
+        public delegate bool VariableIoHandler(VstAudioBuffer[] inputs, VstAudioBuffer[] outputs, out int inputProcessed, out int outputProcessed);
+
+        public class VariableIoCommandsProxy : DispatchProxy
+        {
+            public VariableIoHandler Handler { get; set; }
+
+            protected override object Invoke(MethodInfo targetMethod, object[] args)
+            {
+                if (targetMethod.Name != nameof(IVstPluginCommandsVariableIo.ProcessVariableIo))
+                {
+                    throw new NotImplementedException(targetMethod.Name);
+                }
+
+                var result = Handler((VstAudioBuffer[])args[0], (VstAudioBuffer[])args[1], out int inputProcessed, out int outputProcessed);
+                args[2] = inputProcessed;
+                args[3] = outputProcessed;
+                return result;
+            }
+        }
+
+        private class StubPluginCommandStub : IVstPluginCommandStub
+        {
+            public StubPluginCommandStub(VariableIoHandler handler)
+            {
+                var commands = DispatchProxy.Create<IVariableIoCommands, VariableIoCommandsProxy>();
+                ((VariableIoCommandsProxy)(object)commands).Handler = handler;
+                Commands = commands;
+            }
+
+            public IVstPluginContext PluginContext { get; set; }
+
+            public IVstPluginCommands24 Commands { get; }
+        }
+
+        // produces one output sample for every factor input samples (the first of each group).
+        private static VariableIoHandler Decimate(int factor)
+        {
+            return (VstAudioBuffer[] inputs, VstAudioBuffer[] outputs, out int inputProcessed, out int outputProcessed) =>
+            {
+                outputProcessed = Math.Min(outputs[0].SampleCount, inputs[0].SampleCount / factor);
+                inputProcessed = outputProcessed * factor;
+
+                for (int c = 0; c < outputs.Length; c++)
+                {
+                    for (int i = 0; i < outputProcessed; i++)
+                    {
+                        outputs[c][i] = inputs[c][i * factor];
+                    }
+                }
+                return true;
+            };
+        }
+
+        // produces factor output samples for every input sample.
+        private static VariableIoHandler Repeat(int factor)
+        {
+            return (VstAudioBuffer[] inputs, VstAudioBuffer[] outputs, out int inputProcessed, out int outputProcessed) =>
+            {
+                inputProcessed = Math.Min(inputs[0].SampleCount, outputs[0].SampleCount / factor);
+                outputProcessed = inputProcessed * factor;
+
+                for (int c = 0; c < outputs.Length; c++)
+                {
+                    for (int i = 0; i < outputProcessed; i++)
+                    {
+                        outputs[c][i] = inputs[c][i / factor];
+                    }
+                }
+                return true;
+            };
+        }
+
+        // writes count samples per channel: channel * 1000 + first + index.
+        private static int WriteRamp(VstVariableIoProcessor processor, int first, int count)
+        {
+            using (var inputMgr = new VstAudioBufferManager(processor.InputCount, count))
+            {
+                var inputs = inputMgr.Buffers.ToArray();
+                for (int c = 0; c < inputs.Length; c++)
+                {
+                    for (int i = 0; i < count; i++)
+                    {
+                        inputs[c][i] = c * 1000 + first + i;
+                    }
+                }
+
+                return processor.Write(inputs);
+            }
+        }
+
+        private static float[] Read(VstAudioBuffer buffer, int count)
+        {
+            return Enumerable.Range(0, count).Select(i => buffer[i]).ToArray();
+        }
+
+        private static float[] Ramp(int channel, int first, int count, int step)
+        {
+            return Enumerable.Range(0, count).Select(i => (float)(channel * 1000 + first + i * step)).ToArray();
+        }
+
+        [TestMethod]
+        public void Test_VstVariableIoProcessor_MoreInputThanOutput()
+        {
+            using (var processor = new VstVariableIoProcessor(new StubPluginCommandStub(Decimate(2)), 2, Capacity))
+            using (var outputMgr = new VstAudioBufferManager(2, 64))
+            {
+                var outputs = outputMgr.Buffers.ToArray();
+
+                WriteRamp(processor, 0, 100).Should().Be(100);
+                processor.PendingInputCount.Should().Be(100);
+
+                processor.Process(outputs).Should().Be(50);
+                processor.PendingInputCount.Should().Be(0);
+                processor.TotalInputProcessed.Should().Be(100);
+                processor.TotalOutputProcessed.Should().Be(50);
+
+                Read(outputs[0], 50).Should().Equal(Ramp(0, 0, 50, 2));
+                Read(outputs[1], 50).Should().Equal(Ramp(1, 0, 50, 2));
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstVariableIoProcessor_MoreOutputThanInput()
+        {
+            using (var processor = new VstVariableIoProcessor(new StubPluginCommandStub(Repeat(3)), 1, Capacity))
+            using (var outputMgr = new VstAudioBufferManager(1, 64))
+            {
+                var outputs = outputMgr.Buffers.ToArray();
+
+                WriteRamp(processor, 0, 10);
+
+                processor.Process(outputs).Should().Be(30);
+                processor.PendingInputCount.Should().Be(0);
+                processor.TotalInputProcessed.Should().Be(10);
+                processor.TotalOutputProcessed.Should().Be(30);
+
+                Read(outputs[0], 6).Should().Equal(0f, 0f, 0f, 1f, 1f, 1f);
+                outputs[0][29].Should().Be(9f);
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstVariableIoProcessor_PendingInputCarriesOver()
+        {
+            using (var processor = new VstVariableIoProcessor(new StubPluginCommandStub(Decimate(2)), 2, Capacity))
+            using (var outputMgr = new VstAudioBufferManager(2, 20))
+            {
+                var outputs = outputMgr.Buffers.ToArray();
+
+                // the output limits the call: 40 of the 101 input samples are consumed.
+                WriteRamp(processor, 0, 101);
+                processor.Process(outputs).Should().Be(20);
+                processor.PendingInputCount.Should().Be(61);
+
+                // the next call continues where the plugin stopped.
+                processor.Process(outputs).Should().Be(20);
+                Read(outputs[0], 20).Should().Equal(Ramp(0, 40, 20, 2));
+                Read(outputs[1], 20).Should().Equal(Ramp(1, 40, 20, 2));
+
+                // the odd sample stays pending until more input arrives.
+                processor.Process(outputs).Should().Be(10);
+                processor.PendingInputCount.Should().Be(1);
+
+                WriteRamp(processor, 101, 3);
+                processor.Process(outputs).Should().Be(2);
+                Read(outputs[0], 2).Should().Equal(100f, 102f);
+                processor.PendingInputCount.Should().Be(0);
+                processor.TotalInputProcessed.Should().Be(104);
+                processor.TotalOutputProcessed.Should().Be(52);
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstVariableIoProcessor_WriteCompactsAndLimits()
+        {
+            using (var processor = new VstVariableIoProcessor(new StubPluginCommandStub(Decimate(2)), 1, Capacity))
+            using (var outputMgr = new VstAudioBufferManager(1, 50))
+            {
+                var outputs = outputMgr.Buffers.ToArray();
+
+                WriteRamp(processor, 0, 200);
+                processor.Process(outputs).Should().Be(50);
+                processor.PendingInputCount.Should().Be(100);
+
+                // does not fit behind the pending input: moved to the front, then limited by the capacity.
+                WriteRamp(processor, 200, 200).Should().Be(Capacity - 100);
+                processor.PendingInputCount.Should().Be(Capacity);
+
+                processor.Process(outputs).Should().Be(50);
+                Read(outputs[0], 50).Should().Equal(Ramp(0, 100, 50, 2));
+
+                processor.Clear();
+                processor.PendingInputCount.Should().Be(0);
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstVariableIoProcessor_ReportedCountsAreClamped()
+        {
+            VariableIoHandler overreporting = (VstAudioBuffer[] inputs, VstAudioBuffer[] outputs, out int inputProcessed, out int outputProcessed) =>
+            {
+                inputProcessed = inputs[0].SampleCount + 10;
+                outputProcessed = outputs[0].SampleCount + 10;
+                return true;
+            };
+
+            using (var processor = new VstVariableIoProcessor(new StubPluginCommandStub(overreporting), 1, Capacity))
+            using (var outputMgr = new VstAudioBufferManager(1, 16))
+            {
+                WriteRamp(processor, 0, 8);
+
+                processor.Process(outputMgr.Buffers.ToArray()).Should().Be(16);
+                processor.TotalInputProcessed.Should().Be(8);
+                processor.PendingInputCount.Should().Be(0);
+            }
+        }
+
+        [TestMethod]
+        public void Test_VstVariableIoProcessor_PluginFails()
+        {
+            VariableIoHandler failing = (VstAudioBuffer[] inputs, VstAudioBuffer[] outputs, out int inputProcessed, out int outputProcessed) =>
+            {
+                inputProcessed = 0;
+                outputProcessed = 0;
+                return false;
+            };
+
+            using (var processor = new VstVariableIoProcessor(new StubPluginCommandStub(failing), 1, Capacity))
+            using (var outputMgr = new VstAudioBufferManager(1, 16))
+            {
+                WriteRamp(processor, 0, 8);
+
+                processor.Process(outputMgr.Buffers.ToArray()).Should().Be(-1);
+                processor.PendingInputCount.Should().Be(8);
+            }
+        }
+    }
+}
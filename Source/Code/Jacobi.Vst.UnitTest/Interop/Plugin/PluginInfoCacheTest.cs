@@ -0,0 +1,159 @@
+﻿using FluentAssertions;
+using Jacobi.Vst.Core;
+using Jacobi.Vst.Core.Legacy;
+using Jacobi.Vst.Core.Plugin;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.IO;
+using System.Reflection;
+
+namespace Jacobi.Vst.UnitTest.Interop.Plugin
+{
+    [TestClass]
+    public class PluginInfoCacheTest
+    {
+        // PluginInfoCache is internal to the (strong named) plugin interop assembly.
+        private static readonly Type CacheType =
+            Type.GetType("Jacobi.Vst.Plugin.Interop.PluginInfoCache, Jacobi.Vst.Plugin.Interop", true);
+
+        // answers the scan queries PluginInfoCache.Save asks for.
+        public class ScanCommandsProxy : DispatchProxy
+        {
+            protected override object Invoke(MethodInfo targetMethod, object[] args)
+            {
+                switch (targetMethod.Name)
+                {
+                    case nameof(IVstPluginCommands24.GetEffectName): return "Test Effect";
+                    case nameof(IVstPluginCommands24.GetVendorString): return "Test Vendor";
+                    case nameof(IVstPluginCommands24.GetProductString): return null;
+                    case nameof(IVstPluginCommands24.GetVendorVersion): return 1234;
+                    case nameof(IVstPluginCommands24.GetCategory): return VstPluginCategory.Synth;
+                    case nameof(IVstPluginCommands24.GetVstVersion): return 2400;
+                }
+                throw new NotImplementedException(targetMethod.Name);
+            }
+        }
+
+        private string _pluginFolder;
+        private string _cacheFolder;
+        private string _pluginPath;
+        private string _assemblyPath;
+
+        [TestInitialize]
+        public void Setup()
+        {
+            _pluginFolder = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            _cacheFolder = Path.Combine(_pluginFolder, "cache");
+            Directory.CreateDirectory(_pluginFolder);
+
+            // the interop file and the managed plugin assembly next to it.
+            _pluginPath = Path.Combine(_pluginFolder, "TestPlugin.dll");
+            _assemblyPath = Path.Combine(_pluginFolder, "TestPlugin.net.dll");
+            File.WriteAllBytes(_pluginPath, new byte[] { 1, 2, 3 });
+            File.WriteAllBytes(_assemblyPath, new byte[] { 4, 5, 6, 7 });
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            Directory.Delete(_pluginFolder, true);
+        }
+
+        private static VstPluginInfo CreatePluginInfo()
+        {
+            return new VstPluginInfo
+            {
+                Flags = VstPluginFlags.CanReplacing | VstPluginFlags.IsSynth,
+                ProgramCount = 8,
+                ParameterCount = 12,
+                AudioInputCount = 0,
+                AudioOutputCount = 2,
+                InitialDelay = 64,
+                PluginID = 0x54455354,
+                PluginVersion = 1001,
+                ProcessBlockSize = 256
+            };
+        }
+
+        private void Save(VstPluginInfo pluginInfo)
+        {
+            var commands = DispatchProxy.Create<IVstPluginCommands24, ScanCommandsProxy>();
+
+            CacheType.GetMethod("Save", new[] { typeof(string), typeof(VstPluginInfo), typeof(IVstPluginCommands24), typeof(string) })
+                .Invoke(null, new object[] { _pluginPath, pluginInfo, commands, _cacheFolder });
+        }
+
+        private object Load()
+        {
+            return CacheType.GetMethod("Load", new[] { typeof(string), typeof(string) })
+                .Invoke(null, new object[] { _pluginPath, _cacheFolder });
+        }
+
+        private static object Get(object cache, string propertyName)
+        {
+            return CacheType.GetProperty(propertyName).GetValue(cache);
+        }
+
+        [TestMethod]
+        public void Test_PluginInfoCache_RoundTrip()
+        {
+            Load().Should().BeNull();
+
+            Save(CreatePluginInfo());
+            var cache = Load();
+
+            cache.Should().NotBeNull();
+            Get(cache, "PluginInfo").Should().BeEquivalentTo(CreatePluginInfo());
+            Get(cache, "EffectName").Should().Be("Test Effect");
+            Get(cache, "VendorString").Should().Be("Test Vendor");
+            Get(cache, "ProductString").Should().BeNull();
+            Get(cache, "VendorVersion").Should().Be(1234);
+            Get(cache, "Category").Should().Be((int)VstPluginCategory.Synth);
+            Get(cache, "VstVersion").Should().Be(2400);
+        }
+
+        [TestMethod]
+        public void Test_PluginInfoCache_InvalidatedWhenAssemblyChanges()
+        {
+            Save(CreatePluginInfo());
+            Load().Should().NotBeNull();
+
+            File.WriteAllBytes(_assemblyPath, new byte[] { 4, 5, 6, 7, 8 });
+
+            Load().Should().BeNull();
+        }
+
+        [TestMethod]
+        public void Test_PluginInfoCache_InvalidatedWhenWriteTimeChanges()
+        {
+            Save(CreatePluginInfo());
+            Load().Should().NotBeNull();
+
+            // same size, other stamp.
+            File.SetLastWriteTimeUtc(_assemblyPath, File.GetLastWriteTimeUtc(_assemblyPath).AddMinutes(-5));
+
+            Load().Should().BeNull();
+        }
+
+        [TestMethod]
+        public void Test_PluginInfoCache_CorruptFile()
+        {
+            Save(CreatePluginInfo());
+
+            var cacheFile = Directory.GetFiles(_cacheFolder)[0];
+            var data = File.ReadAllBytes(cacheFile);
+            File.WriteAllBytes(cacheFile, data.AsSpan(0, data.Length / 2).ToArray());
+
+            Load().Should().BeNull();
+        }
+
+        [TestMethod]
+        public void Test_PluginInfoCache_LegacyInfoNotCached()
+        {
+            Save(new VstPluginLegacyInfo());
+
+            Directory.Exists(_cacheFolder).Should().BeFalse();
+            Load().Should().BeNull();
+        }
+    }
+}
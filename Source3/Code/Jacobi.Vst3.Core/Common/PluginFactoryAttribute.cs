@@ -0,0 +1,25 @@
+﻿using System;
+
+namespace Jacobi.Vst3.Core.Common
+{
+    /// <summary>
+    /// Identifies the <see cref="IPluginFactory"/> implementation of a plugin assembly.
+    /// </summary>
+    /// <remarks>The interop assembly uses this attribute to find the factory
+    /// without scanning all types of the plugin assembly.</remarks>
+    [AttributeUsage(AttributeTargets.Assembly, AllowMultiple = false)]
+    public sealed class PluginFactoryAttribute : Attribute
+    {
+        public PluginFactoryAttribute(Type factoryType)
+        {
+            if (factoryType == null)
+            {
+                throw new ArgumentNullException(nameof(factoryType));
+            }
+
+            FactoryType = factoryType;
+        }
+
+        public Type FactoryType { get; private set; }
+    }
+}
@@ -0,0 +1,94 @@
+﻿using System;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+
+namespace Jacobi.Vst3.Host
+{
+    /// <summary>
+    /// A <see cref="Jacobi.Vst3.Core.IBStream"/> over a memory-mapped file, for very large plugin states.
+    /// </summary>
+    /// <remarks>The capacity is fixed when the instance is created; writing past it fails.
+    /// The pages are only committed when the plugin touches them.
+    /// A file is truncated to the length of the content when the stream is disposed.</remarks>
+    public sealed unsafe class MappedFileBStream : UnmanagedMemoryBStream
+    {
+        private MemoryMappedFile _file;
+        private MemoryMappedViewAccessor _view;
+        private readonly string _path;
+
+        /// <summary>
+        /// Creates a stream backed by the paging file.
+        /// </summary>
+        public MappedFileBStream(long capacity)
+            : this(MemoryMappedFile.CreateNew(null, capacity), capacity, 0)
+        { }
+
+        /// <summary>
+        /// Creates a stream over the file at <paramref name="path"/>. An existing file is loaded as content.
+        /// </summary>
+        public MappedFileBStream(string path, long capacity)
+            : this(OpenFile(path, capacity, out var length), capacity, length)
+        {
+            _path = path;
+        }
+
+        private MappedFileBStream(MemoryMappedFile file, long capacity, long length)
+        {
+            _file = file;
+            _view = file.CreateViewAccessor(0, capacity);
+
+            byte* ptr = null;
+            _view.SafeMemoryMappedViewHandle.AcquirePointer(ref ptr);
+
+            Buffer = ptr + _view.PointerOffset;
+            Capacity = capacity;
+
+            SetContentLength(length);
+        }
+
+        private static MemoryMappedFile OpenFile(string path, long capacity, out long length)
+        {
+            length = File.Exists(path) ? new FileInfo(path).Length : 0;
+
+            if (length > capacity)
+            {
+                throw new ArgumentOutOfRangeException(nameof(capacity));
+            }
+
+            return MemoryMappedFile.CreateFromFile(path, FileMode.OpenOrCreate, null, capacity);
+        }
+
+        protected override bool Reserve(long size)
+        {
+            return size <= Capacity;
+        }
+
+        protected override void Dispose(bool disposing)
+        {
+            if (disposing)
+            {
+                long length = Length;
+
+                if (_view != null)
+                {
+                    _view.SafeMemoryMappedViewHandle.ReleasePointer();
+                    _view.Dispose();
+                    _view = null;
+                }
+                if (_file != null)
+                {
+                    _file.Dispose();
+                    _file = null;
+
+                    if (_path != null)
+                    {
+                        using var stream = new FileStream(_path, FileMode.Open, FileAccess.Write);
+                        stream.SetLength(length);
+                    }
+                }
+            }
+
+            base.Dispose(disposing);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace Jacobi.Vst3.Host
+{
+    /// <summary>
+    /// A growable <see cref="Jacobi.Vst3.Core.IBStream"/> on the unmanaged heap.
+    /// </summary>
+    /// <remarks>Reuse one instance for getState/setState calls: the memory is kept after <see cref="UnmanagedMemoryBStream.Clear"/>.</remarks>
+    public sealed unsafe class MemoryBStream : UnmanagedMemoryBStream
+    {
+        private const long MinimumCapacity = 4096;
+
+        public MemoryBStream()
+            : this(MinimumCapacity)
+        { }
+
+        public MemoryBStream(long initialCapacity)
+        {
+            if (initialCapacity < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(initialCapacity));
+            }
+
+            Reserve(Math.Max(initialCapacity, MinimumCapacity));
+        }
+
+        ~MemoryBStream()
+        {
+            Dispose(false);
+        }
+
+        protected override bool Reserve(long size)
+        {
+            if (size <= Capacity)
+            {
+                return true;
+            }
+
+            long capacity = Math.Max(size, Capacity * 2);
+
+            try
+            {
+                var ptr = Buffer == null ?
+                    Marshal.AllocHGlobal(new IntPtr(capacity)) :
+                    Marshal.ReAllocHGlobal(new IntPtr(Buffer), new IntPtr(capacity));
+
+                GC.AddMemoryPressure(capacity - Capacity);
+                Buffer = (byte*)ptr.ToPointer();
+                Capacity = capacity;
+                return true;
+            }
+            catch (OutOfMemoryException)
+            {
+                return false;
+            }
+        }
+
+        protected override void Dispose(bool disposing)
+        {
+            if (Buffer != null)
+            {
+                Marshal.FreeHGlobal(new IntPtr(Buffer));
+                GC.RemoveMemoryPressure(Capacity);
+            }
+
+            base.Dispose(disposing);
+        }
+    }
+}
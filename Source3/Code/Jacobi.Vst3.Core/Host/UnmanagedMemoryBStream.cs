@@ -0,0 +1,229 @@
+﻿using Jacobi.Vst3.Core;
+using System;
+using System.Runtime.InteropServices;
+
+namespace Jacobi.Vst3.Host
+{
+    /// <summary>
+    /// Base class for <see cref="IBStream"/> implementations over a block of unmanaged memory.
+    /// </summary>
+    /// <remarks>The plugin reads and writes the memory directly; the host accesses
+    /// the content through <see cref="AsSpan"/> without copying.</remarks>
+    [ClassInterface(ClassInterfaceType.None)]
+    public abstract unsafe class UnmanagedMemoryBStream : IBStream, ISizeableStream, IDisposable
+    {
+        private long _length;
+        private long _position;
+
+        protected UnmanagedMemoryBStream()
+        { }
+
+        /// <summary>
+        /// Gets the start of the memory. Can change when <see cref="Reserve"/> is called.
+        /// </summary>
+        protected byte* Buffer { get; set; }
+
+        /// <summary>
+        /// Gets the number of bytes available at <see cref="Buffer"/>.
+        /// </summary>
+        protected long Capacity { get; set; }
+
+        /// <summary>
+        /// Makes sure at least <paramref name="size"/> bytes are available.
+        /// </summary>
+        /// <returns>Returns false when the memory cannot grow.</returns>
+        protected abstract bool Reserve(long size);
+
+        /// <summary>
+        /// Sets the length of content already present in the memory.
+        /// </summary>
+        protected void SetContentLength(long length)
+        {
+            if (length < 0 || length > Capacity)
+            {
+                throw new ArgumentOutOfRangeException(nameof(length));
+            }
+
+            _length = length;
+        }
+
+        public long Length
+        {
+            get { return _length; }
+        }
+
+        public long Position
+        {
+            get { return _position; }
+            set
+            {
+                if (value < 0)
+                {
+                    throw new ArgumentOutOfRangeException(nameof(value));
+                }
+                _position = value;
+            }
+        }
+
+        /// <summary>
+        /// Returns the content of the stream.
+        /// </summary>
+        public Span<byte> AsSpan()
+        {
+            if (_length > Int32.MaxValue)
+            {
+                throw new InvalidOperationException("The stream is too large for a span.");
+            }
+
+            return new Span<byte>(Buffer, (int)_length);
+        }
+
+        /// <summary>
+        /// Sets the content of the stream to <paramref name="data"/> and rewinds it.
+        /// </summary>
+        public void Load(ReadOnlySpan<byte> data)
+        {
+            if (!Reserve(data.Length))
+            {
+                throw new OutOfMemoryException();
+            }
+
+            data.CopyTo(new Span<byte>(Buffer, data.Length));
+            _length = data.Length;
+            _position = 0;
+        }
+
+        /// <summary>
+        /// Empties the stream. The memory is kept.
+        /// </summary>
+        public void Clear()
+        {
+            _length = 0;
+            _position = 0;
+        }
+
+        public void Dispose()
+        {
+            Dispose(true);
+            GC.SuppressFinalize(this);
+        }
+
+        protected virtual void Dispose(bool disposing)
+        {
+            Buffer = null;
+            Capacity = 0;
+            Clear();
+        }
+
+        #region IBStream Members
+
+        public int Read(IntPtr buffer, int numBytes, ref int numBytesRead)
+        {
+            if (numBytes < 0)
+            {
+                return TResult.E_InvalidArg;
+            }
+
+            long available = Math.Max(0, _length - _position);
+            int count = (int)Math.Min(numBytes, available);
+
+            if (count > 0)
+            {
+                System.Buffer.MemoryCopy(Buffer + _position, buffer.ToPointer(), numBytes, count);
+                _position += count;
+            }
+
+            numBytesRead = count;
+            return TResult.S_OK;
+        }
+
+        public int Write(IntPtr buffer, int numBytes, ref int numBytesWritten)
+        {
+            if (numBytes < 0)
+            {
+                return TResult.E_InvalidArg;
+            }
+
+            long end = _position + numBytes;
+            if (end > Capacity && !Reserve(end))
+            {
+                numBytesWritten = 0;
+                return TResult.E_OutOfMemory;
+            }
+
+            // zero a gap left by seeking past the end
+            ClearRange(_length, _position);
+
+            System.Buffer.MemoryCopy(buffer.ToPointer(), Buffer + _position, Capacity - _position, numBytes);
+            _position = end;
+            _length = Math.Max(_length, end);
+
+            numBytesWritten = numBytes;
+            return TResult.S_OK;
+        }
+
+        public int Seek(long pos, StreamSeekMode mode, ref long result)
+        {
+            long newPosition = mode switch
+            {
+                StreamSeekMode.SeekSet => pos,
+                StreamSeekMode.SeekCur => _position + pos,
+                StreamSeekMode.SeekEnd => _length + pos,
+                _ => -1,
+            };
+
+            if (newPosition < 0)
+            {
+                return TResult.E_InvalidArg;
+            }
+
+            _position = newPosition;
+            result = newPosition;
+            return TResult.S_OK;
+        }
+
+        public int Tell(ref long pos)
+        {
+            pos = _position;
+            return TResult.S_OK;
+        }
+
+        #endregion
+
+        private void ClearRange(long start, long end)
+        {
+            while (start < end)
+            {
+                int count = (int)Math.Min(end - start, Int32.MaxValue);
+                new Span<byte>(Buffer + start, count).Clear();
+                start += count;
+            }
+        }
+
+        #region ISizeableStream Members
+
+        public int GetStreamSize(ref long size)
+        {
+            size = _length;
+            return TResult.S_OK;
+        }
+
+        public int SetStreamSize(long size)
+        {
+            if (size < 0)
+            {
+                return TResult.E_InvalidArg;
+            }
+            if (size > Capacity && !Reserve(size))
+            {
+                return TResult.E_OutOfMemory;
+            }
+
+            ClearRange(_length, size);
+            _length = size;
+            return TResult.S_OK;
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,236 @@
+﻿using Jacobi.Vst3.Core;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.InteropServices;
+
+namespace Jacobi.Vst3.Host
+{
+    /// <summary>
+    /// A loaded VST3 module (bundle or single binary) and its plugin factory.
+    /// </summary>
+    /// <remarks>The binary is loaded with <see cref="NativeLibrary"/>.
+    /// The module entry (InitDll/ModuleEntry) is called on load and the exit (ExitDll/ModuleExit) on dispose.
+    /// Loading is Windows only: the factory is wrapped by the built-in COM interop, which other platforms do not have.
+    /// <see cref="GetBinaryPath"/> follows the bundle layout of every platform.</remarks>
+    public sealed class Vst3Module : IDisposable
+    {
+        [UnmanagedFunctionPointer(Platform.DefaultCallingConvention)]
+        private delegate IntPtr GetPluginFactoryProc();
+
+        [UnmanagedFunctionPointer(Platform.DefaultCallingConvention)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        private delegate bool InitModuleProc();
+
+        [UnmanagedFunctionPointer(Platform.DefaultCallingConvention)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        private delegate bool ModuleEntryProc(IntPtr handle);
+
+        [UnmanagedFunctionPointer(Platform.DefaultCallingConvention)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        private delegate bool ExitModuleProc();
+
+        private IntPtr _handle;
+        private IPluginFactory _factory;
+        private ExitModuleProc _exitModule;
+
+        private Vst3Module(string bundlePath, string binaryPath)
+        {
+            BundlePath = bundlePath;
+            BinaryPath = binaryPath;
+        }
+
+        /// <summary>
+        /// Loads the VST3 module at <paramref name="bundlePath"/>.
+        /// </summary>
+        /// <param name="bundlePath">The path to a .vst3 bundle folder or a .vst3 binary.</param>
+        /// <exception cref="FileNotFoundException">Thrown when the binary is not found.</exception>
+        /// <exception cref="InvalidOperationException">Thrown when the module does not initialize or has no factory.</exception>
+        /// <exception cref="PlatformNotSupportedException">Thrown when not running on Windows.</exception>
+        public static Vst3Module Load(string bundlePath)
+        {
+            if (!RuntimeInformation.IsOSPlatform(OSPlatform.Windows))
+            {
+                throw new PlatformNotSupportedException("Loading VST3 modules requires the COM interop of Windows.");
+            }
+
+            var binaryPath = GetBinaryPath(bundlePath);
+            var module = new Vst3Module(bundlePath, binaryPath);
+
+            try
+            {
+                module.Initialize();
+                return module;
+            }
+            catch
+            {
+                module.Dispose();
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// Gets the path the module was loaded from.
+        /// </summary>
+        public string BundlePath { get; private set; }
+
+        /// <summary>
+        /// Gets the path of the binary inside the bundle.
+        /// </summary>
+        public string BinaryPath { get; private set; }
+
+        /// <summary>
+        /// Gets the plugin factory of the module.
+        /// </summary>
+        public IPluginFactory Factory
+        {
+            get
+            {
+                if (_factory == null) throw new ObjectDisposedException(nameof(Vst3Module));
+                return _factory;
+            }
+        }
+
+        /// <summary>
+        /// Returns the information of all classes exported by the factory.
+        /// </summary>
+        public IReadOnlyList<PClassInfo> GetClassInfos()
+        {
+            var count = Factory.CountClasses();
+            var infos = new List<PClassInfo>(count);
+
+            for (int i = 0; i < count; i++)
+            {
+                var info = new PClassInfo();
+                if (TResult.Succeeded(_factory.GetClassInfo(i, ref info)))
+                {
+                    infos.Add(info);
+                }
+            }
+
+            return infos;
+        }
+
+        /// <summary>
+        /// Returns the path of the binary for the <paramref name="bundlePath"/>, following the VST3 bundle layout.
+        /// </summary>
+        public static string GetBinaryPath(string bundlePath)
+        {
+            if (String.IsNullOrEmpty(bundlePath))
+            {
+                throw new ArgumentNullException(nameof(bundlePath));
+            }
+
+            if (File.Exists(bundlePath))
+            {
+                return bundlePath;
+            }
+
+            var name = Path.GetFileNameWithoutExtension(bundlePath.TrimEnd(Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar));
+            string binaryPath;
+
+            if (RuntimeInformation.IsOSPlatform(OSPlatform.Windows))
+            {
+                binaryPath = Path.Combine(bundlePath, "Contents", GetArchitectureName() + "-win", name + ".vst3");
+            }
+            else if (RuntimeInformation.IsOSPlatform(OSPlatform.Linux))
+            {
+                binaryPath = Path.Combine(bundlePath, "Contents", GetArchitectureName() + "-linux", name + ".so");
+            }
+            else
+            {
+                binaryPath = Path.Combine(bundlePath, "Contents", "MacOS", name);
+            }
+
+            if (!File.Exists(binaryPath))
+            {
+                throw new FileNotFoundException("The VST3 module binary was not found.", binaryPath);
+            }
+
+            return binaryPath;
+        }
+
+        private static string GetArchitectureName()
+        {
+            return RuntimeInformation.ProcessArchitecture switch
+            {
+                Architecture.X86 => "x86",
+                Architecture.Arm64 => "aarch64",
+                Architecture.Arm => "armv7l",
+                _ => "x86_64",
+            };
+        }
+
+        private void Initialize()
+        {
+            _handle = NativeLibrary.Load(BinaryPath);
+
+            if (NativeLibrary.TryGetExport(_handle, "InitDll", out var initDll))
+            {
+                if (!Marshal.GetDelegateForFunctionPointer<InitModuleProc>(initDll)())
+                {
+                    throw new InvalidOperationException($"InitDll failed for '{BinaryPath}'.");
+                }
+                _exitModule = GetExport<ExitModuleProc>("ExitDll");
+            }
+            else if (NativeLibrary.TryGetExport(_handle, "ModuleEntry", out var moduleEntry))
+            {
+                if (!Marshal.GetDelegateForFunctionPointer<ModuleEntryProc>(moduleEntry)(_handle))
+                {
+                    throw new InvalidOperationException($"ModuleEntry failed for '{BinaryPath}'.");
+                }
+                _exitModule = GetExport<ExitModuleProc>("ModuleExit");
+            }
+
+            var getPluginFactory = GetExport<GetPluginFactoryProc>("GetPluginFactory");
+            if (getPluginFactory == null)
+            {
+                throw new InvalidOperationException($"'{BinaryPath}' does not export GetPluginFactory.");
+            }
+
+            var factoryPtr = getPluginFactory();
+            if (factoryPtr == IntPtr.Zero)
+            {
+                throw new InvalidOperationException($"'{BinaryPath}' did not return a plugin factory.");
+            }
+
+            try
+            {
+                _factory = (IPluginFactory)Marshal.GetObjectForIUnknown(factoryPtr);
+            }
+            finally
+            {
+                // GetPluginFactory returned a reference for us.
+                Marshal.Release(factoryPtr);
+            }
+        }
+
+        private T GetExport<T>(string name) where T : Delegate
+        {
+            if (NativeLibrary.TryGetExport(_handle, name, out var ptr))
+            {
+                return Marshal.GetDelegateForFunctionPointer<T>(ptr);
+            }
+
+            return null;
+        }
+
+        public void Dispose()
+        {
+            if (_factory != null)
+            {
+                Marshal.ReleaseComObject(_factory);
+                _factory = null;
+            }
+
+            if (_handle != IntPtr.Zero)
+            {
+                _exitModule?.Invoke();
+                _exitModule = null;
+
+                NativeLibrary.Free(_handle);
+                _handle = IntPtr.Zero;
+            }
+        }
+    }
+}
@@ -0,0 +1,251 @@
+﻿using Jacobi.Vst3.Core;
+using System;
+using System.Collections.Generic;
+using System.IO;
+
+namespace Jacobi.Vst3.Host
+{
+    /// <summary>
+    /// Persists the class information of scanned VST3 modules, so they do not have to be loaded again.
+    /// </summary>
+    /// <remarks>An entry is keyed on the bundle path and is valid as long as the size and
+    /// modification time of the module binary do not change. Call <see cref="Save"/> after scanning.</remarks>
+    public sealed class Vst3ModuleCache
+    {
+        // 'V3MC' and format version
+        private const int CacheFileMagic = 0x434D3356;
+        private const int CacheFileVersion = 1;
+
+        private readonly Dictionary<string, Entry> _entries =
+            new Dictionary<string, Entry>(StringComparer.OrdinalIgnoreCase);
+        private bool _isDirty;
+
+        private sealed class Entry
+        {
+            public long Size;
+            public long LastWriteTime;
+            public PClassInfo[] Classes;
+        }
+
+        public Vst3ModuleCache()
+            : this(DefaultFilePath)
+        { }
+
+        public Vst3ModuleCache(string filePath)
+        {
+            FilePath = filePath;
+        }
+
+        /// <summary>
+        /// Gets the default location: %LocalAppData%\VST.NET\Vst3ModuleCache.bin.
+        /// </summary>
+        public static string DefaultFilePath
+        {
+            get
+            {
+                return Path.Combine(
+                    Environment.GetFolderPath(Environment.SpecialFolder.LocalApplicationData),
+                    "VST.NET", "Vst3ModuleCache.bin");
+            }
+        }
+
+        public string FilePath { get; private set; }
+
+        /// <summary>
+        /// Gets the number of cached modules.
+        /// </summary>
+        public int Count
+        {
+            get { return _entries.Count; }
+        }
+
+        /// <summary>
+        /// Reads the cache file. A missing or corrupt file results in an empty cache.
+        /// </summary>
+        public void Load()
+        {
+            _entries.Clear();
+            _isDirty = false;
+
+            if (!File.Exists(FilePath)) return;
+
+            try
+            {
+                using var reader = new BinaryReader(File.OpenRead(FilePath));
+
+                if (reader.ReadInt32() != CacheFileMagic ||
+                    reader.ReadInt32() != CacheFileVersion)
+                {
+                    return;
+                }
+
+                var count = reader.ReadInt32();
+                for (int i = 0; i < count; i++)
+                {
+                    var path = reader.ReadString();
+                    var entry = new Entry
+                    {
+                        Size = reader.ReadInt64(),
+                        LastWriteTime = reader.ReadInt64(),
+                        Classes = new PClassInfo[reader.ReadInt32()]
+                    };
+
+                    for (int c = 0; c < entry.Classes.Length; c++)
+                    {
+                        entry.Classes[c].ClassId = new Guid(reader.ReadBytes(16));
+                        entry.Classes[c].Cardinality = reader.ReadInt32();
+                        entry.Classes[c].Category = reader.ReadString();
+                        entry.Classes[c].Name = reader.ReadString();
+                    }
+
+                    _entries[path] = entry;
+                }
+            }
+            catch (Exception)
+            {
+                // corrupt or unreadable: scan again.
+                _entries.Clear();
+            }
+        }
+
+        /// <summary>
+        /// Writes the cache file when entries were added or removed.
+        /// </summary>
+        /// <returns>Returns false when the file could not be written; the cache stays dirty.</returns>
+        public bool Save()
+        {
+            if (!_isDirty) return true;
+
+            // write a temporary file first: a crash must not leave a truncated cache.
+            var tempPath = FilePath + ".tmp";
+
+            try
+            {
+                Directory.CreateDirectory(Path.GetDirectoryName(FilePath));
+                Write(tempPath);
+                File.Move(tempPath, FilePath, true);
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                // the modules are just scanned again next time.
+                try { File.Delete(tempPath); }
+                catch (Exception) { }
+
+                return false;
+            }
+
+            _isDirty = false;
+            return true;
+        }
+
+        private void Write(string path)
+        {
+            using (var writer = new BinaryWriter(File.Create(path)))
+            {
+                writer.Write(CacheFileMagic);
+                writer.Write(CacheFileVersion);
+                writer.Write(_entries.Count);
+
+                foreach (var pair in _entries)
+                {
+                    writer.Write(pair.Key);
+                    writer.Write(pair.Value.Size);
+                    writer.Write(pair.Value.LastWriteTime);
+                    writer.Write(pair.Value.Classes.Length);
+
+                    foreach (var info in pair.Value.Classes)
+                    {
+                        writer.Write(info.ClassId.ToByteArray());
+                        writer.Write(info.Cardinality);
+                        writer.Write(info.Category ?? String.Empty);
+                        writer.Write(info.Name ?? String.Empty);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns the cached classes of the module when its binary has not changed.
+        /// </summary>
+        public bool TryGetClassInfos(string bundlePath, out IReadOnlyList<PClassInfo> classInfos)
+        {
+            classInfos = null;
+
+            if (!_entries.TryGetValue(GetKey(bundlePath), out var entry)) return false;
+
+            FileInfo binary;
+            try
+            {
+                binary = new FileInfo(Vst3Module.GetBinaryPath(bundlePath));
+            }
+            catch (FileNotFoundException)
+            {
+                return false;
+            }
+
+            if (binary.Length != entry.Size || binary.LastWriteTimeUtc.Ticks != entry.LastWriteTime)
+            {
+                return false;
+            }
+
+            classInfos = entry.Classes;
+            return true;
+        }
+
+        /// <summary>
+        /// Returns the classes of the module, loading and scanning it only when the cache is out of date.
+        /// </summary>
+        public IReadOnlyList<PClassInfo> GetClassInfos(string bundlePath)
+        {
+            if (TryGetClassInfos(bundlePath, out var classInfos))
+            {
+                return classInfos;
+            }
+
+            using var module = Vst3Module.Load(bundlePath);
+            return Add(bundlePath, module.GetClassInfos());
+        }
+
+        /// <summary>
+        /// Stores the classes of the module, for the current size and modification time of its binary.
+        /// </summary>
+        /// <remarks>For hosts that scan the module themselves, for instance in a separate process.</remarks>
+        public IReadOnlyList<PClassInfo> Add(string bundlePath, IReadOnlyList<PClassInfo> classInfos)
+        {
+            if (classInfos == null) throw new ArgumentNullException(nameof(classInfos));
+
+            var binary = new FileInfo(Vst3Module.GetBinaryPath(bundlePath));
+            var entry = new Entry
+            {
+                Size = binary.Length,
+                LastWriteTime = binary.LastWriteTimeUtc.Ticks,
+                Classes = new PClassInfo[classInfos.Count]
+            };
+
+            for (int i = 0; i < classInfos.Count; i++)
+            {
+                entry.Classes[i] = classInfos[i];
+            }
+
+            _entries[GetKey(bundlePath)] = entry;
+            _isDirty = true;
+
+            return entry.Classes;
+        }
+
+        /// <summary>
+        /// Removes the entry for the module.
+        /// </summary>
+        public bool Remove(string bundlePath)
+        {
+            var removed = _entries.Remove(GetKey(bundlePath));
+            _isDirty |= removed;
+            return removed;
+        }
+
+        private static string GetKey(string bundlePath)
+        {
+            return Path.GetFullPath(bundlePath).TrimEnd(Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar);
+        }
+    }
+}
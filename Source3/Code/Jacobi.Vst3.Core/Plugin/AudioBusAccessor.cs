@@ -1,16 +1,21 @@
 ﻿using Jacobi.Vst3.Common;
 using Jacobi.Vst3.Core;
 using System;
-using System.Runtime.InteropServices;
 
 namespace Jacobi.Vst3.Plugin
 {
-    public class AudioBusAccessor
+    /// <summary>
+    /// Provides access to the audio buffers of one bus in the <see cref="ProcessData"/>.
+    /// </summary>
+    /// <remarks>The accessor points directly into the (native) bus array of the host.
+    /// Nothing is copied or allocated and changes to the silence flags are seen by the host.
+    /// Only use an instance during the process call it was created in.</remarks>
+    public unsafe readonly struct AudioBusAccessor
     {
         private readonly SymbolicSampleSizes _sampleSize;
         private readonly BusDirections _busDir;
         private readonly int _numSamples;
-        private AudioBusBuffers _audioBuffers;
+        private readonly AudioBusBuffers* _audioBuffers;
 
         public AudioBusAccessor(ref ProcessData processData, BusDirections busDir, int busIndex)
         {
@@ -20,23 +25,21 @@ namespace Jacobi.Vst3.Plugin
 
             if (busDir == BusDirections.Input)
             {
-                Guard.ThrowIfOutOfRange("busIndex", busIndex, 0, processData.NumInputs);
+                Guard.ThrowIfOutOfRange("busIndex", busIndex, 0, processData.NumInputs - 1);
 
-                InitializeAudioBuffers(processData.Inputs, busIndex);
+                _audioBuffers = GetAudioBuffers(processData.Inputs, busIndex);
             }
             else
             {
-                Guard.ThrowIfOutOfRange("busIndex", busIndex, 0, processData.NumOutputs);
+                Guard.ThrowIfOutOfRange("busIndex", busIndex, 0, processData.NumOutputs - 1);
 
-                InitializeAudioBuffers(processData.Outputs, busIndex);
+                _audioBuffers = GetAudioBuffers(processData.Outputs, busIndex);
             }
         }
 
-        private void InitializeAudioBuffers(IntPtr arrayPtr, int index)
+        private static AudioBusBuffers* GetAudioBuffers(IntPtr arrayPtr, int index)
         {
-            IntPtr bufferPtr = IntPtr.Add(arrayPtr, index * AudioBusBuffers.Size);
-
-            _audioBuffers = (AudioBusBuffers)Marshal.PtrToStructure(bufferPtr, typeof(AudioBusBuffers));
+            return (AudioBusBuffers*)IntPtr.Add(arrayPtr, index * AudioBusBuffers.Size).ToPointer();
         }
 
         public BusDirections BusDirection
@@ -56,59 +59,80 @@ namespace Jacobi.Vst3.Plugin
 
         public int ChannelCount
         {
-            get { return _audioBuffers.NumChannels; }
+            get { return _audioBuffers->NumChannels; }
+        }
+
+        /// <summary>
+        /// Gets or sets the silence flags (one bit per channel) of the bus.
+        /// </summary>
+        public ulong SilenceFlags
+        {
+            get { return _audioBuffers->SilenceFlags; }
+            set { _audioBuffers->SilenceFlags = value; }
         }
 
         public bool IsChannelSilent(int channelIndex)
         {
-            Guard.ThrowIfOutOfRange("channel", channelIndex, 0, _audioBuffers.NumChannels);
+            ThrowIfInvalidChannel(channelIndex);
 
-            return (_audioBuffers.SilenceFlags & (ulong)(1 << channelIndex)) != 0;
+            return (_audioBuffers->SilenceFlags & GetChannelMask(channelIndex)) != 0;
         }
 
         public void SetChannelSilent(int channelIndex, bool silent)
         {
-            Guard.ThrowIfOutOfRange("channel", channelIndex, 0, _audioBuffers.NumChannels);
+            ThrowIfInvalidChannel(channelIndex);
 
-            ulong mask = (ulong)(1 << channelIndex);
+            ulong mask = GetChannelMask(channelIndex);
 
             // reset (not-silent)
-            _audioBuffers.SilenceFlags &= ~mask;
+            _audioBuffers->SilenceFlags &= ~mask;
 
             if (silent)
             {
                 // set
-                _audioBuffers.SilenceFlags |= mask;
+                _audioBuffers->SilenceFlags |= mask;
             }
         }
 
-        public int Read32(int channelIndex, float[] buffer, int length)
+        /// <summary>
+        /// Returns the 32 bit sample buffer of the channel, also when it is flagged silent.
+        /// </summary>
+        /// <returns>Returns an empty span when the host did not provide buffers.</returns>
+        public Span<float> GetChannel32(int channelIndex)
         {
-            if (length > _numSamples)
-            {
-                length = _numSamples;
-            }
-            if (length > buffer.Length)
+            ThrowIfNotSampleSize(SymbolicSampleSizes.Sample32);
+            ThrowIfInvalidChannel(channelIndex);
+
+            if (_audioBuffers->ChannelBuffers32 == IntPtr.Zero)
             {
-                length = buffer.Length;
+                return Span<float>.Empty;
             }
 
-            unsafe
-            {
-                float* ptr = GetUnsafeBuffer32(channelIndex);
+            float** ptr = (float**)_audioBuffers->ChannelBuffers32.ToPointer();
+            return new Span<float>(ptr[channelIndex], _numSamples);
+        }
 
-                if (ptr != null)
-                {
-                    for (int i = 0; i < length; i++)
-                    {
-                        buffer[i] = ptr[i];
-                    }
+        /// <summary>
+        /// Returns the 64 bit sample buffer of the channel, also when it is flagged silent.
+        /// </summary>
+        /// <returns>Returns an empty span when the host did not provide buffers.</returns>
+        public Span<double> GetChannel64(int channelIndex)
+        {
+            ThrowIfNotSampleSize(SymbolicSampleSizes.Sample64);
+            ThrowIfInvalidChannel(channelIndex);
 
-                    return length;
-                }
+            if (_audioBuffers->ChannelBuffers64 == IntPtr.Zero)
+            {
+                return Span<double>.Empty;
             }
 
-            return 0;
+            double** ptr = (double**)_audioBuffers->ChannelBuffers64.ToPointer();
+            return new Span<double>(ptr[channelIndex], _numSamples);
+        }
+
+        public int Read32(int channelIndex, float[] buffer, int length)
+        {
+            return Read(GetUnsafeBuffer32(channelIndex), buffer, length);
         }
 
         public int Write32(int channelIndex, float[] buffer, int length)
@@ -117,60 +141,13 @@ namespace Jacobi.Vst3.Plugin
             {
                 return 0;
             }
-            if (length > _numSamples)
-            {
-                length = _numSamples;
-            }
-            if (length > buffer.Length)
-            {
-                length = buffer.Length;
-            }
-
-            unsafe
-            {
-                float* ptr = GetUnsafeBuffer32(channelIndex);
 
-                if (ptr != null)
-                {
-                    for (int i = 0; i < length; i++)
-                    {
-                        ptr[i] = buffer[i];
-                    }
-
-                    return length;
-                }
-            }
-
-            return 0;
+            return Write(GetUnsafeBuffer32(channelIndex), buffer, length);
         }
 
         public int Read64(int channelIndex, double[] buffer, int length)
         {
-            if (length > _numSamples)
-            {
-                length = _numSamples;
-            }
-            if (length > buffer.Length)
-            {
-                length = buffer.Length;
-            }
-
-            unsafe
-            {
-                double* ptr = GetUnsafeBuffer64(channelIndex);
-
-                if (ptr != null)
-                {
-                    for (int i = 0; i < length; i++)
-                    {
-                        buffer[i] = ptr[i];
-                    }
-
-                    return length;
-                }
-            }
-
-            return 0;
+            return Read(GetUnsafeBuffer64(channelIndex), buffer, length);
         }
 
         public int Write64(int channelIndex, double[] buffer, int length)
@@ -179,45 +156,19 @@ namespace Jacobi.Vst3.Plugin
             {
                 return 0;
             }
-            if (length > _numSamples)
-            {
-                length = _numSamples;
-            }
-            if (length > buffer.Length)
-            {
-                length = buffer.Length;
-            }
 
-            unsafe
-            {
-                double* ptr = GetUnsafeBuffer64(channelIndex);
-
-                if (ptr != null)
-                {
-                    for (int i = 0; i < length; i++)
-                    {
-                        ptr[i] = buffer[i];
-                    }
-
-                    return length;
-                }
-            }
-
-            return 0;
+            return Write(GetUnsafeBuffer64(channelIndex), buffer, length);
         }
 
-        public unsafe float* GetUnsafeBuffer32(int channelIndex)
+        public float* GetUnsafeBuffer32(int channelIndex)
         {
-            if (_sampleSize != SymbolicSampleSizes.Sample32)
-            {
-                throw new InvalidOperationException("32 bit sample size is not supported.");
-            }
-            Guard.ThrowIfOutOfRange("channel", channelIndex, 0, _audioBuffers.NumChannels);
+            ThrowIfNotSampleSize(SymbolicSampleSizes.Sample32);
+            ThrowIfInvalidChannel(channelIndex);
 
-            if (_audioBuffers.ChannelBuffers32 != IntPtr.Zero &&
+            if (_audioBuffers->ChannelBuffers32 != IntPtr.Zero &&
                 !IsChannelSilent(channelIndex))
             {
-                float** ptr = (float**)_audioBuffers.ChannelBuffers32.ToPointer();
+                float** ptr = (float**)_audioBuffers->ChannelBuffers32.ToPointer();
 
                 return ptr[channelIndex];
             }
@@ -225,23 +176,58 @@ namespace Jacobi.Vst3.Plugin
             return null;
         }
 
-        public unsafe double* GetUnsafeBuffer64(int channelIndex)
+        public double* GetUnsafeBuffer64(int channelIndex)
         {
-            if (_sampleSize != SymbolicSampleSizes.Sample64)
-            {
-                throw new InvalidOperationException("64 bit sample size is not supported.");
-            }
-            Guard.ThrowIfOutOfRange("channel", channelIndex, 0, _audioBuffers.NumChannels);
+            ThrowIfNotSampleSize(SymbolicSampleSizes.Sample64);
+            ThrowIfInvalidChannel(channelIndex);
 
-            if (_audioBuffers.ChannelBuffers64 != IntPtr.Zero &&
+            if (_audioBuffers->ChannelBuffers64 != IntPtr.Zero &&
                 !IsChannelSilent(channelIndex))
             {
-                double** ptr = (double**)_audioBuffers.ChannelBuffers64.ToPointer();
+                double** ptr = (double**)_audioBuffers->ChannelBuffers64.ToPointer();
 
                 return ptr[channelIndex];
             }
 
             return null;
         }
+
+        private int Read<T>(T* ptr, T[] buffer, int length) where T : unmanaged
+        {
+            if (ptr == null) return 0;
+
+            length = Math.Min(Math.Min(length, _numSamples), buffer.Length);
+            new ReadOnlySpan<T>(ptr, length).CopyTo(buffer);
+            return length;
+        }
+
+        private int Write<T>(T* ptr, T[] buffer, int length) where T : unmanaged
+        {
+            if (ptr == null) return 0;
+
+            length = Math.Min(Math.Min(length, _numSamples), buffer.Length);
+            new ReadOnlySpan<T>(buffer, 0, length).CopyTo(new Span<T>(ptr, length));
+            return length;
+        }
+
+        private static ulong GetChannelMask(int channelIndex)
+        {
+            return 1UL << channelIndex;
+        }
+
+        private void ThrowIfInvalidChannel(int channelIndex)
+        {
+            Guard.ThrowIfOutOfRange("channel", channelIndex, 0, _audioBuffers->NumChannels - 1);
+        }
+
+        private void ThrowIfNotSampleSize(SymbolicSampleSizes sampleSize)
+        {
+            if (_sampleSize != sampleSize)
+            {
+                throw new InvalidOperationException(
+                    sampleSize == SymbolicSampleSizes.Sample32 ?
+                    "32 bit sample size is not supported." : "64 bit sample size is not supported.");
+            }
+        }
     }
 }
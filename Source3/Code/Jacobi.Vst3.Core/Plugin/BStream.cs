@@ -1,7 +1,6 @@
 ﻿using Jacobi.Vst3.Core;
 using System;
 using System.IO;
-using System.Runtime.InteropServices;
 
 namespace Jacobi.Vst3.Plugin
 {
@@ -17,27 +16,19 @@ namespace Jacobi.Vst3.Plugin
     public sealed class BStream : Stream
     {
         private readonly StreamAccessMode _mode;
-        private readonly int _unmanagedBufferSize;
-        private IntPtr _unmanagedBuffer;
 
         public BStream(IBStream streamToWrap, StreamAccessMode mode)
-            : this(streamToWrap, mode, 0)
-        { }
-
-        public BStream(IBStream streamToWrap, StreamAccessMode mode, int unmanagedBufferSize)
         {
             BaseStream = streamToWrap;
             SizeableStream = streamToWrap as ISizeableStream;
             _mode = mode;
-
-            if (unmanagedBufferSize > 0)
-            {
-                _unmanagedBufferSize = unmanagedBufferSize;
-                _unmanagedBuffer = Marshal.AllocHGlobal(unmanagedBufferSize);
-                GC.AddMemoryPressure(unmanagedBufferSize);
-            }
         }
 
+        [Obsolete("The stream no longer copies through an unmanaged buffer. Use BStream(IBStream, StreamAccessMode).")]
+        public BStream(IBStream streamToWrap, StreamAccessMode mode, int unmanagedBufferSize)
+            : this(streamToWrap, mode)
+        { }
+
         public IBStream BaseStream { get; private set; }
         public ISizeableStream SizeableStream { get; private set; }
 
@@ -119,71 +110,48 @@ namespace Jacobi.Vst3.Plugin
 
         public override int Read(byte[] buffer, int offset, int count)
         {
-            IntPtr unmanaged = GetUnmanagedBuffer(ref count);
+            return Read(new Span<byte>(buffer, offset, count));
+        }
+
+        // the host reads directly into the (pinned) managed buffer.
+        public override int Read(Span<byte> buffer)
+        {
+            if (buffer.IsEmpty) return 0;
 
-            try
+            unsafe
             {
-                int readBytes = 0;
-
-                if (TResult.Succeeded(BaseStream.Read(unmanaged, count, ref readBytes)))
+                fixed (byte* ptr = buffer)
                 {
-                    for (int i = 0; i < readBytes; i++)
+                    int readBytes = 0;
+
+                    if (TResult.Succeeded(BaseStream.Read(new IntPtr(ptr), buffer.Length, ref readBytes)))
                     {
-                        buffer[offset + i] = Marshal.ReadByte(unmanaged, i);
+                        return readBytes;
                     }
-
-                    return readBytes;
                 }
             }
-            finally
-            {
-                ReleaseUnmanagedBuffer(unmanaged);
-            }
 
             return 0;
         }
 
         public override void Write(byte[] buffer, int offset, int count)
         {
-            IntPtr unmanaged = GetUnmanagedBuffer(ref count);
-
-            try
-            {
-                for (int i = 0; i < count; i++)
-                {
-                    Marshal.WriteByte(unmanaged, i, buffer[offset + i]);
-                }
-
-                int writtenBytes = 0;
-                int result = BaseStream.Write(unmanaged, count, ref writtenBytes);
-                TResult.ThrowIfFailed(result);
-            }
-            finally
-            {
-                ReleaseUnmanagedBuffer(unmanaged);
-            }
+            Write(new ReadOnlySpan<byte>(buffer, offset, count));
         }
 
-        private IntPtr GetUnmanagedBuffer(ref int size)
+        // the host writes directly from the (pinned) managed buffer.
+        public override void Write(ReadOnlySpan<byte> buffer)
         {
-            if (_unmanagedBuffer != IntPtr.Zero)
+            if (buffer.IsEmpty) return;
+
+            unsafe
             {
-                if (size > _unmanagedBufferSize)
+                fixed (byte* ptr = buffer)
                 {
-                    size = _unmanagedBufferSize;
+                    int writtenBytes = 0;
+                    int result = BaseStream.Write(new IntPtr(ptr), buffer.Length, ref writtenBytes);
+                    TResult.ThrowIfFailed(result);
                 }
-
-                return _unmanagedBuffer;
-            }
-
-            return Marshal.AllocHGlobal(size);
-        }
-
-        private void ReleaseUnmanagedBuffer(IntPtr mem)
-        {
-            if (_unmanagedBuffer == IntPtr.Zero)
-            {
-                Marshal.FreeHGlobal(mem);
             }
         }
 
@@ -202,13 +170,6 @@ namespace Jacobi.Vst3.Plugin
         {
             try
             {
-                if (_unmanagedBuffer != IntPtr.Zero)
-                {
-                    Marshal.FreeHGlobal(_unmanagedBuffer);
-                    GC.RemoveMemoryPressure(_unmanagedBufferSize);
-                    _unmanagedBuffer = IntPtr.Zero;
-                }
-
                 BaseStream = null;
             }
             finally
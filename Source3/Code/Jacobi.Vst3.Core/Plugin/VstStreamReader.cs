@@ -1,5 +1,7 @@
 ﻿using Jacobi.Vst3.Core;
 using System;
+using System.Buffers;
+using System.Buffers.Binary;
 using System.IO;
 
 namespace Jacobi.Vst3.Plugin
@@ -25,16 +27,70 @@ namespace Jacobi.Vst3.Plugin
             var reader = new BinaryReader(_stream);
             var count = reader.ReadInt32();
 
-            for (int i = 0; i < count; i++)
+            // a corrupt count must not rent a huge buffer.
+            if (count < 0 || count > Int32.MaxValue / VstStreamWriter.ParameterSize)
             {
-                var id = reader.ReadUInt32();
-                var value = reader.ReadDouble();
+                throw new InvalidDataException($"Invalid parameter count: {count}.");
+            }
+
+            // read all values from the host stream in one call.
+            var size = count * VstStreamWriter.ParameterSize;
 
-                if (parameters.Contains(id))
+            var remaining = GetRemainingLength();
+            if (remaining >= 0 && size > remaining)
+            {
+                throw new InvalidDataException($"The stream holds less than {count} parameters.");
+            }
+
+            var buffer = ArrayPool<byte>.Shared.Rent(size);
+
+            try
+            {
+                var data = new Span<byte>(buffer, 0, size);
+                ReadExactly(data);
+
+                for (int i = 0; i < count; i++)
                 {
-                    parameters[id].PlainValue = value;
+                    var item = data.Slice(i * VstStreamWriter.ParameterSize);
+                    var id = BinaryPrimitives.ReadUInt32LittleEndian(item);
+                    var value = BitConverter.Int64BitsToDouble(BinaryPrimitives.ReadInt64LittleEndian(item.Slice(4)));
+
+                    if (parameters.Contains(id))
+                    {
+                        parameters[id].PlainValue = value;
+                    }
                 }
             }
+            finally
+            {
+                ArrayPool<byte>.Shared.Return(buffer);
+            }
+        }
+
+        // the number of bytes left in the stream, or -1 when the host stream does not report its size.
+        private long GetRemainingLength()
+        {
+            if (!_stream.CanSeek || _stream.SizeableStream == null)
+            {
+                return -1;
+            }
+
+            var position = _stream.Position;
+            return position < 0 ? -1 : _stream.Length - position;
+        }
+
+        private void ReadExactly(Span<byte> data)
+        {
+            while (!data.IsEmpty)
+            {
+                var read = _stream.Read(data);
+                if (read == 0)
+                {
+                    throw new EndOfStreamException();
+                }
+
+                data = data.Slice(read);
+            }
         }
 
         public virtual void ReadPrograms(ProgramList programs)
@@ -6,6 +6,9 @@ namespace Jacobi.Vst3.Plugin
 {
     public class VstStreamWriter
     {
+        // id (uint) and value (double)
+        internal const int ParameterSize = 12;
+
         private readonly BStream _stream;
 
         public VstStreamWriter(IBStream stream)
@@ -22,7 +25,8 @@ namespace Jacobi.Vst3.Plugin
 
         public virtual void WriteParameters(ParameterCollection parameters)
         {
-            var writer = new BinaryWriter(_stream);
+            // collect the values and write them to the host stream in one call.
+            var writer = new BinaryWriter(new BufferedStream(_stream, 4 + parameters.Count * ParameterSize));
             writer.Write(parameters.Count);
 
             foreach (var parameter in parameters)
@@ -30,6 +34,8 @@ namespace Jacobi.Vst3.Plugin
                 writer.Write(parameter.Id);
                 writer.Write(parameter.PlainValue);
             }
+
+            writer.Flush();
         }
 
         public virtual void WritePrograms(ProgramList programs)
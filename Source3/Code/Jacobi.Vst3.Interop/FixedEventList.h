@@ -0,0 +1,114 @@
+#pragma once
+
+#include <pluginterfaces/vst/ivstevents.h>
+#include "FixedFUnknown.h"
+
+// An IEventList on a preallocated array of events.
+// Native code reads the events in place (Get) instead of copying them through getEvent,
+// and several sorted event sources can be combined with Merge.
+class FixedEventList : public Steinberg::Vst::IEventList
+{
+public:
+    FIXED_FUNKNOWN_METHODS(Steinberg::Vst::IEventList)
+
+    ~FixedEventList()
+    {
+        delete[] _events;
+    }
+
+    void Allocate(int32_t capacity)
+    {
+        delete[] _events;
+        _events = new Steinberg::Vst::Event[capacity];
+        _capacity = capacity;
+        _count = 0;
+    }
+
+    void Clear() { _count = 0; }
+
+    int32_t GetCount() const { return _count; }
+    int32_t GetCapacity() const { return _capacity; }
+
+    // the event at index, in the list's storage.
+    Steinberg::Vst::Event* Get(int32_t index) { return &_events[index]; }
+
+    // returns the next free event or nullptr when the list is full.
+    Steinberg::Vst::Event* Add()
+    {
+        if (_count == _capacity) return nullptr;
+        return &_events[_count++];
+    }
+
+    Steinberg::int32 PLUGIN_API getEventCount() override { return _count; }
+
+    Steinberg::tresult PLUGIN_API getEvent(Steinberg::int32 index, Steinberg::Vst::Event& e) override
+    {
+        if (index < 0 || index >= _count) return Steinberg::kInvalidArgument;
+
+        e = _events[index];
+        return Steinberg::kResultOk;
+    }
+
+    Steinberg::tresult PLUGIN_API addEvent(Steinberg::Vst::Event& e) override
+    {
+        auto pEvent = Add();
+        if (pEvent == nullptr) return Steinberg::kResultFalse;
+
+        *pEvent = e;
+        return Steinberg::kResultOk;
+    }
+
+    // Merges the events of source into this list. Both lists must be sorted on sample offset.
+    // Events with the same offset are placed after the events already in this list.
+    // Returns false when the events do not fit; the list is not changed in that case.
+    bool Merge(const FixedEventList& source)
+    {
+        if (_count + source._count > _capacity) return false;
+
+        // merge from the back, in place
+        int32_t i = _count - 1;
+        int32_t j = source._count - 1;
+        int32_t k = _count + source._count - 1;
+
+        while (j >= 0)
+        {
+            if (i >= 0 && _events[i].sampleOffset > source._events[j].sampleOffset)
+            {
+                _events[k--] = _events[i--];
+            }
+            else
+            {
+                _events[k--] = source._events[j--];
+            }
+        }
+
+        _count += source._count;
+        return true;
+    }
+
+    // Sorts the events on sample offset, keeping the order of events with the same offset.
+    // Insertion sort: events usually arrive (almost) in order.
+    void Sort()
+    {
+        for (int32_t n = 1; n < _count; n++)
+        {
+            if (_events[n - 1].sampleOffset <= _events[n].sampleOffset) continue;
+
+            Steinberg::Vst::Event e = _events[n];
+            int32_t pos = n - 1;
+
+            while (pos >= 0 && _events[pos].sampleOffset > e.sampleOffset)
+            {
+                _events[pos + 1] = _events[pos];
+                pos--;
+            }
+
+            _events[pos + 1] = e;
+        }
+    }
+
+private:
+    Steinberg::Vst::Event* _events = nullptr;
+    int32_t _capacity = 0;
+    int32_t _count = 0;
+};
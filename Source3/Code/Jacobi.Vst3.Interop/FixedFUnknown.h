@@ -0,0 +1,19 @@
+#pragma once
+
+#include <pluginterfaces/base/funknown.h>
+
+// Implements FUnknown for objects that live inside their owner: there is no reference counting.
+#define FIXED_FUNKNOWN_METHODS(Interface) \
+    Steinberg::tresult PLUGIN_API queryInterface(const Steinberg::TUID _iid, void** obj) override \
+    { \
+        if (Steinberg::FUnknownPrivate::iidEqual(_iid, Interface::iid) || \
+            Steinberg::FUnknownPrivate::iidEqual(_iid, Steinberg::FUnknown::iid)) \
+        { \
+            *obj = this; \
+            return Steinberg::kResultOk; \
+        } \
+        *obj = nullptr; \
+        return Steinberg::kNoInterface; \
+    } \
+    Steinberg::uint32 PLUGIN_API addRef() override { return 1; } \
+    Steinberg::uint32 PLUGIN_API release() override { return 1; }
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <pluginterfaces/vst/ivstparameterchanges.h>
+#include "FixedFUnknown.h"
+
+// An IParamValueQueue with a fixed number of points, sorted on sample offset.
+class FixedParamValueQueue : public Steinberg::Vst::IParamValueQueue
+{
+public:
+    FIXED_FUNKNOWN_METHODS(Steinberg::Vst::IParamValueQueue)
+
+    // the storage is owned by FixedParameterChanges.
+    void Initialize(int32_t* sampleOffsets, Steinberg::Vst::ParamValue* values, int32_t capacity)
+    {
+        _sampleOffsets = sampleOffsets;
+        _values = values;
+        _capacity = capacity;
+        _count = 0;
+    }
+
+    void Reset(Steinberg::Vst::ParamID id)
+    {
+        _id = id;
+        _count = 0;
+    }
+
+    Steinberg::Vst::ParamID PLUGIN_API getParameterId() override { return _id; }
+    Steinberg::int32 PLUGIN_API getPointCount() override { return _count; }
+
+    Steinberg::tresult PLUGIN_API getPoint(Steinberg::int32 index, Steinberg::int32& sampleOffset, Steinberg::Vst::ParamValue& value) override
+    {
+        if (index < 0 || index >= _count) return Steinberg::kInvalidArgument;
+
+        sampleOffset = _sampleOffsets[index];
+        value = _values[index];
+        return Steinberg::kResultOk;
+    }
+
+    Steinberg::tresult PLUGIN_API addPoint(Steinberg::int32 sampleOffset, Steinberg::Vst::ParamValue value, Steinberg::int32& index) override
+    {
+        int32_t pos = _count;
+        while (pos > 0 && _sampleOffsets[pos - 1] > sampleOffset)
+        {
+            pos--;
+        }
+
+        // a point at the same offset is replaced.
+        if (pos > 0 && _sampleOffsets[pos - 1] == sampleOffset)
+        {
+            _values[pos - 1] = value;
+            index = pos - 1;
+            return Steinberg::kResultOk;
+        }
+
+        if (_count == _capacity) return Steinberg::kResultFalse;
+
+        for (int32_t i = _count; i > pos; i--)
+        {
+            _sampleOffsets[i] = _sampleOffsets[i - 1];
+            _values[i] = _values[i - 1];
+        }
+
+        _sampleOffsets[pos] = sampleOffset;
+        _values[pos] = value;
+        _count++;
+
+        index = pos;
+        return Steinberg::kResultOk;
+    }
+
+    // returns the value of the last point. The queue must not be empty.
+    Steinberg::Vst::ParamValue GetLastValue() const { return _values[_count - 1]; }
+
+private:
+    Steinberg::Vst::ParamID _id = 0;
+    int32_t* _sampleOffsets = nullptr;
+    Steinberg::Vst::ParamValue* _values = nullptr;
+    int32_t _capacity = 0;
+    int32_t _count = 0;
+};
+
+// An IParameterChanges with a fixed number of queues.
+// The points are stored in two arrays (offsets, values) and queues are found by id
+// through an open-addressing hash table. Nothing is allocated after Allocate.
+class FixedParameterChanges : public Steinberg::Vst::IParameterChanges
+{
+public:
+    FIXED_FUNKNOWN_METHODS(Steinberg::Vst::IParameterChanges)
+
+    ~FixedParameterChanges()
+    {
+        Free();
+    }
+
+    // (re)allocates storage for parameterCount queues of pointCapacity points each.
+    void Allocate(int32_t parameterCount, int32_t pointCapacity)
+    {
+        Free();
+
+        _capacity = parameterCount;
+        _queues = new FixedParamValueQueue[parameterCount];
+        _sampleOffsets = new int32_t[(size_t)parameterCount * pointCapacity];
+        _values = new Steinberg::Vst::ParamValue[(size_t)parameterCount * pointCapacity];
+
+        for (int32_t i = 0; i < parameterCount; i++)
+        {
+            _queues[i].Initialize(_sampleOffsets + (size_t)i * pointCapacity, _values + (size_t)i * pointCapacity, pointCapacity);
+        }
+
+        // at most half full
+        int32_t tableBits = 1;
+        while ((1 << tableBits) < parameterCount * 2)
+        {
+            tableBits++;
+        }
+
+        _tableShift = 32 - tableBits;
+        _tableMask = (1 << tableBits) - 1;
+        _table = new int32_t[(size_t)1 << tableBits];
+        _slots = new int32_t[parameterCount > 0 ? parameterCount : 1];
+
+        for (int32_t i = 0; i <= _tableMask; i++)
+        {
+            _table[i] = EmptySlot;
+        }
+
+        _count = 0;
+    }
+
+    // removes all changes, only touching the queues in use.
+    void Clear()
+    {
+        for (int32_t i = 0; i < _count; i++)
+        {
+            _table[_slots[i]] = EmptySlot;
+        }
+
+        _count = 0;
+    }
+
+    FixedParamValueQueue* GetQueue(int32_t index) { return &_queues[index]; }
+
+    Steinberg::int32 PLUGIN_API getParameterCount() override { return _count; }
+
+    Steinberg::Vst::IParamValueQueue* PLUGIN_API getParameterData(Steinberg::int32 index) override
+    {
+        if (index < 0 || index >= _count) return nullptr;
+        return &_queues[index];
+    }
+
+    Steinberg::Vst::IParamValueQueue* PLUGIN_API addParameterData(const Steinberg::Vst::ParamID& id, Steinberg::int32& index) override
+    {
+        if (_table == nullptr) return nullptr;
+
+        // Fibonacci hashing, linear probing
+        int32_t slot = (int32_t)((id * 2654435769u) >> _tableShift);
+        while (_table[slot] != EmptySlot && _queues[_table[slot]].getParameterId() != id)
+        {
+            slot = (slot + 1) & _tableMask;
+        }
+
+        if (_table[slot] != EmptySlot)
+        {
+            index = _table[slot];
+            return &_queues[index];
+        }
+
+        if (_count == _capacity) return nullptr;
+
+        index = _count++;
+        _table[slot] = index;
+        _slots[index] = slot;
+        _queues[index].Reset(id);
+        return &_queues[index];
+    }
+
+private:
+    static const int32_t EmptySlot = -1;
+
+    FixedParamValueQueue* _queues = nullptr;
+    int32_t* _sampleOffsets = nullptr;
+    Steinberg::Vst::ParamValue* _values = nullptr;
+    // queue index per slot
+    int32_t* _table = nullptr;
+    // slot per (used) queue
+    int32_t* _slots = nullptr;
+    int32_t _tableShift = 0;
+    int32_t _tableMask = 0;
+    int32_t _capacity = 0;
+    int32_t _count = 0;
+
+    void Free()
+    {
+        delete[] _queues;
+        delete[] _sampleOffsets;
+        delete[] _values;
+        delete[] _table;
+        delete[] _slots;
+
+        _queues = nullptr;
+        _sampleOffsets = nullptr;
+        _values = nullptr;
+        _table = nullptr;
+        _slots = nullptr;
+        _capacity = 0;
+        _count = 0;
+    }
+};
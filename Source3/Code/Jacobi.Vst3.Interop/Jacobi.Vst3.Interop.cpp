@@ -1,7 +1,19 @@
 #include "pch.h"
 #include <pluginterfaces/base/funknown.h>
 #include <pluginterfaces/base/ipluginbase.h>
+#include "Vst2Adapter.h"
 
+// Keeps the plugin factory of this module alive across GetPluginFactory calls.
+private ref class PluginFactoryCache abstract sealed
+{
+public:
+    static System::Object^ SyncRoot = gcnew System::Object();
+    static Jacobi::Vst3::Core::Common::AssemblyLoader^ Loader;
+    static Jacobi::Vst3::Core::IPluginFactory^ Factory;
+};
+
+// the cache owns one reference.
+static Steinberg::IPluginFactory* g_pPluginFactory = nullptr;
 
 bool PLUGIN_API InitDll()
 {
@@ -9,7 +21,55 @@ bool PLUGIN_API InitDll()
 }
 void PLUGIN_API ExitDll()
 {
+    System::Threading::Monitor::Enter(PluginFactoryCache::SyncRoot);
+    try
+    {
+        if (g_pPluginFactory != nullptr)
+        {
+            g_pPluginFactory->release();
+            g_pPluginFactory = nullptr;
+        }
+
+        auto disposable = dynamic_cast<System::IDisposable^>(PluginFactoryCache::Factory);
+        if (disposable != nullptr)
+        {
+            delete disposable;
+        }
+        PluginFactoryCache::Factory = nullptr;
+
+        if (PluginFactoryCache::Loader != nullptr)
+        {
+            delete PluginFactoryCache::Loader;
+            PluginFactoryCache::Loader = nullptr;
+        }
+    }
+    finally
+    {
+        System::Threading::Monitor::Exit(PluginFactoryCache::SyncRoot);
+    }
+}
+
+System::Type^ FindPluginFactoryType(System::Reflection::Assembly^ pluginAssembly)
+{
+    auto attribute = safe_cast<Jacobi::Vst3::Core::Common::PluginFactoryAttribute^>(
+        System::Attribute::GetCustomAttribute(pluginAssembly, Jacobi::Vst3::Core::Common::PluginFactoryAttribute::typeid));
+
+    if (attribute != nullptr)
+    {
+        return attribute->FactoryType;
+    }
+
+    // no attribute: fall back to scanning the public types.
+    for each (auto type in pluginAssembly->GetExportedTypes())
+    {
+        if (Jacobi::Vst3::Core::IPluginFactory::typeid->IsAssignableFrom(type) &&
+            !type->IsAbstract && !type->IsInterface)
+        {
+            return type;
+        }
+    }
 
+    return nullptr;
 }
 
 Jacobi::Vst3::Core::IPluginFactory^ LoadPlugin()
@@ -18,22 +78,17 @@ Jacobi::Vst3::Core::IPluginFactory^ LoadPlugin()
     auto pluginPath = System::IO::Path::GetDirectoryName(interopPath);
     auto pluginName = System::IO::Path::GetFileNameWithoutExtension(interopPath);
 
-    auto loader = gcnew Jacobi::Vst3::Core::Common::AssemblyLoader(pluginPath);
-    auto pluginAssembly = loader->LoadPlugin(pluginName);
-    
-    System::Type^ pluginType = nullptr;
-    for each (auto type in pluginAssembly->GetTypes())
+    // the loader stays registered to resolve the plugin's dependencies.
+    if (PluginFactoryCache::Loader == nullptr)
     {
-        if (type->IsPublic)
-        {
-            if (type->GetInterface("Jacobi.Vst3.Core.IPluginFactory") != nullptr)
-            {
-                pluginType = type;
-                break;
-            }
-        }
+        PluginFactoryCache::Loader = gcnew Jacobi::Vst3::Core::Common::AssemblyLoader(pluginPath);
     }
 
+    auto pluginAssembly = PluginFactoryCache::Loader->LoadPlugin(pluginName);
+    if (pluginAssembly == nullptr) return nullptr;
+
+    System::Type^ pluginType = FindPluginFactoryType(pluginAssembly);
+
     Jacobi::Vst3::Core::IPluginFactory^ plugin = nullptr;
     if (pluginType != nullptr)
     {
@@ -43,7 +98,7 @@ Jacobi::Vst3::Core::IPluginFactory^ LoadPlugin()
     return plugin;
 }
 
-Steinberg::IPluginFactory* PLUGIN_API GetPluginFactory()
+Steinberg::IPluginFactory* CreatePluginFactory()
 {
     Jacobi::Vst3::Core::IPluginFactory^ pluginFactory = LoadPlugin();
     if (pluginFactory == nullptr) return nullptr;
@@ -56,6 +111,46 @@ Steinberg::IPluginFactory* PLUGIN_API GetPluginFactory()
     {
         Steinberg::FUnknown* unknown = (Steinberg::FUnknown*)unknownPtr.ToPointer();
         unknown->queryInterface(Steinberg::IPluginFactory_iid, (void**)&plugin);
+        // queryInterface added its own reference.
+        unknown->release();
+    }
+
+    if (plugin != nullptr)
+    {
+        PluginFactoryCache::Factory = pluginFactory;
     }
     return plugin;
 }
+
+Steinberg::IPluginFactory* PLUGIN_API GetPluginFactory()
+{
+    System::Threading::Monitor::Enter(PluginFactoryCache::SyncRoot);
+    try
+    {
+        if (g_pPluginFactory == nullptr)
+        {
+            g_pPluginFactory = CreatePluginFactory();
+            if (g_pPluginFactory == nullptr) return nullptr;
+        }
+
+        // the caller releases its reference.
+        g_pPluginFactory->addRef();
+        return g_pPluginFactory;
+    }
+    finally
+    {
+        System::Threading::Monitor::Exit(PluginFactoryCache::SyncRoot);
+    }
+}
+
+// VST2 entry point: wraps the first audio effect of this module in a native VST2 adapter.
+Vst2Plugin* VSTPluginMain(Vst2HostCommand hostCommand)
+{
+    auto pFactory = GetPluginFactory();
+    if (pFactory == nullptr) return nullptr;
+
+    // the adapter holds its own references to the component.
+    auto pPlugin = Vst2Adapter::Create(pFactory, hostCommand);
+    pFactory->release();
+    return pPlugin;
+}
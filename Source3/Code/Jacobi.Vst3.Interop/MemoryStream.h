@@ -0,0 +1,111 @@
+#pragma once
+
+#include <stdlib.h>
+#include <string.h>
+#include <pluginterfaces/base/ibstream.h>
+#include "FixedFUnknown.h"
+
+// A growable IBStream in memory, used to transfer plugin state.
+class MemoryStream : public Steinberg::IBStream
+{
+public:
+    FIXED_FUNKNOWN_METHODS(Steinberg::IBStream)
+
+    ~MemoryStream()
+    {
+        free(_pBuffer);
+    }
+
+    uint8_t* GetBuffer() { return _pBuffer; }
+    int64_t GetSize() const { return _size; }
+
+    // empties the stream; the memory is kept.
+    void Clear()
+    {
+        _size = 0;
+        _position = 0;
+    }
+
+    // sets the content to a copy of the data and rewinds.
+    bool Load(const void* pData, int64_t size)
+    {
+        if (!Reserve(size)) return false;
+
+        memcpy(_pBuffer, pData, (size_t)size);
+        _size = size;
+        _position = 0;
+        return true;
+    }
+
+    void Rewind() { _position = 0; }
+
+    Steinberg::tresult PLUGIN_API read(void* buffer, Steinberg::int32 numBytes, Steinberg::int32* numBytesRead) override
+    {
+        int64_t available = _size - _position;
+        int32_t count = available <= 0 ? 0 : (numBytes < available ? numBytes : (int32_t)available);
+
+        if (count > 0)
+        {
+            memcpy(buffer, _pBuffer + _position, count);
+            _position += count;
+        }
+
+        if (numBytesRead != nullptr) *numBytesRead = count;
+        return Steinberg::kResultOk;
+    }
+
+    Steinberg::tresult PLUGIN_API write(void* buffer, Steinberg::int32 numBytes, Steinberg::int32* numBytesWritten) override
+    {
+        if (numBytes < 0 || !Reserve(_position + numBytes)) return Steinberg::kOutOfMemory;
+
+        // zero a gap left by seeking past the end
+        if (_position > _size)
+        {
+            memset(_pBuffer + _size, 0, (size_t)(_position - _size));
+        }
+
+        memcpy(_pBuffer + _position, buffer, numBytes);
+        _position += numBytes;
+        if (_position > _size) _size = _position;
+
+        if (numBytesWritten != nullptr) *numBytesWritten = numBytes;
+        return Steinberg::kResultOk;
+    }
+
+    Steinberg::tresult PLUGIN_API seek(Steinberg::int64 pos, Steinberg::int32 mode, Steinberg::int64* result) override
+    {
+        int64_t position = mode == kIBSeekSet ? pos : (mode == kIBSeekCur ? _position + pos : _size + pos);
+        if (position < 0) return Steinberg::kInvalidArgument;
+
+        _position = position;
+        if (result != nullptr) *result = position;
+        return Steinberg::kResultOk;
+    }
+
+    Steinberg::tresult PLUGIN_API tell(Steinberg::int64* pos) override
+    {
+        if (pos == nullptr) return Steinberg::kInvalidArgument;
+
+        *pos = _position;
+        return Steinberg::kResultOk;
+    }
+
+private:
+    uint8_t* _pBuffer = nullptr;
+    int64_t _capacity = 0;
+    int64_t _size = 0;
+    int64_t _position = 0;
+
+    bool Reserve(int64_t size)
+    {
+        if (size <= _capacity) return true;
+
+        int64_t capacity = _capacity * 2 > size ? _capacity * 2 : size;
+        auto pBuffer = (uint8_t*)realloc(_pBuffer, (size_t)capacity);
+        if (pBuffer == nullptr) return false;
+
+        _pBuffer = pBuffer;
+        _capacity = capacity;
+        return true;
+    }
+};
@@ -0,0 +1,783 @@
+// compiled without /clr and without the precompiled header (also built by the native tests).
+#include "Vst2Adapter.h"
+#include <algorithm>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+namespace {
+
+    // sets the flag and returns its previous value.
+    long ExchangeFlag(volatile long* pFlag, long value)
+    {
+#ifdef _WIN32
+        return ::InterlockedExchange(pFlag, value);
+#else
+        return __atomic_exchange_n(pFlag, value, __ATOMIC_SEQ_CST);
+#endif
+    }
+
+    template<typename CharT>
+    void CopyString(char* pDest, const CharT* pSource, int32_t maxLength)
+    {
+        int32_t n = 0;
+        for (; n < maxLength && pSource[n] != 0; n++)
+        {
+            pDest[n] = pSource[n] < 128 ? (char)pSource[n] : '?';
+        }
+        pDest[n] = 0;
+    }
+
+    // a VST2 id derived from the VST3 class id (FNV-1a).
+    int32_t GetUniqueId(const Steinberg::TUID cid)
+    {
+        uint32_t hash = 2166136261u;
+        for (int i = 0; i < 16; i++)
+        {
+            hash = (hash ^ (uint8_t)cid[i]) * 16777619u;
+        }
+        return (int32_t)hash;
+    }
+
+    template<typename T>
+    T* QueryInterface(Steinberg::FUnknown* pUnknown, const Steinberg::TUID iid)
+    {
+        T* pInterface = nullptr;
+        if (pUnknown == nullptr || pUnknown->queryInterface(iid, (void**)&pInterface) != Steinberg::kResultOk)
+        {
+            return nullptr;
+        }
+        return pInterface;
+    }
+
+    void SetChannelBuffers(Steinberg::Vst::AudioBusBuffers& buffers, float** ppChannels)
+    {
+        buffers.channelBuffers32 = ppChannels;
+    }
+
+    void SetChannelBuffers(Steinberg::Vst::AudioBusBuffers& buffers, double** ppChannels)
+    {
+        buffers.channelBuffers64 = ppChannels;
+    }
+
+    Steinberg::int32 GetSymbolicSampleSize(float**) { return Steinberg::Vst::kSample32; }
+    Steinberg::int32 GetSymbolicSampleSize(double**) { return Steinberg::Vst::kSample64; }
+}
+
+Vst2Plugin* Vst2Adapter::Create(Steinberg::IPluginFactory* pFactory, Vst2HostCommand hostCommand)
+{
+    if (pFactory == nullptr) return nullptr;
+
+    auto pAdapter = new Vst2Adapter(hostCommand);
+    if (!pAdapter->Initialize(pFactory))
+    {
+        delete pAdapter;
+        return nullptr;
+    }
+
+    return &pAdapter->_plugin;
+}
+
+Vst2Adapter::Vst2Adapter(Vst2HostCommand hostCommand)
+    : _hostCommand(hostCommand), _pComponent(nullptr), _pProcessor(nullptr), _pController(nullptr), _isSingleComponent(false),
+    _isComponentInitialized(false), _inputBusCount(0), _outputBusCount(0), _eventBusCount(0),
+    _parameterCount(0), _parameterInfos(nullptr), _parameterValues(nullptr), _parameterDirty(nullptr),
+    _controllerDirty(nullptr), _parameterIndices(nullptr),
+    _accumulateBuffer(nullptr), _accumulateOutputs(nullptr), _accumulateCapacity(0), _isActive(false)
+{
+    memset(&_plugin, 0, sizeof(Vst2Plugin));
+    memset(&_processData, 0, sizeof(_processData));
+    memset(_inputs, 0, sizeof(_inputs));
+    memset(_outputs, 0, sizeof(_outputs));
+    _name[0] = 0;
+    _vendor[0] = 0;
+
+    _setup.processMode = Steinberg::Vst::kRealtime;
+    _setup.symbolicSampleSize = Steinberg::Vst::kSample32;
+    _setup.maxSamplesPerBlock = 1024;
+    _setup.sampleRate = 44100.0;
+}
+
+Vst2Adapter::~Vst2Adapter()
+{
+    if (_pController != nullptr)
+    {
+        _pController->setComponentHandler(nullptr);
+        if (!_isSingleComponent) _pController->terminate();
+        _pController->release();
+    }
+    if (_pProcessor != nullptr)
+    {
+        _pProcessor->release();
+    }
+    if (_pComponent != nullptr)
+    {
+        if (_isComponentInitialized) _pComponent->terminate();
+        _pComponent->release();
+    }
+
+    delete[] _parameterInfos;
+    delete[] _parameterValues;
+    delete[] _parameterDirty;
+    delete[] _controllerDirty;
+    delete[] _accumulateBuffer;
+    delete[] _accumulateOutputs;
+    delete[] _parameterIndices;
+}
+
+bool Vst2Adapter::Initialize(Steinberg::IPluginFactory* pFactory)
+{
+    Steinberg::PFactoryInfo factoryInfo;
+    if (pFactory->getFactoryInfo(&factoryInfo) == Steinberg::kResultOk)
+    {
+        CopyString(_vendor, factoryInfo.vendor, Vst2MaxVendorStrLen);
+    }
+
+    // the first audio module class
+    Steinberg::PClassInfo classInfo;
+    int32_t classCount = pFactory->countClasses();
+    for (int32_t i = 0; i < classCount && _pComponent == nullptr; i++)
+    {
+        if (pFactory->getClassInfo(i, &classInfo) == Steinberg::kResultOk &&
+            strcmp(classInfo.category, kVstAudioEffectClass) == 0)
+        {
+            pFactory->createInstance(classInfo.cid, Steinberg::Vst::IComponent::iid, (void**)&_pComponent);
+        }
+    }
+
+    if (_pComponent == nullptr) return false;
+    if (_pComponent->initialize(this) != Steinberg::kResultOk) return false;
+    _isComponentInitialized = true;
+
+    _pProcessor = QueryInterface<Steinberg::Vst::IAudioProcessor>(_pComponent, Steinberg::Vst::IAudioProcessor::iid);
+    if (_pProcessor == nullptr) return false;
+
+    // separate controller or single component effect.
+    Steinberg::TUID controllerCid;
+    if (_pComponent->getControllerClassId(controllerCid) == Steinberg::kResultTrue &&
+        pFactory->createInstance(controllerCid, Steinberg::Vst::IEditController::iid, (void**)&_pController) == Steinberg::kResultOk)
+    {
+        if (_pController->initialize(this) != Steinberg::kResultOk)
+        {
+            _pController->release();
+            _pController = nullptr;
+        }
+    }
+    else
+    {
+        _pController = QueryInterface<Steinberg::Vst::IEditController>(_pComponent, Steinberg::Vst::IEditController::iid);
+        _isSingleComponent = _pController != nullptr;
+    }
+
+    if (_pController != nullptr)
+    {
+        _pController->setComponentHandler(this);
+    }
+
+    CopyString(_name, classInfo.name, Vst2MaxEffectNameLen);
+
+    InitializeBuses();
+    InitializeParameters();
+
+    int32_t flags = (int32_t)Vst2PluginFlags::CanReplace;
+    if (_pProcessor->canProcessSampleSize(Steinberg::Vst::kSample64) == Steinberg::kResultTrue)
+    {
+        flags |= (int32_t)Vst2PluginFlags::CanReplaceDouble;
+        _plugin.replaceDouble = ProcessDoubleProc;
+    }
+    if (_plugin.inputCount == 0 && _eventBusCount > 0)
+    {
+        flags |= (int32_t)Vst2PluginFlags::IsSynth;
+    }
+    // the host only saves the state through ChunkGet/ChunkSet when the plugin has program chunks.
+    _stateStream.Clear();
+    if (_pComponent->getState(&_stateStream) == Steinberg::kResultOk)
+    {
+        flags |= (int32_t)Vst2PluginFlags::Programs;
+    }
+    _stateStream.Clear();
+
+    _plugin.VstP = Vst2FourCharacterCode;
+    _plugin.command = DispatchProc;
+    _plugin.process = ProcessAccumulatingProc;
+    _plugin.replace = ProcessProc;
+    _plugin.parameterSet = SetParameterProc;
+    _plugin.parameterGet = GetParameterProc;
+    _plugin.parameterCount = _parameterCount;
+    _plugin.flags = (Vst2PluginFlags)flags;
+    _plugin.startupDelay = (int32_t)_pProcessor->getLatencySamples();
+    _plugin.ioRatio = 1.0f;
+    _plugin.object = this;
+    _plugin.id = GetUniqueId(classInfo.cid);
+    _plugin.version = 1;
+
+    return true;
+}
+
+void Vst2Adapter::InitializeBuses()
+{
+    Steinberg::Vst::BusInfo busInfo;
+
+    _inputBusCount = (std::min)(_pComponent->getBusCount(Steinberg::Vst::kAudio, Steinberg::Vst::kInput), int32_t(MaxBusCount));
+    for (int32_t i = 0; i < _inputBusCount; i++)
+    {
+        // a bus without info has no channels.
+        memset(&busInfo, 0, sizeof(busInfo));
+        if (_pComponent->getBusInfo(Steinberg::Vst::kAudio, Steinberg::Vst::kInput, i, busInfo) != Steinberg::kResultOk)
+        {
+            busInfo.channelCount = 0;
+        }
+        _pComponent->activateBus(Steinberg::Vst::kAudio, Steinberg::Vst::kInput, i, true);
+        _inputs[i].numChannels = busInfo.channelCount;
+        _plugin.inputCount += busInfo.channelCount;
+    }
+
+    _outputBusCount = (std::min)(_pComponent->getBusCount(Steinberg::Vst::kAudio, Steinberg::Vst::kOutput), int32_t(MaxBusCount));
+    for (int32_t i = 0; i < _outputBusCount; i++)
+    {
+        memset(&busInfo, 0, sizeof(busInfo));
+        if (_pComponent->getBusInfo(Steinberg::Vst::kAudio, Steinberg::Vst::kOutput, i, busInfo) != Steinberg::kResultOk)
+        {
+            busInfo.channelCount = 0;
+        }
+        _pComponent->activateBus(Steinberg::Vst::kAudio, Steinberg::Vst::kOutput, i, true);
+        _outputs[i].numChannels = busInfo.channelCount;
+        _plugin.outputCount += busInfo.channelCount;
+    }
+
+    // VST2 has one MIDI input.
+    _eventBusCount = _pComponent->getBusCount(Steinberg::Vst::kEvent, Steinberg::Vst::kInput);
+    if (_eventBusCount > 0)
+    {
+        _pComponent->activateBus(Steinberg::Vst::kEvent, Steinberg::Vst::kInput, 0, true);
+    }
+
+    _processData.numInputs = _inputBusCount;
+    _processData.numOutputs = _outputBusCount;
+    _processData.inputs = _inputs;
+    _processData.outputs = _outputs;
+    _processData.inputParameterChanges = &_inputChanges;
+    _processData.outputParameterChanges = &_outputChanges;
+    _processData.inputEvents = _eventBusCount > 0 ? &_inputEvents : nullptr;
+    _processData.outputEvents = &_outputEvents;
+}
+
+void Vst2Adapter::InitializeParameters()
+{
+    _parameterCount = _pController != nullptr ? _pController->getParameterCount() : 0;
+    if (_parameterCount <= 0)
+    {
+        _parameterCount = 0;
+        return;
+    }
+
+    _parameterInfos = new Steinberg::Vst::ParameterInfo[_parameterCount];
+    _parameterValues = new float[_parameterCount];
+    _parameterDirty = new long[_parameterCount];
+    _controllerDirty = new long[_parameterCount];
+    auto pIndices = new ParameterIndex[_parameterCount];
+
+    for (int32_t i = 0; i < _parameterCount; i++)
+    {
+        memset(&_parameterInfos[i], 0, sizeof(Steinberg::Vst::ParameterInfo));
+        _pController->getParameterInfo(i, _parameterInfos[i]);
+
+        _parameterValues[i] = (float)_pController->getParamNormalized(_parameterInfos[i].id);
+        _parameterDirty[i] = 0;
+        _controllerDirty[i] = 0;
+
+        pIndices[i].id = _parameterInfos[i].id;
+        pIndices[i].index = i;
+    }
+
+    std::sort(pIndices, pIndices + _parameterCount,
+        [](const ParameterIndex& a, const ParameterIndex& b) { return a.id < b.id; });
+    _parameterIndices = pIndices;
+}
+
+int32_t Vst2Adapter::FindParameterIndex(Steinberg::Vst::ParamID id)
+{
+    auto pIndices = _parameterIndices;
+    auto pEnd = pIndices + _parameterCount;
+    auto pFound = std::lower_bound(pIndices, pEnd, id,
+        [](const ParameterIndex& p, Steinberg::Vst::ParamID value) { return p.id < value; });
+
+    return pFound != pEnd && pFound->id == id ? pFound->index : -1;
+}
+
+void Vst2Adapter::SetActive(bool active)
+{
+    if (active == _isActive) return;
+
+    if (active)
+    {
+        // all allocations happen here, not during processing.
+        _inputChanges.Allocate(_parameterCount, MaxPointsPerBlock);
+        _outputChanges.Allocate(_parameterCount, MaxPointsPerBlock);
+        _inputEvents.Allocate(EventCapacity);
+        _outputEvents.Allocate(EventCapacity);
+        AllocateAccumulateBuffers();
+
+        _processData.processMode = _setup.processMode;
+        _processData.symbolicSampleSize = _setup.symbolicSampleSize;
+
+        _pProcessor->setupProcessing(_setup);
+        _pComponent->setActive(true);
+        _pProcessor->setProcessing(true);
+    }
+    else
+    {
+        _pProcessor->setProcessing(false);
+        _pComponent->setActive(false);
+    }
+
+    _isActive = active;
+}
+
+// the outputs the processor renders into for the accumulating process call, one block per output channel.
+void Vst2Adapter::AllocateAccumulateBuffers()
+{
+    int32_t capacity = (std::max)(_setup.maxSamplesPerBlock, Steinberg::int32(0));
+    if (_accumulateOutputs != nullptr && capacity == _accumulateCapacity) return;
+
+    delete[] _accumulateBuffer;
+    delete[] _accumulateOutputs;
+
+    _accumulateBuffer = new float[(size_t)_plugin.outputCount * capacity];
+    _accumulateOutputs = new float*[_plugin.outputCount];
+    for (int32_t i = 0; i < _plugin.outputCount; i++)
+    {
+        _accumulateOutputs[i] = _accumulateBuffer + (size_t)i * capacity;
+    }
+    _accumulateCapacity = capacity;
+}
+
+// moves the parameter values set by the host into the input parameter changes.
+void Vst2Adapter::CollectParameterChanges()
+{
+    for (int32_t i = 0; i < _parameterCount; i++)
+    {
+        if (_parameterDirty[i] != 0 && ExchangeFlag(&_parameterDirty[i], 0) != 0)
+        {
+            Steinberg::int32 index = 0;
+            auto pQueue = _inputChanges.addParameterData(_parameterInfos[i].id, index);
+            if (pQueue != nullptr)
+            {
+                pQueue->addPoint(0, _parameterValues[i], index);
+            }
+        }
+    }
+}
+
+// reports the parameter values changed by the processor to the host.
+// The controller is told later by UpdateController, not on the audio thread.
+void Vst2Adapter::DispatchParameterChanges()
+{
+    int32_t count = _outputChanges.getParameterCount();
+    for (int32_t i = 0; i < count; i++)
+    {
+        auto pQueue = _outputChanges.GetQueue(i);
+        if (pQueue->getPointCount() == 0) continue;
+
+        int32_t index = FindParameterIndex(pQueue->getParameterId());
+        if (index < 0) continue;
+
+        float value = (float)pQueue->GetLastValue();
+        _parameterValues[index] = value;
+        ExchangeFlag(&_controllerDirty[index], 1);
+        _hostCommand(&_plugin, Vst2HostCommands::Automate, index, 0, nullptr, value);
+    }
+}
+
+// passes the parameter values changed by the host or the processor to the controller.
+// Called from EditorIdle, ParameterGetDisplay and ChunkGet, which hosts do not call on the audio thread.
+void Vst2Adapter::UpdateController()
+{
+    for (int32_t i = 0; i < _parameterCount; i++)
+    {
+        if (_controllerDirty[i] != 0 && ExchangeFlag(&_controllerDirty[i], 0) != 0)
+        {
+            _pController->setParamNormalized(_parameterInfos[i].id, _parameterValues[i]);
+        }
+    }
+}
+
+// translates MIDI note messages into note events.
+void Vst2Adapter::AddMidiEvents(Vst2Events* pEvents)
+{
+    if (pEvents == nullptr || _eventBusCount == 0) return;
+
+    for (int32_t i = 0; i < pEvents->eventCount; i++)
+    {
+        auto pMidi = (Vst2MidiEvent*)pEvents->events[i];
+        if (pMidi->kind != Vst2EventKind::Midi) continue;
+
+        uint8_t status = pMidi->midiData[0] & 0xF0;
+        int16_t channel = pMidi->midiData[0] & 0x0F;
+        int16_t pitch = pMidi->midiData[1] & 0x7F;
+        float velocity = (pMidi->midiData[2] & 0x7F) / 127.0f;
+
+        if (status != 0x80 && status != 0x90 && status != 0xA0) continue;
+
+        auto pEvent = _inputEvents.Add();
+        if (pEvent == nullptr) return;
+
+        pEvent->busIndex = 0;
+        pEvent->sampleOffset = pMidi->deltaFrames;
+        pEvent->ppqPosition = 0;
+        pEvent->flags = ((int32_t)pMidi->flags & (int32_t)Vst2MidiEventFlags::IsRealTime) ? Steinberg::Vst::Event::kIsLive : 0;
+
+        if (status == 0x90 && velocity > 0)
+        {
+            pEvent->type = Steinberg::Vst::Event::kNoteOnEvent;
+            pEvent->noteOn.channel = channel;
+            pEvent->noteOn.pitch = pitch;
+            pEvent->noteOn.tuning = pMidi->detune;
+            pEvent->noteOn.velocity = velocity;
+            pEvent->noteOn.length = pMidi->noteLength;
+            pEvent->noteOn.noteId = -1;
+        }
+        else if (status == 0xA0)
+        {
+            pEvent->type = Steinberg::Vst::Event::kPolyPressureEvent;
+            pEvent->polyPressure.channel = channel;
+            pEvent->polyPressure.pitch = pitch;
+            pEvent->polyPressure.pressure = velocity;
+            pEvent->polyPressure.noteId = -1;
+        }
+        else
+        {
+            pEvent->type = Steinberg::Vst::Event::kNoteOffEvent;
+            pEvent->noteOff.channel = channel;
+            pEvent->noteOff.pitch = pitch;
+            pEvent->noteOff.velocity = status == 0x80 ? velocity : 0;
+            pEvent->noteOff.noteId = -1;
+            pEvent->noteOff.tuning = 0;
+        }
+    }
+}
+
+// delivers the parameter changes in a block without audio (a VST3 parameter flush).
+// The events of the block are dropped: they cannot be played without audio.
+void Vst2Adapter::FlushParameters()
+{
+    _inputEvents.Clear();
+
+    _processData.numSamples = 0;
+    _processData.numInputs = 0;
+    _processData.numOutputs = 0;
+
+    CollectParameterChanges();
+    _outputChanges.Clear();
+    _outputEvents.Clear();
+
+    _pProcessor->process(_processData);
+
+    _inputChanges.Clear();
+    _processData.numInputs = _inputBusCount;
+    _processData.numOutputs = _outputBusCount;
+
+    DispatchParameterChanges();
+}
+
+template<typename SampleT>
+bool Vst2Adapter::Process(SampleT** inputs, SampleT** outputs, int32_t sampleFrames)
+{
+    // switched off: the events of this block are stale by the time the plugin is switched on.
+    // Parameter values stay pending, they hold the last value the host set.
+    if (!_isActive)
+    {
+        _inputEvents.Clear();
+        return false;
+    }
+
+    // the host must call the entry point for the precision that was set when the plugin was switched on.
+    if (_processData.symbolicSampleSize != GetSymbolicSampleSize(outputs))
+    {
+        for (int32_t i = 0; i < _plugin.outputCount; i++)
+        {
+            memset(outputs[i], 0, sampleFrames * sizeof(SampleT));
+        }
+        FlushParameters();
+        return false;
+    }
+
+    // map the host channels onto the buses, in place.
+    for (int32_t i = 0; i < _inputBusCount; i++)
+    {
+        SetChannelBuffers(_inputs[i], inputs);
+        _inputs[i].silenceFlags = 0;
+        inputs += _inputs[i].numChannels;
+    }
+    for (int32_t i = 0; i < _outputBusCount; i++)
+    {
+        SetChannelBuffers(_outputs[i], outputs);
+        _outputs[i].silenceFlags = 0;
+        outputs += _outputs[i].numChannels;
+    }
+
+    _processData.numSamples = sampleFrames;
+
+    CollectParameterChanges();
+    // the events of several ProcessEvents calls, in sample order.
+    _inputEvents.Sort();
+    _outputChanges.Clear();
+    _outputEvents.Clear();
+
+    _pProcessor->process(_processData);
+
+    _inputChanges.Clear();
+    _inputEvents.Clear();
+
+    DispatchParameterChanges();
+    return true;
+}
+
+// VST3 processors replace their output: render into the accumulate buffers and add those to the host's output.
+void Vst2Adapter::ProcessAccumulating(float** inputs, float** outputs, int32_t sampleFrames)
+{
+    // larger than the block size set before the plugin was switched on.
+    if (sampleFrames > _accumulateCapacity)
+    {
+        if (_isActive) FlushParameters();
+        else _inputEvents.Clear();
+        return;
+    }
+
+    if (!Process(inputs, _accumulateOutputs, sampleFrames)) return;
+
+    for (int32_t i = 0; i < _plugin.outputCount; i++)
+    {
+        for (int32_t n = 0; n < sampleFrames; n++)
+        {
+            outputs[i][n] += _accumulateOutputs[i][n];
+        }
+    }
+}
+
+Vst2IntPtr Vst2Adapter::Dispatch(Vst2PluginCommands command, int32_t index, Vst2IntPtr value, void* ptr, float opt)
+{
+    bool validIndex = index >= 0 && index < _parameterCount;
+
+    switch (command)
+    {
+    case Vst2PluginCommands::Close:
+        SetActive(false);
+        delete this;
+        return 1;
+    case Vst2PluginCommands::SampleRateSet:
+        _setup.sampleRate = opt;
+        return 1;
+    case Vst2PluginCommands::BlockSizeSet:
+        _setup.maxSamplesPerBlock = (int32_t)value;
+        return 1;
+    case Vst2PluginCommands::SetBlockSizeAndSampleRate:
+        _setup.maxSamplesPerBlock = (int32_t)value;
+        _setup.sampleRate = opt;
+        return 1;
+    case Vst2PluginCommands::OnOff:
+        SetActive(value != 0);
+        return 1;
+    case Vst2PluginCommands::SetProcessPrecision:
+        if (value == 1 && _plugin.replaceDouble == nullptr) return 0;
+        _setup.symbolicSampleSize = value == 1 ? Steinberg::Vst::kSample64 : Steinberg::Vst::kSample32;
+        return 1;
+    case Vst2PluginCommands::ProcessEvents:
+        AddMidiEvents((Vst2Events*)ptr);
+        return 1;
+    case Vst2PluginCommands::ParameterGetName:
+        if (!validIndex) return 0;
+        CopyString((char*)ptr, _parameterInfos[index].title, Vst2MaxParamStrLen);
+        return 1;
+    case Vst2PluginCommands::ParameterGetLabel:
+        if (!validIndex) return 0;
+        CopyString((char*)ptr, _parameterInfos[index].units, Vst2MaxParamStrLen);
+        return 1;
+    case Vst2PluginCommands::ParameterGetDisplay:
+        {
+            if (!validIndex) return 0;
+            UpdateController();
+            Steinberg::Vst::String128 display;
+            if (_pController->getParamStringByValue(_parameterInfos[index].id, _parameterValues[index], display) != Steinberg::kResultOk)
+            {
+                return 0;
+            }
+            CopyString((char*)ptr, display, Vst2MaxParamStrLen);
+            return 1;
+        }
+    case Vst2PluginCommands::ParameterCanBeAutomated:
+        return validIndex && (_parameterInfos[index].flags & Steinberg::Vst::ParameterInfo::kCanAutomate) != 0 ? 1 : 0;
+    case Vst2PluginCommands::PluginGetName:
+        CopyString((char*)ptr, _name, Vst2MaxEffectNameLen);
+        return 1;
+    case Vst2PluginCommands::ProductGetString:
+        CopyString((char*)ptr, _name, Vst2MaxProductStrLen);
+        return 1;
+    case Vst2PluginCommands::VendorGetString:
+        CopyString((char*)ptr, _vendor, Vst2MaxVendorStrLen);
+        return 1;
+    case Vst2PluginCommands::PluginGetCategory:
+        return (Vst2IntPtr)(((int32_t)_plugin.flags & (int32_t)Vst2PluginFlags::IsSynth) ? Vst2PlugCategory::Synth : Vst2PlugCategory::Effect);
+    case Vst2PluginCommands::GetVstVersion:
+        return Vst2Version;
+    case Vst2PluginCommands::CanDo:
+        if (ptr != nullptr && _eventBusCount > 0 &&
+            (strcmp((char*)ptr, "receiveVstEvents") == 0 || strcmp((char*)ptr, "receiveVstMidiEvent") == 0))
+        {
+            return 1;
+        }
+        return 0;
+    case Vst2PluginCommands::GetTailSizeInSamples:
+        {
+            // VST2: 0 is unknown, 1 is no tail.
+            uint32_t tail = _pProcessor->getTailSamples();
+            return tail == 0 ? 1 : (Vst2IntPtr)(tail > INT32_MAX ? INT32_MAX : tail);
+        }
+    case Vst2PluginCommands::EditorIdle:
+        UpdateController();
+        return 1;
+    case Vst2PluginCommands::ChunkGet:
+        UpdateController();
+        return GetChunk((void**)ptr);
+    case Vst2PluginCommands::ChunkSet:
+        return SetChunk(ptr, value);
+    default:
+        return 0;
+    }
+}
+
+// chunk layout: component state size (int32), component state, controller state.
+Vst2IntPtr Vst2Adapter::GetChunk(void** ppData)
+{
+    if (ppData == nullptr) return 0;
+
+    _stateStream.Clear();
+
+    int32_t componentSize = 0;
+    _stateStream.write(&componentSize, sizeof(int32_t), nullptr);
+    if (_pComponent->getState(&_stateStream) != Steinberg::kResultOk) return 0;
+
+    componentSize = (int32_t)(_stateStream.GetSize() - sizeof(int32_t));
+    memcpy(_stateStream.GetBuffer(), &componentSize, sizeof(int32_t));
+
+    if (_pController != nullptr && !_isSingleComponent)
+    {
+        _pController->getState(&_stateStream);
+    }
+
+    *ppData = _stateStream.GetBuffer();
+    return (Vst2IntPtr)_stateStream.GetSize();
+}
+
+Vst2IntPtr Vst2Adapter::SetChunk(void* pData, Vst2IntPtr size)
+{
+    if (pData == nullptr || size < (Vst2IntPtr)sizeof(int32_t)) return 0;
+
+    int32_t componentSize = 0;
+    memcpy(&componentSize, pData, sizeof(int32_t));
+    if (componentSize < 0 || componentSize > size - (Vst2IntPtr)sizeof(int32_t)) return 0;
+
+    auto pComponentState = (uint8_t*)pData + sizeof(int32_t);
+    if (!_stateStream.Load(pComponentState, componentSize)) return 0;
+    if (_pComponent->setState(&_stateStream) != Steinberg::kResultOk) return 0;
+
+    if (_pController != nullptr)
+    {
+        _stateStream.Rewind();
+        _pController->setComponentState(&_stateStream);
+
+        int64_t controllerSize = size - sizeof(int32_t) - componentSize;
+        if (controllerSize > 0 && !_isSingleComponent &&
+            _stateStream.Load(pComponentState + componentSize, controllerSize))
+        {
+            _pController->setState(&_stateStream);
+        }
+
+        for (int32_t i = 0; i < _parameterCount; i++)
+        {
+            _parameterValues[i] = (float)_pController->getParamNormalized(_parameterInfos[i].id);
+        }
+    }
+
+    return 1;
+}
+
+Steinberg::tresult PLUGIN_API Vst2Adapter::beginEdit(Steinberg::Vst::ParamID id)
+{
+    int32_t index = FindParameterIndex(id);
+    if (index < 0) return Steinberg::kInvalidArgument;
+
+    _hostCommand(&_plugin, Vst2HostCommands::EditBegin, index, 0, nullptr, 0);
+    return Steinberg::kResultOk;
+}
+
+Steinberg::tresult PLUGIN_API Vst2Adapter::performEdit(Steinberg::Vst::ParamID id, Steinberg::Vst::ParamValue valueNormalized)
+{
+    int32_t index = FindParameterIndex(id);
+    if (index < 0) return Steinberg::kInvalidArgument;
+
+    // the processor receives the value with the next block.
+    _parameterValues[index] = (float)valueNormalized;
+    ExchangeFlag(&_parameterDirty[index], 1);
+
+    _hostCommand(&_plugin, Vst2HostCommands::Automate, index, 0, nullptr, (float)valueNormalized);
+    return Steinberg::kResultOk;
+}
+
+Steinberg::tresult PLUGIN_API Vst2Adapter::endEdit(Steinberg::Vst::ParamID id)
+{
+    int32_t index = FindParameterIndex(id);
+    if (index < 0) return Steinberg::kInvalidArgument;
+
+    _hostCommand(&_plugin, Vst2HostCommands::EditEnd, index, 0, nullptr, 0);
+    return Steinberg::kResultOk;
+}
+
+Steinberg::tresult PLUGIN_API Vst2Adapter::restartComponent(Steinberg::int32 /*flags*/)
+{
+    _plugin.startupDelay = (int32_t)_pProcessor->getLatencySamples();
+    _hostCommand(&_plugin, Vst2HostCommands::IoChanged, 0, 0, nullptr, 0);
+    return Steinberg::kResultOk;
+}
+
+Vst2IntPtr Vst2Handler Vst2Adapter::DispatchProc(Vst2Plugin* pPlugin, Vst2PluginCommands command, int32_t index, Vst2IntPtr value, void* ptr, float opt)
+{
+    return FromPlugin(pPlugin)->Dispatch(command, index, value, ptr, opt);
+}
+
+void Vst2Handler Vst2Adapter::ProcessProc(Vst2Plugin* pPlugin, float** inputs, float** outputs, int32_t sampleFrames)
+{
+    FromPlugin(pPlugin)->Process(inputs, outputs, sampleFrames);
+}
+
+void Vst2Handler Vst2Adapter::ProcessAccumulatingProc(Vst2Plugin* pPlugin, float** inputs, float** outputs, int32_t sampleFrames)
+{
+    FromPlugin(pPlugin)->ProcessAccumulating(inputs, outputs, sampleFrames);
+}
+
+void Vst2Handler Vst2Adapter::ProcessDoubleProc(Vst2Plugin* pPlugin, double** inputs, double** outputs, int32_t sampleFrames)
+{
+    FromPlugin(pPlugin)->Process(inputs, outputs, sampleFrames);
+}
+
+void Vst2Handler Vst2Adapter::SetParameterProc(Vst2Plugin* pPlugin, int32_t index, float value)
+{
+    auto pAdapter = FromPlugin(pPlugin);
+    if (index < 0 || index >= pAdapter->_parameterCount) return;
+
+    // the processor receives the value with the next block, the controller outside the audio thread (UpdateController).
+    pAdapter->_parameterValues[index] = value;
+    ExchangeFlag(&pAdapter->_parameterDirty[index], 1);
+    ExchangeFlag(&pAdapter->_controllerDirty[index], 1);
+}
+
+float Vst2Handler Vst2Adapter::GetParameterProc(Vst2Plugin* pPlugin, int32_t index)
+{
+    auto pAdapter = FromPlugin(pPlugin);
+    if (index < 0 || index >= pAdapter->_parameterCount) return 0;
+
+    return pAdapter->_parameterValues[index];
+}
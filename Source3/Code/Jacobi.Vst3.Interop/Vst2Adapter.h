@@ -0,0 +1,119 @@
+#pragma once
+
+#include <pluginterfaces/base/ipluginbase.h>
+#include <pluginterfaces/vst/ivstaudioprocessor.h>
+#include <pluginterfaces/vst/ivsteditcontroller.h>
+#include "../../../Source/Code/Jacobi.Vst.Interop/Vst2400.h"
+#include "FixedParameterChanges.h"
+#include "FixedEventList.h"
+#include "MemoryStream.h"
+
+// Exposes a VST3 component (IComponent/IAudioProcessor and its IEditController) as a Vst2Plugin.
+// All tables and buffers are allocated when the plugin is switched on;
+// the process and parameter calls only use native code and do not allocate.
+class Vst2Adapter final : public Steinberg::Vst::IComponentHandler
+{
+public:
+    // creates an adapter for the first audio module class of the factory. Returns nullptr on failure.
+    static Vst2Plugin* Create(Steinberg::IPluginFactory* pFactory, Vst2HostCommand hostCommand);
+
+    FIXED_FUNKNOWN_METHODS(Steinberg::Vst::IComponentHandler)
+
+    // IComponentHandler: parameter edits from the controller (editor).
+    Steinberg::tresult PLUGIN_API beginEdit(Steinberg::Vst::ParamID id) override;
+    Steinberg::tresult PLUGIN_API performEdit(Steinberg::Vst::ParamID id, Steinberg::Vst::ParamValue valueNormalized) override;
+    Steinberg::tresult PLUGIN_API endEdit(Steinberg::Vst::ParamID id) override;
+    Steinberg::tresult PLUGIN_API restartComponent(Steinberg::int32 flags) override;
+
+private:
+    // maximum number of points per parameter per block.
+    static const int32_t MaxPointsPerBlock = 16;
+    // number of events per block.
+    static const int32_t EventCapacity = 1024;
+    // number of audio buses per direction.
+    static const int32_t MaxBusCount = 16;
+
+    Vst2Plugin _plugin;
+    Vst2HostCommand _hostCommand;
+
+    Steinberg::Vst::IComponent* _pComponent;
+    Steinberg::Vst::IAudioProcessor* _pProcessor;
+    Steinberg::Vst::IEditController* _pController;
+    // the component also implements the controller.
+    bool _isSingleComponent;
+    // terminate is only called after a successful initialize.
+    bool _isComponentInitialized;
+    char _name[Vst2MaxEffectNameLen + 1];
+    char _vendor[Vst2MaxVendorStrLen + 1];
+
+    // audio buses: channel count per bus, host buffers are mapped in place.
+    Steinberg::Vst::AudioBusBuffers _inputs[MaxBusCount];
+    Steinberg::Vst::AudioBusBuffers _outputs[MaxBusCount];
+    int32_t _inputBusCount;
+    int32_t _outputBusCount;
+    int32_t _eventBusCount;
+
+    // parameters by VST2 index: id, info and the last known normalized value.
+    int32_t _parameterCount;
+    Steinberg::Vst::ParameterInfo* _parameterInfos;
+    volatile float* _parameterValues;
+    // 1 when the host changed the value since the last process call.
+    volatile long* _parameterDirty;
+    // 1 when the host or the processor changed the value and the controller was not told yet.
+    volatile long* _controllerDirty;
+    // parameter ids and their index, sorted on id.
+    struct ParameterIndex
+    {
+        Steinberg::Vst::ParamID id;
+        int32_t index;
+    };
+    ParameterIndex* _parameterIndices;
+
+    FixedParameterChanges _inputChanges;
+    FixedParameterChanges _outputChanges;
+    FixedEventList _inputEvents;
+    FixedEventList _outputEvents;
+    MemoryStream _stateStream;
+
+    // the processor output for the accumulating process call, allocated when the plugin is switched on.
+    float* _accumulateBuffer;
+    float** _accumulateOutputs;
+    int32_t _accumulateCapacity;
+
+    Steinberg::Vst::ProcessSetup _setup;
+    Steinberg::Vst::ProcessData _processData;
+    bool _isActive;
+
+    Vst2Adapter(Vst2HostCommand hostCommand);
+    ~Vst2Adapter();
+
+    bool Initialize(Steinberg::IPluginFactory* pFactory);
+    void InitializeBuses();
+    void InitializeParameters();
+    void SetActive(bool active);
+    void AllocateAccumulateBuffers();
+
+    int32_t FindParameterIndex(Steinberg::Vst::ParamID id);
+    void CollectParameterChanges();
+    void DispatchParameterChanges();
+    void UpdateController();
+    void AddMidiEvents(Vst2Events* pEvents);
+    void FlushParameters();
+    // returns false when the processor was not called.
+    template<typename SampleT>
+    bool Process(SampleT** inputs, SampleT** outputs, int32_t sampleFrames);
+    void ProcessAccumulating(float** inputs, float** outputs, int32_t sampleFrames);
+
+    Vst2IntPtr Dispatch(Vst2PluginCommands command, int32_t index, Vst2IntPtr value, void* ptr, float opt);
+    Vst2IntPtr GetChunk(void** ppData);
+    Vst2IntPtr SetChunk(void* pData, Vst2IntPtr size);
+
+    static Vst2Adapter* FromPlugin(Vst2Plugin* pPlugin) { return (Vst2Adapter*)pPlugin->object; }
+
+    static Vst2IntPtr Vst2Handler DispatchProc(Vst2Plugin* pPlugin, Vst2PluginCommands command, int32_t index, Vst2IntPtr value, void* ptr, float opt);
+    static void Vst2Handler ProcessProc(Vst2Plugin* pPlugin, float** inputs, float** outputs, int32_t sampleFrames);
+    static void Vst2Handler ProcessAccumulatingProc(Vst2Plugin* pPlugin, float** inputs, float** outputs, int32_t sampleFrames);
+    static void Vst2Handler ProcessDoubleProc(Vst2Plugin* pPlugin, double** inputs, double** outputs, int32_t sampleFrames);
+    static void Vst2Handler SetParameterProc(Vst2Plugin* pPlugin, int32_t index, float value);
+    static float Vst2Handler GetParameterProc(Vst2Plugin* pPlugin, int32_t index);
+};
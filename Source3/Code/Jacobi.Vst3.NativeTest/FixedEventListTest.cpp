@@ -0,0 +1,154 @@
+// Adds events to a FixedEventList and checks in-place access, capacity, stable sorting and sorted merges.
+#include "../Jacobi.Vst3.Interop/FixedEventList.h"
+#include "../../../Source/Code/Jacobi.Vst.NativeTest/NativeTest.h"
+
+#include <initializer_list>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+namespace
+{
+	// adds an event per sample offset, tagged with the bus index.
+	void AddEvents(FixedEventList& list, int32 tag, std::initializer_list<int32> sampleOffsets)
+	{
+		for(int32 offset : sampleOffsets)
+		{
+			Event e = {};
+			e.sampleOffset = offset;
+			e.busIndex = tag;
+			CHECK(list.addEvent(e) == kResultOk);
+		}
+	}
+
+	bool HasOffsets(FixedEventList& list, std::initializer_list<int32> sampleOffsets)
+	{
+		if(list.GetCount() != (int32)sampleOffsets.size())
+		{
+			return false;
+		}
+
+		int32 index = 0;
+		for(int32 offset : sampleOffsets)
+		{
+			if(list.Get(index++)->sampleOffset != offset)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void Test_AddEvent_Full()
+	{
+		FixedEventList list;
+		list.Allocate(1);
+
+		Event e = {};
+		CHECK(list.addEvent(e) == kResultOk);
+		CHECK(list.addEvent(e) == kResultFalse);
+		CHECK(list.Add() == nullptr);
+		CHECK(list.getEventCount() == 1);
+	}
+
+	void Test_GetEvent()
+	{
+		FixedEventList list;
+		list.Allocate(4);
+		AddEvents(list, 1, { 5, 10 });
+
+		Event e = {};
+		CHECK(list.getEvent(1, e) == kResultOk);
+		CHECK(e.sampleOffset == 10);
+		CHECK(list.getEvent(2, e) == kInvalidArgument);
+		CHECK(list.getEvent(-1, e) == kInvalidArgument);
+
+		// in place: a change through Get is seen by getEvent.
+		list.Get(0)->sampleOffset = 7;
+		CHECK(list.getEvent(0, e) == kResultOk);
+		CHECK(e.sampleOffset == 7);
+
+		list.Clear();
+		CHECK(list.getEventCount() == 0);
+		CHECK(list.getEvent(0, e) == kInvalidArgument);
+	}
+
+	void Test_Merge_Sorted()
+	{
+		FixedEventList list;
+		list.Allocate(8);
+		AddEvents(list, 8, { 0, 10, 20 });
+
+		FixedEventList source;
+		source.Allocate(4);
+		AddEvents(source, 4, { 5, 10, 30 });
+
+		CHECK(list.Merge(source));
+		CHECK(HasOffsets(list, { 0, 5, 10, 10, 20, 30 }));
+		// equal offsets: the events already in the list go first.
+		CHECK(list.Get(2)->busIndex == 8);
+		CHECK(list.Get(3)->busIndex == 4);
+		CHECK(source.GetCount() == 3);
+	}
+
+	void Test_Merge_TooManyEvents()
+	{
+		FixedEventList list;
+		list.Allocate(3);
+		AddEvents(list, 3, { 0, 10 });
+
+		FixedEventList source;
+		source.Allocate(2);
+		AddEvents(source, 2, { 5, 15 });
+
+		CHECK(!list.Merge(source));
+		CHECK(HasOffsets(list, { 0, 10 }));
+	}
+
+	void Test_Merge_Empty()
+	{
+		FixedEventList list;
+		list.Allocate(4);
+
+		FixedEventList source;
+		source.Allocate(4);
+		AddEvents(source, 1, { 3, 4 });
+
+		CHECK(list.Merge(source));
+		CHECK(HasOffsets(list, { 3, 4 }));
+
+		FixedEventList empty;
+		empty.Allocate(1);
+		CHECK(list.Merge(empty));
+		CHECK(HasOffsets(list, { 3, 4 }));
+	}
+
+	void Test_Sort_Stable()
+	{
+		FixedEventList list;
+		list.Allocate(8);
+		AddEvents(list, 0, { 20, 10 });
+		AddEvents(list, 1, { 10, 0 });
+		AddEvents(list, 2, { 20 });
+
+		list.Sort();
+
+		CHECK(HasOffsets(list, { 0, 10, 10, 20, 20 }));
+		CHECK(list.Get(1)->busIndex == 0);
+		CHECK(list.Get(2)->busIndex == 1);
+		CHECK(list.Get(3)->busIndex == 0);
+		CHECK(list.Get(4)->busIndex == 2);
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_AddEvent_Full),
+		TEST_CASE(Test_GetEvent),
+		TEST_CASE(Test_Merge_Sorted),
+		TEST_CASE(Test_Merge_TooManyEvents),
+		TEST_CASE(Test_Merge_Empty),
+		TEST_CASE(Test_Sort_Stable)
+	});
+}
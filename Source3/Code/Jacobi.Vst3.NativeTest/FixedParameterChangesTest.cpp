@@ -0,0 +1,170 @@
+// Adds parameter changes to a FixedParameterChanges and checks queue lookup by id, sorted points, capacity and clear.
+#include "../Jacobi.Vst3.Interop/FixedParameterChanges.h"
+#include "../../../Source/Code/Jacobi.Vst.NativeTest/NativeTest.h"
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+namespace
+{
+	void Test_AddParameterData_SameId()
+	{
+		FixedParameterChanges changes;
+		changes.Allocate(4, 8);
+
+		int32 index1 = -1;
+		int32 index2 = -1;
+		auto pQueue1 = changes.addParameterData(500, index1);
+		auto pQueue2 = changes.addParameterData(500, index2);
+
+		CHECK(pQueue1 != nullptr);
+		CHECK(pQueue1 == pQueue2);
+		CHECK(index1 == 0 && index2 == 0);
+		CHECK(pQueue1->getParameterId() == 500);
+		CHECK(changes.getParameterCount() == 1);
+		CHECK(changes.getParameterData(0) == pQueue1);
+		CHECK(changes.getParameterData(1) == nullptr);
+	}
+
+	void Test_AddParameterData_Full()
+	{
+		FixedParameterChanges changes;
+		changes.Allocate(2, 8);
+
+		int32 index = -1;
+		CHECK(changes.addParameterData(1, index) != nullptr);
+		CHECK(changes.addParameterData(2, index) != nullptr);
+		CHECK(changes.addParameterData(3, index) == nullptr);
+
+		// an id that is already in use is still found.
+		CHECK(changes.addParameterData(1, index) != nullptr);
+		CHECK(index == 0);
+	}
+
+	void Test_AddParameterData_NotAllocated()
+	{
+		FixedParameterChanges changes;
+
+		int32 index = -1;
+		CHECK(changes.addParameterData(1, index) == nullptr);
+		CHECK(changes.getParameterCount() == 0);
+	}
+
+	void Test_AddParameterData_ManyIds()
+	{
+		const int32 parameterCount = 600;
+		FixedParameterChanges changes;
+		changes.Allocate(parameterCount, 2);
+
+		// ids that are far apart and collide in the low bits.
+		for(int32 i = 0; i < parameterCount; i++)
+		{
+			int32 index = -1;
+			auto pQueue = changes.addParameterData((ParamID)i * 4096, index);
+			CHECK(pQueue != nullptr && index == i);
+		}
+		CHECK(changes.getParameterCount() == parameterCount);
+
+		for(int32 i = parameterCount - 1; i >= 0; i--)
+		{
+			int32 index = -1;
+			changes.addParameterData((ParamID)i * 4096, index);
+			CHECK(index == i);
+		}
+		CHECK(changes.getParameterCount() == parameterCount);
+	}
+
+	void Test_Clear()
+	{
+		FixedParameterChanges changes;
+		changes.Allocate(4, 8);
+
+		int32 index = -1;
+		int32 pointIndex = -1;
+		changes.addParameterData(7, index)->addPoint(0, 0.5, pointIndex);
+		changes.addParameterData(9, index);
+
+		changes.Clear();
+		CHECK(changes.getParameterCount() == 0);
+		CHECK(changes.getParameterData(0) == nullptr);
+
+		// the queue is reused without the points of the previous block.
+		auto pQueue = changes.addParameterData(9, index);
+		CHECK(index == 0);
+		CHECK(pQueue->getParameterId() == 9);
+		CHECK(pQueue->getPointCount() == 0);
+	}
+
+	void Test_AddPoint_Sorted()
+	{
+		FixedParameterChanges changes;
+		changes.Allocate(1, 4);
+
+		int32 index = -1;
+		auto pQueue = changes.addParameterData(1, index);
+
+		int32 pointIndex = -1;
+		CHECK(pQueue->addPoint(20, 0.2, pointIndex) == kResultOk && pointIndex == 0);
+		CHECK(pQueue->addPoint(10, 0.1, pointIndex) == kResultOk && pointIndex == 0);
+		// a point at the same offset replaces the value.
+		CHECK(pQueue->addPoint(20, 0.3, pointIndex) == kResultOk && pointIndex == 1);
+		CHECK(pQueue->getPointCount() == 2);
+
+		int32 offset = -1;
+		ParamValue value = -1;
+		CHECK(pQueue->getPoint(0, offset, value) == kResultOk);
+		CHECK(offset == 10 && value == 0.1);
+		CHECK(pQueue->getPoint(1, offset, value) == kResultOk);
+		CHECK(offset == 20 && value == 0.3);
+		CHECK(pQueue->getPoint(2, offset, value) == kInvalidArgument);
+		CHECK(changes.GetQueue(0)->GetLastValue() == 0.3);
+	}
+
+	void Test_AddPoint_Full()
+	{
+		FixedParameterChanges changes;
+		changes.Allocate(2, 2);
+
+		int32 index = -1;
+		int32 pointIndex = -1;
+		auto pQueue = changes.addParameterData(1, index);
+		pQueue->addPoint(0, 0.0, pointIndex);
+		pQueue->addPoint(10, 0.1, pointIndex);
+
+		CHECK(pQueue->addPoint(5, 0.05, pointIndex) == kResultFalse);
+		// replacing a point does not need room.
+		CHECK(pQueue->addPoint(10, 0.2, pointIndex) == kResultOk);
+
+		// the points of the next queue are separate.
+		auto pOther = changes.addParameterData(2, index);
+		CHECK(pOther->addPoint(0, 1.0, pointIndex) == kResultOk);
+		CHECK(pQueue->getPointCount() == 2);
+		CHECK(changes.GetQueue(0)->GetLastValue() == 0.2);
+	}
+
+	void Test_QueryInterface()
+	{
+		FixedParameterChanges changes;
+		changes.Allocate(1, 1);
+
+		void* pObj = nullptr;
+		CHECK(changes.queryInterface(IParameterChanges::iid, &pObj) == kResultOk);
+		CHECK(pObj == static_cast<IParameterChanges*>(&changes));
+		CHECK(changes.queryInterface(IParamValueQueue::iid, &pObj) == kNoInterface);
+		CHECK(pObj == nullptr);
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_AddParameterData_SameId),
+		TEST_CASE(Test_AddParameterData_Full),
+		TEST_CASE(Test_AddParameterData_NotAllocated),
+		TEST_CASE(Test_AddParameterData_ManyIds),
+		TEST_CASE(Test_Clear),
+		TEST_CASE(Test_AddPoint_Sorted),
+		TEST_CASE(Test_AddPoint_Full),
+		TEST_CASE(Test_QueryInterface)
+	});
+}
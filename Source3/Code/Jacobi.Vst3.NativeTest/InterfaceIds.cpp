@@ -0,0 +1,11 @@
+// Defines the interface ids of the VST3 SDK for a test program (see usediids.cpp in Jacobi.Vst3.Interop).
+#define INIT_CLASS_IID
+
+#include <pluginterfaces/base/funknown.h>
+#include <pluginterfaces/base/ibstream.h>
+#include <pluginterfaces/base/ipluginbase.h>
+#include <pluginterfaces/vst/ivstaudioprocessor.h>
+#include <pluginterfaces/vst/ivstcomponent.h>
+#include <pluginterfaces/vst/ivsteditcontroller.h>
+#include <pluginterfaces/vst/ivstevents.h>
+#include <pluginterfaces/vst/ivstparameterchanges.h>
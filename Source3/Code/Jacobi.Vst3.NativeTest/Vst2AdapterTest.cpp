@@ -0,0 +1,433 @@
+// Wraps a mock VST3 component in a Vst2Adapter and checks the component lifetime, the bus channels,
+// the parameter values the controller receives, the state chunk and the process entry points.
+#include "../Jacobi.Vst3.Interop/Vst2Adapter.h"
+#include "../../../Source/Code/Jacobi.Vst.NativeTest/NativeTest.h"
+
+#include <string.h>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+namespace
+{
+	const ParamID GainId = 1000;
+	const ParamID MeterId = 2000;
+
+	// a single component effect: stereo in and out, a MIDI input, a gain and a meter parameter.
+	// The processor applies the gain and reports 0.25 for the meter. The state is the gain.
+	class MockComponent : public IComponent, public IAudioProcessor, public IEditController
+	{
+	public:
+		tresult initializeResult = kResultOk;
+		tresult busInfoResult = kResultOk;
+		tresult stateResult = kResultOk;
+		int32 refCount = 1;
+		int32 initializeCount = 0;
+		int32 terminateCount = 0;
+		// process calls with audio and without (parameter flushes).
+		int32 processCount = 0;
+		int32 flushCount = 0;
+		int32 eventCount = 0;
+		// the gain the processor uses and the values the controller knows.
+		ParamValue processorGain = 0.5;
+		ParamValue controllerGain = 0.5;
+		ParamValue controllerMeter = 0;
+
+		tresult PLUGIN_API queryInterface(const TUID iid, void** obj) override
+		{
+			if(FUnknownPrivate::iidEqual(iid, IComponent::iid)) *obj = (IComponent*)this;
+			else if(FUnknownPrivate::iidEqual(iid, IAudioProcessor::iid)) *obj = (IAudioProcessor*)this;
+			else if(FUnknownPrivate::iidEqual(iid, IEditController::iid)) *obj = (IEditController*)this;
+			else return kNoInterface;
+
+			refCount++;
+			return kResultOk;
+		}
+		uint32 PLUGIN_API addRef() override { return ++refCount; }
+		uint32 PLUGIN_API release() override { return --refCount; }
+
+		tresult PLUGIN_API initialize(FUnknown*) override { initializeCount++; return initializeResult; }
+		tresult PLUGIN_API terminate() override { terminateCount++; return kResultOk; }
+
+		// IComponent
+		tresult PLUGIN_API getControllerClassId(TUID) override { return kResultFalse; }
+		tresult PLUGIN_API setIoMode(IoMode) override { return kResultOk; }
+		int32 PLUGIN_API getBusCount(MediaType type, BusDirection direction) override { return type == kAudio || direction == kInput ? 1 : 0; }
+		tresult PLUGIN_API getBusInfo(MediaType, BusDirection, int32, BusInfo& bus) override
+		{
+			if(busInfoResult != kResultOk) return busInfoResult;
+
+			bus.channelCount = 2;
+			return kResultOk;
+		}
+		tresult PLUGIN_API getRoutingInfo(RoutingInfo&, RoutingInfo&) override { return kResultFalse; }
+		tresult PLUGIN_API activateBus(MediaType, BusDirection, int32, TBool) override { return kResultOk; }
+		tresult PLUGIN_API setActive(TBool) override { return kResultOk; }
+		tresult PLUGIN_API setState(IBStream* pState) override
+		{
+			int32 read = 0;
+			ParamValue gain;
+			if(pState->read(&gain, sizeof(gain), &read) != kResultOk || read != sizeof(gain)) return kResultFalse;
+
+			processorGain = gain;
+			return kResultOk;
+		}
+		tresult PLUGIN_API getState(IBStream* pState) override
+		{
+			if(stateResult != kResultOk) return stateResult;
+
+			return pState->write(&processorGain, sizeof(processorGain), nullptr);
+		}
+
+		// IAudioProcessor
+		tresult PLUGIN_API setBusArrangements(SpeakerArrangement*, int32, SpeakerArrangement*, int32) override { return kResultOk; }
+		tresult PLUGIN_API getBusArrangement(BusDirection, int32, SpeakerArrangement&) override { return kResultOk; }
+		tresult PLUGIN_API canProcessSampleSize(int32) override { return kResultTrue; }
+		uint32 PLUGIN_API getLatencySamples() override { return 0; }
+		tresult PLUGIN_API setupProcessing(ProcessSetup&) override { return kResultOk; }
+		tresult PLUGIN_API setProcessing(TBool) override { return kResultOk; }
+		tresult PLUGIN_API process(ProcessData& data) override
+		{
+			(data.numSamples > 0 ? processCount : flushCount)++;
+			if(data.inputEvents != nullptr) eventCount += data.inputEvents->getEventCount();
+
+			IParameterChanges* pChanges = data.inputParameterChanges;
+			for(int32 i = 0; i < pChanges->getParameterCount(); i++)
+			{
+				IParamValueQueue* pQueue = pChanges->getParameterData(i);
+				int32 offset;
+				ParamValue value;
+				if(pQueue->getParameterId() == GainId && pQueue->getPoint(pQueue->getPointCount() - 1, offset, value) == kResultOk)
+				{
+					processorGain = value;
+				}
+			}
+
+			for(int32 c = 0; c < 2; c++)
+			{
+				for(int32 n = 0; n < data.numSamples; n++)
+				{
+					if(data.symbolicSampleSize == kSample32)
+						data.outputs[0].channelBuffers32[c][n] = (float)(data.inputs[0].channelBuffers32[c][n] * processorGain);
+					else
+						data.outputs[0].channelBuffers64[c][n] = data.inputs[0].channelBuffers64[c][n] * processorGain;
+				}
+			}
+
+			int32 index;
+			IParamValueQueue* pQueue = data.outputParameterChanges->addParameterData(MeterId, index);
+			pQueue->addPoint(0, 0.25, index);
+			return kResultOk;
+		}
+		uint32 PLUGIN_API getTailSamples() override { return 0; }
+
+		// IEditController
+		tresult PLUGIN_API setComponentState(IBStream*) override { return kResultOk; }
+		int32 PLUGIN_API getParameterCount() override { return 2; }
+		tresult PLUGIN_API getParameterInfo(int32 index, ParameterInfo& info) override
+		{
+			info.id = index == 0 ? GainId : MeterId;
+			info.flags = ParameterInfo::kCanAutomate;
+			return kResultOk;
+		}
+		tresult PLUGIN_API getParamStringByValue(ParamID, ParamValue, String128 string) override { string[0] = 0; return kResultOk; }
+		tresult PLUGIN_API getParamValueByString(ParamID, TChar*, ParamValue&) override { return kResultFalse; }
+		ParamValue PLUGIN_API normalizedParamToPlain(ParamID, ParamValue value) override { return value; }
+		ParamValue PLUGIN_API plainParamToNormalized(ParamID, ParamValue value) override { return value; }
+		ParamValue PLUGIN_API getParamNormalized(ParamID id) override { return id == GainId ? controllerGain : controllerMeter; }
+		tresult PLUGIN_API setParamNormalized(ParamID id, ParamValue value) override
+		{
+			(id == GainId ? controllerGain : controllerMeter) = value;
+			return kResultOk;
+		}
+		tresult PLUGIN_API setComponentHandler(IComponentHandler*) override { return kResultOk; }
+		IPlugView* PLUGIN_API createView(FIDString) override { return nullptr; }
+	};
+
+	class MockFactory : public IPluginFactory
+	{
+	public:
+		MockComponent component;
+
+		tresult PLUGIN_API queryInterface(const TUID, void**) override { return kNoInterface; }
+		uint32 PLUGIN_API addRef() override { return 1; }
+		uint32 PLUGIN_API release() override { return 1; }
+
+		tresult PLUGIN_API getFactoryInfo(PFactoryInfo* pInfo) override { memset(pInfo, 0, sizeof(PFactoryInfo)); return kResultOk; }
+		int32 PLUGIN_API countClasses() override { return 1; }
+		tresult PLUGIN_API getClassInfo(int32, PClassInfo* pInfo) override
+		{
+			memset(pInfo, 0, sizeof(PClassInfo));
+			strcpy(pInfo->category, kVstAudioEffectClass);
+			strcpy(pInfo->name, "Mock");
+			return kResultOk;
+		}
+		tresult PLUGIN_API createInstance(FIDString, FIDString iid, void** obj) override
+		{
+			return component.queryInterface(iid, obj);
+		}
+	};
+
+	Vst2IntPtr Vst2Handler HostCommand(Vst2Plugin*, Vst2HostCommands, int32_t, Vst2IntPtr, void*, float)
+	{
+		return 0;
+	}
+
+	Vst2IntPtr Command(Vst2Plugin* pPlugin, Vst2PluginCommands command, Vst2IntPtr value = 0)
+	{
+		return pPlugin->command(pPlugin, command, 0, value, nullptr, 0);
+	}
+
+	void SwitchOn(Vst2Plugin* pPlugin)
+	{
+		Command(pPlugin, Vst2PluginCommands::OnOff, 0);
+		Command(pPlugin, Vst2PluginCommands::OnOff, 1);
+	}
+
+	// sends a note on at the start of the next block.
+	void SendNote(Vst2Plugin* pPlugin)
+	{
+		Vst2MidiEvent note = {};
+		note.kind = Vst2EventKind::Midi;
+		note.sizeInBytes = sizeof(Vst2MidiEvent);
+		note.midiData[0] = (char)0x90;
+		note.midiData[1] = 60;
+		note.midiData[2] = 100;
+
+		Vst2Events events = {};
+		events.eventCount = 1;
+		events.events[0] = (Vst2Event*)&note;
+		pPlugin->command(pPlugin, Vst2PluginCommands::ProcessEvents, 0, 0, &events, 0);
+	}
+
+	template<typename SampleT>
+	struct StereoBlock
+	{
+		static const int32_t Size = 4;
+		SampleT input[2][Size];
+		SampleT output[2][Size];
+		SampleT* inputs[2] = { input[0], input[1] };
+		SampleT* outputs[2] = { output[0], output[1] };
+
+		StereoBlock()
+		{
+			for(int32_t c = 0; c < 2; c++)
+			{
+				for(int32_t n = 0; n < Size; n++)
+				{
+					input[c][n] = 1;
+					output[c][n] = -1;
+				}
+			}
+		}
+	};
+
+	void Test_Close_TerminatesComponent()
+	{
+		MockFactory factory;
+		Vst2Plugin* pPlugin = Vst2Adapter::Create(&factory, HostCommand);
+		CHECK(pPlugin != nullptr);
+		CHECK(factory.component.initializeCount == 1);
+
+		Command(pPlugin, Vst2PluginCommands::Close);
+		CHECK(factory.component.terminateCount == 1);
+		CHECK(factory.component.refCount == 1);
+	}
+
+	void Test_Create_InitializeFails_NotTerminated()
+	{
+		MockFactory factory;
+		factory.component.initializeResult = kResultFalse;
+
+		CHECK(Vst2Adapter::Create(&factory, HostCommand) == nullptr);
+		CHECK(factory.component.initializeCount == 1);
+		CHECK(factory.component.terminateCount == 0);
+		CHECK(factory.component.refCount == 1);
+	}
+
+	void Test_Create_BusInfoFails_NoChannels()
+	{
+		MockFactory factory;
+		factory.component.busInfoResult = kResultFalse;
+
+		Vst2Plugin* pPlugin = Vst2Adapter::Create(&factory, HostCommand);
+		CHECK(pPlugin->inputCount == 0);
+		CHECK(pPlugin->outputCount == 0);
+
+		Command(pPlugin, Vst2PluginCommands::Close);
+	}
+
+	void Test_Chunk_RoundTrip()
+	{
+		MockFactory factory;
+		Vst2Plugin* pPlugin = Vst2Adapter::Create(&factory, HostCommand);
+		CHECK(((int32_t)pPlugin->flags & (int32_t)Vst2PluginFlags::Programs) != 0);
+
+		factory.component.processorGain = 0.25;
+		void* pChunk = nullptr;
+		Vst2IntPtr size = pPlugin->command(pPlugin, Vst2PluginCommands::ChunkGet, 0, 0, &pChunk, 0);
+		// the component state size and the component state: a single component has no separate controller state.
+		CHECK(size == (Vst2IntPtr)(sizeof(int32_t) + sizeof(ParamValue)));
+
+		char saved[sizeof(int32_t) + sizeof(ParamValue)];
+		memcpy(saved, pChunk, sizeof(saved));
+
+		factory.component.processorGain = 0.9;
+		CHECK(pPlugin->command(pPlugin, Vst2PluginCommands::ChunkSet, 0, sizeof(saved), saved, 0) == 1);
+		CHECK(factory.component.processorGain == 0.25);
+
+		Command(pPlugin, Vst2PluginCommands::Close);
+	}
+
+	void Test_Create_NoState_NoChunks()
+	{
+		MockFactory factory;
+		factory.component.stateResult = kNotImplemented;
+
+		Vst2Plugin* pPlugin = Vst2Adapter::Create(&factory, HostCommand);
+		CHECK(((int32_t)pPlugin->flags & (int32_t)Vst2PluginFlags::Programs) == 0);
+
+		Command(pPlugin, Vst2PluginCommands::Close);
+	}
+
+	void Test_SetParameter_UpdatesController()
+	{
+		MockFactory factory;
+		Vst2Plugin* pPlugin = Vst2Adapter::Create(&factory, HostCommand);
+		SwitchOn(pPlugin);
+
+		// gain is VST2 parameter 0. Hosts automate from the audio thread: the controller is told on the next idle call.
+		pPlugin->parameterSet(pPlugin, 0, 0.75f);
+		CHECK(factory.component.controllerGain == 0.5);
+		CHECK(factory.component.processorGain == 0.5);
+
+		StereoBlock<float> block;
+		pPlugin->replace(pPlugin, block.inputs, block.outputs, StereoBlock<float>::Size);
+		CHECK(factory.component.processorGain == 0.75);
+		CHECK(block.output[1][3] == 0.75f);
+		CHECK(factory.component.controllerGain == 0.5);
+
+		Command(pPlugin, Vst2PluginCommands::EditorIdle);
+		CHECK(factory.component.controllerGain == 0.75);
+
+		Command(pPlugin, Vst2PluginCommands::Close);
+	}
+
+	void Test_ProcessorChange_UpdatesControllerOutsideProcess()
+	{
+		MockFactory factory;
+		Vst2Plugin* pPlugin = Vst2Adapter::Create(&factory, HostCommand);
+		SwitchOn(pPlugin);
+
+		StereoBlock<float> block;
+		pPlugin->replace(pPlugin, block.inputs, block.outputs, StereoBlock<float>::Size);
+
+		// the host sees the meter right away, the controller on the next idle call.
+		CHECK(pPlugin->parameterGet(pPlugin, 1) == 0.25f);
+		CHECK(factory.component.controllerMeter == 0);
+
+		Command(pPlugin, Vst2PluginCommands::EditorIdle);
+		CHECK(factory.component.controllerMeter == 0.25);
+
+		Command(pPlugin, Vst2PluginCommands::Close);
+	}
+
+	void Test_Process_PrecisionMismatch_Silences()
+	{
+		MockFactory factory;
+		Vst2Plugin* pPlugin = Vst2Adapter::Create(&factory, HostCommand);
+		SwitchOn(pPlugin);
+
+		// switched on for 32 bit: the parameters are flushed without audio, the events are dropped.
+		SendNote(pPlugin);
+		pPlugin->parameterSet(pPlugin, 0, 0.75f);
+		StereoBlock<double> doubleBlock;
+		pPlugin->replaceDouble(pPlugin, doubleBlock.inputs, doubleBlock.outputs, StereoBlock<double>::Size);
+		CHECK(factory.component.processCount == 0);
+		CHECK(factory.component.flushCount == 1);
+		CHECK(factory.component.processorGain == 0.75);
+		CHECK(factory.component.eventCount == 0);
+		CHECK(doubleBlock.output[0][0] == 0 && doubleBlock.output[1][3] == 0);
+
+		// the precision is applied when the plugin is switched on.
+		CHECK(Command(pPlugin, Vst2PluginCommands::SetProcessPrecision, 1) == 1);
+		StereoBlock<float> floatBlock;
+		pPlugin->replace(pPlugin, floatBlock.inputs, floatBlock.outputs, StereoBlock<float>::Size);
+		CHECK(factory.component.processCount == 1);
+		CHECK(factory.component.eventCount == 0);
+
+		SwitchOn(pPlugin);
+		StereoBlock<float> silencedBlock;
+		pPlugin->replace(pPlugin, silencedBlock.inputs, silencedBlock.outputs, StereoBlock<float>::Size);
+		CHECK(factory.component.processCount == 1);
+		CHECK(silencedBlock.output[0][0] == 0 && silencedBlock.output[1][3] == 0);
+
+		pPlugin->replaceDouble(pPlugin, doubleBlock.inputs, doubleBlock.outputs, StereoBlock<double>::Size);
+		CHECK(factory.component.processCount == 2);
+		CHECK(doubleBlock.output[0][0] == 0.75);
+
+		Command(pPlugin, Vst2PluginCommands::Close);
+	}
+
+	void Test_Process_SwitchedOff_DropsEvents()
+	{
+		MockFactory factory;
+		Vst2Plugin* pPlugin = Vst2Adapter::Create(&factory, HostCommand);
+
+		SendNote(pPlugin);
+		StereoBlock<float> block;
+		pPlugin->replace(pPlugin, block.inputs, block.outputs, StereoBlock<float>::Size);
+		CHECK(factory.component.processCount == 0);
+
+		SwitchOn(pPlugin);
+		pPlugin->replace(pPlugin, block.inputs, block.outputs, StereoBlock<float>::Size);
+		CHECK(factory.component.processCount == 1);
+		CHECK(factory.component.eventCount == 0);
+
+		SendNote(pPlugin);
+		pPlugin->replace(pPlugin, block.inputs, block.outputs, StereoBlock<float>::Size);
+		CHECK(factory.component.eventCount == 1);
+
+		Command(pPlugin, Vst2PluginCommands::Close);
+	}
+
+	void Test_Process_Accumulating_AddsToOutput()
+	{
+		MockFactory factory;
+		Vst2Plugin* pPlugin = Vst2Adapter::Create(&factory, HostCommand);
+		Command(pPlugin, Vst2PluginCommands::BlockSizeSet, StereoBlock<float>::Size);
+		SwitchOn(pPlugin);
+
+		// the outputs start at -1, the processor adds 0.5.
+		StereoBlock<float> block;
+		pPlugin->process(pPlugin, block.inputs, block.outputs, StereoBlock<float>::Size);
+		CHECK(factory.component.processCount == 1);
+		CHECK(block.output[0][0] == -0.5f && block.output[1][3] == -0.5f);
+
+		pPlugin->process(pPlugin, block.inputs, block.outputs, StereoBlock<float>::Size);
+		CHECK(block.output[0][0] == 0.0f && block.output[1][3] == 0.0f);
+
+		// larger than the block size: nothing is added.
+		pPlugin->process(pPlugin, block.inputs, block.outputs, StereoBlock<float>::Size + 1);
+		CHECK(factory.component.processCount == 2);
+		CHECK(block.output[0][0] == 0.0f);
+
+		Command(pPlugin, Vst2PluginCommands::Close);
+	}
+}
+
+int main()
+{
+	return NativeTest::RunTests({
+		TEST_CASE(Test_Close_TerminatesComponent),
+		TEST_CASE(Test_Create_InitializeFails_NotTerminated),
+		TEST_CASE(Test_Create_BusInfoFails_NoChannels),
+		TEST_CASE(Test_Chunk_RoundTrip),
+		TEST_CASE(Test_Create_NoState_NoChunks),
+		TEST_CASE(Test_SetParameter_UpdatesController),
+		TEST_CASE(Test_ProcessorChange_UpdatesControllerOutsideProcess),
+		TEST_CASE(Test_Process_PrecisionMismatch_Silences),
+		TEST_CASE(Test_Process_SwitchedOff_DropsEvents),
+		TEST_CASE(Test_Process_Accumulating_AddsToOutput)
+	});
+}
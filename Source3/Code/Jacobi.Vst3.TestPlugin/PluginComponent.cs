@@ -106,22 +106,24 @@ namespace Jacobi.Vst3.TestPlugin
             var inputBus = new AudioBusAccessor(ref data, BusDirections.Input, 0);
             var outputBus = new AudioBusAccessor(ref data, BusDirections.Output, 0);
 
-            unsafe
+            var channelCount = Math.Min(inputBus.ChannelCount, outputBus.ChannelCount);
+
+            for (int c = 0; c < channelCount; c++)
             {
-                for (int c = 0; c < inputBus.ChannelCount; c++)
-                {
-                    var input = inputBus.GetUnsafeBuffer32(c);
-                    var output = outputBus.GetUnsafeBuffer32(c);
-                    outputBus.SetChannelSilent(0, input == null);
+                var input = inputBus.GetChannel32(c);
+                var output = outputBus.GetChannel32(c);
+                var silent = inputBus.IsChannelSilent(c);
 
-                    if (input != null && output != null)
-                    {
-                        for (int i = 0; i < outputBus.SampleCount; i++)
-                        {
-                            output[i] = input[i];
-                        }
-                    }
+                if (silent)
+                {
+                    output.Clear();
                 }
+                else if (!input.IsEmpty && !output.IsEmpty)
+                {
+                    input.CopyTo(output);
+                }
+
+                outputBus.SetChannelSilent(c, silent);
             }
 
             return TResult.S_OK;
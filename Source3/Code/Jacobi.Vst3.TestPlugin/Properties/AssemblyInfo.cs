@@ -1,4 +1,5 @@
-﻿using System.Reflection;
+﻿using Jacobi.Vst3.Core.Common;
+using System.Reflection;
 using System.Runtime.InteropServices;
 
 // General Information about an assembly is controlled through the following 
@@ -35,3 +36,6 @@ using System.Runtime.InteropServices;
 //[assembly: AssemblyFileVersion("1.0.0.0")]
 
 //[assembly: NeutralResourcesLanguage("en-US")]
+
+// The plugin factory the interop assembly instantiates.
+[assembly: PluginFactory(typeof(Jacobi.Vst3.TestPlugin.PluginFactory))]
@@ -0,0 +1,113 @@
+using FluentAssertions;
+using Jacobi.Vst3.Core;
+using Jacobi.Vst3.Plugin;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Runtime.InteropServices;
+
+namespace Jacobi.Vst3.UnitTests
+{
+    [TestClass]
+    public class AudioBusAccessorTests
+    {
+        private const int ChannelCount = 2;
+        private const int SampleCount = 8;
+
+        private IntPtr _busPtr;
+        private IntPtr _channelsPtr;
+        private IntPtr[] _samplePtrs;
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            _samplePtrs = new IntPtr[ChannelCount];
+            _channelsPtr = Marshal.AllocHGlobal(IntPtr.Size * ChannelCount);
+
+            for (int c = 0; c < ChannelCount; c++)
+            {
+                _samplePtrs[c] = Marshal.AllocHGlobal(sizeof(float) * SampleCount);
+                Marshal.WriteIntPtr(_channelsPtr, c * IntPtr.Size, _samplePtrs[c]);
+            }
+
+            var buffers = new AudioBusBuffers
+            {
+                NumChannels = ChannelCount,
+                SilenceFlags = 0,
+                ChannelBuffers32 = _channelsPtr
+            };
+
+            _busPtr = Marshal.AllocHGlobal(AudioBusBuffers.Size);
+            Marshal.StructureToPtr(buffers, _busPtr, false);
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            foreach (var ptr in _samplePtrs)
+            {
+                Marshal.FreeHGlobal(ptr);
+            }
+            Marshal.FreeHGlobal(_channelsPtr);
+            Marshal.FreeHGlobal(_busPtr);
+        }
+
+        private ProcessData CreateProcessData()
+        {
+            return new ProcessData
+            {
+                SymbolicSampleSize = SymbolicSampleSizes.Sample32,
+                NumSamples = SampleCount,
+                NumOutputs = 1,
+                Outputs = _busPtr
+            };
+        }
+
+        [TestMethod]
+        public void GetChannel32_WritesToHostBuffer()
+        {
+            var data = CreateProcessData();
+            var bus = new AudioBusAccessor(ref data, BusDirections.Output, 0);
+
+            var channel = bus.GetChannel32(1);
+            channel.Length.Should().Be(SampleCount);
+            channel.Fill(0.5f);
+
+            var samples = new float[SampleCount];
+            Marshal.Copy(_samplePtrs[1], samples, 0, SampleCount);
+            samples.Should().OnlyContain(s => s == 0.5f);
+        }
+
+        [TestMethod]
+        public void SetChannelSilent_WritesToHostBuffer()
+        {
+            var data = CreateProcessData();
+            var bus = new AudioBusAccessor(ref data, BusDirections.Output, 0);
+
+            bus.SetChannelSilent(1, true);
+
+            var buffers = Marshal.PtrToStructure<AudioBusBuffers>(_busPtr);
+            buffers.SilenceFlags.Should().Be(2UL);
+            bus.IsChannelSilent(0).Should().BeFalse();
+            bus.IsChannelSilent(1).Should().BeTrue();
+        }
+
+        [TestMethod]
+        public void GetChannel64_WrongSampleSize_Throws()
+        {
+            var data = CreateProcessData();
+            var bus = new AudioBusAccessor(ref data, BusDirections.Output, 0);
+
+            Action act = () => bus.GetChannel64(0);
+            act.Should().Throw<InvalidOperationException>();
+        }
+
+        [TestMethod]
+        public void Ctor_InvalidBusIndex_Throws()
+        {
+            var data = CreateProcessData();
+
+            Action act = () => new AudioBusAccessor(ref data, BusDirections.Output, 1);
+            act.Should().Throw<ArgumentOutOfRangeException>();
+        }
+    }
+}
@@ -0,0 +1,75 @@
+using FluentAssertions;
+using Jacobi.Vst3.Core;
+using Jacobi.Vst3.Host;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Runtime.InteropServices;
+
+namespace Jacobi.Vst3.UnitTests
+{
+    [TestClass]
+    public class MemoryBStreamTests
+    {
+        [TestMethod]
+        public void Write_GrowsBeyondInitialCapacity()
+        {
+            using var stream = new MemoryBStream(0);
+            var data = new byte[10000];
+            new Random(42).NextBytes(data);
+
+            var ptr = Marshal.AllocHGlobal(data.Length);
+            try
+            {
+                Marshal.Copy(data, 0, ptr, data.Length);
+
+                int written = 0;
+                stream.Write(ptr, data.Length, ref written).Should().Be(TResult.S_OK);
+                written.Should().Be(data.Length);
+            }
+            finally
+            {
+                Marshal.FreeHGlobal(ptr);
+            }
+
+            stream.Length.Should().Be(data.Length);
+            stream.AsSpan().ToArray().Should().Equal(data);
+        }
+
+        [TestMethod]
+        public void Read_AfterLoad_ReturnsContent()
+        {
+            using var stream = new MemoryBStream();
+            stream.Load(new byte[] { 1, 2, 3, 4 });
+
+            long pos = 0;
+            stream.Seek(1, StreamSeekMode.SeekSet, ref pos).Should().Be(TResult.S_OK);
+
+            var ptr = Marshal.AllocHGlobal(8);
+            try
+            {
+                int read = 0;
+                stream.Read(ptr, 8, ref read).Should().Be(TResult.S_OK);
+                read.Should().Be(3);
+
+                var result = new byte[3];
+                Marshal.Copy(ptr, result, 0, 3);
+                result.Should().Equal(2, 3, 4);
+            }
+            finally
+            {
+                Marshal.FreeHGlobal(ptr);
+            }
+        }
+
+        [TestMethod]
+        public void SetStreamSize_ZeroFillsNewBytes()
+        {
+            using var stream = new MemoryBStream();
+            stream.Load(new byte[] { 1 });
+
+            stream.SetStreamSize(3).Should().Be(TResult.S_OK);
+
+            stream.AsSpan().ToArray().Should().Equal(1, 0, 0);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+﻿using FluentAssertions;
+using Jacobi.Vst3.Core;
+using Jacobi.Vst3.Host;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.IO;
+
+namespace Jacobi.Vst3.UnitTests
+{
+    [TestClass]
+    public class Vst3ModuleCacheTests
+    {
+        private string _folder;
+        private string _modulePath;
+        private string _cachePath;
+
+        [TestInitialize]
+        public void Setup()
+        {
+            _folder = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            Directory.CreateDirectory(_folder);
+
+            // a single binary module: its contents are never loaded.
+            _modulePath = Path.Combine(_folder, "Test.vst3");
+            File.WriteAllBytes(_modulePath, new byte[100]);
+
+            _cachePath = Path.Combine(_folder, "cache", "Vst3ModuleCache.bin");
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            Directory.Delete(_folder, true);
+        }
+
+        private static readonly PClassInfo[] ClassInfos = new[]
+        {
+            new PClassInfo { ClassId = Guid.NewGuid(), Cardinality = PClassInfo.ClassCardinalityManyInstances, Category = "Audio Module Class", Name = "Test" },
+            new PClassInfo { ClassId = Guid.NewGuid(), Cardinality = PClassInfo.ClassCardinalityManyInstances, Category = "Component Controller Class", Name = "Test Controller" },
+        };
+
+        private Vst3ModuleCache CreateSavedCache()
+        {
+            var cache = new Vst3ModuleCache(_cachePath);
+            cache.Add(_modulePath, ClassInfos);
+            cache.Save().Should().BeTrue();
+            return cache;
+        }
+
+        private Vst3ModuleCache LoadCache()
+        {
+            var cache = new Vst3ModuleCache(_cachePath);
+            cache.Load();
+            return cache;
+        }
+
+        [TestMethod]
+        public void Load_SavedCache_ReturnsClassInfos()
+        {
+            CreateSavedCache();
+
+            var cache = LoadCache();
+
+            cache.Count.Should().Be(1);
+            cache.TryGetClassInfos(_modulePath, out var classInfos).Should().BeTrue();
+            classInfos.Should().Equal(ClassInfos);
+        }
+
+        [TestMethod]
+        public void TryGetClassInfos_SizeChanged_IsInvalid()
+        {
+            CreateSavedCache();
+            var lastWriteTime = File.GetLastWriteTimeUtc(_modulePath);
+            File.WriteAllBytes(_modulePath, new byte[200]);
+            File.SetLastWriteTimeUtc(_modulePath, lastWriteTime);
+
+            LoadCache().TryGetClassInfos(_modulePath, out _).Should().BeFalse();
+        }
+
+        [TestMethod]
+        public void TryGetClassInfos_WriteTimeChanged_IsInvalid()
+        {
+            CreateSavedCache();
+            File.SetLastWriteTimeUtc(_modulePath, File.GetLastWriteTimeUtc(_modulePath).AddMinutes(1));
+
+            LoadCache().TryGetClassInfos(_modulePath, out _).Should().BeFalse();
+        }
+
+        [TestMethod]
+        public void Load_TruncatedFile_IsEmpty()
+        {
+            CreateSavedCache();
+            var data = File.ReadAllBytes(_cachePath);
+            File.WriteAllBytes(_cachePath, data.AsSpan(0, data.Length - 10).ToArray());
+
+            var cache = LoadCache();
+
+            cache.Count.Should().Be(0);
+            cache.TryGetClassInfos(_modulePath, out _).Should().BeFalse();
+        }
+
+        [TestMethod]
+        public void Load_CorruptFile_IsEmpty()
+        {
+            Directory.CreateDirectory(Path.GetDirectoryName(_cachePath));
+            File.WriteAllBytes(_cachePath, new byte[] { 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+
+            LoadCache().Count.Should().Be(0);
+        }
+
+        [TestMethod]
+        public void Save_UnwritablePath_ReturnsFalse()
+        {
+            // the cache file path is taken by a folder.
+            Directory.CreateDirectory(_cachePath);
+
+            var cache = new Vst3ModuleCache(_cachePath);
+            cache.Add(_modulePath, ClassInfos);
+
+            cache.Save().Should().BeFalse();
+            File.Exists(_cachePath + ".tmp").Should().BeFalse();
+        }
+    }
+}
@@ -0,0 +1,114 @@
+﻿using FluentAssertions;
+using Jacobi.Vst3.Core;
+using Jacobi.Vst3.Host;
+using Jacobi.Vst3.Plugin;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.IO;
+
+namespace Jacobi.Vst3.UnitTests
+{
+    [TestClass]
+    public class VstStreamReaderTests
+    {
+        // a host stream that does not report its size.
+        private class UnsizedBStream : IBStream
+        {
+            private readonly IBStream _stream;
+
+            public UnsizedBStream(IBStream stream) => _stream = stream;
+
+            public int Read(IntPtr buffer, int numBytes, ref int numBytesRead) => _stream.Read(buffer, numBytes, ref numBytesRead);
+            public int Write(IntPtr buffer, int numBytes, ref int numBytesWritten) => _stream.Write(buffer, numBytes, ref numBytesWritten);
+            public int Seek(long pos, StreamSeekMode mode, ref long result) => _stream.Seek(pos, mode, ref result);
+            public int Tell(ref long pos) => _stream.Tell(ref pos);
+        }
+
+        private static ParameterCollection CreateParameters(params uint[] ids)
+        {
+            var parameters = new ParameterCollection();
+            foreach (var id in ids)
+            {
+                var info = new ParameterValueInfo();
+                info.ParameterInfo.ParamId = id;
+                parameters.Add(new Parameter(info));
+            }
+            return parameters;
+        }
+
+        // a parameter count followed by the given number of (id, value) entries.
+        private static byte[] CreateData(int count, int entries)
+        {
+            var data = new MemoryStream();
+            var writer = new BinaryWriter(data);
+            writer.Write(count);
+            for (int i = 0; i < entries; i++)
+            {
+                writer.Write((uint)i);
+                writer.Write(0.5);
+            }
+            return data.ToArray();
+        }
+
+        [TestMethod]
+        public void ReadParameters_WrittenValues_AreRead()
+        {
+            using var stream = new MemoryBStream();
+            var written = CreateParameters(1, 2);
+            written[1].PlainValue = 0.25;
+            written[2].PlainValue = 0.75;
+            new VstStreamWriter(stream).WriteParameters(written);
+
+            stream.Position = 0;
+            var parameters = CreateParameters(1, 2);
+            new VstStreamReader(stream).ReadParameters(parameters);
+
+            parameters[1].PlainValue.Should().Be(0.25);
+            parameters[2].PlainValue.Should().Be(0.75);
+        }
+
+        [TestMethod]
+        public void ReadParameters_NegativeCount_Throws()
+        {
+            using var stream = new MemoryBStream();
+            stream.Load(CreateData(-1, 1));
+
+            Action read = () => new VstStreamReader(stream).ReadParameters(CreateParameters(0));
+
+            read.Should().Throw<InvalidDataException>();
+        }
+
+        [TestMethod]
+        public void ReadParameters_CountBeyondStream_Throws()
+        {
+            using var stream = new MemoryBStream();
+            stream.Load(CreateData(1000, 2));
+
+            Action read = () => new VstStreamReader(stream).ReadParameters(CreateParameters(0));
+
+            read.Should().Throw<InvalidDataException>();
+        }
+
+        [TestMethod]
+        public void ReadParameters_UnsizedStream_RejectsOverflow()
+        {
+            using var stream = new MemoryBStream();
+            stream.Load(CreateData(Int32.MaxValue, 1));
+
+            Action read = () => new VstStreamReader(new UnsizedBStream(stream)).ReadParameters(CreateParameters(0));
+
+            read.Should().Throw<InvalidDataException>();
+        }
+
+        [TestMethod]
+        public void ReadParameters_UnsizedStreamTruncated_Throws()
+        {
+            using var stream = new MemoryBStream();
+            stream.Load(CreateData(3, 2));
+
+            Action read = () => new VstStreamReader(new UnsizedBStream(stream)).ReadParameters(CreateParameters(0));
+
+            read.Should().Throw<EndOfStreamException>();
+        }
+    }
+}